@@ -0,0 +1,138 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the "benchmark plugin"
+ */
+
+// C++ Plugin Framework includes
+#include "BenchmarkPlugin.hpp"
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigWriter.hpp>
+
+// Qt includes
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+// -------------------------------------------------------------------------------------------------
+
+static const VersionInfo s_version("1.0.0");
+static const QString s_description("benchmark plugin");
+static const QString s_interface("CppPluginFramework::Benchmarks::IBenchmarkPlugin");
+static const QSet<QString> s_exportedInterfaces { s_interface };
+
+// -------------------------------------------------------------------------------------------------
+
+BenchmarkPlugin::BenchmarkPlugin(const QString &name)
+    : CppPluginFramework::AbstractPlugin(name, s_version, s_description, s_exportedInterfaces)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool BenchmarkPlugin::loadConfig(const CppConfigFramework::ConfigObjectNode &config)
+{
+    const auto jsonValue = CppConfigFramework::ConfigWriter::convertToJsonValue(config);
+
+    if (!jsonValue.isObject())
+    {
+        return false;
+    }
+
+    const QJsonObject jsonObject = jsonValue.toObject();
+    m_startCost = jsonObject.value(QStringLiteral("start_cost_us")).toInt(0);
+
+    return (m_startCost >= 0);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool BenchmarkPlugin::injectDependency(IPlugin *plugin)
+{
+    if (isStarted() || (!plugin->isInterfaceExported(s_interface)))
+    {
+        return false;
+    }
+
+    auto *dependency = plugin->interface<IBenchmarkPlugin>();
+
+    if (dependency == nullptr)
+    {
+        return false;
+    }
+
+    m_dependencies.append(dependency);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void BenchmarkPlugin::ejectDependencies()
+{
+    if (!isStarted())
+    {
+        m_dependencies.clear();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int BenchmarkPlugin::depth() const
+{
+    int maxDependencyDepth = 0;
+
+    for (const auto *dependency : m_dependencies)
+    {
+        maxDependencyDepth = std::max(maxDependencyDepth, dependency->depth());
+    }
+
+    return maxDependencyDepth + 1;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool BenchmarkPlugin::onStart()
+{
+    // Simulate the cost of the start by busy waiting
+    QElapsedTimer timer;
+    timer.start();
+
+    const qint64 startCost = static_cast<qint64>(m_startCost) * Q_INT64_C(1000);
+
+    while (timer.nsecsElapsed() < startCost)
+    {
+    }
+
+    return true;
+}
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
@@ -0,0 +1,84 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the "benchmark plugin"
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AbstractPlugin.hpp>
+#include <CppPluginFramework/PluginFactoryTemplate.hpp>
+#include <IBenchmarkPlugin.hpp>
+
+// Qt includes
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+/*!
+ * Plugin with a configurable cost of its lifecycle operations
+ *
+ * Config parameters:
+ * - "start_cost_us": CPU time spent in onStart() in microseconds (optional)
+ * - "payload": object of arbitrary size that is converted together with the config (optional)
+ */
+class BenchmarkPlugin : public CppPluginFramework::AbstractPlugin, public IBenchmarkPlugin
+{
+public:
+    BenchmarkPlugin(const QString &name);
+    ~BenchmarkPlugin() = default;
+
+    bool loadConfig(const CppConfigFramework::ConfigObjectNode &config) override;
+    bool injectDependency(IPlugin *plugin) override;
+    void ejectDependencies() override;
+
+    int depth() const override;
+
+private:
+    bool onStart() override;
+
+private:
+    int m_startCost = 0;
+    QList<IBenchmarkPlugin *> m_dependencies;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_EXPORT PluginFactory : public QObject, public PluginFactoryTemplate<BenchmarkPlugin>
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "CppPluginFramework::IPluginFactory" FILE "BenchmarkPlugin.json")
+    Q_INTERFACES(CppPluginFramework::IPluginFactory)
+
+public:
+    //! Destructor
+    ~PluginFactory() override = default;
+};
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
@@ -0,0 +1,249 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a generator of synthetic plugin graphs for the benchmarks
+ */
+
+// Own header
+#include "GraphGenerator.hpp"
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigValueNode.hpp>
+
+// Qt includes
+#include <QtCore/QDir>
+
+// System includes
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+//! Names of the shapes
+static const std::vector<std::pair<GraphGenerator::Shape, QString>> s_shapeNames
+{
+    { GraphGenerator::Shape::Chain, QStringLiteral("chain") },
+    { GraphGenerator::Shape::FanOut, QStringLiteral("fan-out") },
+    { GraphGenerator::Shape::LayeredDag, QStringLiteral("layered") },
+    { GraphGenerator::Shape::Random, QStringLiteral("random") }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Picks distinct random indexes from a range
+ *
+ * \param   begin       First index of the range
+ * \param   end         Index after the last index of the range
+ * \param   count       Maximum number of picked indexes
+ * \param   generator   Random generator
+ *
+ * \return  Picked indexes
+ */
+static std::vector<int> pickIndexes(const int begin,
+                                    const int end,
+                                    const int count,
+                                    std::mt19937 *generator)
+{
+    std::vector<int> indexes;
+
+    for (int index = begin; index < end; index++)
+    {
+        indexes.push_back(index);
+    }
+
+    std::shuffle(indexes.begin(), indexes.end(), *generator);
+    indexes.resize(std::min(indexes.size(), static_cast<size_t>(std::max(count, 0))));
+    return indexes;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool GraphGenerator::shapeFromString(const QString &name, Shape *shape)
+{
+    for (const auto &item : s_shapeNames)
+    {
+        if (item.second == name)
+        {
+            *shape = item.first;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString GraphGenerator::shapeToString(const Shape shape)
+{
+    for (const auto &item : s_shapeNames)
+    {
+        if (item.first == shape)
+        {
+            return item.second;
+        }
+    }
+
+    return QString();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString GraphGenerator::instanceName(const int index)
+{
+    return QStringLiteral("instance%1").arg(index);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString GraphGenerator::libraryFilePath(const Parameters &parameters, const int index)
+{
+    return QDir(parameters.pluginDirectory)
+            .filePath(QStringLiteral("BenchmarkPlugin%1.plugin").arg(index + 1));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::map<QString, QStringList> GraphGenerator::generateDependencies(const Parameters &parameters)
+{
+    std::mt19937 generator(parameters.seed);
+    std::map<QString, QStringList> dependencies;
+
+    // Width of a layer of the layered shape
+    const int layerWidth =
+            std::max(1, static_cast<int>(std::lround(std::sqrt(parameters.instanceCount))));
+
+    for (int index = 0; index < parameters.instanceCount; index++)
+    {
+        std::vector<int> dependencyIndexes;
+
+        switch (parameters.shape)
+        {
+            case Shape::Chain:
+                if (index > 0)
+                {
+                    dependencyIndexes.push_back(index - 1);
+                }
+                break;
+
+            case Shape::FanOut:
+                if (index > 0)
+                {
+                    dependencyIndexes.push_back(0);
+                }
+                break;
+
+            case Shape::LayeredDag:
+            {
+                const int layer = index / layerWidth;
+
+                if (layer > 0)
+                {
+                    dependencyIndexes = pickIndexes((layer - 1) * layerWidth,
+                                                    layer * layerWidth,
+                                                    parameters.maxDependencies,
+                                                    &generator);
+                }
+                break;
+            }
+
+            case Shape::Random:
+            {
+                const int maxCount = std::min(index, parameters.maxDependencies);
+                const int count = std::uniform_int_distribution<int>(0, maxCount)(generator);
+                dependencyIndexes = pickIndexes(0, index, count, &generator);
+                break;
+            }
+        }
+
+        std::sort(dependencyIndexes.begin(), dependencyIndexes.end());
+        QStringList &instanceDependencies = dependencies[instanceName(index)];
+
+        for (const int dependencyIndex : dependencyIndexes)
+        {
+            instanceDependencies.append(instanceName(dependencyIndex));
+        }
+    }
+
+    return dependencies;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+PluginManagerConfig GraphGenerator::generateConfig(const Parameters &parameters)
+{
+    // Config of the plugin instances (same payload for all of them)
+    CppConfigFramework::ConfigObjectNode payload;
+
+    for (int index = 0; index < parameters.configSize; index++)
+    {
+        payload.setMember(QStringLiteral("parameter%1").arg(index),
+                          CppConfigFramework::ConfigValueNode(
+                              QStringLiteral("value%1").arg(index)));
+    }
+
+    CppConfigFramework::ConfigObjectNode instanceConfig;
+    instanceConfig.setMember(QStringLiteral("start_cost_us"),
+                             CppConfigFramework::ConfigValueNode(parameters.startCost));
+    instanceConfig.setMember(QStringLiteral("payload"), payload);
+
+    // Distribute the plugin instances to the plugin libraries
+    const auto dependencies = generateDependencies(parameters);
+    const int libraryCount = std::max(parameters.libraryCount, 1);
+    std::vector<QList<PluginInstanceConfig>> libraryInstances(static_cast<size_t>(libraryCount));
+
+    for (int index = 0; index < parameters.instanceCount; index++)
+    {
+        const QString name = instanceName(index);
+
+        libraryInstances[static_cast<size_t>(index % libraryCount)].append(
+                    PluginInstanceConfig(name, instanceConfig, dependencies.at(name).toSet()));
+    }
+
+    QList<PluginConfig> pluginConfigs;
+
+    for (int index = 0; index < libraryCount; index++)
+    {
+        const auto &instances = libraryInstances[static_cast<size_t>(index)];
+
+        if (!instances.isEmpty())
+        {
+            pluginConfigs.append(PluginConfig(libraryFilePath(parameters, index),
+                                              VersionInfo(1, 0, 0),
+                                              instances));
+        }
+    }
+
+    PluginManagerConfig config;
+    config.setPluginConfigs(pluginConfigs);
+    return config;
+}
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
@@ -0,0 +1,154 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a generator of synthetic plugin graphs for the benchmarks
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/PluginManagerConfig.hpp>
+
+// Qt includes
+#include <QtCore/QStringList>
+
+// System includes
+#include <map>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+//! This class generates plugin manager configs with synthetic dependency graphs
+class GraphGenerator
+{
+public:
+    //! Shape of the dependency graph
+    enum class Shape
+    {
+        //! Each plugin instance depends on the previous one
+        Chain,
+
+        //! All plugin instances depend on the first one
+        FanOut,
+
+        //! Plugin instances are arranged in layers and depend on instances of the previous layer
+        LayeredDag,
+
+        //! Each plugin instance depends on random instances that were generated before it
+        Random
+    };
+
+    //! Parameters of the generated graph
+    struct Parameters
+    {
+        //! Shape of the dependency graph
+        Shape shape = Shape::LayeredDag;
+
+        //! Number of plugin instances
+        int instanceCount = 100;
+
+        //! Number of plugin libraries the plugin instances are distributed to
+        int libraryCount = 1;
+
+        //! Number of payload parameters in the config of each plugin instance
+        int configSize = 10;
+
+        //! CPU time spent in starting each plugin instance in microseconds
+        int startCost = 0;
+
+        //! Maximum number of dependencies of a plugin instance (layered and random shapes)
+        int maxDependencies = 3;
+
+        //! Seed of the random generator (layered and random shapes)
+        quint32 seed = 1U;
+
+        //! Directory with the benchmark plugin libraries
+        QString pluginDirectory;
+    };
+
+    /*!
+     * Converts the shape name to the shape
+     *
+     * \param       name    Shape name ("chain", "fan-out", "layered" or "random")
+     * \param[out]  shape   Shape
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (unknown shape name)
+     */
+    static bool shapeFromString(const QString &name, Shape *shape);
+
+    /*!
+     * Converts the shape to its name
+     *
+     * \param   shape   Shape
+     *
+     * \return  Shape name
+     */
+    static QString shapeToString(Shape shape);
+
+    /*!
+     * Gets the name of the plugin instance
+     *
+     * \param   index   Index of the plugin instance
+     *
+     * \return  Name of the plugin instance
+     */
+    static QString instanceName(int index);
+
+    /*!
+     * Gets the file path to the plugin library
+     *
+     * \param   parameters  Parameters of the generated graph
+     * \param   index       Index of the plugin library
+     *
+     * \return  File path to the plugin library
+     */
+    static QString libraryFilePath(const Parameters &parameters, int index);
+
+    /*!
+     * Generates the dependencies of the plugin instances
+     *
+     * \param   parameters  Parameters of the generated graph
+     *
+     * \return  Dependencies keyed by name of the plugin instance (the graph is always acyclic)
+     */
+    static std::map<QString, QStringList> generateDependencies(const Parameters &parameters);
+
+    /*!
+     * Generates the plugin manager config
+     *
+     * \param   parameters  Parameters of the generated graph
+     *
+     * \return  Plugin manager config
+     */
+    static PluginManagerConfig generateConfig(const Parameters &parameters);
+
+private:
+    //! Construction of this class is disabled
+    GraphGenerator() = delete;
+};
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
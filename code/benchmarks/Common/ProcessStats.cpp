@@ -0,0 +1,160 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the resource usage of the benchmark process
+ */
+
+// Own header
+#include "ProcessStats.hpp"
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/MemoryAccounting.hpp>
+
+// Qt includes
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+// System includes
+#include <algorithm>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+#if defined(Q_OS_LINUX)
+/*!
+ * Reads the current resident set size
+ *
+ * \return  Resident set size in bytes (-1 if not available)
+ */
+static qint64 readResidentSetSize()
+{
+    QFile file(QStringLiteral("/proc/self/statm"));
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return -1;
+    }
+
+    // Second field is the number of resident pages
+    const QList<QByteArray> fields = file.readAll().simplified().split(' ');
+
+    if (fields.size() < 2)
+    {
+        return -1;
+    }
+
+    return fields.at(1).toLongLong() * static_cast<qint64>(sysconf(_SC_PAGESIZE));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Counts the mapped shared libraries and plugins
+ *
+ * \return  Number of mapped libraries (-1 if not available)
+ */
+static int countMappedLibraries()
+{
+    const auto mappings = MemoryAccounting::fileMappings();
+
+    if (mappings.empty())
+    {
+        return -1;
+    }
+
+    int count = 0;
+
+    for (const auto &mapping : mappings)
+    {
+        if (mapping.filePath.contains(QStringLiteral(".so")) ||
+            mapping.filePath.endsWith(QStringLiteral(".plugin")))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Counts the open file descriptors
+ *
+ * \return  Number of open file descriptors (-1 if not available)
+ */
+static int countOpenFileDescriptors()
+{
+    const QDir directory(QStringLiteral("/proc/self/fd"));
+
+    if (!directory.exists())
+    {
+        return -1;
+    }
+
+    // Descriptor used for reading the directory is not counted
+    const int count = directory.entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot)
+                      .size();
+    return std::max(count - 1, 0);
+}
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+ProcessStats ProcessStats::read()
+{
+    ProcessStats stats;
+
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(Q_OS_MACOS)
+        // Reported in bytes
+        stats.peakResidentSetSize = static_cast<qint64>(usage.ru_maxrss);
+#else
+        // Reported in kilobytes
+        stats.peakResidentSetSize = static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+
+#if defined(Q_OS_LINUX)
+    stats.residentSetSize = readResidentSetSize();
+    stats.mappedLibraryCount = countMappedLibraries();
+    stats.openFileDescriptorCount = countOpenFileDescriptors();
+#endif
+
+    return stats;
+}
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
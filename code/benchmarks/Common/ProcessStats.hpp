@@ -0,0 +1,65 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the resource usage of the benchmark process
+ */
+
+#pragma once
+
+// Qt includes
+#include <QtCore/QtGlobal>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace Benchmarks
+{
+
+//! Resource usage of the process
+struct ProcessStats
+{
+    //! Current resident set size in bytes (-1 if not available)
+    qint64 residentSetSize = -1;
+
+    //! Peak resident set size in bytes (-1 if not available)
+    qint64 peakResidentSetSize = -1;
+
+    //! Number of mapped shared libraries and plugins (-1 if not available)
+    int mappedLibraryCount = -1;
+
+    //! Number of open file descriptors (-1 if not available)
+    int openFileDescriptorCount = -1;
+
+    /*!
+     * Reads the resource usage of the calling process
+     *
+     * \return  Resource usage
+     *
+     * \note    Only the peak resident set size is available on other platforms than Linux
+     */
+    static ProcessStats read();
+};
+
+} // namespace Benchmarks
+} // namespace CppPluginFramework
@@ -0,0 +1,544 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a benchmark of the plugin lifecycle with synthetic plugin graphs
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/MemoryAccounting.hpp>
+#include <CppPluginFramework/PluginManager.hpp>
+#include "GraphGenerator.hpp"
+#include "ProcessStats.hpp"
+
+// Qt includes
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+using namespace CppPluginFramework::Benchmarks;
+
+//! Benchmarked phases of the plugin lifecycle
+enum class Phase
+{
+    Load,
+    Start,
+    Stop,
+    Unload
+};
+
+//! Number of the benchmarked phases
+static constexpr size_t s_phaseCount = 4U;
+
+//! Names of the benchmarked phases
+static const std::array<QString, s_phaseCount> s_phaseNames
+{
+    {
+        QStringLiteral("load"),
+        QStringLiteral("start"),
+        QStringLiteral("stop"),
+        QStringLiteral("unload")
+    }
+};
+
+//! Measurements of a single iteration
+struct Iteration
+{
+    //! Wall time of each phase in nanoseconds
+    std::array<qint64, s_phaseCount> durations {};
+
+    //! Number of heap allocations made during each phase
+    std::array<quint64, s_phaseCount> allocationCounts {};
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the total number of heap allocations attributed to the plugin instances
+ *
+ * \return  Number of allocations (always 0 if the allocator is not interposed)
+ */
+static quint64 allocationCount()
+{
+    quint64 count = 0U;
+
+    for (const auto &stats : MemoryAccounting::allocationStats())
+    {
+        count += stats.allocationCount;
+    }
+
+    return count;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Executes a single iteration of the benchmark
+ *
+ * \param       config      Plugin manager config
+ * \param[out]  iteration   Measurements
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+static bool runIteration(const PluginManagerConfig &config, Iteration *iteration)
+{
+    PluginManager pluginManager;
+    QElapsedTimer timer;
+    bool success = true;
+
+    const auto measure = [&](const Phase phase, const std::function<bool()> &function)
+    {
+        const auto index = static_cast<size_t>(phase);
+        const quint64 allocationCountBefore = allocationCount();
+
+        timer.start();
+        success = function() && success;
+        iteration->durations[index] = timer.nsecsElapsed();
+
+        iteration->allocationCounts[index] = allocationCount() - allocationCountBefore;
+    };
+
+    measure(Phase::Load, [&]() { return pluginManager.load(config); });
+    measure(Phase::Start, [&]() { return pluginManager.start(); });
+    measure(Phase::Stop, [&]() { pluginManager.stop(); return true; });
+    measure(Phase::Unload, [&]() { return pluginManager.unload(); });
+
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Summarizes the samples of a phase
+ *
+ * \param   samples     Samples
+ *
+ * \return  Summary with the minimum, median, mean and maximum and the samples
+ */
+static QJsonObject summarize(std::vector<qint64> samples)
+{
+    QJsonArray sampleArray;
+
+    for (const qint64 sample : samples)
+    {
+        sampleArray.append(static_cast<double>(sample));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const size_t middle = samples.size() / 2U;
+    const qint64 median = ((samples.size() % 2U) == 1U)
+                          ? samples[middle]
+                          : ((samples[middle - 1U] + samples[middle]) / 2);
+    const qint64 sum = std::accumulate(samples.cbegin(), samples.cend(), Q_INT64_C(0));
+
+    return QJsonObject {
+        { "min_ns", static_cast<double>(samples.front()) },
+        { "median_ns", static_cast<double>(median) },
+        { "mean_ns", static_cast<double>(sum / static_cast<qint64>(samples.size())) },
+        { "max_ns", static_cast<double>(samples.back()) },
+        { "samples_ns", sampleArray }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Compares the results with the baseline results
+ *
+ * \param   results     Results
+ * \param   baseline    Baseline results
+ * \param   threshold   Maximum allowed increase of the median wall time in percent
+ * \param   stream      Output stream
+ *
+ * \retval  true    No phase regressed
+ * \retval  false   At least one phase regressed beyond the threshold
+ */
+static bool compare(const QJsonObject &results,
+                    const QJsonObject &baseline,
+                    const double threshold,
+                    QTextStream &stream)
+{
+    if (results.value("parameters") != baseline.value("parameters"))
+    {
+        stream << "Warning: the parameters of the baseline differ from the current parameters\n";
+    }
+
+    const QJsonObject phases = results.value("phases").toObject();
+    const QJsonObject baselinePhases = baseline.value("phases").toObject();
+    bool success = true;
+
+    stream << qSetFieldWidth(10) << left << "PHASE"
+           << qSetFieldWidth(16) << right << "BASELINE ms"
+           << qSetFieldWidth(16) << "CURRENT ms"
+           << qSetFieldWidth(12) << "CHANGE %"
+           << qSetFieldWidth(0) << left << "\n";
+
+    for (const QString &phaseName : s_phaseNames)
+    {
+        const double current = phases.value(phaseName).toObject().value("median_ns").toDouble();
+        const double previous =
+                baselinePhases.value(phaseName).toObject().value("median_ns").toDouble();
+
+        if (previous <= 0.0)
+        {
+            stream << qSetFieldWidth(10) << left << phaseName
+                   << qSetFieldWidth(0) << "missing in the baseline\n";
+            continue;
+        }
+
+        const double change = ((current - previous) / previous) * 100.0;
+        const bool regressed = (change > threshold);
+
+        stream << qSetFieldWidth(10) << left << phaseName
+               << qSetFieldWidth(16) << right << QString::number(previous / 1000000.0, 'f', 3)
+               << qSetFieldWidth(16) << QString::number(current / 1000000.0, 'f', 3)
+               << qSetFieldWidth(12) << QString::number(change, 'f', 1)
+               << qSetFieldWidth(0) << left << (regressed ? "  REGRESSION\n" : "\n");
+
+        success = success && (!regressed);
+    }
+
+    stream.flush();
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Reads a non-negative integer option
+ *
+ * \param       parser      Command-line parser
+ * \param       option      Option
+ * \param       minimum     Minimum allowed value
+ * \param[out]  value       Value
+ *
+ * \retval  true    Success
+ * \retval  false   Failure (value is not an integer or is less than the minimum)
+ */
+static bool readIntOption(const QCommandLineParser &parser,
+                          const QCommandLineOption &option,
+                          const int minimum,
+                          int *value)
+{
+    bool ok = false;
+    *value = parser.value(option).toInt(&ok);
+    return ok && (*value >= minimum);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Entry point of the benchmark
+ *
+ * \param   argc    Number of arguments
+ * \param   argv    Arguments
+ *
+ * \return  Exit code (0: success, 1: failure, 2: regression against the baseline)
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("cppplugin-lifecycle-benchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                QStringLiteral("Measures the plugin lifecycle with a synthetic plugin graph"));
+    parser.addHelpOption();
+
+    const QCommandLineOption shapeOption(
+                QStringLiteral("shape"),
+                QStringLiteral("Dependency shape: chain, fan-out, layered or random "
+                               "(default: layered)"),
+                QStringLiteral("shape"),
+                QStringLiteral("layered"));
+    parser.addOption(shapeOption);
+
+    const QCommandLineOption instancesOption(
+                QStringLiteral("instances"),
+                QStringLiteral("Number of plugin instances (default: 100)"),
+                QStringLiteral("count"),
+                QStringLiteral("100"));
+    parser.addOption(instancesOption);
+
+    const QCommandLineOption librariesOption(
+                QStringLiteral("libraries"),
+                QStringLiteral("Number of plugin libraries (default: %1)")
+                .arg(BENCHMARK_LIBRARY_COUNT),
+                QStringLiteral("count"),
+                QString::number(BENCHMARK_LIBRARY_COUNT));
+    parser.addOption(librariesOption);
+
+    const QCommandLineOption configSizeOption(
+                QStringLiteral("config-size"),
+                QStringLiteral("Number of payload parameters per plugin instance (default: 10)"),
+                QStringLiteral("count"),
+                QStringLiteral("10"));
+    parser.addOption(configSizeOption);
+
+    const QCommandLineOption startCostOption(
+                QStringLiteral("start-cost"),
+                QStringLiteral("CPU time spent in starting each plugin instance "
+                               "in microseconds (default: 0)"),
+                QStringLiteral("us"),
+                QStringLiteral("0"));
+    parser.addOption(startCostOption);
+
+    const QCommandLineOption maxDependenciesOption(
+                QStringLiteral("max-dependencies"),
+                QStringLiteral("Maximum number of dependencies per plugin instance (default: 3)"),
+                QStringLiteral("count"),
+                QStringLiteral("3"));
+    parser.addOption(maxDependenciesOption);
+
+    const QCommandLineOption seedOption(
+                QStringLiteral("seed"),
+                QStringLiteral("Seed of the random dependency shapes (default: 1)"),
+                QStringLiteral("seed"),
+                QStringLiteral("1"));
+    parser.addOption(seedOption);
+
+    const QCommandLineOption iterationsOption(
+                QStringLiteral("iterations"),
+                QStringLiteral("Number of measured iterations (default: 5)"),
+                QStringLiteral("count"),
+                QStringLiteral("5"));
+    parser.addOption(iterationsOption);
+
+    const QCommandLineOption warmupOption(
+                QStringLiteral("warmup"),
+                QStringLiteral("Number of iterations executed before the measurement "
+                               "(default: 1)"),
+                QStringLiteral("count"),
+                QStringLiteral("1"));
+    parser.addOption(warmupOption);
+
+    const QCommandLineOption pluginDirOption(
+                QStringLiteral("plugin-dir"),
+                QStringLiteral("Directory with the benchmark plugin libraries"),
+                QStringLiteral("path"),
+                QString::fromUtf8(BENCHMARK_PLUGIN_DIRECTORY));
+    parser.addOption(pluginDirOption);
+
+    const QCommandLineOption labelOption(
+                QStringLiteral("label"),
+                QStringLiteral("Label stored in the results (for example a commit hash)"),
+                QStringLiteral("label"));
+    parser.addOption(labelOption);
+
+    const QCommandLineOption outputOption(
+                QStringLiteral("output"),
+                QStringLiteral("Path to the file the results are written to (default: stdout)"),
+                QStringLiteral("path"));
+    parser.addOption(outputOption);
+
+    const QCommandLineOption compareOption(
+                QStringLiteral("compare"),
+                QStringLiteral("Path to the baseline results to compare the results with"),
+                QStringLiteral("path"));
+    parser.addOption(compareOption);
+
+    const QCommandLineOption thresholdOption(
+                QStringLiteral("threshold"),
+                QStringLiteral("Maximum allowed increase of the median wall time of a phase "
+                               "in percent (default: 10)"),
+                QStringLiteral("percent"),
+                QStringLiteral("10"));
+    parser.addOption(thresholdOption);
+
+    parser.process(application);
+
+    QTextStream errorStream(stderr);
+
+    // Read the parameters
+    GraphGenerator::Parameters parameters;
+    int iterationCount = 0;
+    int warmupCount = 0;
+    int seed = 0;
+
+    if (!GraphGenerator::shapeFromString(parser.value(shapeOption), &parameters.shape))
+    {
+        errorStream << "Invalid dependency shape: " << parser.value(shapeOption) << "\n";
+        errorStream.flush();
+        parser.showHelp(1);
+    }
+
+    if ((!readIntOption(parser, instancesOption, 1, &parameters.instanceCount)) ||
+        (!readIntOption(parser, librariesOption, 1, &parameters.libraryCount)) ||
+        (parameters.libraryCount > BENCHMARK_LIBRARY_COUNT) ||
+        (!readIntOption(parser, configSizeOption, 0, &parameters.configSize)) ||
+        (!readIntOption(parser, startCostOption, 0, &parameters.startCost)) ||
+        (!readIntOption(parser, maxDependenciesOption, 0, &parameters.maxDependencies)) ||
+        (!readIntOption(parser, seedOption, 0, &seed)) ||
+        (!readIntOption(parser, iterationsOption, 1, &iterationCount)) ||
+        (!readIntOption(parser, warmupOption, 0, &warmupCount)))
+    {
+        errorStream << "Invalid benchmark parameters (at most " << BENCHMARK_LIBRARY_COUNT
+                    << " plugin libraries are built)\n";
+        errorStream.flush();
+        parser.showHelp(1);
+    }
+
+    bool ok = false;
+    const double threshold = parser.value(thresholdOption).toDouble(&ok);
+
+    if ((!ok) || (threshold < 0.0))
+    {
+        errorStream << "Invalid threshold: " << parser.value(thresholdOption) << "\n";
+        return 1;
+    }
+
+    parameters.seed = static_cast<quint32>(seed);
+    parameters.pluginDirectory = parser.value(pluginDirOption);
+
+    const PluginManagerConfig config = GraphGenerator::generateConfig(parameters);
+
+    if (!config.isValid())
+    {
+        errorStream << "Generated config is not valid: " << config.validateConfig() << "\n";
+        return 1;
+    }
+
+    // Execute the benchmark
+    std::vector<Iteration> iterations;
+
+    for (int i = 0; i < (warmupCount + iterationCount); i++)
+    {
+        Iteration iteration;
+
+        if (!runIteration(config, &iteration))
+        {
+            errorStream << "Failed to execute the plugin lifecycle (iteration " << i << ")\n";
+            return 1;
+        }
+
+        if (i >= warmupCount)
+        {
+            iterations.push_back(iteration);
+        }
+    }
+
+    // Build the results
+    const bool allocationsCounted = MemoryAccounting::isAllocatorInterposed();
+    QJsonObject phases;
+
+    for (size_t phase = 0U; phase < s_phaseCount; phase++)
+    {
+        std::vector<qint64> durations;
+        quint64 allocations = 0U;
+
+        for (const auto &iteration : iterations)
+        {
+            durations.push_back(iteration.durations[phase]);
+            allocations += iteration.allocationCounts[phase];
+        }
+
+        QJsonObject summary = summarize(durations);
+        summary.insert("allocations",
+                       allocationsCounted
+                       ? QJsonValue(static_cast<double>(allocations / iterations.size()))
+                       : QJsonValue());
+        phases.insert(s_phaseNames[phase], summary);
+    }
+
+    const QJsonObject results {
+        { "label", parser.value(labelOption) },
+        {
+            "parameters",
+            QJsonObject {
+                { "shape", GraphGenerator::shapeToString(parameters.shape) },
+                { "instances", parameters.instanceCount },
+                { "libraries", parameters.libraryCount },
+                { "config_size", parameters.configSize },
+                { "start_cost_us", parameters.startCost },
+                { "max_dependencies", parameters.maxDependencies },
+                { "seed", seed },
+                { "iterations", iterationCount },
+                { "warmup", warmupCount }
+            }
+        },
+        { "phases", phases },
+        { "peak_rss_bytes", static_cast<double>(ProcessStats::read().peakResidentSetSize) }
+    };
+
+    const QByteArray json = QJsonDocument(results).toJson();
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+
+        if ((!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) ||
+            (file.write(json) != json.size()))
+        {
+            errorStream << "Failed to write the results: " << file.fileName() << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        QTextStream outputStream(stdout);
+        outputStream << json;
+    }
+
+    // Compare with the baseline
+    if (parser.isSet(compareOption))
+    {
+        QFile file(parser.value(compareOption));
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            errorStream << "Failed to read the baseline results: " << file.fileName() << "\n";
+            return 1;
+        }
+
+        const QJsonDocument baseline = QJsonDocument::fromJson(file.readAll());
+
+        if (!baseline.isObject())
+        {
+            errorStream << "Invalid baseline results: " << file.fileName() << "\n";
+            return 1;
+        }
+
+        QTextStream outputStream(parser.isSet(outputOption) ? stdout : stderr);
+
+        if (!compare(results, baseline.object(), threshold, outputStream))
+        {
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,361 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains microbenchmarks for PluginInstanceConfig, PluginConfig and PluginManagerConfig classes
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/PluginManagerConfig.hpp>
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigValueNode.hpp>
+
+// Qt includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Benchmark class declaration ---------------------------------------------------------------------
+
+using namespace CppConfigFramework;
+using namespace CppPluginFramework;
+
+class BenchConfig : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Benchmark functions
+    void benchPluginInstanceConfigLoad();
+    void benchPluginInstanceConfigCopy();
+    void benchPluginInstanceConfigIsValid();
+
+    void benchPluginConfigLoad();
+    void benchPluginConfigLoad_data();
+    void benchPluginConfigCopy();
+    void benchPluginConfigCopy_data();
+    void benchPluginConfigIsValid();
+    void benchPluginConfigIsValid_data();
+
+    void benchPluginManagerConfigLoad();
+    void benchPluginManagerConfigLoad_data();
+    void benchPluginManagerConfigCopy();
+    void benchPluginManagerConfigCopy_data();
+    void benchPluginManagerConfigIsValid();
+    void benchPluginManagerConfigIsValid_data();
+
+private:
+    /*!
+     * Adds the data column with the number of plugin instances
+     */
+    static void addInstanceCountData();
+
+    /*!
+     * Creates the config node of a plugin instance
+     *
+     * \param   index   Index of the plugin instance (it depends on the previous plugin instance)
+     *
+     * \return  Config node
+     */
+    static ConfigObjectNode createInstanceNode(int index);
+
+    /*!
+     * Creates the config node of a plugin
+     *
+     * \param   instanceCount   Number of plugin instances
+     *
+     * \return  Config node
+     */
+    static ConfigObjectNode createPluginNode(int instanceCount);
+
+    /*!
+     * Creates the plugin config
+     *
+     * \param   instanceCount   Number of plugin instances
+     *
+     * \return  Plugin config
+     */
+    static PluginConfig createPluginConfig(int instanceCount);
+};
+
+// Benchmark: PluginInstanceConfig::loadConfig() method --------------------------------------------
+
+void BenchConfig::benchPluginInstanceConfigLoad()
+{
+    ConfigObjectNode configNode;
+    configNode.setMember("instance", createInstanceNode(1));
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        PluginInstanceConfig instanceConfig;
+        result = instanceConfig.loadConfig("instance", configNode);
+    }
+
+    QVERIFY(result);
+}
+
+// Benchmark: copying of PluginInstanceConfig ------------------------------------------------------
+
+void BenchConfig::benchPluginInstanceConfigCopy()
+{
+    const PluginInstanceConfig instanceConfig = createPluginConfig(2).instanceConfigs().last();
+    PluginInstanceConfig copy;
+
+    QBENCHMARK
+    {
+        copy = instanceConfig;
+    }
+
+    QCOMPARE(copy, instanceConfig);
+}
+
+// Benchmark: PluginInstanceConfig::isValid() method -----------------------------------------------
+
+void BenchConfig::benchPluginInstanceConfigIsValid()
+{
+    const PluginInstanceConfig instanceConfig = createPluginConfig(2).instanceConfigs().last();
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = instanceConfig.isValid();
+    }
+
+    QVERIFY(result);
+}
+
+// Benchmark: PluginConfig::loadConfig() method ----------------------------------------------------
+
+void BenchConfig::benchPluginConfigLoad()
+{
+    QFETCH(int, instanceCount);
+
+    ConfigObjectNode configNode;
+    configNode.setMember("plugin", createPluginNode(instanceCount));
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        PluginConfig pluginConfig;
+        result = pluginConfig.loadConfig("plugin", configNode);
+    }
+
+    QVERIFY(result);
+}
+
+void BenchConfig::benchPluginConfigLoad_data()
+{
+    addInstanceCountData();
+}
+
+// Benchmark: copying of PluginConfig --------------------------------------------------------------
+
+void BenchConfig::benchPluginConfigCopy()
+{
+    QFETCH(int, instanceCount);
+
+    const PluginConfig pluginConfig = createPluginConfig(instanceCount);
+    PluginConfig copy;
+
+    QBENCHMARK
+    {
+        copy = pluginConfig;
+    }
+
+    QCOMPARE(copy, pluginConfig);
+}
+
+void BenchConfig::benchPluginConfigCopy_data()
+{
+    addInstanceCountData();
+}
+
+// Benchmark: PluginConfig::isValid() method -------------------------------------------------------
+
+void BenchConfig::benchPluginConfigIsValid()
+{
+    QFETCH(int, instanceCount);
+
+    const PluginConfig pluginConfig = createPluginConfig(instanceCount);
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = pluginConfig.isValid();
+    }
+
+    QVERIFY(result);
+}
+
+void BenchConfig::benchPluginConfigIsValid_data()
+{
+    addInstanceCountData();
+}
+
+// Benchmark: PluginManagerConfig::loadConfig() method ---------------------------------------------
+
+void BenchConfig::benchPluginManagerConfigLoad()
+{
+    QFETCH(int, instanceCount);
+
+    ConfigObjectNode pluginsNode;
+    pluginsNode.setMember("plugin1", createPluginNode(instanceCount));
+
+    ConfigObjectNode configNode;
+    configNode.setMember("plugins", pluginsNode);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        PluginManagerConfig managerConfig;
+        result = managerConfig.loadConfig(configNode);
+    }
+
+    QVERIFY(result);
+}
+
+void BenchConfig::benchPluginManagerConfigLoad_data()
+{
+    addInstanceCountData();
+}
+
+// Benchmark: copying of PluginManagerConfig -------------------------------------------------------
+
+void BenchConfig::benchPluginManagerConfigCopy()
+{
+    QFETCH(int, instanceCount);
+
+    PluginManagerConfig managerConfig;
+    managerConfig.setPluginConfigs({ createPluginConfig(instanceCount) });
+
+    PluginManagerConfig copy;
+
+    QBENCHMARK
+    {
+        copy = managerConfig;
+    }
+
+    QCOMPARE(copy, managerConfig);
+}
+
+void BenchConfig::benchPluginManagerConfigCopy_data()
+{
+    addInstanceCountData();
+}
+
+// Benchmark: PluginManagerConfig::isValid() method ------------------------------------------------
+
+void BenchConfig::benchPluginManagerConfigIsValid()
+{
+    QFETCH(int, instanceCount);
+
+    PluginManagerConfig managerConfig;
+    managerConfig.setPluginConfigs({ createPluginConfig(instanceCount) });
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = managerConfig.isValid();
+    }
+
+    QVERIFY(result);
+}
+
+void BenchConfig::benchPluginManagerConfigIsValid_data()
+{
+    addInstanceCountData();
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+void BenchConfig::addInstanceCountData()
+{
+    QTest::addColumn<int>("instanceCount");
+
+    QTest::newRow("1 instance") << 1;
+    QTest::newRow("10 instances") << 10;
+    QTest::newRow("100 instances") << 100;
+}
+
+ConfigObjectNode BenchConfig::createInstanceNode(const int index)
+{
+    ConfigObjectNode config;
+    config.setMember("value", ConfigValueNode(QString("value%1").arg(index)));
+    config.setMember("delimiter", ConfigValueNode(";"));
+
+    ConfigObjectNode instanceNode;
+    instanceNode.setMember("name", ConfigValueNode(QString("instance%1").arg(index)));
+    instanceNode.setMember("config", config);
+
+    if (index > 0)
+    {
+        const QStringList dependencies { QString("instance%1").arg(index - 1) };
+        instanceNode.setMember("dependencies",
+                               ConfigValueNode(QJsonArray::fromStringList(dependencies)));
+    }
+
+    return instanceNode;
+}
+
+ConfigObjectNode BenchConfig::createPluginNode(const int instanceCount)
+{
+    ConfigObjectNode instancesNode;
+
+    for (int i = 0; i < instanceCount; i++)
+    {
+        instancesNode.setMember(QString("instance%1").arg(i), createInstanceNode(i));
+    }
+
+    ConfigObjectNode pluginNode;
+    pluginNode.setMember("file_path", ConfigValueNode(QCoreApplication::applicationFilePath()));
+    pluginNode.setMember("version", ConfigValueNode("1.0.0"));
+    pluginNode.setMember("instances", instancesNode);
+
+    return pluginNode;
+}
+
+PluginConfig BenchConfig::createPluginConfig(const int instanceCount)
+{
+    ConfigObjectNode configNode;
+    configNode.setMember("plugin", createPluginNode(instanceCount));
+
+    PluginConfig pluginConfig;
+
+    if (!pluginConfig.loadConfig("plugin", configNode))
+    {
+        qWarning() << "Failed to create the plugin config";
+    }
+
+    return pluginConfig;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(BenchConfig)
+#include "benchConfig.moc"
@@ -0,0 +1,425 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains microbenchmarks for the access to a plugin instance from concurrent threads
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AbstractPlugin.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+#include <QtTest/QTest>
+
+// System includes
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// Benchmark types ---------------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+//! Number of calls executed by each thread in a single benchmark iteration
+static constexpr int s_callsPerIteration = 1000;
+
+class ICounter
+{
+public:
+    virtual ~ICounter() = default;
+    virtual int increment(int step) = 0;
+};
+
+class CounterPlugin : public AbstractPlugin, public ICounter
+{
+public:
+    explicit CounterPlugin(const QString &name)
+        : AbstractPlugin(name, VersionInfo(1, 0, 0), "counter", {"ICounter", "IOther"})
+    {
+    }
+
+    bool loadConfig(const CppConfigFramework::ConfigObjectNode &) override
+    {
+        return true;
+    }
+
+    bool injectDependency(IPlugin *) override
+    {
+        return false;
+    }
+
+    void ejectDependencies() override
+    {
+    }
+
+    int increment(const int step) override
+    {
+        return m_value.fetch_add(step, std::memory_order_relaxed) + step;
+    }
+
+private:
+    std::atomic<int> m_value { 0 };
+};
+
+/*!
+ * Executes a function concurrently in a pool of threads
+ *
+ * The threads are started once and then wait for the next round, so that the benchmark does not
+ * measure the creation of the threads.
+ */
+class ContentionRunner
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param   threadCount     Number of threads
+     * \param   function        Function executed by each thread in each round
+     */
+    ContentionRunner(const int threadCount, const std::function<void()> &function)
+        : m_function(function)
+    {
+        for (int i = 0; i < threadCount; i++)
+        {
+            m_threads.emplace_back(&ContentionRunner::runThread, this);
+        }
+    }
+
+    //! Destructor (stops the threads)
+    ~ContentionRunner()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stopRequested = true;
+            m_roundStarted.wakeAll();
+        }
+
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    //! Executes a round (returns when all threads executed the function)
+    void run()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_round++;
+        m_pendingThreadCount = static_cast<int>(m_threads.size());
+        m_roundStarted.wakeAll();
+
+        while (m_pendingThreadCount > 0)
+        {
+            m_roundFinished.wait(&m_mutex);
+        }
+    }
+
+private:
+    //! Executes the rounds in a thread of the pool
+    void runThread()
+    {
+        quint64 executedRound = 0U;
+
+        while (true)
+        {
+            {
+                QMutexLocker locker(&m_mutex);
+
+                while ((!m_stopRequested) && (m_round == executedRound))
+                {
+                    m_roundStarted.wait(&m_mutex);
+                }
+
+                if (m_stopRequested)
+                {
+                    return;
+                }
+
+                executedRound = m_round;
+            }
+
+            m_function();
+
+            QMutexLocker locker(&m_mutex);
+            m_pendingThreadCount--;
+
+            if (m_pendingThreadCount == 0)
+            {
+                m_roundFinished.wakeAll();
+            }
+        }
+    }
+
+private:
+    //! Holds the function executed by each thread
+    std::function<void()> m_function;
+
+    //! Holds the threads of the pool
+    std::vector<std::thread> m_threads;
+
+    //! Enables thread-safe access to the state of the rounds
+    QMutex m_mutex;
+
+    //! Wakes up the threads when a round starts or when they need to stop
+    QWaitCondition m_roundStarted;
+
+    //! Wakes up the benchmark when all threads finished the round
+    QWaitCondition m_roundFinished;
+
+    //! Holds the index of the current round
+    quint64 m_round = 0U;
+
+    //! Holds the number of threads that did not finish the current round yet
+    int m_pendingThreadCount = 0;
+
+    //! Holds the flag that requests the threads to stop
+    bool m_stopRequested = false;
+};
+
+// Benchmark class declaration ---------------------------------------------------------------------
+
+class BenchPluginContention : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after each benchmark
+    void init();
+    void cleanup();
+
+    // Benchmark functions
+    void benchInterface();
+    void benchInterface_data();
+
+    void benchName();
+    void benchName_data();
+
+    void benchVersion();
+    void benchVersion_data();
+
+    void benchDescription();
+    void benchDescription_data();
+
+    void benchIsInterfaceExported();
+    void benchIsInterfaceExported_data();
+
+    void benchExportedInterfaces();
+    void benchExportedInterfaces_data();
+
+    void benchIsStarted();
+    void benchIsStarted_data();
+
+private:
+    /*!
+     * Adds the data column with the number of threads
+     */
+    static void addThreadCountData();
+
+    /*!
+     * Benchmarks a call executed concurrently by the number of threads from the current data row
+     *
+     * \param   call    Call (returns false in case of an unexpected result)
+     */
+    static void benchmarkConcurrentCall(const std::function<bool()> &call);
+
+private:
+    //! Plugin instance accessed by the benchmarks
+    std::unique_ptr<CounterPlugin> m_plugin;
+};
+
+// Benchmark init/cleanup methods ------------------------------------------------------------------
+
+void BenchPluginContention::init()
+{
+    m_plugin.reset(new CounterPlugin("instance1"));
+}
+
+void BenchPluginContention::cleanup()
+{
+    m_plugin.reset();
+}
+
+// Benchmark: IPlugin::interface() method ----------------------------------------------------------
+
+void BenchPluginContention::benchInterface()
+{
+    IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return (plugin->interface<ICounter>() != nullptr);
+    });
+}
+
+void BenchPluginContention::benchInterface_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::name() method --------------------------------------------------------
+
+void BenchPluginContention::benchName()
+{
+    const IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return !plugin->name().isEmpty();
+    });
+}
+
+void BenchPluginContention::benchName_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::version() method -----------------------------------------------------
+
+void BenchPluginContention::benchVersion()
+{
+    const IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return plugin->version().isValid();
+    });
+}
+
+void BenchPluginContention::benchVersion_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::description() method -------------------------------------------------
+
+void BenchPluginContention::benchDescription()
+{
+    const IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return !plugin->description().isEmpty();
+    });
+}
+
+void BenchPluginContention::benchDescription_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::isInterfaceExported() method -----------------------------------------
+
+void BenchPluginContention::benchIsInterfaceExported()
+{
+    const IPlugin *plugin = m_plugin.get();
+    const QString interface("IOther");
+
+    benchmarkConcurrentCall([plugin, &interface]()
+    {
+        return plugin->isInterfaceExported(interface);
+    });
+}
+
+void BenchPluginContention::benchIsInterfaceExported_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::exportedInterfaces() method ------------------------------------------
+
+void BenchPluginContention::benchExportedInterfaces()
+{
+    const IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return (plugin->exportedInterfaces().size() == 2);
+    });
+}
+
+void BenchPluginContention::benchExportedInterfaces_data()
+{
+    addThreadCountData();
+}
+
+// Benchmark: AbstractPlugin::isStarted() method ---------------------------------------------------
+
+void BenchPluginContention::benchIsStarted()
+{
+    const IPlugin *plugin = m_plugin.get();
+
+    benchmarkConcurrentCall([plugin]()
+    {
+        return !plugin->isStarted();
+    });
+}
+
+void BenchPluginContention::benchIsStarted_data()
+{
+    addThreadCountData();
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+void BenchPluginContention::addThreadCountData()
+{
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2)
+    {
+        QTest::newRow(QString("%1 thread(s)").arg(threadCount).toUtf8().constData()) << threadCount;
+    }
+}
+
+void BenchPluginContention::benchmarkConcurrentCall(const std::function<bool()> &call)
+{
+    QFETCH(int, threadCount);
+
+    std::atomic<int> failureCount(0);
+
+    ContentionRunner runner(threadCount, [&call, &failureCount]()
+    {
+        for (int i = 0; i < s_callsPerIteration; i++)
+        {
+            if (!call())
+            {
+                failureCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Each iteration executes the call s_callsPerIteration times in each thread
+    QBENCHMARK
+    {
+        runner.run();
+    }
+
+    QCOMPARE(failureCount.load(), 0);
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(BenchPluginContention)
+#include "benchPluginContention.moc"
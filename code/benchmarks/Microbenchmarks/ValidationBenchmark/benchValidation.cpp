@@ -0,0 +1,204 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains microbenchmarks for the validation functions
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/Validation.hpp>
+
+// Qt includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Benchmark class declaration ---------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class BenchValidation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Benchmark functions
+    void benchValidatePluginInstanceName();
+    void benchValidatePluginInstanceName_data();
+
+    void benchValidateInterfaceName();
+    void benchValidateInterfaceName_data();
+
+    void benchValidateExportedInterfaces();
+    void benchValidateExportedInterfaces_data();
+
+    void benchValidateEnvironmentVariableName();
+    void benchValidateEnvironmentVariableName_data();
+
+    void benchValidateFilePath();
+    void benchValidateFilePath_data();
+};
+
+// Benchmark: Validation::validatePluginInstanceName() ---------------------------------------------
+
+void BenchValidation::benchValidatePluginInstanceName()
+{
+    QFETCH(QString, name);
+    QFETCH(bool, expectedResult);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = Validation::validatePluginInstanceName(name);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchValidation::benchValidatePluginInstanceName_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("short") << "instance1" << true;
+    QTest::newRow("long") << "application.subsystem.component-instance_123" << true;
+    QTest::newRow("invalid") << "1instance" << false;
+}
+
+// Benchmark: Validation::validateInterfaceName() --------------------------------------------------
+
+void BenchValidation::benchValidateInterfaceName()
+{
+    QFETCH(QString, name);
+    QFETCH(bool, expectedResult);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = Validation::validateInterfaceName(name);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchValidation::benchValidateInterfaceName_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("short") << "IPlugin" << true;
+    QTest::newRow("namespaced") << "CppPluginFramework::TestPlugins::ITestPlugin1" << true;
+    QTest::newRow("invalid") << "CppPluginFramework:::ITestPlugin1" << false;
+}
+
+// Benchmark: Validation::validateExportedInterfaces() ---------------------------------------------
+
+void BenchValidation::benchValidateExportedInterfaces()
+{
+    QFETCH(int, interfaceCount);
+
+    QSet<QString> exportedInterfaces;
+
+    for (int i = 0; i < interfaceCount; i++)
+    {
+        exportedInterfaces.insert(QString("CppPluginFramework::Benchmarks::IInterface%1").arg(i));
+    }
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = Validation::validateExportedInterfaces(exportedInterfaces);
+    }
+
+    QVERIFY(result);
+}
+
+void BenchValidation::benchValidateExportedInterfaces_data()
+{
+    QTest::addColumn<int>("interfaceCount");
+
+    QTest::newRow("1 interface") << 1;
+    QTest::newRow("4 interfaces") << 4;
+    QTest::newRow("16 interfaces") << 16;
+}
+
+// Benchmark: Validation::validateEnvironmentVariableName() ----------------------------------------
+
+void BenchValidation::benchValidateEnvironmentVariableName()
+{
+    QFETCH(QString, name);
+    QFETCH(bool, expectedResult);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = Validation::validateEnvironmentVariableName(name);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchValidation::benchValidateEnvironmentVariableName_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("short") << "HOME" << true;
+    QTest::newRow("long") << "CPP_PLUGIN_FRAMEWORK_PLUGIN_DIRECTORY" << true;
+    QTest::newRow("invalid") << "1HOME" << false;
+}
+
+// Benchmark: Validation::validateFilePath() -------------------------------------------------------
+
+void BenchValidation::benchValidateFilePath()
+{
+    QFETCH(QString, filePath);
+    QFETCH(bool, expectedResult);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = Validation::validateFilePath(filePath);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchValidation::benchValidateFilePath_data()
+{
+    QTest::addColumn<QString>("filePath");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("existing file") << QCoreApplication::applicationFilePath() << true;
+    QTest::newRow("directory") << QCoreApplication::applicationDirPath() << false;
+    QTest::newRow("missing file") << QCoreApplication::applicationFilePath() + ".missing" << false;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(BenchValidation)
+#include "benchValidation.moc"
@@ -0,0 +1,221 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains microbenchmarks for VersionInfo and VersionRange classes
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/VersionInfo.hpp>
+#include <CppPluginFramework/VersionRange.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QJsonValue>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Benchmark class declaration ---------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+Q_DECLARE_METATYPE(VersionInfo)
+
+class BenchVersion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Benchmark functions
+    void benchParse();
+    void benchParse_data();
+
+    void benchDeserialize();
+
+    void benchToString();
+
+    void benchCompare();
+    void benchCompare_data();
+
+    void benchIsVersionInRange();
+    void benchIsVersionInRange_data();
+
+    void benchVersionRangeMatches();
+    void benchVersionRangeMatches_data();
+};
+
+// Benchmark: parsing of a version string ----------------------------------------------------------
+
+void BenchVersion::benchParse()
+{
+    QFETCH(QString, version);
+
+    bool valid = false;
+
+    QBENCHMARK
+    {
+        valid = VersionInfo(version).isValid();
+    }
+
+    QVERIFY(valid);
+}
+
+void BenchVersion::benchParse_data()
+{
+    QTest::addColumn<QString>("version");
+
+    QTest::newRow("release") << "1.2.3";
+    QTest::newRow("dev") << "1.2.3-alpha.1";
+    QTest::newRow("large numbers") << "123456.654321.999999";
+}
+
+// Benchmark: deserialization of a version ---------------------------------------------------------
+
+void BenchVersion::benchDeserialize()
+{
+    const QJsonValue json(QStringLiteral("1.2.3-dev"));
+    VersionInfo version;
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = deserialize(json, &version);
+    }
+
+    QVERIFY(result);
+    QCOMPARE(version, VersionInfo(1, 2, 3, "dev"));
+}
+
+// Benchmark: conversion of a version to a string --------------------------------------------------
+
+void BenchVersion::benchToString()
+{
+    const VersionInfo version(1, 2, 3, "dev");
+    QString result;
+
+    QBENCHMARK
+    {
+        result = version.toString();
+    }
+
+    QCOMPARE(result, QString("1.2.3-dev"));
+}
+
+// Benchmark: comparison of versions ---------------------------------------------------------------
+
+void BenchVersion::benchCompare()
+{
+    QFETCH(VersionInfo, left);
+    QFETCH(VersionInfo, right);
+
+    int lessCount = 0;
+
+    QBENCHMARK
+    {
+        if (left < right)
+        {
+            lessCount++;
+        }
+    }
+
+    QVERIFY(lessCount > 0);
+}
+
+void BenchVersion::benchCompare_data()
+{
+    QTest::addColumn<VersionInfo>("left");
+    QTest::addColumn<VersionInfo>("right");
+
+    QTest::newRow("major") << VersionInfo(1, 0, 0) << VersionInfo(2, 0, 0);
+    QTest::newRow("patch") << VersionInfo(1, 2, 3) << VersionInfo(1, 2, 4);
+    QTest::newRow("dev") << VersionInfo(1, 2, 3, "alpha") << VersionInfo(1, 2, 3, "beta");
+}
+
+// Benchmark: VersionInfo::isVersionInRange() method -----------------------------------------------
+
+void BenchVersion::benchIsVersionInRange()
+{
+    QFETCH(VersionInfo, version);
+    QFETCH(VersionInfo, minVersion);
+    QFETCH(VersionInfo, maxVersion);
+    QFETCH(bool, expectedResult);
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = VersionInfo::isVersionInRange(version, minVersion, maxVersion);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchVersion::benchIsVersionInRange_data()
+{
+    QTest::addColumn<VersionInfo>("version");
+    QTest::addColumn<VersionInfo>("minVersion");
+    QTest::addColumn<VersionInfo>("maxVersion");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("in range")
+            << VersionInfo(1, 5, 0) << VersionInfo(1, 0, 0) << VersionInfo(2, 0, 0) << true;
+    QTest::newRow("below range")
+            << VersionInfo(0, 9, 0) << VersionInfo(1, 0, 0) << VersionInfo(2, 0, 0) << false;
+    QTest::newRow("dev in range")
+            << VersionInfo(1, 0, 0, "rc1") << VersionInfo(1, 0, 0, "beta")
+            << VersionInfo(1, 1, 0) << true;
+}
+
+// Benchmark: VersionRange::matches() method -------------------------------------------------------
+
+void BenchVersion::benchVersionRangeMatches()
+{
+    QFETCH(QString, expression);
+    QFETCH(VersionInfo, version);
+    QFETCH(bool, expectedResult);
+
+    const VersionRange range(expression);
+    QVERIFY(range.isValid());
+
+    bool result = false;
+
+    QBENCHMARK
+    {
+        result = range.matches(version);
+    }
+
+    QCOMPARE(result, expectedResult);
+}
+
+void BenchVersion::benchVersionRangeMatches_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<VersionInfo>("version");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("caret") << "^1.2" << VersionInfo(1, 5, 0) << true;
+    QTest::newRow("union") << ">=1.0 <1.2 || >=2.0 <3.0" << VersionInfo(2, 1, 0) << true;
+    QTest::newRow("excluded") << "^1.2" << VersionInfo(2, 0, 0) << false;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(BenchVersion)
+#include "benchVersion.moc"
@@ -0,0 +1,584 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a soak test that cycles the plugin manager through its lifecycle many times
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/PluginManager.hpp>
+#include "GraphGenerator.hpp"
+#include "ProcessStats.hpp"
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigValueNode.hpp>
+
+// Qt includes
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
+
+// System includes
+#include <algorithm>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+using namespace CppConfigFramework;
+using namespace CppPluginFramework;
+using namespace CppPluginFramework::Benchmarks;
+
+//! Kind of a soak cycle
+enum class CycleKind
+{
+    //! Load, start, stop and unload
+    Full,
+
+    //! Load and unload without starting
+    LoadOnly,
+
+    //! Load, start, stop, start again, stop and unload
+    Restart,
+
+    //! Load fails while the plugin instances are configured, then unload
+    FailedLoad
+};
+
+//! Latency series of the full cycles of a config
+struct LatencySeries
+{
+    //! Name of the config
+    QString name;
+
+    //! Duration of each full cycle in nanoseconds
+    std::vector<qint64> durations;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates the plugin manager config with the test plugins
+ *
+ * \return  Plugin manager config
+ */
+static PluginManagerConfig createTestPluginsConfig()
+{
+    const PluginConfig plugin1Config(
+                QString::fromUtf8(SOAK_TEST_PLUGIN1_PATH),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance1",
+                        ConfigObjectNode { { "value", ConfigValueNode("value1") } }),
+                    PluginInstanceConfig(
+                        "instance2",
+                        ConfigObjectNode { { "value", ConfigValueNode("value2") } })
+                });
+
+    const PluginConfig plugin2Config(
+                QString::fromUtf8(SOAK_TEST_PLUGIN2_PATH),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig("instance3",
+                                         ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                                         { "instance1", "instance2" })
+                });
+
+    PluginManagerConfig config;
+    config.setPluginConfigs({ plugin1Config, plugin2Config });
+    return config;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates a plugin manager config whose loading fails after some plugin instances were created
+ *
+ * \param   parameters  Parameters of the generated graph
+ *
+ * \return  Plugin manager config (valid, but the last plugin instance rejects its config)
+ */
+static PluginManagerConfig createFailingConfig(const GraphGenerator::Parameters &parameters)
+{
+    PluginManagerConfig config = GraphGenerator::generateConfig(parameters);
+    QList<PluginConfig> pluginConfigs = config.pluginConfigs();
+
+    PluginConfig &lastPluginConfig = pluginConfigs.last();
+    QList<PluginInstanceConfig> instanceConfigs = lastPluginConfig.instanceConfigs();
+    PluginInstanceConfig &lastInstanceConfig = instanceConfigs.last();
+
+    // Benchmark plugin rejects a negative start cost
+    lastInstanceConfig.setConfig(
+                ConfigObjectNode { { "start_cost_us", ConfigValueNode(-1) } });
+    lastPluginConfig.setInstanceConfigs(instanceConfigs);
+
+    config.setPluginConfigs(pluginConfigs);
+    return config;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Executes a soak cycle
+ *
+ * \param   pluginManager   Plugin manager
+ * \param   config          Plugin manager config
+ * \param   kind            Kind of the cycle
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+static bool runCycle(PluginManager *pluginManager,
+                     const PluginManagerConfig &config,
+                     const CycleKind kind)
+{
+    switch (kind)
+    {
+        case CycleKind::Full:
+            if ((!pluginManager->load(config)) || (!pluginManager->start()))
+            {
+                return false;
+            }
+
+            pluginManager->stop();
+            return pluginManager->unload();
+
+        case CycleKind::LoadOnly:
+            return pluginManager->load(config) && pluginManager->unload();
+
+        case CycleKind::Restart:
+            if ((!pluginManager->load(config)) || (!pluginManager->start()))
+            {
+                return false;
+            }
+
+            pluginManager->stop();
+
+            if (!pluginManager->start())
+            {
+                return false;
+            }
+
+            pluginManager->stop();
+            return pluginManager->unload();
+
+        case CycleKind::FailedLoad:
+            if (pluginManager->load(config))
+            {
+                return false;
+            }
+
+            // Plugin manager needs to be reusable after the partially loaded plugins are unloaded
+            pluginManager->unload();
+            return pluginManager->pluginInstanceNames().isEmpty();
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Calculates the median of the samples
+ *
+ * \param   begin   Iterator to the first sample
+ * \param   end     Iterator after the last sample
+ *
+ * \return  Median (0 if there are no samples)
+ */
+static qint64 median(std::vector<qint64>::const_iterator begin,
+                     std::vector<qint64>::const_iterator end)
+{
+    std::vector<qint64> samples(begin, end);
+
+    if (samples.empty())
+    {
+        return 0;
+    }
+
+    const auto middle = samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2U);
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Converts the process stats to JSON
+ *
+ * \param   cycle   Index of the cycle after which the stats were read
+ * \param   stats   Process stats
+ *
+ * \return  JSON object
+ */
+static QJsonObject toJson(const int cycle, const ProcessStats &stats)
+{
+    return QJsonObject {
+        { "cycle", cycle },
+        { "rss_bytes", static_cast<double>(stats.residentSetSize) },
+        { "mapped_libraries", stats.mappedLibraryCount },
+        { "open_file_descriptors", stats.openFileDescriptorCount }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Reads a non-negative integer option
+ *
+ * \param       parser      Command-line parser
+ * \param       option      Option
+ * \param       minimum     Minimum allowed value
+ * \param[out]  value       Value
+ *
+ * \retval  true    Success
+ * \retval  false   Failure (value is not an integer or is less than the minimum)
+ */
+static bool readIntOption(const QCommandLineParser &parser,
+                          const QCommandLineOption &option,
+                          const int minimum,
+                          int *value)
+{
+    bool ok = false;
+    *value = parser.value(option).toInt(&ok);
+    return ok && (*value >= minimum);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Entry point of the soak test
+ *
+ * \param   argc    Number of arguments
+ * \param   argv    Arguments
+ *
+ * \return  Exit code (0: success, 1: failure of a cycle, 2: a threshold was exceeded)
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("cppplugin-soak"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                QStringLiteral("Cycles the plugin manager through its lifecycle and checks that "
+                               "its resource usage and latency do not grow"));
+    parser.addHelpOption();
+
+    const QCommandLineOption cyclesOption(
+                QStringLiteral("cycles"),
+                QStringLiteral("Number of measured cycles (default: 2000)"),
+                QStringLiteral("count"),
+                QStringLiteral("2000"));
+    parser.addOption(cyclesOption);
+
+    const QCommandLineOption warmupOption(
+                QStringLiteral("warmup"),
+                QStringLiteral("Number of cycles executed before the baseline is taken "
+                               "(default: 100)"),
+                QStringLiteral("count"),
+                QStringLiteral("100"));
+    parser.addOption(warmupOption);
+
+    const QCommandLineOption instancesOption(
+                QStringLiteral("instances"),
+                QStringLiteral("Number of generated plugin instances (default: 50)"),
+                QStringLiteral("count"),
+                QStringLiteral("50"));
+    parser.addOption(instancesOption);
+
+    const QCommandLineOption partialEveryOption(
+                QStringLiteral("partial-every"),
+                QStringLiteral("Every N-th cycle is a partial cycle: load only, restart or failed "
+                               "load (default: 10, 0 disables them)"),
+                QStringLiteral("count"),
+                QStringLiteral("10"));
+    parser.addOption(partialEveryOption);
+
+    const QCommandLineOption sampleEveryOption(
+                QStringLiteral("sample-every"),
+                QStringLiteral("Resource usage is sampled every N cycles (default: 100)"),
+                QStringLiteral("count"),
+                QStringLiteral("100"));
+    parser.addOption(sampleEveryOption);
+
+    const QCommandLineOption windowOption(
+                QStringLiteral("window"),
+                QStringLiteral("Number of cycles in the first and last latency window "
+                               "(default: 100)"),
+                QStringLiteral("count"),
+                QStringLiteral("100"));
+    parser.addOption(windowOption);
+
+    const QCommandLineOption maxRssGrowthOption(
+                QStringLiteral("max-rss-growth"),
+                QStringLiteral("Maximum growth of the resident set size in KiB (default: 16384)"),
+                QStringLiteral("KiB"),
+                QStringLiteral("16384"));
+    parser.addOption(maxRssGrowthOption);
+
+    const QCommandLineOption maxLibraryGrowthOption(
+                QStringLiteral("max-library-growth"),
+                QStringLiteral("Maximum growth of the number of mapped libraries (default: 0)"),
+                QStringLiteral("count"),
+                QStringLiteral("0"));
+    parser.addOption(maxLibraryGrowthOption);
+
+    const QCommandLineOption maxFdGrowthOption(
+                QStringLiteral("max-fd-growth"),
+                QStringLiteral("Maximum growth of the number of open file descriptors "
+                               "(default: 0)"),
+                QStringLiteral("count"),
+                QStringLiteral("0"));
+    parser.addOption(maxFdGrowthOption);
+
+    const QCommandLineOption maxLatencyDriftOption(
+                QStringLiteral("max-latency-drift"),
+                QStringLiteral("Maximum increase of the median cycle latency in percent "
+                               "(default: 50)"),
+                QStringLiteral("percent"),
+                QStringLiteral("50"));
+    parser.addOption(maxLatencyDriftOption);
+
+    const QCommandLineOption outputOption(
+                QStringLiteral("output"),
+                QStringLiteral("Path to the file the report is written to"),
+                QStringLiteral("path"));
+    parser.addOption(outputOption);
+
+    parser.process(application);
+
+    QTextStream errorStream(stderr);
+    QTextStream outputStream(stdout);
+
+    int cycleCount = 0;
+    int warmupCount = 0;
+    int partialEvery = 0;
+    int sampleEvery = 0;
+    int window = 0;
+    int maxRssGrowth = 0;
+    int maxLibraryGrowth = 0;
+    int maxFdGrowth = 0;
+    int maxLatencyDrift = 0;
+
+    GraphGenerator::Parameters parameters;
+    parameters.libraryCount = BENCHMARK_LIBRARY_COUNT;
+    parameters.pluginDirectory = QString::fromUtf8(BENCHMARK_PLUGIN_DIRECTORY);
+
+    if ((!readIntOption(parser, cyclesOption, 1, &cycleCount)) ||
+        (!readIntOption(parser, warmupOption, 0, &warmupCount)) ||
+        (!readIntOption(parser, instancesOption, 1, &parameters.instanceCount)) ||
+        (!readIntOption(parser, partialEveryOption, 0, &partialEvery)) ||
+        (!readIntOption(parser, sampleEveryOption, 1, &sampleEvery)) ||
+        (!readIntOption(parser, windowOption, 1, &window)) ||
+        (!readIntOption(parser, maxRssGrowthOption, 0, &maxRssGrowth)) ||
+        (!readIntOption(parser, maxLibraryGrowthOption, 0, &maxLibraryGrowth)) ||
+        (!readIntOption(parser, maxFdGrowthOption, 0, &maxFdGrowth)) ||
+        (!readIntOption(parser, maxLatencyDriftOption, 0, &maxLatencyDrift)))
+    {
+        errorStream << "Invalid soak test parameters\n";
+        errorStream.flush();
+        parser.showHelp(1);
+    }
+
+    // Prepare the configs (full cycles alternate between them)
+    const std::vector<PluginManagerConfig> configs
+    {
+        createTestPluginsConfig(),
+        GraphGenerator::generateConfig(parameters)
+    };
+    const PluginManagerConfig failingConfig = createFailingConfig(parameters);
+
+    std::vector<LatencySeries> latencySeries(configs.size());
+    latencySeries[0].name = QStringLiteral("test_plugins");
+    latencySeries[1].name = QStringLiteral("generated");
+
+    for (const auto &config : configs)
+    {
+        if (!config.isValid())
+        {
+            errorStream << "Config is not valid: " << config.validateConfig() << "\n";
+            return 1;
+        }
+    }
+
+    // Execute the cycles
+    PluginManager pluginManager;
+    ProcessStats baseline;
+    QJsonArray samples;
+    const int totalCycleCount = warmupCount + cycleCount;
+    int partialCycleIndex = 0;
+
+    for (int cycle = 0; cycle < totalCycleCount; cycle++)
+    {
+        if (cycle == warmupCount)
+        {
+            baseline = ProcessStats::read();
+            samples.append(toJson(cycle, baseline));
+        }
+
+        const bool partial = (partialEvery > 0) && (((cycle + 1) % partialEvery) == 0);
+        bool success = false;
+
+        if (partial)
+        {
+            const CycleKind kinds[] { CycleKind::LoadOnly, CycleKind::Restart,
+                                      CycleKind::FailedLoad };
+            const CycleKind kind = kinds[partialCycleIndex % 3];
+            partialCycleIndex++;
+
+            success = runCycle(&pluginManager,
+                               (kind == CycleKind::FailedLoad) ? failingConfig : configs[1],
+                               kind);
+        }
+        else
+        {
+            const size_t configIndex = static_cast<size_t>(cycle) % configs.size();
+
+            QElapsedTimer timer;
+            timer.start();
+            success = runCycle(&pluginManager, configs[configIndex], CycleKind::Full);
+
+            if (cycle >= warmupCount)
+            {
+                latencySeries[configIndex].durations.push_back(timer.nsecsElapsed());
+            }
+        }
+
+        if (!success)
+        {
+            errorStream << "Cycle " << cycle << " failed\n";
+            return 1;
+        }
+
+        if ((cycle >= warmupCount) && (((cycle - warmupCount + 1) % sampleEvery) == 0))
+        {
+            const ProcessStats stats = ProcessStats::read();
+            samples.append(toJson(cycle + 1, stats));
+
+            outputStream << "cycle " << (cycle + 1) << "/" << totalCycleCount
+                         << ": rss " << (stats.residentSetSize / 1024) << " KiB"
+                         << ", libraries " << stats.mappedLibraryCount
+                         << ", fds " << stats.openFileDescriptorCount << "\n";
+            outputStream.flush();
+        }
+    }
+
+    // Check the resource growth
+    const ProcessStats current = ProcessStats::read();
+    QStringList failures;
+
+    const qint64 rssGrowth = current.residentSetSize - baseline.residentSetSize;
+    const int libraryGrowth = current.mappedLibraryCount - baseline.mappedLibraryCount;
+    const int fdGrowth = current.openFileDescriptorCount - baseline.openFileDescriptorCount;
+
+    if ((baseline.residentSetSize >= 0) && (rssGrowth > (static_cast<qint64>(maxRssGrowth) * 1024)))
+    {
+        failures.append(QString("RSS grew by %1 KiB").arg(rssGrowth / 1024));
+    }
+
+    if ((baseline.mappedLibraryCount >= 0) && (libraryGrowth > maxLibraryGrowth))
+    {
+        failures.append(QString("Number of mapped libraries grew by %1").arg(libraryGrowth));
+    }
+
+    if ((baseline.openFileDescriptorCount >= 0) && (fdGrowth > maxFdGrowth))
+    {
+        failures.append(QString("Number of open file descriptors grew by %1").arg(fdGrowth));
+    }
+
+    // Check the latency drift (first window against the last window of each config)
+    QJsonObject latencies;
+
+    for (const auto &series : latencySeries)
+    {
+        const auto size = static_cast<std::ptrdiff_t>(series.durations.size());
+        const std::ptrdiff_t windowSize = std::min(static_cast<std::ptrdiff_t>(window), size / 2);
+
+        if (windowSize == 0)
+        {
+            continue;
+        }
+
+        const qint64 first = median(series.durations.cbegin(),
+                                    series.durations.cbegin() + windowSize);
+        const qint64 last = median(series.durations.cend() - windowSize, series.durations.cend());
+        const double drift = (first > 0) ? ((static_cast<double>(last - first) / first) * 100.0)
+                                         : 0.0;
+
+        latencies.insert(series.name, QJsonObject {
+                             { "first_median_ns", static_cast<double>(first) },
+                             { "last_median_ns", static_cast<double>(last) },
+                             { "drift_percent", drift }
+                         });
+
+        if (drift > maxLatencyDrift)
+        {
+            failures.append(QString("Median latency of the %1 cycles drifted by %2%")
+                            .arg(series.name)
+                            .arg(drift, 0, 'f', 1));
+        }
+    }
+
+    // Write the report
+    const QJsonObject report {
+        { "cycles", cycleCount },
+        { "warmup", warmupCount },
+        { "instances", parameters.instanceCount },
+        { "partial_every", partialEvery },
+        { "samples", samples },
+        { "latencies", latencies },
+        { "rss_growth_bytes", static_cast<double>(rssGrowth) },
+        { "mapped_library_growth", libraryGrowth },
+        { "open_file_descriptor_growth", fdGrowth },
+        { "failures", QJsonArray::fromStringList(failures) }
+    };
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        const QByteArray json = QJsonDocument(report).toJson();
+
+        if ((!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) ||
+            (file.write(json) != json.size()))
+        {
+            errorStream << "Failed to write the report: " << file.fileName() << "\n";
+            return 1;
+        }
+    }
+
+    for (const QString &failure : failures)
+    {
+        errorStream << "FAIL: " << failure << "\n";
+    }
+
+    if (!failures.isEmpty())
+    {
+        return 2;
+    }
+
+    outputStream << "PASS: " << totalCycleCount << " cycles\n";
+    return 0;
+}
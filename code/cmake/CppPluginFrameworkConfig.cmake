@@ -1,4 +1,5 @@
 include(CMakeFindDependencyMacro)
 find_dependency(CppConfigFramework)
+find_dependency(Threads)
 
 include("${CMAKE_CURRENT_LIST_DIR}/CppPluginFrameworkTargets.cmake")
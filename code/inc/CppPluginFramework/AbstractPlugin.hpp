@@ -22,6 +22,8 @@
 
 // C++ Plugin Framework includes
 #include <CppPluginFramework/IPlugin.hpp>
+#include <CppPluginFramework/MetricsRegistry.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
 
 // Qt includes
 #include <QtCore/QMutex>
@@ -46,8 +48,11 @@ namespace CppPluginFramework
  * - Injection and ejection of dependencies
  *
  * Derived classes can also hook to events:
+ * - Preparing plugin
  * - Starting plugin
  * - Stopping plugin
+ *
+ * A plugin instance is ready as soon as it is started, unless it defers its readiness.
  */
 class CPPPLUGINFRAMEWORK_EXPORT AbstractPlugin : public IPlugin
 {
@@ -81,6 +86,9 @@ public:
     //! \copydoc CppPluginFramework::IPlugin::exportedInterfaces()
     QSet<QString> exportedInterfaces() const override final;
 
+    //! \copydoc CppPluginFramework::IPlugin::prepare()
+    bool prepare() override final;
+
     //! \copydoc CppPluginFramework::IPlugin::isStarted()
     bool isStarted() const override final;
 
@@ -90,7 +98,86 @@ public:
     //! \copydoc CppPluginFramework::IPlugin::stop()
     void stop() override final;
 
+    //! \copydoc CppPluginFramework::IPlugin::readiness()
+    std::shared_ptr<Readiness> readiness() const override final;
+
+protected:
+    /*!
+     * Defers the readiness of this plugin instance
+     *
+     * \return  Readiness that needs to be settled when the plugin instance is ready (or failed)
+     *
+     * This is meant to be called from onStart() by a plugin instance that needs a long time to
+     * become ready, so that it can return from onStart() early and finish its work (for example
+     * the warm-up of a cache) in the background. Readiness can be settled from any thread except
+     * the one that starts the plugin manager (or looks up a lazy plugin instance), because that
+     * thread is blocked while it waits for the readiness (see PluginManager::start()). Dependents
+     * fail to start if the readiness is not settled within the readiness timeout.
+     */
+    std::shared_ptr<Readiness> deferReadiness();
+
+    /*!
+     * Creates a trace span for this plugin instance
+     *
+     * \param   name    Name of the span (string literal)
+     *
+     * \return  Span that records a trace event when it goes out of scope
+     *
+     * This is meant for marking the internals of the plugin (for example of onStart()) in the
+     * trace. The span is nested in the trace event of the lifecycle phase that is executed on the
+     * same thread. If trace recording is disabled the span does nothing.
+     */
+    TraceRecorder::Span traceSpan(const char *name) const;
+
+    /*!
+     * Registers a counter of this plugin instance
+     *
+     * \param   name    Metric name
+     * \param   help    Help text
+     *
+     * \return  Counter handle (see MetricsRegistry::counter())
+     *
+     * Handles can be stored and used from any thread, incrementing a counter never takes a lock.
+     */
+    MetricsRegistry::Counter registerCounter(const QString &name,
+                                             const QString &help = QString()) const;
+
+    /*!
+     * Registers a gauge of this plugin instance
+     *
+     * \param   name    Metric name
+     * \param   help    Help text
+     *
+     * \return  Gauge handle (see MetricsRegistry::gauge())
+     */
+    MetricsRegistry::Gauge registerGauge(const QString &name,
+                                         const QString &help = QString()) const;
+
+    /*!
+     * Registers a histogram of this plugin instance
+     *
+     * \param   name    Metric name (should contain the unit, for example "_nanoseconds")
+     * \param   help    Help text
+     *
+     * \return  Histogram handle (see MetricsRegistry::histogram())
+     */
+    MetricsRegistry::Histogram registerHistogram(const QString &name,
+                                                 const QString &help = QString()) const;
+
 private:
+    /*!
+     * Executes the preparation procedure
+     *
+     * \retval  true    Success
+     * \retval  false    Failure
+     *
+     * This method is called inside prepare() method, possibly on a worker thread and concurrently
+     * with the preparation of other plugin instances. Default implementation doesn't do anything.
+     * This method needs to be overridden if any work that doesn't need the dependencies can be
+     * moved out of the startup.
+     */
+    virtual bool onPrepare();
+
     /*!
      * Executes the startup procedure
      *
@@ -130,6 +217,9 @@ private:
 
     //! Holds the "started" flag
     bool m_started;
+
+    //! Holds the deferred readiness of the started plugin instance
+    std::shared_ptr<Readiness> m_readiness;
 };
 
 }
@@ -0,0 +1,404 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains an asynchronous logging backend for the framework's logging categories
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QVariant>
+#include <QtCore/QWaitCondition>
+
+// System includes
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+/*!
+ * Logs a message with deferred formatting
+ *
+ * \param   TYPE        Message type (for example QtWarningMsg)
+ * \param   CATEGORY    Logging category
+ * \param   ...         Format string (with %1, %2, ... placeholders) followed by the arguments
+ *
+ * Nothing is evaluated if the category is disabled for the message type. If the asynchronous
+ * logging backend is running only the arguments are captured in the calling thread, otherwise the
+ * message is formatted and logged immediately.
+ */
+#define CPPPLUGINFRAMEWORK_LOG(TYPE, CATEGORY, ...) \
+    do \
+    { \
+        if ((CATEGORY).isEnabled(TYPE)) \
+        { \
+            CppPluginFramework::AsyncLogBackend::instance().log(TYPE, CATEGORY, __VA_ARGS__); \
+        } \
+    } while (false)
+
+//! Logs a warning with deferred formatting (see CPPPLUGINFRAMEWORK_LOG)
+#define CPPPLUGINFRAMEWORK_WARNING(CATEGORY, ...) \
+    CPPPLUGINFRAMEWORK_LOG(QtWarningMsg, CATEGORY, __VA_ARGS__)
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class is an asynchronous logging backend for the framework's logging categories
+ *
+ * While the backend is running:
+ * - Messages logged with CPPPLUGINFRAMEWORK_LOG only capture their arguments in the calling thread
+ * - Messages logged with qCWarning() (and similar) in the framework's logging categories are
+ *   intercepted with a Qt message handler
+ *
+ * Messages are passed through a lock-free ring buffer of the calling thread to a background thread
+ * which formats them and writes them to the sink. Messages are rate limited per logging category.
+ * Messages that are over the rate limit or that do not fit into the ring buffer are dropped and
+ * counted.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT AsyncLogBackend
+{
+public:
+    //! Maximum number of arguments of a message
+    static constexpr int MaxArgumentCount = 4;
+
+    //! Sink that writes the formatted messages
+    using Sink = std::function<void(QtMsgType type,
+                                    const QString &category,
+                                    const QString &message)>;
+
+    //! Backend options
+    struct Options
+    {
+        /*!
+         * Capacity of the ring buffer of each thread (rounded up to a power of two)
+         *
+         * \note    Ring buffer of a thread is created when the thread logs its first message
+         */
+        int ringCapacity = 1024;
+
+        //! Maximum number of messages per logging category per second (0 means unlimited)
+        int rateLimit = 100;
+
+        //! Sink (if not set then the Qt message handler that was installed before is used)
+        Sink sink;
+    };
+
+    /*!
+     * Gets the process-wide logging backend
+     *
+     * \return  Logging backend
+     */
+    static AsyncLogBackend &instance();
+
+    //! Destructor
+    ~AsyncLogBackend();
+
+    //! Copy constructor is disabled
+    AsyncLogBackend(const AsyncLogBackend &) = delete;
+
+    //! Copy assignment operator is disabled
+    AsyncLogBackend &operator=(const AsyncLogBackend &) = delete;
+
+    /*!
+     * Starts the backend
+     *
+     * \param   options     Backend options
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (backend is already running)
+     */
+    bool start(const Options &options = Options());
+
+    //! Writes all queued messages and stops the backend
+    void stop();
+
+    /*!
+     * Checks if the backend is running
+     *
+     * \retval  true    Running
+     * \retval  false   Not running
+     */
+    bool isRunning() const;
+
+    //! Waits until all messages queued by the calling thread are written
+    void flush();
+
+    /*!
+     * Gets the number of messages that were dropped because a ring buffer was full
+     *
+     * \return  Number of dropped messages since the backend was started
+     */
+    quint64 droppedMessageCount() const;
+
+    /*!
+     * Gets the number of messages that were dropped because of the rate limit
+     *
+     * \return  Number of rate limited messages since the backend was started
+     */
+    quint64 rateLimitedMessageCount() const;
+
+    /*!
+     * Logs a message
+     *
+     * \param   type        Message type
+     * \param   category    Logging category (needs to outlive the backend)
+     * \param   format      Format string with %1, %2, ... placeholders (needs to be a literal)
+     * \param   arguments   Arguments (any type that can be converted to a string with QVariant)
+     *
+     * \note    Use CPPPLUGINFRAMEWORK_LOG macro to skip the disabled categories without any cost
+     */
+    template<typename... Args>
+    void log(QtMsgType type,
+             const QLoggingCategory &category,
+             const char *format,
+             const Args &... arguments)
+    {
+        static_assert(sizeof...(Args) <= MaxArgumentCount, "Too many arguments");
+
+        Arguments capturedArguments = { { QVariant(arguments)... } };
+        logMessage(type, category, format, std::move(capturedArguments), sizeof...(Args));
+    }
+
+private:
+    //! Captured arguments of a message
+    using Arguments = std::array<QVariant, MaxArgumentCount>;
+
+    //! Queued message
+    struct Entry
+    {
+        //! Message type
+        QtMsgType type = QtDebugMsg;
+
+        //! Logging category (nullptr for intercepted messages)
+        const QLoggingCategory *category = nullptr;
+
+        //! Name of the logging category of an intercepted message
+        QString categoryName;
+
+        //! Format string (nullptr for intercepted messages)
+        const char *format = nullptr;
+
+        //! Formatted message of an intercepted message
+        QString message;
+
+        //! Arguments
+        Arguments arguments;
+
+        //! Number of arguments
+        int argumentCount = 0;
+    };
+
+    //! Single producer, single consumer lock-free ring buffer
+    class Ring
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   capacity    Capacity (power of two)
+         */
+        explicit Ring(size_t capacity);
+
+        /*!
+         * Adds an entry to the ring buffer (called only by the owning thread)
+         *
+         * \param   entry   Entry
+         *
+         * \retval  true    Success
+         * \retval  false   Failure (ring buffer is full)
+         */
+        bool push(Entry &&entry);
+
+        /*!
+         * Takes an entry from the ring buffer (called only by the background thread)
+         *
+         * \param[out]  entry   Entry
+         *
+         * \retval  true    Success
+         * \retval  false   Failure (ring buffer is empty)
+         */
+        bool pop(Entry *entry);
+
+        //! Holds the "orphaned" flag (owning thread has finished)
+        std::atomic<bool> orphaned;
+
+    private:
+        //! Holds the entries
+        std::vector<Entry> m_entries;
+
+        //! Holds the mask for converting a position to an index
+        size_t m_mask;
+
+        //! Holds the write position
+        std::atomic<size_t> m_head;
+
+        //! Holds the read position
+        std::atomic<size_t> m_tail;
+    };
+
+    //! Per category rate limiter (fixed window of one second)
+    struct RateLimiter
+    {
+        //! Start of the current window in milliseconds
+        std::atomic<qint64> windowStart;
+
+        //! Number of messages in the current window
+        std::atomic<int> count;
+    };
+
+    //! Number of rate limiters (one for each framework category and one for all others)
+    static constexpr int RateLimiterCount = 4;
+
+    //! Constructor
+    AsyncLogBackend();
+
+    /*!
+     * Logs a message with captured arguments
+     *
+     * \param   type            Message type
+     * \param   category        Logging category
+     * \param   format          Format string
+     * \param   arguments       Captured arguments
+     * \param   argumentCount   Number of arguments
+     */
+    void logMessage(QtMsgType type,
+                    const QLoggingCategory &category,
+                    const char *format,
+                    Arguments &&arguments,
+                    int argumentCount);
+
+    /*!
+     * Queues the entry to the ring buffer of the calling thread
+     *
+     * \param   entry           Entry
+     * \param   categoryName    Name of the logging category
+     */
+    void enqueue(Entry &&entry, const char *categoryName);
+
+    /*!
+     * Checks the rate limit of the category
+     *
+     * \param   categoryName    Name of the logging category
+     *
+     * \retval  true    Message is allowed
+     * \retval  false   Message is over the rate limit
+     */
+    bool checkRateLimit(const char *categoryName);
+
+    /*!
+     * Gets the ring buffer of the calling thread
+     *
+     * \return  Ring buffer
+     */
+    Ring *threadRing();
+
+    //! Formats and writes all queued messages (called only by the background thread)
+    void drain();
+
+    /*!
+     * Writes the message to the sink
+     *
+     * \param   type        Message type
+     * \param   category    Name of the logging category
+     * \param   message     Formatted message
+     */
+    void write(QtMsgType type, const QString &category, const QString &message);
+
+    //! Background thread's loop
+    void run();
+
+    /*!
+     * Qt message handler that intercepts the messages of the framework's logging categories
+     *
+     * \param   type        Message type
+     * \param   context     Message context
+     * \param   message     Formatted message
+     */
+    static void messageHandler(QtMsgType type,
+                               const QMessageLogContext &context,
+                               const QString &message);
+
+private:
+    //! Holds the "running" flag
+    std::atomic<bool> m_running;
+
+    //! Holds the options (only read by the background thread)
+    Options m_options;
+
+    //! Holds the capacity of new ring buffers (read by the logging threads)
+    std::atomic<int> m_ringCapacity;
+
+    //! Holds the rate limit (read by the logging threads)
+    std::atomic<int> m_rateLimit;
+
+    //! Holds the Qt message handler that was installed before the backend was started
+    QtMessageHandler m_previousHandler;
+
+    //! Enables thread-safe access to the list of ring buffers
+    QMutex m_ringsMutex;
+
+    //! Holds the ring buffers of all threads
+    std::vector<std::shared_ptr<Ring>> m_rings;
+
+    //! Holds the rate limiters
+    std::array<RateLimiter, RateLimiterCount> m_rateLimiters;
+
+    //! Holds the number of messages dropped because a ring buffer was full
+    std::atomic<quint64> m_droppedMessageCount;
+
+    //! Holds the number of messages dropped because of the rate limit
+    std::atomic<quint64> m_rateLimitedMessageCount;
+
+    //! Holds the background thread
+    std::thread m_thread;
+
+    //! Enables synchronization with the background thread
+    QMutex m_threadMutex;
+
+    //! Wakes up the background thread
+    QWaitCondition m_wakeUpCondition;
+
+    //! Signals that a flush was completed
+    QWaitCondition m_flushedCondition;
+
+    //! Holds the "stop requested" flag
+    bool m_stopRequested;
+
+    //! Holds the number of requested flushes
+    quint64 m_flushRequestCount;
+
+    //! Holds the number of completed flushes
+    quint64 m_flushCompletedCount;
+};
+
+} // namespace CppPluginFramework
@@ -0,0 +1,180 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the handle of an asynchronous operation of the plugin manager
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// System includes
+#include <atomic>
+#include <functional>
+#include <future>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class is a handle of an asynchronous operation of the plugin manager
+ *
+ * The operation is executed on the plugin manager's executor thread. Its progress is reported to
+ * the progress observer (on the executor thread) each time a plugin instance is processed and its
+ * result is available through a future.
+ *
+ * Cancellation is cooperative: the operation checks for it between the plugin instances and a
+ * cancelled operation is rolled back to the state before the operation. An operation that is
+ * cancelled while it is still queued is not executed at all.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT AsyncOperation
+{
+public:
+    //! State of the operation
+    enum class State
+    {
+        //! Operation is waiting to be executed
+        Queued,
+
+        //! Operation is being executed
+        Running,
+
+        //! Operation succeeded
+        Succeeded,
+
+        //! Operation failed (and it was rolled back)
+        Failed,
+
+        //! Operation was cancelled (and it was rolled back)
+        Cancelled
+    };
+
+    //! Progress of the operation
+    struct Progress
+    {
+        //! Name of the processed plugin instance
+        QString instanceName;
+
+        //! Number of the processed plugin instances
+        int completedCount = 0;
+
+        //! Number of all plugin instances that the operation processes
+        int totalCount = 0;
+    };
+
+    /*!
+     * Observer of the progress
+     *
+     * \param   progress    Progress of the operation
+     */
+    using ProgressObserver = std::function<void(const Progress &progress)>;
+
+    /*!
+     * Constructor
+     *
+     * \param   progressObserver    Progress observer (optional)
+     */
+    explicit AsyncOperation(const ProgressObserver &progressObserver = ProgressObserver());
+
+    //! Destructor
+    ~AsyncOperation();
+
+    //! Copy constructor is disabled
+    AsyncOperation(const AsyncOperation &) = delete;
+
+    //! Copy assignment operator is disabled
+    AsyncOperation &operator=(const AsyncOperation &) = delete;
+
+    /*!
+     * Gets the state of the operation
+     *
+     * \return  State of the operation
+     */
+    State state() const;
+
+    /*!
+     * Gets the result of the operation
+     *
+     * \return  Future that resolves to true if the operation succeeded and false if it failed or
+     *          it was cancelled
+     */
+    std::shared_future<bool> future() const;
+
+    //! Requests the cancellation of the operation
+    void cancel();
+
+    /*!
+     * Checks if the cancellation of the operation was requested
+     *
+     * \retval  true    Cancellation was requested
+     * \retval  false   Cancellation was not requested
+     */
+    bool isCancellationRequested() const;
+
+    //! Marks the operation as running (called by the plugin manager)
+    void setRunning();
+
+    /*!
+     * Reports the progress to the progress observer (called by the plugin manager)
+     *
+     * \param   progress    Progress of the operation
+     */
+    void reportProgress(const Progress &progress) const;
+
+    /*!
+     * Finishes the operation (called by the plugin manager, only the first call has an effect)
+     *
+     * \param   success     Flag that indicates that the operation succeeded
+     *
+     * An operation that did not succeed after its cancellation was requested is cancelled.
+     */
+    void finish(bool success);
+
+private:
+    //! Enables thread-safe access to the state of the operation
+    mutable QMutex m_mutex;
+
+    //! Holds the state of the operation
+    State m_state;
+
+    //! Holds the flag that requests the cancellation
+    std::atomic<bool> m_cancellationRequested;
+
+    //! Holds the progress observer
+    ProgressObserver m_progressObserver;
+
+    //! Holds the promise of the result
+    std::promise<bool> m_promise;
+
+    //! Holds the future of the result
+    std::shared_future<bool> m_future;
+};
+
+} // namespace CppPluginFramework
@@ -0,0 +1,231 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the accounting of CPU time per plugin instance
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+// System includes
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class attributes CPU time to the plugin instances
+ *
+ * Threads are registered against the name of the plugin instance that owns them (an empty name
+ * stands for the framework itself). A registered thread is named after its owner so that it can be
+ * attributed in tools like perf and top, and the CPU time it consumes after its registration is
+ * attributed to its owner. Plugins need to register the threads they start themselves (see
+ * ThreadScope), the framework registers its own threads.
+ *
+ * The plugin manager also attributes the CPU time that its thread spends in starting and stopping
+ * each plugin instance.
+ *
+ * CPU time of the registered threads is read with their CPU-time clocks when a snapshot is taken.
+ * Optionally a background thread samples it periodically and publishes it to the metrics registry
+ * as the "cppplugin_plugin_cpu_nanoseconds" counter of each plugin instance.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT CpuAccounting
+{
+private:
+    // Forward declaration of the registered thread's data
+    struct ThreadRecord;
+
+public:
+    //! Registers the calling thread for the lifetime of this object
+    class CPPPLUGINFRAMEWORK_EXPORT ThreadScope
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   instanceName    Name of the plugin instance (empty for the framework)
+         * \param   threadName      Thread name (default: name of the plugin instance)
+         */
+        explicit ThreadScope(const QString &instanceName, const QString &threadName = QString());
+
+        //! Destructor (unregisters the thread)
+        ~ThreadScope();
+
+        //! Copy constructor is disabled
+        ThreadScope(const ThreadScope &) = delete;
+
+        //! Copy assignment operator is disabled
+        ThreadScope &operator=(const ThreadScope &) = delete;
+    };
+
+    //! CPU time of a plugin instance
+    struct CpuStats
+    {
+        //! Name of the plugin instance (empty for the framework)
+        QString instance;
+
+        //! Total CPU time in nanoseconds
+        qint64 cpuTime = 0;
+
+        //! Number of currently registered threads
+        int threadCount = 0;
+    };
+
+    /*!
+     * Gets the process-wide CPU accounting
+     *
+     * \return  CPU accounting
+     */
+    static CpuAccounting &instance();
+
+    //! Destructor
+    ~CpuAccounting();
+
+    //! Copy constructor is disabled
+    CpuAccounting(const CpuAccounting &) = delete;
+
+    //! Copy assignment operator is disabled
+    CpuAccounting &operator=(const CpuAccounting &) = delete;
+
+    /*!
+     * Registers the calling thread
+     *
+     * \param   instanceName    Name of the plugin instance (empty for the framework)
+     * \param   threadName      Thread name (default: name of the plugin instance, truncated to 15
+     *                          bytes on Linux)
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (CPU-time clock of the thread is not available)
+     *
+     * If the thread is already registered then the CPU time it consumed so far is attributed to
+     * its previous owner.
+     *
+     * \note    Thread needs to be unregistered before it finishes
+     */
+    bool registerThread(const QString &instanceName, const QString &threadName = QString());
+
+    //! Unregisters the calling thread (its CPU time stays attributed to its owner)
+    void unregisterThread();
+
+    /*!
+     * Attributes CPU time to the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     * \param   cpuTime         CPU time in nanoseconds
+     */
+    void addCpuTime(const QString &instanceName, qint64 cpuTime);
+
+    /*!
+     * Takes a snapshot of the CPU times
+     *
+     * \return  CPU times of all plugin instances (sorted by name of the plugin instance)
+     */
+    std::vector<CpuStats> snapshot() const;
+
+    /*!
+     * Starts the periodic sampling of the CPU times into the metrics registry
+     *
+     * \param   interval    Sampling interval in milliseconds
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (sampling is already running or the interval is not positive)
+     */
+    bool startSampling(int interval = 1000);
+
+    //! Stops the periodic sampling (the CPU times are sampled one last time)
+    void stopSampling();
+
+    /*!
+     * Checks if the periodic sampling is running
+     *
+     * \retval  true    Running
+     * \retval  false   Not running
+     */
+    bool isSampling() const;
+
+    /*!
+     * Gets the CPU time of the calling thread
+     *
+     * \return  CPU time in nanoseconds
+     */
+    static qint64 threadCpuTime();
+
+    /*!
+     * Gets the CPU time of the whole process
+     *
+     * \return  CPU time in nanoseconds
+     */
+    static qint64 processCpuTime();
+
+private:
+    //! Constructor
+    CpuAccounting();
+
+    //! Publishes the CPU times to the metrics registry
+    void publish();
+
+    //! Executes the sampling in the background thread
+    void run();
+
+private:
+    //! Enables thread-safe access to the registered threads and CPU times
+    mutable QMutex m_mutex;
+
+    //! Holds the registered threads keyed by their native handles
+    std::map<Qt::HANDLE, std::unique_ptr<ThreadRecord>> m_threads;
+
+    //! Holds the CPU times of the unregistered threads and the added CPU times
+    std::map<QString, qint64> m_retiredCpuTimes;
+
+    //! Holds the CPU times already published to the metrics registry (used by publish())
+    std::map<QString, qint64> m_publishedCpuTimes;
+
+    //! Holds the sampling thread
+    std::thread m_samplingThread;
+
+    //! Enables thread-safe access to the sampling thread's state
+    mutable QMutex m_samplingMutex;
+
+    //! Wakes up the sampling thread when the sampling needs to stop
+    QWaitCondition m_samplingCondition;
+
+    //! Holds the sampling interval in milliseconds
+    int m_samplingInterval;
+
+    //! Holds the flag that requests the sampling thread to stop
+    bool m_samplingStopRequested;
+};
+
+} // namespace CppPluginFramework
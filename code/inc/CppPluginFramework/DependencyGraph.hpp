@@ -0,0 +1,282 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds the dependency graph of the plugin instances
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+// System includes
+#include <map>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class holds the dependency graph of the plugin instances
+ *
+ * Plugin instances are represented by integer IDs (their index in the list of node names) and the
+ * edges (from a plugin instance to its dependencies) are stored in compressed sparse row format.
+ * The graph is immutable after construction and all of its operations run in linear time with
+ * regard to the number of nodes and edges.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT DependencyGraph
+{
+public:
+    //! Range of node IDs
+    class Range
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   first   Pointer to the first item
+         * \param   last    Pointer past the last item
+         */
+        Range(const int *first, const int *last);
+
+        //! Returns pointer to the first item
+        const int *begin() const;
+
+        //! Returns pointer past the last item
+        const int *end() const;
+
+        //! Returns number of items in the range
+        int size() const;
+
+        //! Checks if the range is empty
+        bool isEmpty() const;
+
+    private:
+        //! Pointer to the first item
+        const int *m_first;
+
+        //! Pointer past the last item
+        const int *m_last;
+    };
+
+    //! Constructor
+    DependencyGraph() = default;
+
+    /*!
+     * Constructor
+     *
+     * \param   nodeNames   Names of the nodes (node ID is the index in this list)
+     * \param   edges       Edges as pairs of node IDs (dependent node, dependency)
+     *
+     * \note    Edges that reference an invalid node ID are ignored
+     */
+    DependencyGraph(const QStringList &nodeNames, const std::vector<std::pair<int, int>> &edges);
+
+    /*!
+     * Creates a graph from the plugin instances and their dependencies
+     *
+     * \param       dependencies    Dependencies of each plugin instance
+     * \param[out]  graph           Created graph
+     * \param[out]  error           Optional output for the error string
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (a dependency does not reference a plugin instance)
+     */
+    static bool fromDependencies(const std::map<QString, QStringList> &dependencies,
+                                 DependencyGraph *graph,
+                                 QString *error = nullptr);
+
+    /*!
+     * Returns number of nodes
+     *
+     * \return  Number of nodes
+     */
+    int nodeCount() const;
+
+    /*!
+     * Returns number of edges
+     *
+     * \return  Number of edges
+     */
+    int edgeCount() const;
+
+    /*!
+     * Returns the ID of the node with the specified name
+     *
+     * \param   nodeName    Node name
+     *
+     * \return  Node ID or -1 if there is no node with that name
+     */
+    int nodeId(const QString &nodeName) const;
+
+    /*!
+     * Returns the name of the specified node
+     *
+     * \param   nodeId  Node ID
+     *
+     * \return  Node name or an empty string if node ID is not valid
+     */
+    QString nodeName(int nodeId) const;
+
+    /*!
+     * Returns the names of all nodes
+     *
+     * \return  Names of all nodes
+     */
+    QStringList nodeNames() const;
+
+    /*!
+     * Returns the dependencies of the specified node
+     *
+     * \param   nodeId  Node ID
+     *
+     * \return  IDs of the dependencies
+     */
+    Range dependencies(int nodeId) const;
+
+    /*!
+     * Returns the dependents of the specified node
+     *
+     * \param   nodeId  Node ID
+     *
+     * \return  IDs of the nodes that depend on the specified node
+     */
+    Range dependents(int nodeId) const;
+
+    /*!
+     * Finds all dependency cycles (Tarjan's strongly connected components algorithm)
+     *
+     * \return  Node IDs of each strongly connected component that contains a cycle
+     */
+    std::vector<std::vector<int>> cycles() const;
+
+    /*!
+     * Creates a human readable description of the dependency cycles
+     *
+     * \param   cycles  Dependency cycles
+     *
+     * \return  Description with the names of the nodes in each cycle
+     */
+    QString cyclesToString(const std::vector<std::vector<int>> &cycles) const;
+
+    /*!
+     * Splits the nodes into topological layers
+     *
+     * \param[out]  layers  Layers of node IDs
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (graph contains a cycle)
+     *
+     * The first layer holds the nodes without dependencies and each following layer holds the nodes
+     * whose dependencies are all in the previous layers. Nodes in the same layer do not depend on
+     * each other.
+     */
+    bool topologicalLayers(std::vector<std::vector<int>> *layers) const;
+
+    /*!
+     * Splits the nodes into reverse topological layers
+     *
+     * \param[out]  layers  Layers of node IDs
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (graph contains a cycle)
+     *
+     * The first layer holds the nodes without dependents and each following layer holds the nodes
+     * whose dependents are all in the previous layers.
+     */
+    bool reverseTopologicalLayers(std::vector<std::vector<int>> *layers) const;
+
+    /*!
+     * Creates the startup order
+     *
+     * \param       priorities  IDs of the nodes that need to be started first (in this order)
+     * \param[out]  order       Startup order
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (graph contains a cycle)
+     *
+     * The prioritized nodes are kept in front in the specified order, each one preceded by its
+     * (transitive) dependencies that are not ordered yet, then all the other nodes follow in
+     * topological order. The order is always a topological order.
+     */
+    bool startupOrder(const std::vector<int> &priorities, std::vector<int> *order) const;
+
+    /*!
+     * Creates the shutdown order
+     *
+     * \param       priorities  IDs of the nodes that need to be started first (in this order)
+     * \param[out]  order       Shutdown order
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (graph contains a cycle)
+     *
+     * Shutdown order is the reverse of the startup order so that each node is stopped before its
+     * dependencies.
+     */
+    bool shutdownOrder(const std::vector<int> &priorities, std::vector<int> *order) const;
+
+private:
+    /*!
+     * Splits the nodes into layers with Kahn's algorithm
+     *
+     * \param       offsets         Row offsets of the edges that block the nodes
+     * \param       reverseOffsets  Row offsets of the edges that release the nodes
+     * \param       reverseTargets  Targets of the edges that release the nodes
+     * \param[out]  layers          Layers of node IDs
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (graph contains a cycle)
+     *
+     * Nodes within a layer are ordered by the order in which they were released, which only
+     * depends on the graph itself.
+     */
+    bool computeLayers(const std::vector<int> &offsets,
+                       const std::vector<int> &reverseOffsets,
+                       const std::vector<int> &reverseTargets,
+                       std::vector<std::vector<int>> *layers) const;
+
+private:
+    //! Holds the node names
+    QStringList m_nodeNames;
+
+    //! Holds the node IDs keyed by their name
+    QHash<QString, int> m_nodeIds;
+
+    //! Holds the row offsets of the dependencies
+    std::vector<int> m_offsets;
+
+    //! Holds the dependencies of all nodes
+    std::vector<int> m_targets;
+
+    //! Holds the row offsets of the dependents
+    std::vector<int> m_reverseOffsets;
+
+    //! Holds the dependents of all nodes
+    std::vector<int> m_reverseTargets;
+};
+
+} // namespace CppPluginFramework
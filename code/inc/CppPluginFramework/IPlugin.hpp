@@ -21,6 +21,7 @@
 #pragma once
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/Readiness.hpp>
 #include <CppPluginFramework/VersionInfo.hpp>
 
 // C++ Config Framework includes
@@ -29,6 +30,7 @@
 // Qt includes
 
 // System includes
+#include <memory>
 
 // Forward declarations
 
@@ -107,6 +109,22 @@ public:
     //! Ejects all injected dependencies (interfaces)
     virtual void ejectDependencies() = 0;
 
+    /*!
+     * Prepares the plugin
+     *
+     * \retval  true    Plugin was prepared
+     * \retval  false   Plugin was not prepared
+     *
+     * This is called once after the dependencies were injected and before the plugin is started,
+     * for the work that does not need the dependencies to be started (for example parsing of the
+     * config files or building of lookup tables). Plugins are prepared concurrently, so this method
+     * must not call into the injected dependencies.
+     */
+    virtual bool prepare()
+    {
+        return true;
+    }
+
     /*!
      * Checks if plugin is started
      *
@@ -126,6 +144,19 @@ public:
     //! Stops the plugin
     virtual void stop() = 0;
 
+    /*!
+     * Gets the readiness of the started plugin
+     *
+     * \return  Readiness or a null pointer if the plugin is ready as soon as start() returns
+     *
+     * A plugin that returns a readiness from its start() needs to eventually settle it. Plugin
+     * instances that depend on it are started only after it is ready.
+     */
+    virtual std::shared_ptr<Readiness> readiness() const
+    {
+        return {};
+    }
+
     /*!
      * Convenience method for casting this plugin to the specified interface
      *
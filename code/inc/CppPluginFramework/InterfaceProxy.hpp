@@ -0,0 +1,511 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the instrumented proxies of the exported interfaces
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/IPlugin.hpp>
+
+// Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+
+// System includes
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class is a process-wide registry of the interface proxies and of their call stats
+ *
+ * A proxy is registered for an interface name. When instrumentation is enabled for a dependency
+ * the plugin manager injects a proxy of the dependency instead of the dependency itself. The proxy
+ * counts all calls of each method and measures the latency of every N-th call (1-in-N sampling)
+ * per method and per pair of the calling and the called plugin instance.
+ *
+ * Call sites are never removed from the registry, so the proxies can keep pointers to them.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT ProxyRegistry
+{
+public:
+    // Forward declaration of the call site's data (opaque)
+    struct CallSite;
+
+    /*!
+     * Factory of proxies
+     *
+     * \param   callerName  Name of the plugin instance that calls the proxy
+     * \param   target      Plugin instance that is called through the proxy
+     *
+     * \return  Proxy
+     */
+    using Factory = std::function<std::unique_ptr<IPlugin>(const QString &callerName,
+                                                           IPlugin *target)>;
+
+    //! Call stats of a method for a pair of plugin instances
+    struct CPPPLUGINFRAMEWORK_EXPORT CallStats
+    {
+        //! Name of the calling plugin instance
+        QString caller;
+
+        //! Name of the called plugin instance
+        QString callee;
+
+        //! Interface name
+        QString interface;
+
+        //! Method name
+        QString method;
+
+        //! Number of calls
+        quint64 callCount = 0U;
+
+        //! Number of calls with measured latency
+        quint64 sampledCount = 0U;
+
+        //! Total latency of the sampled calls in nanoseconds
+        qint64 sampledDuration = 0;
+
+        //! Maximum latency of the sampled calls in nanoseconds
+        qint64 maxDuration = 0;
+
+        /*!
+         * Estimates the mean latency of the calls
+         *
+         * \return  Mean latency of the sampled calls in nanoseconds
+         */
+        qint64 meanDuration() const;
+
+        /*!
+         * Estimates the total latency of all calls
+         *
+         * \return  Mean latency of the sampled calls multiplied by the number of calls
+         */
+        qint64 estimatedTotalDuration() const;
+    };
+
+    /*!
+     * Gets the process-wide proxy registry
+     *
+     * \return  Proxy registry
+     */
+    static ProxyRegistry &instance();
+
+    //! Destructor
+    ~ProxyRegistry();
+
+    //! Copy constructor is disabled
+    ProxyRegistry(const ProxyRegistry &) = delete;
+
+    //! Copy assignment operator is disabled
+    ProxyRegistry &operator=(const ProxyRegistry &) = delete;
+
+    /*!
+     * Registers a proxy factory
+     *
+     * \param   interface   Interface name
+     * \param   factory     Proxy factory
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (invalid interface name or factory)
+     *
+     * Previously registered factory of the interface is replaced.
+     */
+    bool registerProxyFactory(const QString &interface, const Factory &factory);
+
+    /*!
+     * Registers a proxy class
+     *
+     * \tparam  Proxy   Proxy class (needs a constructor with the caller name and the target)
+     *
+     * \param   interface   Interface name
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    template<typename Proxy>
+    bool registerProxy(const QString &interface)
+    {
+        return registerProxyFactory(interface,
+                                    [](const QString &callerName, IPlugin *target)
+                                    {
+                                        return std::unique_ptr<IPlugin>(new Proxy(callerName,
+                                                                                  target));
+                                    });
+    }
+
+    /*!
+     * Unregisters the proxy factory
+     *
+     * \param   interface   Interface name
+     */
+    void unregisterProxy(const QString &interface);
+
+    /*!
+     * Checks if a proxy is registered for the interface
+     *
+     * \param   interface   Interface name
+     *
+     * \retval  true    Registered
+     * \retval  false   Not registered
+     */
+    bool hasProxy(const QString &interface) const;
+
+    /*!
+     * Creates a proxy
+     *
+     * \param   interface   Interface name
+     * \param   callerName  Name of the plugin instance that calls the proxy
+     * \param   target      Plugin instance that is called through the proxy
+     *
+     * \return  Proxy or nullptr if no proxy is registered for the interface
+     */
+    std::unique_ptr<IPlugin> createProxy(const QString &interface,
+                                         const QString &callerName,
+                                         IPlugin *target) const;
+
+    /*!
+     * Sets the sampling rate
+     *
+     * \param   rate    Latency of every N-th call is measured (values below 1 are set to 1)
+     */
+    void setSamplingRate(int rate);
+
+    /*!
+     * Gets the sampling rate
+     *
+     * \return  Latency of every N-th call is measured
+     */
+    int samplingRate() const;
+
+    /*!
+     * Sets the latency injected into the calls of the plugin instance through the proxies
+     *
+     * \param   callee  Name of the called plugin instance
+     * \param   delay   Delay of each call in microseconds (zero disables the injection)
+     * \param   jitter  Maximum random delay added to the delay in microseconds
+     *
+     * The injected latency is included in the measured latency of the calls.
+     */
+    void setInjectedLatency(const QString &callee, int delay, int jitter = 0);
+
+    /*!
+     * Registers a call site or gets the already registered one
+     *
+     * \param   caller      Name of the calling plugin instance
+     * \param   callee      Name of the called plugin instance
+     * \param   interface   Interface name
+     * \param   method      Method name
+     *
+     * \return  Call site
+     */
+    CallSite *callSite(const QString &caller,
+                       const QString &callee,
+                       const QString &interface,
+                       const QString &method);
+
+    /*!
+     * Counts the call and decides if its latency is measured
+     *
+     * \param   callSite    Call site
+     *
+     * \return  Start timestamp in nanoseconds or -1 if the call is not sampled
+     */
+    static qint64 beginCall(CallSite *callSite);
+
+    /*!
+     * Records the latency of a sampled call
+     *
+     * \param   callSite    Call site
+     * \param   startTime   Start timestamp returned by beginCall()
+     */
+    static void endCall(CallSite *callSite, qint64 startTime);
+
+    /*!
+     * Takes a snapshot of the call stats
+     *
+     * \return  Call stats of all call sites (sorted by caller, callee, interface and method)
+     */
+    std::vector<CallStats> snapshot() const;
+
+    //! Resets the call stats of all call sites to zero
+    void reset();
+
+private:
+    //! Constructor
+    ProxyRegistry();
+
+private:
+    //! Enables thread-safe access to the registry
+    mutable QMutex m_mutex;
+
+    //! Holds the proxy factories keyed by interface name
+    QHash<QString, Factory> m_factories;
+
+    //! Holds the injected latencies (delay and jitter) keyed by name of the called plugin instance
+    QHash<QString, QPair<int, int>> m_injectedLatencies;
+
+    //! Holds the call sites keyed by caller, callee, interface and method
+    std::map<std::tuple<QString, QString, QString, QString>, std::unique_ptr<CallSite>> m_callSites;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! Measures the latency of a call (if it is sampled) for the lifetime of this object
+class CallSample
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param   callSite    Call site
+     */
+    explicit CallSample(ProxyRegistry::CallSite *callSite)
+        : m_callSite(callSite),
+          m_startTime(ProxyRegistry::beginCall(callSite))
+    {
+    }
+
+    //! Destructor
+    ~CallSample()
+    {
+        if (m_startTime >= 0)
+        {
+            ProxyRegistry::endCall(m_callSite, m_startTime);
+        }
+    }
+
+    //! Copy constructor is disabled
+    CallSample(const CallSample &) = delete;
+
+    //! Copy assignment operator is disabled
+    CallSample &operator=(const CallSample &) = delete;
+
+private:
+    //! Holds the call site
+    ProxyRegistry::CallSite *m_callSite;
+
+    //! Holds the start timestamp (-1 if the call is not sampled)
+    qint64 m_startTime;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * This is a base class for the proxies of plugin instances
+ *
+ * The proxy exports only the proxied interface. Lifecycle methods are not forwarded, because the
+ * proxy is only a view of the target which is managed by the plugin manager.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT ProxyPlugin : public IPlugin
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param   interface   Name of the proxied interface
+     * \param   callerName  Name of the plugin instance that calls the proxy
+     * \param   target      Plugin instance that is called through the proxy
+     */
+    ProxyPlugin(const QString &interface, const QString &callerName, IPlugin *target);
+
+    //! Destructor
+    ~ProxyPlugin() override = default;
+
+    //! \copydoc    IPlugin::name()
+    QString name() const override;
+
+    //! \copydoc    IPlugin::version()
+    VersionInfo version() const override;
+
+    //! \copydoc    IPlugin::description()
+    QString description() const override;
+
+    //! \copydoc    IPlugin::isInterfaceExported()
+    bool isInterfaceExported(const QString &interface) const override;
+
+    //! \copydoc    IPlugin::exportedInterfaces()
+    QSet<QString> exportedInterfaces() const override;
+
+    //! \copydoc    IPlugin::loadConfig() (always fails)
+    bool loadConfig(const CppConfigFramework::ConfigObjectNode &config) override;
+
+    //! \copydoc    IPlugin::injectDependency() (always fails)
+    bool injectDependency(IPlugin *plugin) override;
+
+    //! \copydoc    IPlugin::ejectDependencies() (does nothing)
+    void ejectDependencies() override;
+
+    //! \copydoc    IPlugin::prepare() (always fails)
+    bool prepare() override;
+
+    //! \copydoc    IPlugin::isStarted()
+    bool isStarted() const override;
+
+    //! \copydoc    IPlugin::start() (always fails)
+    bool start() override;
+
+    //! \copydoc    IPlugin::stop() (does nothing)
+    void stop() override;
+
+    //! \copydoc    IPlugin::readiness()
+    std::shared_ptr<Readiness> readiness() const override;
+
+    /*!
+     * Gets the name of the proxied interface
+     *
+     * \return  Interface name
+     */
+    QString proxiedInterface() const;
+
+    /*!
+     * Gets the name of the plugin instance that calls the proxy
+     *
+     * \return  Name of the plugin instance
+     */
+    QString callerName() const;
+
+    /*!
+     * Gets the plugin instance that is called through the proxy
+     *
+     * \return  Plugin instance
+     */
+    IPlugin *targetPlugin() const;
+
+private:
+    //! Holds the name of the proxied interface
+    QString m_interface;
+
+    //! Holds the name of the plugin instance that calls the proxy
+    QString m_callerName;
+
+    //! Holds the plugin instance that is called through the proxy
+    IPlugin *m_target;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * This is a template base class for the instrumented proxy of an interface
+ *
+ * \tparam  Interface   Proxied interface
+ *
+ * A proxy needs to implement each method of the interface by forwarding it through call():
+ *
+ * \code
+ * class ExampleProxy : public InterfaceProxy<IExample>
+ * {
+ * public:
+ *     ExampleProxy(const QString &callerName, IPlugin *target)
+ *         : InterfaceProxy("IExample", {"value", "setValue"}, callerName, target)
+ *     {
+ *     }
+ *
+ *     QString value() const override
+ *     {
+ *         return call(0, [this]() { return target()->value(); });
+ *     }
+ *
+ *     void setValue(const QString &value) override
+ *     {
+ *         call(1, [&]() { target()->setValue(value); });
+ *     }
+ * };
+ * \endcode
+ *
+ * And then it needs to be registered with ProxyRegistry::registerProxy<ExampleProxy>("IExample").
+ */
+template<typename Interface>
+class InterfaceProxy : public ProxyPlugin, public Interface
+{
+protected:
+    /*!
+     * Constructor
+     *
+     * \param   interface       Name of the proxied interface
+     * \param   methodNames     Names of the interface methods (indexed by the method index)
+     * \param   callerName      Name of the plugin instance that calls the proxy
+     * \param   target          Plugin instance that is called through the proxy
+     */
+    InterfaceProxy(const QString &interface,
+                   const QStringList &methodNames,
+                   const QString &callerName,
+                   IPlugin *target)
+        : ProxyPlugin(interface, callerName, target),
+          m_target(target->interface<Interface>())
+    {
+        auto &registry = ProxyRegistry::instance();
+        const QString calleeName = target->name();
+
+        for (const QString &methodName : methodNames)
+        {
+            m_callSites.push_back(registry.callSite(callerName, calleeName, interface, methodName));
+        }
+    }
+
+    /*!
+     * Gets the proxied interface of the target
+     *
+     * \return  Proxied interface
+     */
+    Interface *target() const
+    {
+        return m_target;
+    }
+
+    /*!
+     * Calls the method of the target and samples its latency
+     *
+     * \param   methodIndex     Index of the method (in the method names passed to the constructor)
+     * \param   function        Function that calls the method of the target
+     *
+     * \return  Return value of the function
+     */
+    template<typename Function>
+    auto call(const int methodIndex, Function function) const -> decltype(function())
+    {
+        CallSample sample(m_callSites.at(static_cast<size_t>(methodIndex)));
+        return function();
+    }
+
+private:
+    //! Holds the proxied interface of the target
+    Interface *m_target;
+
+    //! Holds the call sites of the methods
+    std::vector<ProxyRegistry::CallSite *> m_callSites;
+};
+
+} // namespace CppPluginFramework
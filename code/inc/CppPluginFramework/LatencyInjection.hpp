@@ -0,0 +1,120 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the latency injection into plugin instances for performance testing
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LatencyInjectionConfig.hpp>
+
+// Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class injects latency into the lifecycle operations of plugin instances
+ *
+ * It is a test facility for simulating slow plugins without changing them: the plugin manager
+ * delays loadConfig(), start() and stop() of the configured plugin instances. Calls of their
+ * interfaces are delayed by the interface proxies (see ProxyRegistry::setInjectedLatency()).
+ */
+class CPPPLUGINFRAMEWORK_EXPORT LatencyInjection
+{
+public:
+    //! Lifecycle operation of a plugin instance
+    enum class Operation
+    {
+        //! Loading of the plugin instance's config
+        LoadConfig,
+
+        //! Starting of the plugin instance
+        Start,
+
+        //! Stopping of the plugin instance
+        Stop
+    };
+
+    /*!
+     * Sets the latency injection configs
+     *
+     * \param   configs     Latency injection configs (one per plugin instance)
+     */
+    void setConfigs(const QList<LatencyInjectionConfig> &configs);
+
+    /*!
+     * Gets the latency injection configs
+     *
+     * \return  Latency injection configs
+     */
+    QList<LatencyInjectionConfig> configs() const;
+
+    //! Removes all latency injection configs
+    void clear();
+
+    /*!
+     * Checks if latency is injected into any plugin instance
+     *
+     * \retval  true    Latency is injected
+     * \retval  false   Latency is not injected
+     */
+    bool isEmpty() const;
+
+    /*!
+     * Checks if calls of the plugin instance's interface are delayed
+     *
+     * \param   instanceName    Name of the plugin instance
+     *
+     * \retval  true    Calls are delayed
+     * \retval  false   Calls are not delayed
+     */
+    bool delaysCalls(const QString &instanceName) const;
+
+    /*!
+     * Delays the lifecycle operation of the plugin instance (if configured)
+     *
+     * \param   instanceName    Name of the plugin instance
+     * \param   operation       Lifecycle operation
+     */
+    void inject(const QString &instanceName, Operation operation) const;
+
+    /*!
+     * Blocks the calling thread for the delay and a random jitter
+     *
+     * \param   delay   Delay in microseconds (nothing is done if it is not positive)
+     * \param   jitter  Maximum random delay added to the delay in microseconds
+     */
+    static void injectDelay(int delay, int jitter);
+
+private:
+    //! Holds the latency injection configs keyed by name of the plugin instance
+    QHash<QString, LatencyInjectionConfig> m_configs;
+};
+
+} // namespace CppPluginFramework
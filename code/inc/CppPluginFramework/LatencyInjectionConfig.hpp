@@ -0,0 +1,258 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a config class for the Latency Injection into a Plugin Instance
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigItem.hpp>
+
+// Qt includes
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * Config class for the Latency Injection into a Plugin Instance
+ *
+ * All delays and the jitter are in microseconds. A random delay between zero and the jitter is
+ * added to each non-zero delay.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT LatencyInjectionConfig : public CppConfigFramework::ConfigItem
+{
+public:
+    //! Constructor
+    LatencyInjectionConfig() = default;
+
+    /*!
+     * Constructor
+     *
+     * \param   instanceName        Name of the plugin instance
+     * \param   loadConfigDelay     Delay of loadConfig()
+     * \param   startDelay          Delay of start()
+     * \param   stopDelay           Delay of stop()
+     * \param   callDelay           Delay of the calls of the plugin instance's interface
+     * \param   jitter              Maximum random delay added to each delay
+     */
+    LatencyInjectionConfig(const QString &instanceName,
+                           int loadConfigDelay = 0,
+                           int startDelay = 0,
+                           int stopDelay = 0,
+                           int callDelay = 0,
+                           int jitter = 0);
+
+    /*!
+     * Copy constructor
+     *
+     * \param   other   Instance to copy
+     */
+    LatencyInjectionConfig(const LatencyInjectionConfig &other) = default;
+
+    /*!
+     * Move constructor
+     *
+     * \param   other   Instance to move
+     */
+    LatencyInjectionConfig(LatencyInjectionConfig &&other) noexcept = default;
+
+    //! Destructor
+    ~LatencyInjectionConfig() override = default;
+
+    /*!
+     * Copy assignment operator
+     *
+     * \param   other   Instance to copy assign
+     *
+     * \return  Reference to this instance after the assignment is made
+     */
+    LatencyInjectionConfig &operator=(const LatencyInjectionConfig &other) = default;
+
+    /*!
+     * Move assignment operator
+     *
+     * \param   other   Instance to move assign
+     *
+     * \return  Reference to this instance after the assignment is made
+     */
+    LatencyInjectionConfig &operator=(LatencyInjectionConfig &&other) noexcept = default;
+
+    /*!
+     * Checks if latency injection config is valid
+     *
+     * \retval  true    Latency injection config is valid
+     * \retval  false   Latency injection config is not valid
+     */
+    bool isValid() const;
+
+    /*!
+     * Returns name of the plugin instance
+     *
+     * \return  Name of the plugin instance
+     */
+    QString instanceName() const;
+
+    /*!
+     * Sets name of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     */
+    void setInstanceName(const QString &instanceName);
+
+    /*!
+     * Returns delay of loadConfig()
+     *
+     * \return  Delay in microseconds
+     */
+    int loadConfigDelay() const;
+
+    /*!
+     * Sets delay of loadConfig()
+     *
+     * \param   loadConfigDelay     Delay in microseconds
+     */
+    void setLoadConfigDelay(int loadConfigDelay);
+
+    /*!
+     * Returns delay of start()
+     *
+     * \return  Delay in microseconds
+     */
+    int startDelay() const;
+
+    /*!
+     * Sets delay of start()
+     *
+     * \param   startDelay  Delay in microseconds
+     */
+    void setStartDelay(int startDelay);
+
+    /*!
+     * Returns delay of stop()
+     *
+     * \return  Delay in microseconds
+     */
+    int stopDelay() const;
+
+    /*!
+     * Sets delay of stop()
+     *
+     * \param   stopDelay   Delay in microseconds
+     */
+    void setStopDelay(int stopDelay);
+
+    /*!
+     * Returns delay of the calls of the plugin instance's interface
+     *
+     * \return  Delay in microseconds
+     *
+     * \note    Only calls through an interface proxy can be delayed (see ProxyRegistry)
+     */
+    int callDelay() const;
+
+    /*!
+     * Sets delay of the calls of the plugin instance's interface
+     *
+     * \param   callDelay   Delay in microseconds
+     */
+    void setCallDelay(int callDelay);
+
+    /*!
+     * Returns maximum random delay added to each delay
+     *
+     * \return  Jitter in microseconds
+     */
+    int jitter() const;
+
+    /*!
+     * Sets maximum random delay added to each delay
+     *
+     * \param   jitter  Jitter in microseconds
+     */
+    void setJitter(int jitter);
+
+private:
+    //! \copydoc    CppConfigFramework::ConfigItem::loadConfigParameters()
+    bool loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config) override;
+
+    //! \copydoc    CppConfigFramework::ConfigItem::storeConfigParameters()
+    bool storeConfigParameters(CppConfigFramework::ConfigObjectNode *config) override;
+
+    //! \copydoc    CppConfigFramework::ConfigItem::validateConfig()
+    QString validateConfig() const override;
+
+private:
+    //! Holds the name of the plugin instance
+    QString m_instanceName;
+
+    //! Holds the delay of loadConfig() in microseconds
+    int m_loadConfigDelay = 0;
+
+    //! Holds the delay of start() in microseconds
+    int m_startDelay = 0;
+
+    //! Holds the delay of stop() in microseconds
+    int m_stopDelay = 0;
+
+    //! Holds the delay of the calls of the plugin instance's interface in microseconds
+    int m_callDelay = 0;
+
+    //! Holds the maximum random delay added to each delay in microseconds
+    int m_jitter = 0;
+};
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "equal to" operator for CppPluginFramework::LatencyInjectionConfig
+ *
+ * \param   left    Latency injection config
+ * \param   right   Latency injection config
+ *
+ * \retval  true    Latency injection configs are equal
+ * \retval  false   Latency injection configs are not equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator==(const CppPluginFramework::LatencyInjectionConfig &left,
+                                          const CppPluginFramework::LatencyInjectionConfig &right);
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "not equal to" operator for CppPluginFramework::LatencyInjectionConfig
+ *
+ * \param   left    Latency injection config
+ * \param   right   Latency injection config
+ *
+ * \retval  true    Latency injection configs are not equal
+ * \retval  false   Latency injection configs are equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator!=(const CppPluginFramework::LatencyInjectionConfig &left,
+                                          const CppPluginFramework::LatencyInjectionConfig &right);
@@ -0,0 +1,283 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds the timings of the plugin lifecycle phases
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+// System includes
+#include <array>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class holds the timings of the plugin lifecycle phases
+ *
+ * Durations are measured with a monotonic clock (in nanoseconds) and accumulated into histograms
+ * per phase and per plugin instance (or plugin library for the phases that are done per library),
+ * so that repeated load/start/stop/unload cycles can be compared.
+ *
+ * \note    This class is not thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT LifecycleTimings
+{
+public:
+    //! Lifecycle phase
+    enum class Phase
+    {
+        //! Validation of the plugin manager config
+        ConfigValidation,
+
+        //! Loading of a plugin library
+        LibraryLoad,
+
+        //! Creation of a plugin instance
+        CreateInstance,
+
+        //! Loading of a plugin instance's config
+        LoadConfig,
+
+        //! Check of a plugin instance's version
+        VersionCheck,
+
+        //! Injection of a dependency into a plugin instance
+        InjectDependency,
+
+        //! Preparation of a plugin instance (executed concurrently for all plugin instances)
+        Prepare,
+
+        //! Start of a plugin instance
+        Start,
+
+        //! Stop of a plugin instance
+        Stop,
+
+        //! Teardown (destruction) of a plugin instance
+        Teardown
+    };
+
+    //! Number of lifecycle phases
+    static constexpr int PhaseCount = 10;
+
+    //! Histogram of durations with logarithmic (power of two) buckets
+    class CPPPLUGINFRAMEWORK_EXPORT Histogram
+    {
+    public:
+        //! Number of buckets (bucket N holds the durations from 2^N to 2^(N+1) - 1 nanoseconds)
+        static constexpr int BucketCount = 64;
+
+        /*!
+         * Adds a duration to the histogram
+         *
+         * \param   duration    Duration in nanoseconds
+         */
+        void add(qint64 duration);
+
+        /*!
+         * Merges another histogram into this one
+         *
+         * \param   other   Histogram to merge
+         */
+        void merge(const Histogram &other);
+
+        //! Returns number of recorded durations
+        quint64 count() const;
+
+        //! Returns sum of all recorded durations
+        qint64 total() const;
+
+        //! Returns the shortest recorded duration
+        qint64 min() const;
+
+        //! Returns the longest recorded duration
+        qint64 max() const;
+
+        //! Returns the mean of the recorded durations
+        double mean() const;
+
+        /*!
+         * Estimates the percentile of the recorded durations
+         *
+         * \param   percentile  Percentile (from 0.0 to 100.0)
+         *
+         * \return  Upper bound of the bucket that holds the percentile (limited to the longest
+         *          recorded duration)
+         */
+        qint64 percentile(double percentile) const;
+
+        //! Returns the buckets
+        const std::array<quint64, BucketCount> &buckets() const;
+
+        /*!
+         * Converts the histogram to JSON
+         *
+         * \return  Histogram in JSON format (only the non-empty buckets are included)
+         */
+        QJsonObject toJson() const;
+
+    private:
+        //! Holds the buckets
+        std::array<quint64, BucketCount> m_buckets = {};
+
+        //! Holds the number of recorded durations
+        quint64 m_count = 0;
+
+        //! Holds the sum of all recorded durations
+        qint64 m_total = 0;
+
+        //! Holds the shortest recorded duration
+        qint64 m_min = 0;
+
+        //! Holds the longest recorded duration
+        qint64 m_max = 0;
+    };
+
+    /*!
+     * Measures the duration of its own lifetime and records it
+     *
+     * If trace recording is enabled the measurement is also recorded as a trace event.
+     */
+    class CPPPLUGINFRAMEWORK_EXPORT Scope
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   timings     Timings to record the duration to (nothing is recorded if nullptr)
+         * \param   phase       Lifecycle phase
+         * \param   name        Name of the plugin instance or library
+         */
+        Scope(LifecycleTimings *timings, Phase phase, const QString &name);
+
+        //! Destructor
+        ~Scope();
+
+        //! Copy constructor is disabled
+        Scope(const Scope &) = delete;
+
+        //! Copy assignment operator is disabled
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        //! Holds the timings
+        LifecycleTimings *m_timings;
+
+        //! Holds the lifecycle phase
+        Phase m_phase;
+
+        //! Holds the name
+        QString m_name;
+
+        //! Holds the timer
+        QElapsedTimer m_timer;
+
+        //! Holds the trace timestamp of the start of the measurement (-1 if not traced)
+        qint64 m_traceTimestamp;
+    };
+
+    /*!
+     * Records a duration
+     *
+     * \param   phase       Lifecycle phase
+     * \param   name        Name of the plugin instance or library (empty for global phases)
+     * \param   duration    Duration in nanoseconds
+     */
+    void record(Phase phase, const QString &name, qint64 duration);
+
+    /*!
+     * Returns the histogram of all durations recorded for the phase
+     *
+     * \param   phase   Lifecycle phase
+     *
+     * \return  Histogram
+     */
+    Histogram histogram(Phase phase) const;
+
+    /*!
+     * Returns the histogram of the durations recorded for the phase and name
+     *
+     * \param   phase   Lifecycle phase
+     * \param   name    Name of the plugin instance or library
+     *
+     * \return  Histogram
+     */
+    Histogram histogram(Phase phase, const QString &name) const;
+
+    /*!
+     * Returns the names for which durations were recorded for the phase
+     *
+     * \param   phase   Lifecycle phase
+     *
+     * \return  Names (sorted)
+     */
+    QStringList names(Phase phase) const;
+
+    //! Clears all recorded durations
+    void clear();
+
+    /*!
+     * Converts the timings to JSON
+     *
+     * \return  Timings in JSON format
+     */
+    QJsonObject toJson() const;
+
+    /*!
+     * Writes the timings in JSON format to a file
+     *
+     * \param   filePath    Path to the file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool writeJson(const QString &filePath) const;
+
+    /*!
+     * Converts the phase to a string
+     *
+     * \param   phase   Lifecycle phase
+     *
+     * \return  Name of the phase
+     */
+    static QString phaseToString(Phase phase);
+
+private:
+    //! Holds the histograms of each phase
+    std::array<Histogram, PhaseCount> m_phaseHistograms;
+
+    //! Holds the histograms of each phase keyed by name
+    std::array<QHash<QString, Histogram>, PhaseCount> m_namedHistograms;
+};
+
+} // namespace CppPluginFramework
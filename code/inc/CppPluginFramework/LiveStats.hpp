@@ -0,0 +1,336 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the live stats of the plugin instances published in a shared-memory segment
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LifecycleTimings.hpp>
+#include <CppPluginFramework/MetricsRegistry.hpp>
+
+// Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+// System includes
+#include <array>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class publishes the live stats of the plugin instances to a named POSIX shared-memory
+ * segment
+ *
+ * The segment has a fixed layout with a table of plugin instances and a table of metrics. Each
+ * record is protected with its own sequence lock, so the readers (for example "cppplugin-top") can
+ * attach to the segment read-only and never block the publisher. The segment is created and sized
+ * only once, updating the records does not execute any system calls.
+ *
+ * Names longer than NameSize - 1 bytes (UTF-8 encoded) are truncated.
+ *
+ * \note    This class is not thread-safe (there can only be a single publisher of a segment)
+ */
+class CPPPLUGINFRAMEWORK_EXPORT LiveStats
+{
+public:
+    //! State of a plugin instance
+    enum class InstanceState
+    {
+        //! Plugin instance is loaded
+        Loaded,
+
+        //! Plugin instance is being started
+        Starting,
+
+        //! Plugin instance is started
+        Started,
+
+        //! Plugin instance failed to start
+        Failed,
+
+        //! Plugin instance is being stopped
+        Stopping,
+
+        //! Plugin instance is stopped
+        Stopped
+    };
+
+    //! Size of the name fields in the segment (including the terminating null character)
+    static constexpr int NameSize = 64;
+
+    //! Default capacity of the plugin instance table
+    static constexpr int DefaultInstanceCapacity = 256;
+
+    //! Default capacity of the metric table
+    static constexpr int DefaultMetricCapacity = 1024;
+
+    //! Stats of a plugin instance
+    struct InstanceStats
+    {
+        //! Name of the plugin instance
+        QString name;
+
+        //! State of the plugin instance
+        InstanceState state = InstanceState::Loaded;
+
+        //! Time when the plugin instance was started (milliseconds since epoch, 0 if not started)
+        qint64 startTime = 0;
+
+        //! Total durations of the lifecycle phases in nanoseconds
+        std::array<qint64, LifecycleTimings::PhaseCount> phaseDurations = {};
+
+        //! Number of executions of the lifecycle phases
+        std::array<quint64, LifecycleTimings::PhaseCount> phaseCounts = {};
+    };
+
+    //! Stats of a metric
+    struct MetricStats
+    {
+        //! Metric name
+        QString name;
+
+        //! Name of the plugin instance
+        QString instance;
+
+        //! Metric type
+        MetricsRegistry::Type type = MetricsRegistry::Type::Counter;
+
+        //! Value of a counter or a gauge
+        qint64 value = 0;
+
+        //! Number of values recorded in a histogram
+        quint64 count = 0U;
+
+        //! Sum of the values recorded in a histogram
+        quint64 sum = 0U;
+
+        //! Median of the values recorded in a histogram
+        quint64 p50 = 0U;
+
+        //! 99th percentile of the values recorded in a histogram
+        quint64 p99 = 0U;
+    };
+
+    //! Contents of the segment
+    struct Snapshot
+    {
+        //! ID of the publishing process
+        qint64 processId = 0;
+
+        //! Time of the last update (milliseconds since epoch)
+        qint64 updateTime = 0;
+
+        //! Stats of the plugin instances
+        std::vector<InstanceStats> instances;
+
+        //! Stats of the metrics
+        std::vector<MetricStats> metrics;
+    };
+
+    //! Constructor
+    LiveStats();
+
+    //! Destructor (removes the segment)
+    ~LiveStats();
+
+    //! Copy constructor is disabled
+    LiveStats(const LiveStats &) = delete;
+
+    //! Copy assignment operator is disabled
+    LiveStats &operator=(const LiveStats &) = delete;
+
+    /*!
+     * Gets the default segment name of the process
+     *
+     * \param   processId   Process ID
+     *
+     * \return  Segment name ("/cppplugin-<pid>")
+     */
+    static QString defaultSegmentName(qint64 processId);
+
+    /*!
+     * Creates the segment
+     *
+     * \param   segmentName         Name of the segment (a leading slash is added if missing)
+     * \param   instanceCapacity    Capacity of the plugin instance table
+     * \param   metricCapacity      Capacity of the metric table
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool create(const QString &segmentName,
+                int instanceCapacity = DefaultInstanceCapacity,
+                int metricCapacity = DefaultMetricCapacity);
+
+    //! Unmaps and removes the segment
+    void destroy();
+
+    /*!
+     * Checks if the segment is created
+     *
+     * \retval  true    Created
+     * \retval  false   Not created
+     */
+    bool isCreated() const;
+
+    /*!
+     * Gets the name of the segment
+     *
+     * \return  Segment name (empty if the segment is not created)
+     */
+    QString segmentName() const;
+
+    /*!
+     * Replaces the table of the plugin instances (all are in the "loaded" state)
+     *
+     * \param   instanceNames   Names of the plugin instances
+     */
+    void setInstances(const QStringList &instanceNames);
+
+    /*!
+     * Sets the state of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     * \param   state           New state
+     *
+     * The start time is set when the state changes to "started" and cleared when it changes to
+     * "stopped".
+     */
+    void setInstanceState(const QString &instanceName, InstanceState state);
+
+    /*!
+     * Sets the lifecycle phase timings of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     * \param   timings         Lifecycle timings
+     */
+    void setInstanceTimings(const QString &instanceName, const LifecycleTimings &timings);
+
+    /*!
+     * Replaces the table of the metrics
+     *
+     * \param   snapshots   Metric snapshots (metrics over the capacity are skipped)
+     */
+    void setMetrics(const std::vector<MetricsRegistry::MetricSnapshot> &snapshots);
+
+    /*!
+     * Converts the state to a string
+     *
+     * \param   state   State
+     *
+     * \return  Name of the state
+     */
+    static QString stateToString(InstanceState state);
+
+private:
+    //! Updates the header of the segment
+    void updateHeader();
+
+private:
+    //! Holds the name of the segment
+    QString m_segmentName;
+
+    //! Holds the mapped segment (nullptr if the segment is not created)
+    void *m_segment;
+
+    //! Holds the size of the segment
+    size_t m_segmentSize;
+
+    //! Holds the number of used records in the plugin instance table
+    int m_instanceCount;
+
+    //! Holds the number of used records in the metric table
+    int m_metricCount;
+
+    //! Holds the indexes of the plugin instance records
+    QHash<QString, int> m_instanceIndexes;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * This class reads the live stats from a shared-memory segment published by LiveStats
+ *
+ * The segment is mapped read-only, so the reader cannot interfere with the publishing process.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT LiveStatsReader
+{
+public:
+    //! Constructor
+    LiveStatsReader();
+
+    //! Destructor
+    ~LiveStatsReader();
+
+    //! Copy constructor is disabled
+    LiveStatsReader(const LiveStatsReader &) = delete;
+
+    //! Copy assignment operator is disabled
+    LiveStatsReader &operator=(const LiveStatsReader &) = delete;
+
+    /*!
+     * Attaches to the segment
+     *
+     * \param   segmentName     Name of the segment (a leading slash is added if missing)
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (segment does not exist or it has an unsupported layout)
+     */
+    bool attach(const QString &segmentName);
+
+    //! Detaches from the segment
+    void detach();
+
+    /*!
+     * Checks if the reader is attached to a segment
+     *
+     * \retval  true    Attached
+     * \retval  false   Not attached
+     */
+    bool isAttached() const;
+
+    /*!
+     * Reads the contents of the segment
+     *
+     * \param[out]  snapshot    Contents of the segment
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (not attached or the publisher kept updating the segment)
+     *
+     * Records that are updated while they are read are read again.
+     */
+    bool read(LiveStats::Snapshot *snapshot) const;
+
+private:
+    //! Holds the mapped segment (nullptr if not attached)
+    const void *m_segment;
+
+    //! Holds the size of the segment
+    size_t m_segmentSize;
+};
+
+} // namespace CppPluginFramework
@@ -0,0 +1,238 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the accounting of memory per plugin instance and per plugin library
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+// System includes
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class attributes memory to the plugin instances and to the plugin libraries
+ *
+ * Each thread has a "current plugin instance" tag. The plugin manager sets it while a plugin
+ * instance is created, configured, started and stopped. Plugins that start their own threads
+ * need to propagate it: take the currentTag() in the starting thread and open a Scope with it in
+ * the new thread.
+ *
+ * If the library is built with the CMake option "CppPluginFramework_MemoryAccounting" the global
+ * operator new and operator delete are replaced. Each allocation made with operator new is then
+ * attributed to the plugin instance that was tagged when the memory was allocated, even if it is
+ * freed in another thread or under another tag. Allocations made directly with malloc() are not
+ * counted, which includes the data of the Qt containers (for example QString, QByteArray, QVector
+ * and QHash), so the allocation stats are a lower bound of the heap usage of a plugin instance.
+ * The replacement only works if the library is linked to the executable (and not loaded at
+ * runtime).
+ *
+ * Mapped and resident sizes of the loaded libraries are read from "/proc/self/smaps" (Linux only).
+ *
+ * Accounts are never removed, so the tags stay valid for the lifetime of the process.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT MemoryAccounting
+{
+public:
+    // Forward declaration of the account's data (opaque)
+    struct Account;
+
+    // Forward declaration of the tag scope
+    class Scope;
+
+    //! Tag of a plugin instance
+    class CPPPLUGINFRAMEWORK_EXPORT Tag
+    {
+    public:
+        //! Constructor (creates an invalid tag which means no plugin instance)
+        Tag();
+
+        /*!
+         * Checks if the tag is valid
+         *
+         * \retval  true    Valid
+         * \retval  false   Invalid
+         */
+        bool isValid() const;
+
+        /*!
+         * Gets the name of the plugin instance
+         *
+         * \return  Name of the plugin instance (empty if the tag is not valid)
+         */
+        QString instanceName() const;
+
+    private:
+        friend class MemoryAccounting;
+        friend class Scope;
+
+        /*!
+         * Constructor
+         *
+         * \param   account     Account
+         */
+        explicit Tag(Account *account);
+
+    private:
+        //! Holds the account
+        Account *m_account;
+    };
+
+    //! Sets the current tag of the thread for the lifetime of this object
+    class CPPPLUGINFRAMEWORK_EXPORT Scope
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   instanceName    Name of the plugin instance
+         */
+        explicit Scope(const QString &instanceName);
+
+        /*!
+         * Constructor
+         *
+         * \param   tag     Tag (for example the current tag of the thread that started this one)
+         */
+        explicit Scope(const Tag &tag);
+
+        //! Destructor (restores the previous tag)
+        ~Scope();
+
+        //! Copy constructor is disabled
+        Scope(const Scope &) = delete;
+
+        //! Copy assignment operator is disabled
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        //! Holds the previous tag of the thread
+        Account *m_previousAccount;
+    };
+
+    //! Heap allocation stats of a plugin instance
+    struct CPPPLUGINFRAMEWORK_EXPORT AllocationStats
+    {
+        //! Name of the plugin instance
+        QString instance;
+
+        //! Total number of allocated bytes
+        quint64 allocatedBytes = 0U;
+
+        //! Total number of freed bytes
+        quint64 freedBytes = 0U;
+
+        //! Number of allocations
+        quint64 allocationCount = 0U;
+
+        //! Number of deallocations
+        quint64 freeCount = 0U;
+
+        /*!
+         * Gets the number of bytes that are still allocated
+         *
+         * \return  Allocated bytes minus freed bytes
+         */
+        qint64 liveBytes() const;
+    };
+
+    //! Memory mapped from a file
+    struct MappingStats
+    {
+        //! Path to the mapped file
+        QString filePath;
+
+        //! Size of all mappings of the file in bytes
+        quint64 mappedBytes = 0U;
+
+        //! Resident size of all mappings of the file in bytes
+        quint64 residentBytes = 0U;
+    };
+
+    /*!
+     * Gets the tag of a plugin instance (registers its account if needed)
+     *
+     * \param   instanceName    Name of the plugin instance
+     *
+     * \return  Tag (invalid if the name is empty)
+     */
+    static Tag tag(const QString &instanceName);
+
+    /*!
+     * Gets the current tag of the calling thread
+     *
+     * \return  Current tag (invalid if no plugin instance is tagged)
+     */
+    static Tag currentTag();
+
+    /*!
+     * Checks if heap allocations are recorded
+     *
+     * \retval  true    Global operator new and operator delete are replaced (allocations made with
+     *                  malloc() are not recorded)
+     * \retval  false   Only the tags are maintained, allocation stats stay at zero
+     */
+    static bool isAllocatorInterposed();
+
+    /*!
+     * Gets the heap allocation stats of all plugin instances
+     *
+     * \return  Allocation stats (sorted by name of the plugin instance)
+     */
+    static std::vector<AllocationStats> allocationStats();
+
+    /*!
+     * Gets the mapped and resident sizes of all files mapped into the process
+     *
+     * \return  Mapping stats (sorted by file path, empty if "/proc/self/smaps" cannot be read)
+     */
+    static std::vector<MappingStats> fileMappings();
+
+    /*!
+     * Parses the contents of a "smaps" file
+     *
+     * \param   contents    Contents of the file
+     *
+     * \return  Mapping stats of the mapped files (sorted by file path)
+     *
+     * Anonymous mappings and pseudo paths (for example "[heap]") are skipped.
+     */
+    static std::vector<MappingStats> parseSmaps(const QByteArray &contents);
+
+private:
+    //! Construction of this class is disabled
+    MemoryAccounting() = delete;
+};
+
+} // namespace CppPluginFramework
@@ -0,0 +1,392 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a registry of metrics (counters, gauges and histograms)
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// System includes
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class is a process-wide registry of metrics
+ *
+ * Each metric is identified by its name and the name of the plugin instance it belongs to (empty
+ * for the metrics of the framework itself). Metric names need to match the OpenMetrics naming
+ * rules ("[a-zA-Z_:][a-zA-Z0-9_:]*").
+ *
+ * Counters and histograms are split into per-thread shards that are updated with relaxed atomic
+ * operations, so recording a value never takes a lock. Shards are merged only when a snapshot is
+ * taken. Gauges are a single atomic value because they can also be set.
+ *
+ * Metrics are never removed from the registry, so the handles stay valid for the lifetime of the
+ * process.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT MetricsRegistry
+{
+private:
+    // Forward declaration of the metric's data
+    struct Metric;
+
+public:
+    //! Metric type
+    enum class Type
+    {
+        //! Monotonically increasing value
+        Counter,
+
+        //! Value that can go up and down
+        Gauge,
+
+        //! Distribution of values
+        Histogram
+    };
+
+    //! Number of shards of each counter and histogram
+    static constexpr int ShardCount = 8;
+
+    //! Number of bits of the histogram's sub-buckets (each power of two is split into 8 buckets)
+    static constexpr int SubBucketBits = 3;
+
+    //! Number of histogram buckets (relative error of a bucket's upper bound is at most 12.5 %)
+    static constexpr int BucketCount = (64 - SubBucketBits + 1) << SubBucketBits;
+
+    //! Handle of a counter
+    class CPPPLUGINFRAMEWORK_EXPORT Counter
+    {
+    public:
+        //! Constructor (creates an invalid handle which does nothing)
+        Counter();
+
+        /*!
+         * Checks if the handle is valid
+         *
+         * \retval  true    Valid
+         * \retval  false   Invalid
+         */
+        bool isValid() const;
+
+        /*!
+         * Increments the counter
+         *
+         * \param   value   Value to add
+         */
+        void increment(quint64 value = 1U) const;
+
+    private:
+        friend class MetricsRegistry;
+
+        /*!
+         * Constructor
+         *
+         * \param   metric  Metric
+         */
+        explicit Counter(Metric *metric);
+
+    private:
+        //! Holds the metric
+        Metric *m_metric;
+    };
+
+    //! Handle of a gauge
+    class CPPPLUGINFRAMEWORK_EXPORT Gauge
+    {
+    public:
+        //! Constructor (creates an invalid handle which does nothing)
+        Gauge();
+
+        /*!
+         * Checks if the handle is valid
+         *
+         * \retval  true    Valid
+         * \retval  false   Invalid
+         */
+        bool isValid() const;
+
+        /*!
+         * Sets the gauge
+         *
+         * \param   value   New value
+         */
+        void set(qint64 value) const;
+
+        /*!
+         * Adds to the gauge
+         *
+         * \param   value   Value to add (negative to subtract)
+         */
+        void add(qint64 value) const;
+
+    private:
+        friend class MetricsRegistry;
+
+        /*!
+         * Constructor
+         *
+         * \param   metric  Metric
+         */
+        explicit Gauge(Metric *metric);
+
+    private:
+        //! Holds the metric
+        Metric *m_metric;
+    };
+
+    //! Handle of a histogram
+    class CPPPLUGINFRAMEWORK_EXPORT Histogram
+    {
+    public:
+        //! Constructor (creates an invalid handle which does nothing)
+        Histogram();
+
+        /*!
+         * Checks if the handle is valid
+         *
+         * \retval  true    Valid
+         * \retval  false   Invalid
+         */
+        bool isValid() const;
+
+        /*!
+         * Records a value
+         *
+         * \param   value   Value
+         */
+        void record(quint64 value) const;
+
+        /*!
+         * Records the time elapsed since the timer was started
+         *
+         * \param   timer   Started timer
+         */
+        void recordElapsed(const QElapsedTimer &timer) const;
+
+    private:
+        friend class MetricsRegistry;
+
+        /*!
+         * Constructor
+         *
+         * \param   metric  Metric
+         */
+        explicit Histogram(Metric *metric);
+
+    private:
+        //! Holds the metric
+        Metric *m_metric;
+    };
+
+    //! Snapshot of a metric (shards of all threads are merged)
+    struct CPPPLUGINFRAMEWORK_EXPORT MetricSnapshot
+    {
+        //! Metric type
+        Type type = Type::Counter;
+
+        //! Metric name
+        QString name;
+
+        //! Help text
+        QString help;
+
+        //! Name of the plugin instance (empty for the metrics of the framework)
+        QString instance;
+
+        //! Value of a counter or a gauge
+        qint64 value = 0;
+
+        //! Number of values recorded in a histogram
+        quint64 count = 0U;
+
+        //! Sum of the values recorded in a histogram
+        quint64 sum = 0U;
+
+        //! Non-empty buckets of a histogram as pairs of inclusive upper bound and count (ascending)
+        std::vector<std::pair<quint64, quint64>> buckets;
+
+        /*!
+         * Estimates the percentile of the values recorded in a histogram
+         *
+         * \param   percentile  Percentile (from 0.0 to 100.0)
+         *
+         * \return  Upper bound of the bucket that holds the percentile (0 if there are no values)
+         */
+        quint64 percentile(double percentile) const;
+    };
+
+    /*!
+     * Gets the process-wide metrics registry
+     *
+     * \return  Metrics registry
+     */
+    static MetricsRegistry &instance();
+
+    //! Destructor
+    ~MetricsRegistry();
+
+    //! Copy constructor is disabled
+    MetricsRegistry(const MetricsRegistry &) = delete;
+
+    //! Copy assignment operator is disabled
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    /*!
+     * Registers a counter or gets the already registered one
+     *
+     * \param   name        Metric name (optional "_total" suffix is removed)
+     * \param   instance    Name of the plugin instance (empty for the metrics of the framework)
+     * \param   help        Help text (only used when the metric is registered)
+     *
+     * \return  Counter handle (invalid if the name is not valid or is used by another metric type)
+     */
+    Counter counter(const QString &name,
+                    const QString &instance = QString(),
+                    const QString &help = QString());
+
+    /*!
+     * Registers a gauge or gets the already registered one
+     *
+     * \param   name        Metric name
+     * \param   instance    Name of the plugin instance (empty for the metrics of the framework)
+     * \param   help        Help text (only used when the metric is registered)
+     *
+     * \return  Gauge handle (invalid if the name is not valid or is used by another metric type)
+     */
+    Gauge gauge(const QString &name,
+                const QString &instance = QString(),
+                const QString &help = QString());
+
+    /*!
+     * Registers a histogram or gets the already registered one
+     *
+     * \param   name        Metric name (should contain the unit, for example "_nanoseconds")
+     * \param   instance    Name of the plugin instance (empty for the metrics of the framework)
+     * \param   help        Help text (only used when the metric is registered)
+     *
+     * \return  Histogram handle (invalid if the name is not valid or used by another metric type)
+     */
+    Histogram histogram(const QString &name,
+                        const QString &instance = QString(),
+                        const QString &help = QString());
+
+    /*!
+     * Takes a snapshot of all metrics
+     *
+     * \return  Metric snapshots (sorted by name and instance)
+     */
+    std::vector<MetricSnapshot> snapshot() const;
+
+    //! Resets the values of all metrics to zero (registered handles stay valid)
+    void reset();
+
+    /*!
+     * Converts the metric snapshots to the OpenMetrics text format
+     *
+     * \param   snapshots   Metric snapshots (sorted by name)
+     *
+     * \return  Metrics in OpenMetrics text format
+     *
+     * The plugin instance is rendered as the "instance" label. Only the non-empty buckets of the
+     * histograms are rendered (together with the "+Inf" bucket).
+     */
+    static QByteArray toOpenMetrics(const std::vector<MetricSnapshot> &snapshots);
+
+    /*!
+     * Writes the metric snapshots in OpenMetrics text format to a file
+     *
+     * \param   snapshots   Metric snapshots (sorted by name)
+     * \param   filePath    Path to the file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    static bool writeOpenMetrics(const std::vector<MetricSnapshot> &snapshots,
+                                 const QString &filePath);
+
+    /*!
+     * Sends the metric snapshots in OpenMetrics text format to a local (Unix domain) socket
+     *
+     * \param   snapshots   Metric snapshots (sorted by name)
+     * \param   socketPath  Path to the socket of a listening collector
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     *
+     * The connection is closed after the whole document is written.
+     */
+    static bool sendOpenMetrics(const std::vector<MetricSnapshot> &snapshots,
+                                const QString &socketPath);
+
+    /*!
+     * Gets the inclusive upper bound of a histogram bucket
+     *
+     * \param   index   Bucket index
+     *
+     * \return  Upper bound
+     */
+    static quint64 bucketUpperBound(int index);
+
+private:
+    //! Constructor
+    MetricsRegistry();
+
+    /*!
+     * Registers a metric or gets the already registered one
+     *
+     * \param   type        Metric type
+     * \param   name        Metric name
+     * \param   instance    Name of the plugin instance
+     * \param   help        Help text
+     *
+     * \return  Metric or nullptr in case of failure
+     */
+    Metric *registerMetric(Type type,
+                           const QString &name,
+                           const QString &instance,
+                           const QString &help);
+
+private:
+    //! Enables thread-safe access to the metrics
+    mutable QMutex m_mutex;
+
+    //! Holds the metrics keyed by name and instance
+    std::map<std::pair<QString, QString>, std::unique_ptr<Metric>> m_metrics;
+};
+
+} // namespace CppPluginFramework
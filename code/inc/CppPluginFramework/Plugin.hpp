@@ -22,6 +22,9 @@
 
 // C++ Plugin Framework includes
 #include <CppPluginFramework/IPluginFactory.hpp>
+#include <CppPluginFramework/LatencyInjection.hpp>
+#include <CppPluginFramework/LifecycleTimings.hpp>
+#include <CppPluginFramework/PluginCatalog.hpp>
 #include <CppPluginFramework/PluginConfig.hpp>
 
 // Qt includes
@@ -29,6 +32,7 @@
 // System includes
 
 // Forward declarations
+class QPluginLoader;
 
 // Macros
 
@@ -45,35 +49,91 @@ public:
      * Loads plugin instances from the specified library
      *
      * \param   pluginConfig    Plugin config
+     * \param   pluginCatalog   Optional plugin catalog (needed only if the plugin config references
+     *                          the plugin by interface instead of by file path)
+     * \param   timings         Optional lifecycle timings to record the durations of the loading
+     *                          phases to
+     * \param   latencyInjection    Optional latency injection into the loading of the configs
+     * \param   pluginLoader        Optional plugin loader to load the library with
      *
      * \return  Loaded plugin instances or an empty vector if loading failed
+     *
+     * Qt keeps a library loaded until each plugin loader that loaded it unloads it. Libraries are
+     * therefore only released if they are loaded with a plugin loader provided by the caller, which
+     * can unload it after all of the plugin instances from the library are destroyed.
+     */
+    static std::vector<std::unique_ptr<IPlugin>> loadInstances(
+            const PluginConfig &pluginConfig,
+            const PluginCatalog *pluginCatalog = nullptr,
+            LifecycleTimings *timings = nullptr,
+            const LatencyInjection *latencyInjection = nullptr,
+            QPluginLoader *pluginLoader = nullptr);
+
+    /*!
+     * Resolves the file path to the plugin's library
+     *
+     * \param   pluginConfig    Plugin config
+     * \param   pluginCatalog   Optional plugin catalog (needed only if the plugin config references
+     *                          the plugin by interface instead of by file path)
+     *
+     * \return  File path to the plugin's library or an empty string if it could not be resolved
+     *
+     * If the plugin config references the plugin by interface then the plugin library with the
+     * highest version that exports the interface and matches the version requirement is selected.
      */
-    static std::vector<std::unique_ptr<IPlugin>> loadInstances(const PluginConfig &pluginConfig);
+    static QString resolveFilePath(const PluginConfig &pluginConfig,
+                                   const PluginCatalog *pluginCatalog);
 
 private:
     //! Construction of this class is disabled
     Plugin() = delete;
 
+    /*!
+     * Loads plugin instances from the library at the resolved file path
+     *
+     * \param   filePath            File path to the plugin's library
+     * \param   pluginConfig        Plugin config
+     * \param   timings             Optional lifecycle timings
+     * \param   latencyInjection    Optional latency injection
+     * \param   pluginLoader        Plugin loader to load the library with
+     *
+     * \return  Loaded plugin instances or an empty vector if loading failed
+     */
+    static std::vector<std::unique_ptr<IPlugin>> loadLibraryInstances(
+            const QString &filePath,
+            const PluginConfig &pluginConfig,
+            LifecycleTimings *timings,
+            const LatencyInjection *latencyInjection,
+            QPluginLoader *pluginLoader);
+
     /*!
      * Loads the plugin instance from the specified library and configures it
      *
-     * \param   instanceConfig  Plugin instance config
+     * \param   pluginFactory       Plugin factory
+     * \param   instanceConfig      Plugin instance config
+     * \param   filePath            File path to the plugin's library
+     * \param   timings             Optional lifecycle timings
+     * \param   latencyInjection    Optional latency injection
      *
      * \return  Loaded plugin instance or nullptr if loading failed
      */
     static std::unique_ptr<IPlugin> loadInstance(const IPluginFactory &pluginFactory,
-                                                 const PluginInstanceConfig &instanceConfig);
+                                                 const PluginInstanceConfig &instanceConfig,
+                                                 const QString &filePath,
+                                                 LifecycleTimings *timings,
+                                                 const LatencyInjection *latencyInjection);
 
     /*!
      * Checks if the version matches the plugin config's version requirements
      *
-     * \param   pluginVersion   Plugin version
-     * \param   pluginConfig    Plugin config
+     * \param   pluginVersion       Plugin version
+     * \param   versionRequirement  Plugin config's compiled version requirement
      *
      * \retval  true    Success
      * \retval  false   Failure
      */
-    static bool checkVersion(const VersionInfo &pluginVersion, const PluginConfig &pluginConfig);
+    static bool checkVersion(const VersionInfo &pluginVersion,
+                             const VersionRange &versionRequirement);
 };
 
 } // namespace CppPluginFramework
@@ -0,0 +1,197 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds an index of the available plugin libraries
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/VersionRange.hpp>
+
+// Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+// System includes
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class holds an index of the plugin libraries found in the plugin directories
+ *
+ * The metadata of each plugin library is read without loading the library. For this the plugin
+ * factory needs to embed the plugin metadata with the FILE parameter of the Q_PLUGIN_METADATA
+ * macro:
+ *
+ * \code{.json}
+ *
+ *     {
+ *         "version": "1.0.0",
+ *         "description": "Example plugin",
+ *         "exported_interfaces": [ "IExample" ]
+ *     }
+ *
+ * \endcode
+ *
+ * The index can be stored to a cache file. Entries in the cache are keyed by the library's file
+ * path, modification time and size, so that a rescan only needs to read the metadata of the
+ * libraries that were added or changed since the last scan.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT PluginCatalog
+{
+public:
+    //! Holds information about a file in the plugin directories
+    struct Entry
+    {
+        //! Canonical path to the file
+        QString filePath;
+
+        //! Modification time of the file (milliseconds since epoch)
+        qint64 lastModified = 0;
+
+        //! Size of the file
+        qint64 size = 0;
+
+        //! Flag that indicates that the file is a valid plugin library
+        bool isPlugin = false;
+
+        //! Plugin's version
+        VersionInfo version;
+
+        //! Plugin's description
+        QString description;
+
+        //! Plugin's exported interfaces
+        QStringList exportedInterfaces;
+
+        //! Class name of the plugin factory
+        QString factoryClassName;
+    };
+
+    /*!
+     * Loads the index from the cache file
+     *
+     * \param   cacheFilePath   Path to the cache file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     *
+     * \note    Cached entries are only reused if the file's modification time and size still match
+     */
+    bool loadCache(const QString &cacheFilePath);
+
+    /*!
+     * Stores the index to the cache file
+     *
+     * \param   cacheFilePath   Path to the cache file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool storeCache(const QString &cacheFilePath) const;
+
+    /*!
+     * Scans the plugin directories and updates the index
+     *
+     * \param   directories         Plugin directories
+     * \param[out]  metadataReads   Optional output for the number of files whose metadata had to be
+     *                              read (files that were not found in the index or were changed)
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     *
+     * \note    Only libraries (QLibrary::isLibrary() or the custom "plugin" suffix) are indexed and
+     *          symbolic links to a library share the entry of the library's canonical path
+     */
+    bool scan(const QStringList &directories, int *metadataReads = nullptr);
+
+    /*!
+     * Finds the plugin library with the highest version that exports the specified interface and
+     * matches the version range
+     *
+     * \param   interface       Name of the exported interface
+     * \param   versionRange    Version range
+     *
+     * \return  Catalog entry or nullptr if no plugin library matches
+     */
+    const Entry *findBestMatch(const QString &interface, const VersionRange &versionRange) const;
+
+    /*!
+     * Finds the entry for the specified file
+     *
+     * \param   filePath    Path to the file
+     *
+     * \return  Catalog entry or nullptr if the file is not in the index
+     */
+    const Entry *entry(const QString &filePath) const;
+
+    /*!
+     * Returns all plugin libraries in the index
+     *
+     * \return  Plugin libraries in the index
+     */
+    std::vector<Entry> plugins() const;
+
+    /*!
+     * Reads the metadata of the specified plugin library without loading it
+     *
+     * \param       filePath    Path to the plugin library
+     * \param[out]  entry       Catalog entry
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (file is not a valid plugin library)
+     */
+    static bool readMetadata(const QString &filePath, Entry *entry);
+
+private:
+    //! Holds a plugin library in the interface index
+    struct IndexItem
+    {
+        //! Packed plugin version
+        quint64 key;
+
+        //! Development version string
+        QString dev;
+
+        //! Index of the entry
+        int entryIndex;
+    };
+
+    //! Rebuilds the interface index
+    void rebuildIndex();
+
+private:
+    //! Holds all the entries
+    std::vector<Entry> m_entries;
+
+    //! Holds the entry indexes keyed by their file path
+    QHash<QString, int> m_entryIndexes;
+
+    //! Holds the plugin libraries sorted by version for each exported interface
+    QHash<QString, std::vector<IndexItem>> m_interfaceIndex;
+};
+
+} // namespace CppPluginFramework
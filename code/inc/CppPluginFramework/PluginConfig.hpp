@@ -23,6 +23,7 @@
 // C++ Plugin Framework includes
 #include <CppPluginFramework/PluginInstanceConfig.hpp>
 #include <CppPluginFramework/VersionInfo.hpp>
+#include <CppPluginFramework/VersionRange.hpp>
 
 // Qt includes
 
@@ -68,6 +69,17 @@ public:
                  const VersionInfo &maxVersion,
                  const QList<PluginInstanceConfig> &instanceConfigs);
 
+    /*!
+     * Constructor
+     *
+     * \param   filePath        Path to the plugin's library
+     * \param   versionRange    Required plugin version range expression
+     * \param   instanceConfigs List of plugin's instance configs
+     */
+    PluginConfig(const QString &filePath,
+                 const VersionRange &versionRange,
+                 const QList<PluginInstanceConfig> &instanceConfigs);
+
     /*!
      * Copy constructor
      *
@@ -127,6 +139,14 @@ public:
      */
     bool isVersionRange() const;
 
+    /*!
+     * Checks if a version range expression is used
+     *
+     * \retval  true    A version range expression is used
+     * \retval  false   A specific version or a min/max version range is used
+     */
+    bool isVersionRangeExpression() const;
+
     /*!
      * Returns file path to the plugin's library
      *
@@ -141,6 +161,29 @@ public:
      */
     void setFilePath(const QString &filePath);
 
+    /*!
+     * Returns the interface by which the plugin's library is looked up in the plugin catalog
+     *
+     * \return  Name of the interface exported by the plugin or an empty string if the file path to
+     *          the plugin's library is used instead
+     */
+    QString interface() const;
+
+    /*!
+     * Sets the interface by which the plugin's library is looked up in the plugin catalog
+     *
+     * \param   interface   Name of the interface exported by the plugin
+     */
+    void setInterface(const QString &interface);
+
+    /*!
+     * Returns the name by which the plugin is referenced in messages
+     *
+     * \return  File path to the plugin's library or the interface with the plugin's version
+     *          requirement if the plugin's library is looked up in the plugin catalog
+     */
+    QString displayName() const;
+
     /*!
      * Returns plugin's required version
      *
@@ -183,6 +226,28 @@ public:
      */
     void setMaxVersion(const VersionInfo &maxVersion);
 
+    /*!
+     * Returns plugin's required version range expression
+     *
+     * \return  Plugin's required version range expression
+     */
+    VersionRange versionRange() const;
+
+    /*!
+     * Sets plugin's required version range expression
+     *
+     * \param   versionRange    Plugin's required version range expression
+     */
+    void setVersionRange(const VersionRange &versionRange);
+
+    /*!
+     * Returns the plugin's version requirement compiled to a version range
+     *
+     * \return  Plugin's version requirement (exact version, min/max version range or version range
+     *          expression)
+     */
+    VersionRange versionRequirement() const;
+
     /*!
      * Returns list of plugin's instance configs
      *
@@ -211,6 +276,9 @@ private:
     //! Holds the path to the plugin's library
     QString m_filePath;
 
+    //! Holds the interface by which the plugin's library is looked up in the plugin catalog
+    QString m_interface;
+
     //! Holds the plugin's required version
     VersionInfo m_version;
 
@@ -220,6 +288,9 @@ private:
     //! Holds the plugin's maximum required version
     VersionInfo m_maxVersion;
 
+    //! Holds the plugin's required version range expression
+    VersionRange m_versionRange;
+
     //! Holds the list of plugin's instance configs
     QList<PluginInstanceConfig> m_instanceConfigs;
 };
@@ -27,6 +27,7 @@
 #include <CppConfigFramework/ConfigItem.hpp>
 
 // Qt includes
+#include <QtCore/QMap>
 
 // System includes
 
@@ -43,19 +44,44 @@ namespace CppPluginFramework
 class CPPPLUGINFRAMEWORK_EXPORT PluginInstanceConfig : public CppConfigFramework::ConfigItem
 {
 public:
+    //! Cardinality of a required interface
+    enum class Cardinality
+    {
+        //! Exactly one plugin instance must export the interface
+        One,
+
+        //! All plugin instances that export the interface (at least one)
+        All,
+
+        //! At most one plugin instance may export the interface
+        Optional
+    };
+
+    //! Activation of the plugin instance
+    enum class Activation
+    {
+        //! Plugin instance is created when the plugins are loaded
+        Eager,
+
+        //! Plugin instance is created when it is looked up for the first time
+        Lazy
+    };
+
     //! Constructor
     PluginInstanceConfig() = default;
 
     /*!
      * Constructor
      *
-     * \param   name            Name of the plugin instance
-     * \param   config          Plugin instance's config
-     * \param   dependencies    List of plugin's dependencies
+     * \param   name                Name of the plugin instance
+     * \param   config              Plugin instance's config
+     * \param   dependencies        List of plugin's dependencies
+     * \param   requiredInterfaces  Interfaces required by the plugin instance
      */
     PluginInstanceConfig(const QString &name,
                          const CppConfigFramework::ConfigObjectNode &config = {},
-                         const QSet<QString> &dependencies = {});
+                         const QSet<QString> &dependencies = {},
+                         const QMap<QString, Cardinality> &requiredInterfaces = {});
 
     /*!
      * Copy constructor
@@ -142,6 +168,58 @@ public:
      */
     void setDependencies(const QSet<QString> &dependencies);
 
+    /*!
+     * Returns the interfaces required by the plugin instance
+     *
+     * \return  Required interfaces and their cardinality
+     *
+     * The plugin manager injects the plugin instances that export the required interfaces in
+     * addition to the explicitly listed dependencies (auto-wiring).
+     */
+    QMap<QString, Cardinality> requiredInterfaces() const;
+
+    /*!
+     * Sets the interfaces required by the plugin instance
+     *
+     * \param   requiredInterfaces  Required interfaces and their cardinality
+     */
+    void setRequiredInterfaces(const QMap<QString, Cardinality> &requiredInterfaces);
+
+    /*!
+     * Returns the activation of the plugin instance
+     *
+     * \return  Activation of the plugin instance
+     *
+     * The plugin manager defers the creation, dependency injection and start of a lazy plugin
+     * instance until it is looked up for the first time.
+     */
+    Activation activation() const;
+
+    /*!
+     * Sets the activation of the plugin instance
+     *
+     * \param   activation  Activation of the plugin instance
+     */
+    void setActivation(Activation activation);
+
+    /*!
+     * Returns the idle timeout of the plugin instance
+     *
+     * \return  Idle timeout in milliseconds (0 if the plugin instance is never evicted)
+     *
+     * The plugin manager can evict a lazy plugin instance that was not looked up for longer than
+     * its idle timeout (see PluginManager::evictIdleInstances()).
+     */
+    int idleTimeout() const;
+
+    /*!
+     * Sets the idle timeout of the plugin instance
+     *
+     * \param   idleTimeout     Idle timeout in milliseconds (0 if the plugin instance is never
+     *                          evicted)
+     */
+    void setIdleTimeout(int idleTimeout);
+
 private:
     //! \copydoc    CppConfigFramework::ConfigItem::loadConfigParameters()
     bool loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config) override;
@@ -161,6 +239,15 @@ private:
 
     //! Holds the list of plugin instance's dependencies
     QSet<QString> m_dependencies;
+
+    //! Holds the interfaces required by the plugin instance
+    QMap<QString, Cardinality> m_requiredInterfaces;
+
+    //! Holds the activation of the plugin instance
+    Activation m_activation = Activation::Eager;
+
+    //! Holds the idle timeout of the plugin instance in milliseconds
+    int m_idleTimeout = 0;
 };
 
 } // namespace CppPluginFramework
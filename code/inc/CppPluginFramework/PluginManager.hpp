@@ -21,14 +21,32 @@
 #pragma once
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncOperation.hpp>
+#include <CppPluginFramework/CpuAccounting.hpp>
+#include <CppPluginFramework/DependencyGraph.hpp>
 #include <CppPluginFramework/IPlugin.hpp>
+#include <CppPluginFramework/InterfaceProxy.hpp>
+#include <CppPluginFramework/LatencyInjection.hpp>
+#include <CppPluginFramework/LifecycleTimings.hpp>
+#include <CppPluginFramework/LiveStats.hpp>
+#include <CppPluginFramework/MemoryAccounting.hpp>
+#include <CppPluginFramework/MetricsRegistry.hpp>
+#include <CppPluginFramework/PluginCatalog.hpp>
 #include <CppPluginFramework/PluginManagerConfig.hpp>
+#include <CppPluginFramework/StartupAnalysis.hpp>
 
 // Qt includes
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
 
 // System includes
+#include <functional>
+#include <future>
 
 // Forward declarations
+class QThreadPool;
 
 // Macros
 
@@ -37,9 +55,40 @@
 namespace CppPluginFramework
 {
 
-//! This class manages plugins
+/*!
+ * This class manages plugins
+ *
+ * Lazy plugin instances (see PluginInstanceConfig::Activation) are only registered when the
+ * plugins are loaded. Interfaces that they export are read from the plugin's metadata so that they
+ * take part in the dependency resolution. A lazy plugin instance is activated (created, configured,
+ * its dependencies injected and started if the plugin manager is started) by the first lookup with
+ * pluginInstance(). Its lazy dependencies are activated before it and a lazy plugin instance that
+ * an eager plugin instance depends on is activated already when the plugins are loaded.
+ *
+ * A lazy plugin instance with an idle timeout can be evicted again (see evictIdleInstances()) and
+ * it is activated again by its next lookup.
+ *
+ * The asynchronous variants of load(), start(), stop() and unload() are executed one after another
+ * on a thread owned by the plugin manager, so that the calling thread (for example the one with
+ * the main event loop) stays responsive. They report their progress and they can be cancelled (see
+ * AsyncOperation).
+ *
+ * \note    Lookups of the plugin instances are thread-safe, but they must not be made concurrently
+ *          with the other methods. The other methods must not be called while an asynchronous
+ *          operation is queued or running.
+ */
 class CPPPLUGINFRAMEWORK_EXPORT PluginManager
 {
+private:
+    // Forward declaration of the lazy plugin instance's data
+    struct LazyInstance;
+
+    // Forward declaration of the aggregate readiness of the started plugin instances
+    struct ReadinessTracker;
+
+    // Forward declaration of the executor of the asynchronous operations
+    struct Executor;
+
 public:
     //! Destructor
     ~PluginManager();
@@ -48,14 +97,25 @@ public:
      * Loads all plugin instances specified in the config
      *
      * \param   pluginManagerConfig     Plugin manager configs
+     * \param   startupProfile          Name of the startup profile (empty: all plugin instances)
      *
      * \retval  true    Success
      * \retval  false   Failure
      *
      * After each plugin is loaded all of its instances get created and configured. When all the
-     * plugins are loaded the dependencies of each plugin instance are injected into it.
+     * plugins are loaded the dependencies of each plugin instance are injected into it. Creation of
+     * the lazy plugin instances is deferred until they are activated.
+     *
+     * Finally all plugin instances are prepared (see IPlugin::prepare()) concurrently on a pool of
+     * worker threads, so that start() only needs to execute the work that depends on the startup
+     * order. The lazy plugin instances are prepared when they are activated.
+     *
+     * With a startup profile (see StartupProfileConfig) only its root plugin instances and their
+     * transitive dependencies (explicit ones and the providers of the required interfaces) are
+     * loaded. Plugins without any of these plugin instances are not loaded at all.
      */
-    bool load(const PluginManagerConfig &pluginManagerConfig);
+    bool load(const PluginManagerConfig &pluginManagerConfig,
+              const QString &startupProfile = QString());
 
     /*!
      *  Unloads all loaded plugin instances
@@ -70,59 +130,548 @@ public:
      *
      * \retval  true    Success
      * \retval  false   Failure
+     *
+     * Lazy plugin instances that were not activated yet are started when they are activated.
+     *
+     * Each plugin instance is started only after all of its dependencies are ready (see
+     * IPlugin::readiness()). Plugin instances are started in the startup order, except that the
+     * ones with dependencies that are not ready yet are skipped until they are, so the warm-ups of
+     * independent plugin instances overlap. This method returns when all plugin instances are
+     * started, but some of them might still be warming up (see readyFuture()). Startup fails if the
+     * dependencies of a plugin instance do not become ready within the readiness timeout (see
+     * PluginManagerConfig::readinessTimeout()).
+     *
+     * \note    Readiness must not be settled on the thread that calls this method (for example by a
+     *          timer of its event loop), because this method blocks while it waits for it.
      */
     bool start();
 
     //! Stops all loaded plugin instances
     void stop();
 
+    /*!
+     * Loads all plugin instances specified in the config asynchronously (see load())
+     *
+     * \param   pluginManagerConfig     Plugin manager configs
+     * \param   startupProfile          Name of the startup profile (empty: all plugin instances)
+     * \param   progressObserver        Observer that is notified after each plugin instance is
+     *                                  loaded (optional)
+     *
+     * \return  Handle of the operation
+     *
+     * If loading fails or it is cancelled then all plugin instances that were already loaded are
+     * unloaded again.
+     */
+    std::shared_ptr<AsyncOperation> loadAsync(
+            const PluginManagerConfig &pluginManagerConfig,
+            const QString &startupProfile = QString(),
+            const AsyncOperation::ProgressObserver &progressObserver = {});
+
+    /*!
+     * Unloads all loaded plugin instances asynchronously (see unload())
+     *
+     * \param   progressObserver    Observer that is notified after each plugin instance is unloaded
+     *                              (optional)
+     *
+     * \return  Handle of the operation (it can only be cancelled while it is queued)
+     */
+    std::shared_ptr<AsyncOperation> unloadAsync(
+            const AsyncOperation::ProgressObserver &progressObserver = {});
+
+    /*!
+     * Starts all loaded plugin instances asynchronously (see start())
+     *
+     * \param   progressObserver    Observer that is notified after each plugin instance is started
+     *                              (optional)
+     *
+     * \return  Handle of the operation
+     *
+     * If startup fails or it is cancelled then all plugin instances that were already started are
+     * stopped again.
+     */
+    std::shared_ptr<AsyncOperation> startAsync(
+            const AsyncOperation::ProgressObserver &progressObserver = {});
+
+    /*!
+     * Stops all loaded plugin instances asynchronously (see stop())
+     *
+     * \param   progressObserver    Observer that is notified after each plugin instance is stopped
+     *                              (optional)
+     *
+     * \return  Handle of the operation (it can only be cancelled while it is queued)
+     */
+    std::shared_ptr<AsyncOperation> stopAsync(
+            const AsyncOperation::ProgressObserver &progressObserver = {});
+
+    /*!
+     * Gets the aggregate readiness of the plugin instances
+     *
+     * \return  Future that is resolved with true when all plugin instances started by the last
+     *          start() are ready, or with false when any of them failed to start or to become ready
+     *          or when the plugin manager was stopped (or not started) before that
+     */
+    std::shared_future<bool> readyFuture() const;
+
+    /*!
+     * Evicts the lazy plugin instances that were idle for longer than their idle timeout
+     *
+     * \return  Number of evicted plugin instances
+     *
+     * An evicted plugin instance is stopped, its dependencies are ejected and it is destroyed. Its
+     * library is unloaded when no other plugin instance uses it anymore. A plugin instance is idle
+     * if it was not looked up with pluginInstance() within its idle timeout, and it is pinned
+     * (never evicted) while any of the plugin instances that depend on it is activated. Dependents
+     * are evicted before their dependencies so that a whole idle dependency chain is evicted at
+     * once.
+     *
+     * \note    Pointers to the evicted plugin instances must not be used anymore, so the
+     *          application needs to call this method at a point where it holds no such pointers
+     *          (for example periodically from its event loop)
+     */
+    int evictIdleInstances();
+
     /*!
      * Checks if a plugin instance with the specified name was loaded
      *
      * \param   instanceName    Plugin instance name
      *
-     * \retval  true    Plugin was loaded
+     * \retval  true    Plugin was loaded (or registered if it is a lazy plugin instance)
      * \retval  false   Plugin was not loaded
      */
     bool hasPluginInstance(const QString &instanceName) const;
 
+    /*!
+     * Checks if the specified plugin instance was activated
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \retval  true    Plugin instance was activated (eager plugin instances are activated when
+     *                  they are loaded)
+     * \retval  false   Plugin instance was not activated or there is no plugin instance with that
+     *                  name
+     */
+    bool isPluginInstanceActivated(const QString &instanceName) const;
+
     /*!
      * Gets the specified plugin instance
      *
      * \param   instanceName    Plugin instance name
      *
-     * \return  Plugin instance or nullptr if there is no plugin instance with that name
+     * \return  Plugin instance or nullptr if there is no plugin instance with that name or if the
+     *          activation of the lazy plugin instance failed
+     *
+     * A lazy plugin instance is activated by the first lookup. Concurrent lookups wait for the
+     * activation to finish and the activation is never repeated, not even after a failure. If the
+     * plugin manager is started then the lookup first waits for the readiness of the dependencies,
+     * which does not block the lookups of the other plugin instances. The activation fails if a
+     * dependency does not become ready within the readiness timeout.
      */
     IPlugin *pluginInstance(const QString &instanceName);
 
     /*!
      * Gets names of all loaded plugin instances
      *
-     * \return  Names of all loaded plugin instances
+     * \return  Names of all loaded plugin instances (including the lazy plugin instances that were
+     *          not activated yet)
      */
     QStringList pluginInstanceNames() const;
 
+    /*!
+     * Gets names of all loaded plugin instances that export the specified interface
+     *
+     * \param   interface   Interface name
+     *
+     * \return  Names of the plugin instances (sorted)
+     */
+    QStringList interfaceProviders(const QString &interface) const;
+
+    /*!
+     * Gets the dependency graph of the loaded plugin instances
+     *
+     * \return  Dependency graph (explicit and auto-wired dependencies)
+     */
+    const DependencyGraph &dependencyGraph() const;
+
+    /*!
+     * Gets the order in which the plugin instances are started
+     *
+     * \return  Names of the plugin instances in startup order
+     */
+    QStringList pluginStartupOrder() const;
+
+    /*!
+     * Analyzes the critical path of the last startup
+     *
+     * \return  Startup analysis
+     *
+     * The start durations measured in the last call to start() are combined with the dependency
+     * graph. Plugin instances that were not started count with a zero duration.
+     */
+    StartupAnalysis startupAnalysis() const;
+
+    /*!
+     * Gets the lifecycle timings
+     *
+     * \return  Durations of the lifecycle phases accumulated over all load/start/stop/unload cycles
+     */
+    const LifecycleTimings &lifecycleTimings() const;
+
+    //! Clears the lifecycle timings
+    void clearLifecycleTimings();
+
+    /*!
+     * Takes a snapshot of the metrics
+     *
+     * \return  Metrics of the plugin managers and of the loaded plugin instances (sorted by name)
+     *
+     * The snapshot contains the lifecycle metrics recorded by the plugin managers and the metrics
+     * registered by the loaded plugin instances. It can be rendered in OpenMetrics text format with
+     * MetricsRegistry::toOpenMetrics(), MetricsRegistry::writeOpenMetrics() or
+     * MetricsRegistry::sendOpenMetrics().
+     */
+    std::vector<MetricsRegistry::MetricSnapshot> metricsSnapshot() const;
+
+    /*!
+     * Gets the heap allocation stats of the loaded plugin instances
+     *
+     * \return  Allocation stats (sorted by name of the plugin instance)
+     *
+     * Allocations are attributed to a plugin instance while it is created, configured, started and
+     * stopped, and in its own threads if it propagates its memory accounting tag. The stats stay at
+     * zero unless the library is built with allocator interposition (see MemoryAccounting).
+     */
+    std::vector<MemoryAccounting::AllocationStats> memoryAllocationStats() const;
+
+    /*!
+     * Gets the mapped and resident sizes of the libraries of the loaded plugin instances
+     *
+     * \return  Mapping stats (sorted by file path, empty if "/proc/self/smaps" cannot be read)
+     */
+    std::vector<MemoryAccounting::MappingStats> pluginLibraryMappings() const;
+
+    /*!
+     * Gets the CPU times of the loaded plugin instances
+     *
+     * \return  CPU times (sorted by name of the plugin instance)
+     *
+     * The CPU time of a plugin instance contains the time the plugin manager spent in starting and
+     * stopping it and the time consumed by the threads registered to it (see CpuAccounting).
+     */
+    std::vector<CpuAccounting::CpuStats> cpuStats() const;
+
+    /*!
+     * Gets the file path to the library of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     *
+     * \return  Canonical file path to the library (empty if the plugin instance is not loaded)
+     */
+    QString pluginLibraryPath(const QString &instanceName) const;
+
+    /*!
+     * Enables instrumentation of a dependency edge
+     *
+     * \param   instanceName    Name of the plugin instance that uses the dependency
+     * \param   dependencyName  Name of the dependency (empty for all dependencies of the instance)
+     *
+     * When the dependencies are injected in load() the plugin instance gets a proxy of an
+     * instrumented dependency instead of the dependency itself. The proxy is created from the
+     * ProxyRegistry for the interface that the dependency exports. If the dependency exports more
+     * than one interface or no proxy is registered for its interface then it is injected directly.
+     * Dependencies with call latency injected by the config are always instrumented.
+     *
+     * \note    Instrumentation needs to be enabled before load()
+     */
+    void instrumentDependency(const QString &instanceName,
+                              const QString &dependencyName = QString());
+
+    //! Disables instrumentation of all dependency edges
+    void clearInstrumentedDependencies();
+
+    /*!
+     * Gets the call stats of the instrumented dependency edges
+     *
+     * \return  Call stats of the calls made by the loaded plugin instances (sorted by caller,
+     *          callee, interface and method)
+     */
+    std::vector<ProxyRegistry::CallStats> callStats() const;
+
+    /*!
+     * Starts publishing the live stats to a shared-memory segment
+     *
+     * \param   segmentName     Name of the segment (default: "/cppplugin-<pid>")
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     *
+     * The states, start times and lifecycle timings of the plugin instances are updated on each
+     * lifecycle event. The metrics are updated on each lifecycle event and on each call to
+     * publishLiveStatsMetrics(). The segment can be viewed with the "cppplugin-top" tool.
+     */
+    bool publishLiveStats(const QString &segmentName = QString());
+
+    //! Stops publishing the live stats and removes the shared-memory segment
+    void unpublishLiveStats();
+
+    //! Updates the metrics in the published live stats (does nothing if they are not published)
+    void publishLiveStatsMetrics();
+
+    /*!
+     * Gets the plugin catalog
+     *
+     * \return  Plugin catalog
+     *
+     * The plugin catalog is updated in load() if the config defines any plugin directories.
+     */
+    const PluginCatalog &pluginCatalog() const;
+
 private:
     /*!
-     * Injects dependencies to all specified plugins
+     * Queues an asynchronous operation to the executor
+     *
+     * \param   progressObserver    Progress observer
+     * \param   precondition        Precondition of the operation (the operation fails without
+     *                              changing anything if it is not met)
+     * \param   operation           Operation
+     * \param   rollback            Rollback that is executed if the operation does not succeed
+     *
+     * \return  Handle of the operation
+     */
+    std::shared_ptr<AsyncOperation> post(const AsyncOperation::ProgressObserver &progressObserver,
+                                         const std::function<bool()> &precondition,
+                                         const std::function<bool()> &operation,
+                                         const std::function<void()> &rollback);
+
+    /*!
+     * Reports the progress of the running asynchronous operation (if any)
+     *
+     * \param   instanceName    Name of the processed plugin instance
+     * \param   completedCount  Number of the processed plugin instances
+     * \param   totalCount      Number of all plugin instances that the operation processes
+     */
+    void reportProgress(const QString &instanceName, int completedCount, int totalCount) const;
+
+    /*!
+     * Checks if the cancellation of the running asynchronous operation was requested
+     *
+     * \retval  true    Cancellation was requested
+     * \retval  false   Cancellation was not requested (or no asynchronous operation is running)
+     */
+    bool isCancellationRequested() const;
+
+    /*!
+     * Loads all plugin instances specified in the config (see load())
+     *
+     * \param   pluginManagerConfig     Plugin manager configs
+     * \param   startupProfile          Name of the startup profile (empty: all plugin instances)
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool loadPlugins(const PluginManagerConfig &pluginManagerConfig,
+                     const QString &startupProfile);
+
+    /*!
+     * Removes the plugin instances that are not reachable from the startup profile's roots
+     *
+     * \param   startupProfile      Startup profile
+     * \param   pluginConfigs       Plugin configs that get pruned
+     * \param   startupPriorities   Startup priorities that get pruned
+     *
+     * Interfaces exported by the plugins are read from their metadata without loading them.
+     */
+    void pruneToStartupProfile(const StartupProfileConfig &startupProfile,
+                               QList<PluginConfig> *pluginConfigs,
+                               QStringList *startupPriorities) const;
+
+    /*!
+     * Updates the plugin catalog
+     *
+     * \param   pluginManagerConfig     Plugin manager configs
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool updatePluginCatalog(const PluginManagerConfig &pluginManagerConfig);
+
+    /*!
+     * Registers the lazy plugin instances of the plugin without loading them
+     *
+     * \param   pluginConfig    Plugin config with only the configs of the lazy plugin instances
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool registerLazyInstances(const PluginConfig &pluginConfig);
+
+    /*!
+     * Gets the specified plugin instance without activating it
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \return  Plugin instance or nullptr if there is no plugin instance with that name or if it
+     *          was not activated yet
+     */
+    IPlugin *activatedPluginInstance(const QString &instanceName) const;
+
+    /*!
+     * Activates the lazy plugin instance and its lazy dependencies
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \return  Plugin instance or nullptr in case of failure
+     *
+     * If the plugin manager is started then the dependencies need to be ready already. In case of
+     * a failure the partially activated plugin instance is released again.
+     *
+     * \note    Caller needs to hold the activation mutex
+     */
+    IPlugin *activateLazyInstance(const QString &instanceName);
+
+    /*!
+     * Checks if any of the plugin instances that depend on the specified plugin instance is
+     * activated
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \retval  true    At least one dependent is activated
+     * \retval  false   No dependent is activated
+     */
+    bool hasActivatedDependents(const QString &instanceName) const;
+
+    /*!
+     * Evicts the activated lazy plugin instance
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \note    Caller needs to hold the activation mutex
+     */
+    void evictLazyInstance(const QString &instanceName);
+
+    /*!
+     * Releases the (stopped) plugin instance of the lazy plugin instance and its library
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \note    Caller needs to hold the activation mutex
+     */
+    void releaseLazyInstance(const QString &instanceName);
+
+    //! Builds the index of the plugin instances that export each interface
+    void buildInterfaceIndex();
+
+    /*!
+     * Resolves the dependencies of all specified plugins
+     *
+     * \param       pluginConfigs           List of plugin configs
+     * \param[out]  resolvedDependencies    Dependencies of each plugin instance
      *
-     * \param   pluginConfigs   List of plugin configs
+     * \retval  true    All dependencies were resolved
+     * \retval  false   At least one dependency could not be resolved
+     *
+     * Explicit dependencies are combined with the providers of the required interfaces. All missing
+     * and ambiguous dependencies are reported before returning.
+     */
+    bool resolveDependencies(const QList<PluginConfig> &pluginConfigs,
+                             std::map<QString, QStringList> *resolvedDependencies) const;
+
+    /*!
+     * Builds the dependency graph and the startup and shutdown orders
+     *
+     * \param   resolvedDependencies    Dependencies of each plugin instance
+     * \param   startupPriorities       Names of the plugin instances that need to be started first
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (dependencies form a cycle)
+     */
+    bool buildDependencyGraph(const std::map<QString, QStringList> &resolvedDependencies,
+                              const QStringList &startupPriorities);
+
+    /*!
+     * Prepares all the loaded plugin instances concurrently and records their preparation durations
+     *
+     * \retval  true    All plugin instances were prepared
+     * \retval  false   Preparation of at least one plugin instance failed or it was cancelled
+     *
+     * The plugin instances are prepared on a pool of worker threads owned by the plugin manager
+     * (the calling thread takes part as well). Loading cancellation is checked between the
+     * preparations.
+     */
+    bool prepareAllInstances();
+
+    /*!
+     * Starts the plugin instance and records its start duration
+     *
+     * \param   instanceName    Plugin instance name
+     * \param   instance        Plugin instance
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool startInstance(const QString &instanceName, IPlugin *instance);
+
+    /*!
+     * Stops the plugin instance
+     *
+     * \param   instanceName    Plugin instance name
+     * \param   instance        Plugin instance
+     */
+    void stopInstance(const QString &instanceName, IPlugin *instance);
+
+    /*!
+     * Gets the readiness of the dependencies of the plugin instance
+     *
+     * \param   instanceName    Plugin instance name
+     *
+     * \return  Ready if all dependencies are ready, Failed if any of them failed (or is not
+     *          activated), otherwise Pending
+     */
+    Readiness::State dependenciesReadiness(const QString &instanceName) const;
+
+    /*!
+     * Records the start of the plugin instance and the flows from its dependencies as trace events
+     *
+     * \param   nodeId      Node ID of the plugin instance
+     * \param   timestamp   Trace timestamp of the start
+     * \param   duration    Start duration in nanoseconds
+     */
+    void traceStart(int nodeId, qint64 timestamp, qint64 duration);
+
+    //! Replaces all plugin instance records and metrics in the published live stats
+    void refreshLiveStats();
+
+    /*!
+     * Injects dependencies to all plugin instances
+     *
+     * \param   resolvedDependencies    Dependencies of each plugin instance
      *
      * \retval  true    All dependencies were injected
      * \retval  false   Injection of at least one dependency failed
      */
-    bool injectAllDependencies(const QList<PluginConfig> &pluginConfigs);
+    bool injectAllDependencies(const std::map<QString, QStringList> &resolvedDependencies);
 
     /*!
      * Injects dependencies to the specified instance
      *
-     * \param   instanceName    Name of the plugin instance to inject dependencies to
+     * \param   instance        Plugin instance to inject dependencies to
      * \param   dependencies    Names of the needed dependencies to inject
      *
      * \retval  true    Success
      * \retval  false   Failure
+     *
+     * Lazy dependencies that were not activated yet are activated.
      */
-    bool injectDependencies(const QString &instanceName, const QSet<QString> &dependencies);
+    bool injectDependencies(IPlugin *instance, const QStringList &dependencies);
+
+    /*!
+     * Creates a proxy of the dependency if its dependency edge is instrumented
+     *
+     * \param   instanceName    Name of the plugin instance that uses the dependency
+     * \param   dependency      Dependency
+     *
+     * \return  Proxy of the dependency (owned by the plugin manager) or the dependency itself
+     */
+    IPlugin *instrumentedDependency(const QString &instanceName, IPlugin *dependency);
 
     /*!
      * Ejects all injected dependencies
@@ -136,8 +685,71 @@ private:
     //! Holds all of the loaded plugins
     std::map<QString, std::unique_ptr<IPlugin>> m_pluginInstances;
 
+    //! Holds the registered lazy plugin instances
+    std::map<QString, std::unique_ptr<LazyInstance>> m_lazyInstances;
+
+    //! Serializes the activations of the lazy plugin instances
+    QMutex m_activationMutex;
+
+    //! Flag that indicates that the plugin manager is started (activated instances get started)
+    bool m_started = false;
+
+    //! Holds the readiness timeout in milliseconds (0 to wait for the readiness without a timeout)
+    int m_readinessTimeout = PluginManagerConfig::DefaultReadinessTimeout;
+
+    //! Holds the aggregate readiness of the plugin instances started by the last start()
+    std::shared_ptr<ReadinessTracker> m_readinessTracker;
+
+    //! Holds the executor of the asynchronous operations (created by the first one)
+    std::unique_ptr<Executor> m_executor;
+
+    //! Holds the asynchronous operation that is running (only accessed by the executor)
+    std::shared_ptr<AsyncOperation> m_runningOperation;
+
+    //! Holds the pool of worker threads that prepare the plugin instances (created on demand)
+    std::unique_ptr<QThreadPool> m_preparePool;
+
+    //! Holds the names of the plugin instances that export each interface
+    QHash<QString, QStringList> m_interfaceProviders;
+
+    //! Holds the canonical file paths to the libraries of the plugin instances
+    QHash<QString, QString> m_pluginLibraryPaths;
+
+    //! Holds the instrumented dependency edges (instance name and dependency name or empty)
+    QSet<QPair<QString, QString>> m_instrumentedDependencies;
+
+    //! Holds the proxies of the instrumented dependencies that were injected
+    std::vector<std::unique_ptr<IPlugin>> m_dependencyProxies;
+
+    //! Holds the latency injection from the config
+    LatencyInjection m_latencyInjection;
+
+    //! Holds the dependency graph of the plugin instances
+    DependencyGraph m_dependencyGraph;
+
     //! Holds the order in which the plugin instances will be started
     QStringList m_pluginStartupOrder;
+
+    //! Holds the order in which the plugin instances will be stopped
+    QStringList m_pluginShutdownOrder;
+
+    //! Holds the start durations of the plugin instances in nanoseconds (indexed by node ID)
+    std::vector<qint64> m_startDurations;
+
+    //! Holds the trace timestamps of the plugin instance starts (indexed by node ID, -1 if none)
+    std::vector<qint64> m_startTraceTimestamps;
+
+    //! Holds the trace thread IDs of the plugin instance starts (indexed by node ID)
+    std::vector<int> m_startTraceThreadIds;
+
+    //! Holds the plugin catalog
+    PluginCatalog m_pluginCatalog;
+
+    //! Holds the lifecycle timings
+    LifecycleTimings m_lifecycleTimings;
+
+    //! Holds the published live stats
+    LiveStats m_liveStats;
 };
 
 } // namespace CppPluginFramework
@@ -21,7 +21,9 @@
 #pragma once
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/LatencyInjectionConfig.hpp>
 #include <CppPluginFramework/PluginConfig.hpp>
+#include <CppPluginFramework/StartupProfileConfig.hpp>
 
 // Qt includes
 
@@ -40,6 +42,9 @@ namespace CppPluginFramework
 class CPPPLUGINFRAMEWORK_EXPORT PluginManagerConfig : public CppConfigFramework::ConfigItem
 {
 public:
+    //! Default readiness timeout in milliseconds
+    static constexpr int DefaultReadinessTimeout = 60000;
+
     //! Constructor
     PluginManagerConfig() = default;
 
@@ -114,6 +119,90 @@ public:
      */
     void setPluginStartupPriorities(const QStringList &startupPriorities);
 
+    /*!
+     * Gets directories that are scanned for the plugin catalog
+     *
+     * \return  Plugin directories
+     */
+    const QStringList &pluginDirectories() const;
+
+    /*!
+     * Sets directories that are scanned for the plugin catalog
+     *
+     * \param   pluginDirectories   Plugin directories
+     */
+    void setPluginDirectories(const QStringList &pluginDirectories);
+
+    /*!
+     * Gets path to the plugin catalog cache file
+     *
+     * \return  Path to the plugin catalog cache file or an empty string if the cache is not used
+     */
+    QString pluginCatalogCache() const;
+
+    /*!
+     * Sets path to the plugin catalog cache file
+     *
+     * \param   pluginCatalogCache  Path to the plugin catalog cache file
+     */
+    void setPluginCatalogCache(const QString &pluginCatalogCache);
+
+    /*!
+     * Gets latency injection configs (test facility for simulating slow plugin instances)
+     *
+     * \return  Latency injection configs
+     */
+    const QList<LatencyInjectionConfig> &latencyInjectionConfigs() const;
+
+    /*!
+     * Sets latency injection configs
+     *
+     * \param   latencyInjectionConfigs     Latency injection configs
+     */
+    void setLatencyInjectionConfigs(const QList<LatencyInjectionConfig> &latencyInjectionConfigs);
+
+    /*!
+     * Gets startup profiles
+     *
+     * \return  Startup profiles
+     */
+    const QList<StartupProfileConfig> &startupProfiles() const;
+
+    /*!
+     * Sets startup profiles
+     *
+     * \param   startupProfiles     Startup profiles
+     */
+    void setStartupProfiles(const QList<StartupProfileConfig> &startupProfiles);
+
+    /*!
+     * Gets the readiness timeout
+     *
+     * \return  Readiness timeout in milliseconds (0 if the readiness is awaited without a timeout)
+     *
+     * This is the longest time that the startup (or the activation of a lazy plugin instance)
+     * waits for a dependency to become ready. The dependents of a plugin instance that does not
+     * become ready in time fail to start.
+     */
+    int readinessTimeout() const;
+
+    /*!
+     * Sets the readiness timeout
+     *
+     * \param   readinessTimeout    Readiness timeout in milliseconds (0 if the readiness is awaited
+     *                              without a timeout)
+     */
+    void setReadinessTimeout(int readinessTimeout);
+
+    /*!
+     * Gets the startup profile
+     *
+     * \param   name    Name of the startup profile
+     *
+     * \return  Startup profile or a default constructed one if it is not defined
+     */
+    StartupProfileConfig startupProfile(const QString &name) const;
+
 private:
     //! \copydoc    CppConfigFramework::ConfigItem::loadConfigParameters()
     bool loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config) override;
@@ -131,6 +220,21 @@ private:
     //! Holds the optional order in which the plugin instances need to be started; all unreferenced
     //! plugin instances will be started in no particular order
     QStringList m_pluginStartupPriorities;
+
+    //! Holds the optional directories that are scanned for the plugin catalog
+    QStringList m_pluginDirectories;
+
+    //! Holds the optional path to the plugin catalog cache file
+    QString m_pluginCatalogCache;
+
+    //! Holds the optional latency injection configs
+    QList<LatencyInjectionConfig> m_latencyInjectionConfigs;
+
+    //! Holds the optional startup profiles
+    QList<StartupProfileConfig> m_startupProfiles;
+
+    //! Holds the optional readiness timeout in milliseconds
+    int m_readinessTimeout = DefaultReadinessTimeout;
 };
 
 } // namespace CppPluginFramework
@@ -0,0 +1,168 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the readiness of a started plugin instance
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+// System includes
+#include <functional>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class holds the readiness of a started plugin instance
+ *
+ * A plugin instance that needs a long time to become ready (for example to warm up a cache) can
+ * return from start() early and signal later, from any thread, that it is ready or that it failed
+ * (see AbstractPlugin::deferReadiness()). Readiness is settled only once.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT Readiness
+{
+public:
+    //! Readiness state
+    enum class State
+    {
+        //! Plugin instance is not ready yet
+        Pending,
+
+        //! Plugin instance is ready
+        Ready,
+
+        //! Plugin instance failed to become ready
+        Failed
+    };
+
+    /*!
+     * Observer of the readiness
+     *
+     * \param   state   Settled state (Ready or Failed)
+     */
+    using Observer = std::function<void(State state)>;
+
+    //! Constructor
+    Readiness();
+
+    //! Destructor
+    ~Readiness();
+
+    //! Copy constructor is disabled
+    Readiness(const Readiness &) = delete;
+
+    //! Copy assignment operator is disabled
+    Readiness &operator=(const Readiness &) = delete;
+
+    /*!
+     * Gets the readiness state
+     *
+     * \return  Readiness state
+     */
+    State state() const;
+
+    /*!
+     * Gets the error
+     *
+     * \return  Error of the failed readiness (empty if the readiness did not fail)
+     */
+    QString error() const;
+
+    /*!
+     * Signals that the plugin instance is ready
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (readiness is already settled)
+     */
+    bool setReady();
+
+    /*!
+     * Signals that the plugin instance failed to become ready
+     *
+     * \param   error   Error
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (readiness is already settled)
+     */
+    bool setFailed(const QString &error);
+
+    /*!
+     * Waits until the readiness is settled
+     *
+     * \param   timeout     Timeout in milliseconds (negative to wait without a timeout)
+     *
+     * \return  Readiness state (Pending if it was not settled before the timeout)
+     */
+    State wait(int timeout = -1) const;
+
+    /*!
+     * Sets the observer that is notified when the readiness is settled
+     *
+     * \param   observer    Observer (empty to remove it)
+     *
+     * If the readiness is already settled then the observer is notified immediately. The observer
+     * is notified while the readiness is locked, so it must not call the methods of the readiness,
+     * but once this method returns the previous observer is guaranteed not to be running anymore.
+     */
+    void setObserver(const Observer &observer);
+
+private:
+    /*!
+     * Settles the readiness
+     *
+     * \param   state   Settled state
+     * \param   error   Error
+     *
+     * \retval  true    Success
+     * \retval  false   Failure (readiness is already settled)
+     */
+    bool settle(State state, const QString &error);
+
+private:
+    //! Enables thread-safe access to the readiness
+    mutable QMutex m_mutex;
+
+    //! Wakes up the threads that wait for the readiness
+    mutable QWaitCondition m_condition;
+
+    //! Holds the readiness state
+    State m_state;
+
+    //! Holds the error
+    QString m_error;
+
+    //! Holds the observer
+    Observer m_observer;
+};
+
+} // namespace CppPluginFramework
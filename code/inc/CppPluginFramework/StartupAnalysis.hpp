@@ -0,0 +1,190 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that analyzes the critical path of the plugin instance startup
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/DependencyGraph.hpp>
+
+// Qt includes
+#include <QtCore/QJsonObject>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class analyzes the critical path of the plugin instance startup
+ *
+ * The measured start durations of the plugin instances are combined with the dependency graph to
+ * find the earliest possible schedule in which each plugin instance is started as soon as all of
+ * its dependencies are started. From it the critical path (the chain of plugin instances that
+ * determines the total startup time), the slack of each plugin instance (how much longer it could
+ * take without delaying the startup) and the achievable parallelism are derived.
+ *
+ * All durations are in nanoseconds.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT StartupAnalysis
+{
+public:
+    //! Holds the schedule of a plugin instance
+    struct InstanceTiming
+    {
+        //! Plugin instance name
+        QString name;
+
+        //! Measured start duration
+        qint64 duration = 0;
+
+        //! Earliest time when the plugin instance can be started
+        qint64 earliestStart = 0;
+
+        //! Earliest time when the plugin instance can finish starting
+        qint64 earliestFinish = 0;
+
+        //! Latest time when the plugin instance can be started without delaying the startup
+        qint64 latestStart = 0;
+
+        //! Latest time when the plugin instance can finish starting without delaying the startup
+        qint64 latestFinish = 0;
+
+        //! Slack of the plugin instance
+        qint64 slack = 0;
+
+        //! Flag that indicates that the plugin instance is on the critical path
+        bool isCritical = false;
+    };
+
+    //! Constructor
+    StartupAnalysis() = default;
+
+    /*!
+     * Constructor
+     *
+     * \param   graph       Dependency graph (must not contain cycles)
+     * \param   durations   Start duration of each plugin instance (indexed by node ID)
+     */
+    StartupAnalysis(const DependencyGraph &graph, const std::vector<qint64> &durations);
+
+    /*!
+     * Checks if analysis is valid
+     *
+     * \retval  true    Valid
+     * \retval  false   Invalid (graph contains a cycle or the durations do not match the graph)
+     */
+    bool isValid() const;
+
+    /*!
+     * Returns the duration of the critical path (shortest achievable startup time)
+     *
+     * \return  Duration of the critical path
+     */
+    qint64 criticalPathDuration() const;
+
+    /*!
+     * Returns the sum of the start durations of all plugin instances (sequential startup time)
+     *
+     * \return  Sum of the start durations
+     */
+    qint64 totalDuration() const;
+
+    /*!
+     * Returns the achievable parallelism
+     *
+     * \return  Ratio between the total duration and the critical path duration
+     */
+    double parallelism() const;
+
+    /*!
+     * Returns the critical path
+     *
+     * \return  Names of the plugin instances on the critical path (in startup order)
+     */
+    QStringList criticalPath() const;
+
+    /*!
+     * Returns the schedule of all plugin instances
+     *
+     * \return  Schedule of all plugin instances (indexed by node ID)
+     */
+    const std::vector<InstanceTiming> &instanceTimings() const;
+
+    /*!
+     * Creates a machine readable report
+     *
+     * \return  Report in JSON format
+     */
+    QJsonObject toJson() const;
+
+    /*!
+     * Creates a Graphviz graph of the plugin instance dependencies annotated with the timings
+     *
+     * \return  Graph in DOT format
+     */
+    QString toDot() const;
+
+    /*!
+     * Writes the JSON report to a file
+     *
+     * \param   filePath    Path to the file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool writeJson(const QString &filePath) const;
+
+    /*!
+     * Writes the Graphviz graph to a file
+     *
+     * \param   filePath    Path to the file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool writeDot(const QString &filePath) const;
+
+private:
+    //! Holds the dependency graph
+    DependencyGraph m_graph;
+
+    //! Holds the schedule of all plugin instances
+    std::vector<InstanceTiming> m_instanceTimings;
+
+    //! Holds the critical path (node IDs)
+    std::vector<int> m_criticalPath;
+
+    //! Holds the duration of the critical path
+    qint64 m_criticalPathDuration = 0;
+
+    //! Holds the sum of all start durations
+    qint64 m_totalDuration = 0;
+
+    //! Holds the validity flag
+    bool m_valid = false;
+};
+
+} // namespace CppPluginFramework
@@ -0,0 +1,180 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a config class for the Startup Profile of the Plugin Manager
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigItem.hpp>
+
+// Qt includes
+#include <QtCore/QStringList>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * Config class for the Startup Profile of the Plugin Manager
+ *
+ * A startup profile names a set of root plugin instances. When the plugin manager loads a profile
+ * only the root plugin instances and their transitive dependencies are loaded and started.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT StartupProfileConfig : public CppConfigFramework::ConfigItem
+{
+public:
+    //! Constructor
+    StartupProfileConfig() = default;
+
+    /*!
+     * Constructor
+     *
+     * \param   name            Name of the startup profile
+     * \param   rootInstances   Names of the root plugin instances
+     */
+    StartupProfileConfig(const QString &name, const QStringList &rootInstances);
+
+    /*!
+     * Copy constructor
+     *
+     * \param   other   Instance to copy
+     */
+    StartupProfileConfig(const StartupProfileConfig &other) = default;
+
+    /*!
+     * Move constructor
+     *
+     * \param   other   Instance to move
+     */
+    StartupProfileConfig(StartupProfileConfig &&other) noexcept = default;
+
+    //! Destructor
+    ~StartupProfileConfig() override = default;
+
+    /*!
+     * Copy assignment operator
+     *
+     * \param   other   Instance to copy assign
+     *
+     * \return  Reference to this instance after the assignment is made
+     */
+    StartupProfileConfig &operator=(const StartupProfileConfig &other) = default;
+
+    /*!
+     * Move assignment operator
+     *
+     * \param   other   Instance to move assign
+     *
+     * \return  Reference to this instance after the assignment is made
+     */
+    StartupProfileConfig &operator=(StartupProfileConfig &&other) noexcept = default;
+
+    /*!
+     * Checks if startup profile config is valid
+     *
+     * \retval  true    Startup profile config is valid
+     * \retval  false   Startup profile config is not valid
+     */
+    bool isValid() const;
+
+    /*!
+     * Returns name of the startup profile
+     *
+     * \return  Name of the startup profile
+     */
+    QString name() const;
+
+    /*!
+     * Sets name of the startup profile
+     *
+     * \param   name    Name of the startup profile
+     */
+    void setName(const QString &name);
+
+    /*!
+     * Returns names of the root plugin instances
+     *
+     * \return  Names of the root plugin instances
+     */
+    const QStringList &rootInstances() const;
+
+    /*!
+     * Sets names of the root plugin instances
+     *
+     * \param   rootInstances   Names of the root plugin instances
+     */
+    void setRootInstances(const QStringList &rootInstances);
+
+private:
+    //! \copydoc    CppConfigFramework::ConfigItem::loadConfigParameters()
+    bool loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config) override;
+
+    //! \copydoc    CppConfigFramework::ConfigItem::storeConfigParameters()
+    bool storeConfigParameters(CppConfigFramework::ConfigObjectNode *config) override;
+
+    //! \copydoc    CppConfigFramework::ConfigItem::validateConfig()
+    QString validateConfig() const override;
+
+private:
+    //! Holds the name of the startup profile
+    QString m_name;
+
+    //! Holds the names of the root plugin instances
+    QStringList m_rootInstances;
+};
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "equal to" operator for CppPluginFramework::StartupProfileConfig
+ *
+ * \param   left    Startup profile config
+ * \param   right   Startup profile config
+ *
+ * \retval  true    Startup profile configs are equal
+ * \retval  false   Startup profile configs are not equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator==(const CppPluginFramework::StartupProfileConfig &left,
+                                          const CppPluginFramework::StartupProfileConfig &right);
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "not equal to" operator for CppPluginFramework::StartupProfileConfig
+ *
+ * \param   left    Startup profile config
+ * \param   right   Startup profile config
+ *
+ * \retval  true    Startup profile configs are not equal
+ * \retval  false   Startup profile configs are equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator!=(const CppPluginFramework::StartupProfileConfig &left,
+                                          const CppPluginFramework::StartupProfileConfig &right);
@@ -0,0 +1,280 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that records trace events in the Chrome trace event format
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CppPluginFrameworkExport.hpp>
+
+// Qt includes
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// System includes
+#include <atomic>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class records trace events of the whole process in the Chrome trace event format
+ *
+ * The recorded trace can be opened in "chrome://tracing" or in Perfetto UI. Each event is recorded
+ * on the row of the thread it was recorded in.
+ *
+ * Recording is disabled by default. While it is disabled the spans only check an atomic flag, so
+ * they can be left in the code.
+ *
+ * \note    All methods are thread-safe
+ */
+class CPPPLUGINFRAMEWORK_EXPORT TraceRecorder
+{
+public:
+    //! Measures the duration of its own lifetime and records it as a trace event
+    class CPPPLUGINFRAMEWORK_EXPORT Span
+    {
+    public:
+        /*!
+         * Constructor
+         *
+         * \param   category    Category of the event
+         * \param   name        Name of the event
+         * \param   instance    Name of the plugin instance (optional)
+         *
+         * \note    Strings are copied only if recording is enabled
+         */
+        Span(const char *category, const char *name, const QString &instance = QString())
+            : m_active(TraceRecorder::isEnabled())
+        {
+            if (m_active)
+            {
+                begin(category, name, instance);
+            }
+        }
+
+        //! Move constructor
+        Span(Span &&other) noexcept;
+
+        //! Destructor
+        ~Span()
+        {
+            if (m_active)
+            {
+                end();
+            }
+        }
+
+        //! Copy constructor is disabled
+        Span(const Span &) = delete;
+
+        //! Copy assignment operator is disabled
+        Span &operator=(const Span &) = delete;
+
+        //! Move assignment operator is disabled
+        Span &operator=(Span &&) = delete;
+
+    private:
+        //! Starts the measurement
+        void begin(const char *category, const char *name, const QString &instance);
+
+        //! Ends the measurement and records the event
+        void end();
+
+    private:
+        //! Holds the "active" flag
+        bool m_active;
+
+        //! Holds the category
+        QString m_category;
+
+        //! Holds the name
+        QString m_name;
+
+        //! Holds the name of the plugin instance
+        QString m_instance;
+
+        //! Holds the timestamp of the start of the measurement
+        qint64 m_timestamp = 0;
+    };
+
+    /*!
+     * Gets the process-wide trace recorder
+     *
+     * \return  Trace recorder
+     */
+    static TraceRecorder &instance();
+
+    /*!
+     * Checks if recording is enabled
+     *
+     * \retval  true    Enabled
+     * \retval  false   Disabled
+     */
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Gets the current timestamp
+     *
+     * \return  Timestamp of a monotonic clock in nanoseconds
+     */
+    static qint64 timestamp();
+
+    /*!
+     * Gets the ID of the current thread
+     *
+     * \return  Small integer that identifies the current thread in the trace
+     */
+    static int currentThreadId();
+
+    //! Clears all recorded events and enables recording
+    void start();
+
+    //! Disables recording (recorded events are kept)
+    void stop();
+
+    //! Clears all recorded events
+    void clear();
+
+    /*!
+     * Records a complete event (an event with a duration) on the current thread
+     *
+     * \param   category    Category of the event
+     * \param   name        Name of the event
+     * \param   instance    Name of the plugin instance (optional)
+     * \param   timestamp   Start of the event
+     * \param   duration    Duration of the event in nanoseconds
+     */
+    void addCompleteEvent(const QString &category,
+                          const QString &name,
+                          const QString &instance,
+                          qint64 timestamp,
+                          qint64 duration);
+
+    /*!
+     * Records a flow event (an arrow) between two events
+     *
+     * \param   name            Name of the flow
+     * \param   fromTimestamp   Timestamp inside the event where the flow starts
+     * \param   fromThreadId    ID of the thread of the event where the flow starts
+     * \param   toTimestamp     Timestamp inside the event where the flow ends
+     * \param   toThreadId      ID of the thread of the event where the flow ends
+     */
+    void addFlowEvent(const QString &name,
+                      qint64 fromTimestamp,
+                      int fromThreadId,
+                      qint64 toTimestamp,
+                      int toThreadId);
+
+    /*!
+     * Gets the number of recorded events
+     *
+     * \return  Number of recorded events (a flow counts as two events)
+     */
+    int eventCount() const;
+
+    /*!
+     * Converts the recorded events to JSON
+     *
+     * \return  Trace in the Chrome trace event format
+     */
+    QJsonObject toJson() const;
+
+    /*!
+     * Writes the recorded events in the Chrome trace event format to a file
+     *
+     * \param   filePath    Path to the file
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool writeJson(const QString &filePath) const;
+
+private:
+    //! Constructor
+    TraceRecorder() = default;
+
+    //! Recorded event
+    struct Event
+    {
+        //! Event type ('X' for complete events, 's' and 'f' for flow events)
+        char type;
+
+        //! Category of the event
+        QString category;
+
+        //! Name of the event
+        QString name;
+
+        //! Name of the plugin instance
+        QString instance;
+
+        //! Timestamp in nanoseconds
+        qint64 timestamp;
+
+        //! Duration in nanoseconds
+        qint64 duration;
+
+        //! ID of the thread
+        int threadId;
+
+        //! ID of the flow
+        quint64 flowId;
+    };
+
+    /*!
+     * Stores the event
+     *
+     * \param   event   Event
+     */
+    void addEvent(Event &&event);
+
+private:
+    //! Holds the "enabled" flag
+    static std::atomic<bool> s_enabled;
+
+    //! Enables thread-safe access to the recorded events
+    mutable QMutex m_mutex;
+
+    //! Holds the recorded events
+    std::vector<Event> m_events;
+
+    //! Holds the names of the threads that recorded events (keyed by thread ID)
+    QMap<int, QString> m_threadNames;
+
+    //! Holds the timestamp at which the recording was started
+    qint64 m_startTimestamp = 0;
+
+    //! Holds the ID of the last recorded flow
+    quint64 m_lastFlowId = 0;
+};
+
+} // namespace CppPluginFramework
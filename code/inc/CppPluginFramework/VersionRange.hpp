@@ -0,0 +1,265 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds a compiled version range expression
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/VersionInfo.hpp>
+
+// Qt includes
+
+// System includes
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * This class holds a version range expression compiled to a list of version intervals
+ *
+ * The expression is a union (`||`) of comparator sets. Each comparator set is a whitespace
+ * separated list of comparators that all need to be satisfied:
+ *
+ * - `1.2.3`, `=1.2.3`: exact version
+ * - `1.2`, `1.x`, `*`: any version with the specified prefix
+ * - `>1.2.3`, `>=1.2.3`, `<1.2.3`, `<=1.2.3`: comparison with a (partial) version
+ * - `^1.2.3`: versions that do not change the left-most non-zero version part
+ * - `~1.2.3`: versions that do not change the minor version part
+ * - `1.2.3 - 1.4`: inclusive hyphen range
+ * - `!dev`: excludes versions with a development version string
+ *
+ * Example: `>=1.2 <1.4 || ^2.0 !dev`
+ *
+ * The major, minor and patch version parts of the interval bounds are packed into a single
+ * integer so that checking a version against the range is just a few integer comparisons per
+ * interval. The development version string is only compared when the packed parts are equal.
+ */
+class CPPPLUGINFRAMEWORK_EXPORT VersionRange
+{
+public:
+    //! Maximum value of the major, minor and patch version parts that can be packed
+    static constexpr int MaxVersionPart = 0x1FFFFF;
+
+    //! Holds a bound of a version interval
+    struct Bound
+    {
+        //! Packed major, minor and patch version parts
+        quint64 key = 0U;
+
+        //! Development version string
+        QString dev;
+
+        //! Flag that indicates that the bound itself is a part of the interval
+        bool inclusive = true;
+
+        //! Flag that indicates that there is no bound
+        bool unbounded = false;
+    };
+
+    //! Holds a version interval
+    struct Interval
+    {
+        //! Lower bound of the interval
+        Bound lower;
+
+        //! Upper bound of the interval
+        Bound upper;
+
+        //! Flag that indicates that development versions are excluded from the interval
+        bool excludeDev = false;
+    };
+
+    //! Constructor
+    VersionRange();
+
+    /*!
+     * Constructor
+     *
+     * \param   expression  Version range expression
+     */
+    explicit VersionRange(const QString &expression);
+
+    /*!
+     * Constructor for a range that matches only the specified version
+     *
+     * \param   version     Exact version
+     *
+     * \note    Range is invalid if any version part is greater than MaxVersionPart
+     */
+    explicit VersionRange(const VersionInfo &version);
+
+    /*!
+     * Constructor for a range that matches versions in range [minVersion, maxVersion)
+     *
+     * \param   minVersion  Minimum version
+     * \param   maxVersion  Maximum version
+     *
+     * \note    Range is invalid if any version part is greater than MaxVersionPart
+     */
+    VersionRange(const VersionInfo &minVersion, const VersionInfo &maxVersion);
+
+    /*!
+     * Checks if version range is null (default constructed value)
+     *
+     * \retval  true    Null
+     * \retval  false   Not null
+     */
+    bool isNull() const;
+
+    /*!
+     * Checks if version range was compiled successfully
+     *
+     * \retval  true    Valid
+     * \retval  false   Invalid
+     */
+    bool isValid() const;
+
+    /*!
+     * Checks if the specified version is in the range
+     *
+     * \param   version     Version to check
+     *
+     * \retval  true    Version is in range
+     * \retval  false   Version is not in range
+     */
+    bool matches(const VersionInfo &version) const;
+
+    /*!
+     * Returns the compiled intervals
+     *
+     * \return  Compiled intervals sorted by their lower bound
+     */
+    const std::vector<Interval> &intervals() const;
+
+    /*!
+     * Returns the version range expression
+     *
+     * \return  Version range expression
+     */
+    QString toString() const;
+
+    /*!
+     * Packs the major, minor and patch version parts to a single integer
+     *
+     * \param   version     Version to pack
+     *
+     * \return  Packed version
+     *
+     * \note    Version parts greater than MaxVersionPart are clamped to MaxVersionPart
+     */
+    static quint64 packVersion(const VersionInfo &version);
+
+    /*!
+     * Checks if the specified version is in the interval
+     *
+     * \param   key         Packed major, minor and patch version parts
+     * \param   dev         Development version string
+     * \param   interval    Interval
+     *
+     * \retval  true    Version is in the interval
+     * \retval  false   Version is not in the interval
+     */
+    static bool isInInterval(const quint64 key, const QString &dev, const Interval &interval);
+
+    /*!
+     * Compares two packed versions
+     *
+     * \param   leftKey     Packed major, minor and patch version parts of the left version
+     * \param   leftDev     Development version string of the left version
+     * \param   rightKey    Packed major, minor and patch version parts of the right version
+     * \param   rightDev    Development version string of the right version
+     *
+     * \return  Negative value if left is smaller, 0 if they are equal and positive value if left is
+     *          greater than right
+     */
+    static int compare(const quint64 leftKey,
+                       const QString &leftDev,
+                       const quint64 rightKey,
+                       const QString &rightDev);
+
+private:
+    /*!
+     * Compiles the version range expression
+     *
+     * \param   expression  Version range expression
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    bool compile(const QString &expression);
+
+private:
+    //! Holds the version range expression
+    QString m_expression;
+
+    //! Holds the compiled intervals
+    std::vector<Interval> m_intervals;
+
+    //! Holds the flag that indicates that the expression was compiled successfully
+    bool m_valid;
+};
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "equal to" operator for CppPluginFramework::VersionRange
+ *
+ * \param   left    Version range
+ * \param   right   Version range
+ *
+ * \retval  true    Version ranges are equal
+ * \retval  false   Version ranges are not equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator==(const CppPluginFramework::VersionRange &left,
+                                          const CppPluginFramework::VersionRange &right);
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Global "not equal to" operator for CppPluginFramework::VersionRange
+ *
+ * \param   left    Version range
+ * \param   right   Version range
+ *
+ * \retval  true    Version ranges are not equal
+ * \retval  false   Version ranges are equal
+ */
+CPPPLUGINFRAMEWORK_EXPORT bool operator!=(const CppPluginFramework::VersionRange &left,
+                                          const CppPluginFramework::VersionRange &right);
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CedarFramework
+{
+
+//! \copydoc    CedarFramework::serialize()
+template<>
+CPPPLUGINFRAMEWORK_EXPORT bool deserialize(const QJsonValue &json,
+                                           CppPluginFramework::VersionRange *value);
+
+}
@@ -22,6 +22,7 @@
 #include <CppPluginFramework/AbstractPlugin.hpp>
 
 // C++ Plugin Framework includes
+#include "Tracepoints.hpp"
 
 // Qt includes
 
@@ -91,6 +92,19 @@ QSet<QString> AbstractPlugin::exportedInterfaces() const
 
 // -------------------------------------------------------------------------------------------------
 
+bool AbstractPlugin::prepare()
+{
+    // Plugin can only be prepared before it is started
+    if (isStarted())
+    {
+        return false;
+    }
+
+    return onPrepare();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool AbstractPlugin::isStarted() const
 {
     QMutexLocker locker(&m_mutex);
@@ -108,11 +122,27 @@ bool AbstractPlugin::start()
         return false;
     }
 
-    // Start the plugin
+    // Start the plugin (name of the plugin instance is never changed so it can be read without
+    // locking the mutex)
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(plugin_start_begin, qUtf8Printable(m_name));
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_readiness.reset();
+    }
+
     const bool success = onStart();
 
+    CPPPLUGINFRAMEWORK_TRACEPOINT2(plugin_start_end, qUtf8Printable(m_name), success ? 1 : 0);
+
     QMutexLocker locker(&m_mutex);
     m_started = success;
+
+    if (!success)
+    {
+        m_readiness.reset();
+    }
+
     return success;
 }
 
@@ -128,10 +158,71 @@ void AbstractPlugin::stop()
     }
 
     // Stop the plugin
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(plugin_stop_begin, qUtf8Printable(m_name));
+
     onStop();
 
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(plugin_stop_end, qUtf8Printable(m_name));
+
     QMutexLocker locker(&m_mutex);
     m_started = false;
+    m_readiness.reset();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<Readiness> AbstractPlugin::readiness() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_readiness;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<Readiness> AbstractPlugin::deferReadiness()
+{
+    QMutexLocker locker(&m_mutex);
+    m_readiness = std::make_shared<Readiness>();
+    return m_readiness;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+TraceRecorder::Span AbstractPlugin::traceSpan(const char *name) const
+{
+    // Name of the plugin instance is never changed so it can be read without locking the mutex
+    return TraceRecorder::Span("plugin", name, m_name);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Counter AbstractPlugin::registerCounter(const QString &name,
+                                                         const QString &help) const
+{
+    return MetricsRegistry::instance().counter(name, m_name, help);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Gauge AbstractPlugin::registerGauge(const QString &name,
+                                                     const QString &help) const
+{
+    return MetricsRegistry::instance().gauge(name, m_name, help);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Histogram AbstractPlugin::registerHistogram(const QString &name,
+                                                             const QString &help) const
+{
+    return MetricsRegistry::instance().histogram(name, m_name, help);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AbstractPlugin::onPrepare()
+{
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------
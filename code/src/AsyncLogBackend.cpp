@@ -0,0 +1,617 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains an asynchronous logging backend for the framework's logging categories
+ */
+
+// Own header
+#include <CppPluginFramework/AsyncLogBackend.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CpuAccounting.hpp>
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+constexpr int AsyncLogBackend::MaxArgumentCount;
+constexpr int AsyncLogBackend::RateLimiterCount;
+
+//! Interval in which the background thread checks the ring buffers
+static constexpr unsigned long s_pollInterval = 10;
+
+//! Prefix of the names of the framework's logging categories
+static const char s_categoryPrefix[] = "CppPluginFramework.";
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the current time of a monotonic clock
+ *
+ * \return  Time in milliseconds
+ */
+static qint64 currentTime()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Formats the message
+ *
+ * \param   format          Format string
+ * \param   arguments       Arguments
+ * \param   argumentCount   Number of arguments
+ *
+ * \return  Formatted message
+ */
+static QString formatMessage(
+        const char *format,
+        const std::array<QVariant, AsyncLogBackend::MaxArgumentCount> &arguments,
+        const int argumentCount)
+{
+    const QString formatString = QString::fromUtf8(format);
+
+    // Multi-argument overloads replace all placeholders in a single pass so that the placeholders
+    // inside of the arguments are not replaced
+    switch (argumentCount)
+    {
+        case 1:
+            return formatString.arg(arguments[0].toString());
+
+        case 2:
+            return formatString.arg(arguments[0].toString(), arguments[1].toString());
+
+        case 3:
+            return formatString.arg(arguments[0].toString(),
+                                    arguments[1].toString(),
+                                    arguments[2].toString());
+
+        case 4:
+            return formatString.arg(arguments[0].toString(),
+                                    arguments[1].toString(),
+                                    arguments[2].toString(),
+                                    arguments[3].toString());
+
+        default:
+            return formatString;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Writes the message with Qt's logging
+ *
+ * \param   type        Message type
+ * \param   category    Name of the logging category
+ * \param   message     Formatted message
+ */
+static void writeWithQt(const QtMsgType type, const char *category, const QString &message)
+{
+    QMessageLogger logger(nullptr, 0, nullptr, category);
+
+    switch (type)
+    {
+        case QtDebugMsg:
+            logger.debug("%s", qUtf8Printable(message));
+            break;
+
+        case QtInfoMsg:
+            logger.info("%s", qUtf8Printable(message));
+            break;
+
+        case QtWarningMsg:
+            logger.warning("%s", qUtf8Printable(message));
+            break;
+
+        case QtCriticalMsg:
+            logger.critical("%s", qUtf8Printable(message));
+            break;
+
+        case QtFatalMsg:
+            logger.fatal("%s", qUtf8Printable(message));
+            break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Rounds the value up to a power of two
+ *
+ * \param   value   Value
+ *
+ * \return  Power of two
+ */
+static size_t roundUpToPowerOfTwo(const int value)
+{
+    size_t result = 1U;
+
+    while (result < static_cast<size_t>(std::max(value, 1)))
+    {
+        result <<= 1U;
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncLogBackend::Ring::Ring(const size_t capacity)
+    : orphaned(false),
+      m_entries(capacity),
+      m_mask(capacity - 1U),
+      m_head(0U),
+      m_tail(0U)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncLogBackend::Ring::push(Entry &&entry)
+{
+    const size_t head = m_head.load(std::memory_order_relaxed);
+
+    if ((head - m_tail.load(std::memory_order_acquire)) > m_mask)
+    {
+        return false;
+    }
+
+    m_entries[head & m_mask] = std::move(entry);
+    m_head.store(head + 1U, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncLogBackend::Ring::pop(Entry *entry)
+{
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if (tail == m_head.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    // Entry is moved out so that the captured strings are released already by the consumer
+    *entry = std::move(m_entries[tail & m_mask]);
+    m_entries[tail & m_mask] = Entry();
+    m_tail.store(tail + 1U, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncLogBackend &AsyncLogBackend::instance()
+{
+    static AsyncLogBackend backend;
+    return backend;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncLogBackend::AsyncLogBackend()
+    : m_running(false),
+      m_ringCapacity(Options().ringCapacity),
+      m_rateLimit(Options().rateLimit),
+      m_previousHandler(nullptr),
+      m_droppedMessageCount(0U),
+      m_rateLimitedMessageCount(0U),
+      m_stopRequested(false),
+      m_flushRequestCount(0U),
+      m_flushCompletedCount(0U)
+{
+    for (auto &rateLimiter : m_rateLimiters)
+    {
+        rateLimiter.windowStart.store(0);
+        rateLimiter.count.store(0);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+    stop();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncLogBackend::start(const Options &options)
+{
+    QMutexLocker locker(&m_threadMutex);
+
+    if (m_thread.joinable())
+    {
+        return false;
+    }
+
+    m_options = options;
+    m_options.ringCapacity = static_cast<int>(roundUpToPowerOfTwo(options.ringCapacity));
+
+    // Logging threads read these without locking, also while a previous run is winding down
+    m_ringCapacity.store(m_options.ringCapacity, std::memory_order_relaxed);
+    m_rateLimit.store(m_options.rateLimit, std::memory_order_relaxed);
+    m_stopRequested = false;
+    m_droppedMessageCount.store(0U);
+    m_rateLimitedMessageCount.store(0U);
+
+    for (auto &rateLimiter : m_rateLimiters)
+    {
+        rateLimiter.windowStart.store(0);
+        rateLimiter.count.store(0);
+    }
+
+    m_thread = std::thread(&AsyncLogBackend::run, this);
+    m_previousHandler = qInstallMessageHandler(&AsyncLogBackend::messageHandler);
+    m_running.store(true, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::stop()
+{
+    {
+        QMutexLocker locker(&m_threadMutex);
+
+        if (!m_thread.joinable())
+        {
+            return;
+        }
+
+        // New messages are logged synchronously from now on
+        m_running.store(false, std::memory_order_release);
+        qInstallMessageHandler(m_previousHandler);
+
+        m_stopRequested = true;
+        m_wakeUpCondition.wakeAll();
+    }
+
+    // Background thread writes all queued messages before it finishes
+    m_thread.join();
+    m_thread = std::thread();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncLogBackend::isRunning() const
+{
+    return m_running.load(std::memory_order_acquire);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::flush()
+{
+    QMutexLocker locker(&m_threadMutex);
+
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    const quint64 flushRequest = ++m_flushRequestCount;
+    m_wakeUpCondition.wakeAll();
+
+    while ((m_flushCompletedCount < flushRequest) && m_thread.joinable() && (!m_stopRequested))
+    {
+        m_flushedCondition.wait(&m_threadMutex);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 AsyncLogBackend::droppedMessageCount() const
+{
+    return m_droppedMessageCount.load();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 AsyncLogBackend::rateLimitedMessageCount() const
+{
+    return m_rateLimitedMessageCount.load();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::logMessage(const QtMsgType type,
+                                 const QLoggingCategory &category,
+                                 const char *format,
+                                 Arguments &&arguments,
+                                 const int argumentCount)
+{
+    if ((!isRunning()) || (type == QtFatalMsg))
+    {
+        writeWithQt(type, category.categoryName(), formatMessage(format, arguments, argumentCount));
+        return;
+    }
+
+    Entry entry;
+    entry.type = type;
+    entry.category = &category;
+    entry.format = format;
+    entry.arguments = std::move(arguments);
+    entry.argumentCount = argumentCount;
+
+    enqueue(std::move(entry), category.categoryName());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::enqueue(Entry &&entry, const char *categoryName)
+{
+    if (!checkRateLimit(categoryName))
+    {
+        m_rateLimitedMessageCount.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!threadRing()->push(std::move(entry)))
+    {
+        m_droppedMessageCount.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncLogBackend::checkRateLimit(const char *categoryName)
+{
+    const int rateLimit = m_rateLimit.load(std::memory_order_relaxed);
+
+    if (rateLimit <= 0)
+    {
+        return true;
+    }
+
+    // Each framework category has its own rate limiter, all other categories share the last one
+    size_t index = RateLimiterCount - 1;
+
+    if (std::strcmp(categoryName, LoggingCategory::Config.categoryName()) == 0)
+    {
+        index = 0U;
+    }
+    else if (std::strcmp(categoryName, LoggingCategory::Plugin.categoryName()) == 0)
+    {
+        index = 1U;
+    }
+    else if (std::strcmp(categoryName, LoggingCategory::PluginManager.categoryName()) == 0)
+    {
+        index = 2U;
+    }
+
+    auto &rateLimiter = m_rateLimiters[index];
+    const qint64 now = currentTime();
+    qint64 windowStart = rateLimiter.windowStart.load(std::memory_order_relaxed);
+
+    // Only the thread that moves the window resets the counter
+    if (((now - windowStart) >= 1000) &&
+        rateLimiter.windowStart.compare_exchange_strong(windowStart, now))
+    {
+        rateLimiter.count.store(0, std::memory_order_relaxed);
+    }
+
+    return (rateLimiter.count.fetch_add(1, std::memory_order_relaxed) < rateLimit);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncLogBackend::Ring *AsyncLogBackend::threadRing()
+{
+    //! Owner of the ring buffer of a thread
+    struct RingOwner
+    {
+        //! Destructor
+        ~RingOwner()
+        {
+            if (ring)
+            {
+                ring->orphaned.store(true, std::memory_order_release);
+            }
+        }
+
+        //! Holds the ring buffer
+        std::shared_ptr<Ring> ring;
+    };
+
+    thread_local RingOwner owner;
+
+    if (!owner.ring)
+    {
+        const int ringCapacity = m_ringCapacity.load(std::memory_order_relaxed);
+        owner.ring = std::make_shared<Ring>(static_cast<size_t>(ringCapacity));
+
+        QMutexLocker locker(&m_ringsMutex);
+        m_rings.push_back(owner.ring);
+    }
+
+    return owner.ring.get();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::drain()
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    {
+        QMutexLocker locker(&m_ringsMutex);
+        rings = m_rings;
+    }
+
+    Entry entry;
+
+    for (const auto &ring : rings)
+    {
+        // The orphaned flag needs to be read before the last pop so that no entry is missed
+        const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+
+        while (ring->pop(&entry))
+        {
+            if (entry.category != nullptr)
+            {
+                write(entry.type,
+                      QString::fromUtf8(entry.category->categoryName()),
+                      formatMessage(entry.format, entry.arguments, entry.argumentCount));
+            }
+            else
+            {
+                write(entry.type, entry.categoryName, entry.message);
+            }
+        }
+
+        // Ring buffers of the finished threads are no longer needed
+        if (orphaned)
+        {
+            QMutexLocker locker(&m_ringsMutex);
+            m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), ring), m_rings.end());
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::write(const QtMsgType type, const QString &category, const QString &message)
+{
+    if (m_options.sink)
+    {
+        m_options.sink(type, category, message);
+        return;
+    }
+
+    const QByteArray categoryName = category.toUtf8();
+
+    if (m_previousHandler != nullptr)
+    {
+        m_previousHandler(type,
+                          QMessageLogContext(nullptr, 0, nullptr, categoryName.constData()),
+                          message);
+    }
+    else
+    {
+        std::fprintf(stderr, "%s: %s\n", categoryName.constData(), qUtf8Printable(message));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::run()
+{
+    CpuAccounting::ThreadScope threadScope(QString(), QStringLiteral("cpf-async-log"));
+    quint64 reportedDroppedCount = 0U;
+    quint64 reportedRateLimitedCount = 0U;
+    qint64 lastReport = currentTime();
+    bool stopRequested = false;
+
+    while (!stopRequested)
+    {
+        quint64 flushRequest = 0U;
+
+        {
+            QMutexLocker locker(&m_threadMutex);
+
+            if ((!m_stopRequested) && (m_flushRequestCount == m_flushCompletedCount))
+            {
+                m_wakeUpCondition.wait(&m_threadMutex, s_pollInterval);
+            }
+
+            flushRequest = m_flushRequestCount;
+            stopRequested = m_stopRequested;
+        }
+
+        drain();
+
+        // Report the dropped messages at most once per second
+        const qint64 now = currentTime();
+
+        if (((now - lastReport) >= 1000) || stopRequested)
+        {
+            const quint64 droppedCount = m_droppedMessageCount.load();
+            const quint64 rateLimitedCount = m_rateLimitedMessageCount.load();
+
+            if ((droppedCount != reportedDroppedCount) ||
+                (rateLimitedCount != reportedRateLimitedCount))
+            {
+                write(QtWarningMsg,
+                      QStringLiteral("CppPluginFramework"),
+                      QString("Dropped log messages: %1 (ring buffer full), %2 (rate limited)")
+                      .arg(droppedCount - reportedDroppedCount)
+                      .arg(rateLimitedCount - reportedRateLimitedCount));
+
+                reportedDroppedCount = droppedCount;
+                reportedRateLimitedCount = rateLimitedCount;
+            }
+
+            lastReport = now;
+        }
+
+        {
+            QMutexLocker locker(&m_threadMutex);
+            m_flushCompletedCount = flushRequest;
+            m_flushedCondition.wakeAll();
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncLogBackend::messageHandler(const QtMsgType type,
+                                     const QMessageLogContext &context,
+                                     const QString &message)
+{
+    auto &backend = instance();
+    const char *categoryName = (context.category != nullptr) ? context.category : "default";
+    const bool isFrameworkCategory =
+            (std::strncmp(categoryName, s_categoryPrefix, sizeof(s_categoryPrefix) - 1U) == 0);
+
+    if ((!backend.isRunning()) || (!isFrameworkCategory) || (type == QtFatalMsg))
+    {
+        if (backend.m_previousHandler != nullptr)
+        {
+            backend.m_previousHandler(type, context, message);
+        }
+
+        return;
+    }
+
+    Entry entry;
+    entry.type = type;
+    entry.categoryName = QString::fromUtf8(categoryName);
+    entry.message = message;
+
+    backend.enqueue(std::move(entry), categoryName);
+}
+
+} // namespace CppPluginFramework
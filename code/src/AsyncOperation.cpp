@@ -0,0 +1,129 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the handle of an asynchronous operation of the plugin manager
+ */
+
+// Own header
+#include <CppPluginFramework/AsyncOperation.hpp>
+
+// C++ Plugin Framework includes
+
+// Qt includes
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+AsyncOperation::AsyncOperation(const ProgressObserver &progressObserver)
+    : m_state(State::Queued),
+      m_cancellationRequested(false),
+      m_progressObserver(progressObserver),
+      m_future(m_promise.get_future().share())
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncOperation::~AsyncOperation()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+AsyncOperation::State AsyncOperation::state() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_state;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_future<bool> AsyncOperation::future() const
+{
+    return m_future;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncOperation::cancel()
+{
+    m_cancellationRequested.store(true, std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AsyncOperation::isCancellationRequested() const
+{
+    return m_cancellationRequested.load(std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncOperation::setRunning()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_state == State::Queued)
+    {
+        m_state = State::Running;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncOperation::reportProgress(const Progress &progress) const
+{
+    if (m_progressObserver)
+    {
+        m_progressObserver(progress);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AsyncOperation::finish(const bool success)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ((m_state == State::Succeeded) ||
+        (m_state == State::Failed) ||
+        (m_state == State::Cancelled))
+    {
+        return;
+    }
+
+    if (success)
+    {
+        m_state = State::Succeeded;
+    }
+    else
+    {
+        m_state = isCancellationRequested() ? State::Cancelled : State::Failed;
+    }
+
+    m_promise.set_value(success);
+}
+
+} // namespace CppPluginFramework
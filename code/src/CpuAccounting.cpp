@@ -0,0 +1,393 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the accounting of CPU time per plugin instance
+ */
+
+// Own header
+#include <CppPluginFramework/CpuAccounting.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/MetricsRegistry.hpp>
+
+// Qt includes
+#include <QtCore/QThread>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+#if defined(Q_OS_UNIX)
+#include <pthread.h>
+#endif
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+#if defined(Q_OS_UNIX)
+//! Registered thread
+struct CpuAccounting::ThreadRecord
+{
+    //! Name of the plugin instance that owns the thread
+    QString instance;
+
+    //! CPU-time clock of the thread
+    clockid_t clock;
+
+    //! CPU time of the thread when it was registered
+    qint64 baseline;
+};
+#else
+//! Registered thread (CPU-time clocks are not supported on this platform)
+struct CpuAccounting::ThreadRecord
+{
+    //! Name of the plugin instance that owns the thread
+    QString instance;
+};
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(Q_OS_UNIX)
+/*!
+ * Reads the clock
+ *
+ * \param   clock   Clock
+ *
+ * \return  Time in nanoseconds or -1 in case of failure
+ */
+static qint64 readClock(const clockid_t clock)
+{
+    struct timespec time;
+
+    if (clock_gettime(clock, &time) != 0)
+    {
+        return -1;
+    }
+
+    return (static_cast<qint64>(time.tv_sec) * Q_INT64_C(1000000000)) +
+            static_cast<qint64>(time.tv_nsec);
+}
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Sets the name of the calling thread
+ *
+ * \param   threadName  Thread name
+ */
+static void setCurrentThreadName(const QString &threadName)
+{
+#if defined(Q_OS_LINUX)
+    // Linux limits the thread names to 15 bytes (without the terminating null character)
+    const QByteArray name = threadName.toUtf8().left(15);
+    pthread_setname_np(pthread_self(), name.constData());
+#elif defined(Q_OS_MACOS)
+    pthread_setname_np(threadName.toUtf8().constData());
+#else
+    Q_UNUSED(threadName);
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+CpuAccounting::ThreadScope::ThreadScope(const QString &instanceName, const QString &threadName)
+{
+    CpuAccounting::instance().registerThread(instanceName, threadName);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+CpuAccounting::ThreadScope::~ThreadScope()
+{
+    CpuAccounting::instance().unregisterThread();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+CpuAccounting &CpuAccounting::instance()
+{
+    static CpuAccounting cpuAccounting;
+    return cpuAccounting;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+CpuAccounting::CpuAccounting()
+    : m_samplingInterval(0),
+      m_samplingStopRequested(false)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+CpuAccounting::~CpuAccounting()
+{
+    stopSampling();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool CpuAccounting::registerThread(const QString &instanceName, const QString &threadName)
+{
+#if defined(Q_OS_UNIX)
+    std::unique_ptr<ThreadRecord> record(new ThreadRecord);
+    record->instance = instanceName;
+
+    const int result = pthread_getcpuclockid(pthread_self(), &record->clock);
+
+    if (result != 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to get the CPU-time clock of the thread:" << std::strerror(result);
+        return false;
+    }
+
+    record->baseline = threadCpuTime();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto &registeredRecord = m_threads[QThread::currentThreadId()];
+
+        // Attribute the CPU time consumed so far to the previous owner
+        if (registeredRecord)
+        {
+            m_retiredCpuTimes[registeredRecord->instance] +=
+                    record->baseline - registeredRecord->baseline;
+        }
+
+        registeredRecord = std::move(record);
+    }
+
+    const QString name = threadName.isEmpty() ? instanceName : threadName;
+
+    if (!name.isEmpty())
+    {
+        setCurrentThreadName(name);
+    }
+
+    return true;
+#else
+    Q_UNUSED(threadName);
+
+    qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+            << "CPU-time clocks of threads are not supported on this platform:" << instanceName;
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void CpuAccounting::unregisterThread()
+{
+#if defined(Q_OS_UNIX)
+    const qint64 cpuTime = threadCpuTime();
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_threads.find(QThread::currentThreadId());
+
+    if (it == m_threads.end())
+    {
+        return;
+    }
+
+    m_retiredCpuTimes[it->second->instance] += cpuTime - it->second->baseline;
+    m_threads.erase(it);
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void CpuAccounting::addCpuTime(const QString &instanceName, const qint64 cpuTime)
+{
+    QMutexLocker locker(&m_mutex);
+    m_retiredCpuTimes[instanceName] += cpuTime;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<CpuAccounting::CpuStats> CpuAccounting::snapshot() const
+{
+    std::map<QString, CpuStats> stats;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        for (const auto &item : m_retiredCpuTimes)
+        {
+            stats[item.first].cpuTime += item.second;
+        }
+
+#if defined(Q_OS_UNIX)
+        for (const auto &item : m_threads)
+        {
+            const ThreadRecord &record = *item.second;
+            auto &instanceStats = stats[record.instance];
+            instanceStats.threadCount++;
+
+            const qint64 cpuTime = readClock(record.clock);
+
+            if (cpuTime >= record.baseline)
+            {
+                instanceStats.cpuTime += cpuTime - record.baseline;
+            }
+        }
+#endif
+    }
+
+    std::vector<CpuStats> result;
+    result.reserve(stats.size());
+
+    for (auto &item : stats)
+    {
+        item.second.instance = item.first;
+        result.push_back(item.second);
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool CpuAccounting::startSampling(const int interval)
+{
+    QMutexLocker locker(&m_samplingMutex);
+
+    if (m_samplingThread.joinable() || (interval <= 0))
+    {
+        return false;
+    }
+
+    m_samplingInterval = interval;
+    m_samplingStopRequested = false;
+    m_samplingThread = std::thread(&CpuAccounting::run, this);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void CpuAccounting::stopSampling()
+{
+    {
+        QMutexLocker locker(&m_samplingMutex);
+
+        if (!m_samplingThread.joinable())
+        {
+            return;
+        }
+
+        m_samplingStopRequested = true;
+        m_samplingCondition.wakeAll();
+    }
+
+    m_samplingThread.join();
+    m_samplingThread = std::thread();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool CpuAccounting::isSampling() const
+{
+    QMutexLocker locker(&m_samplingMutex);
+    return m_samplingThread.joinable();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 CpuAccounting::threadCpuTime()
+{
+#if defined(Q_OS_UNIX)
+    return std::max(readClock(CLOCK_THREAD_CPUTIME_ID), Q_INT64_C(0));
+#else
+    return 0;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 CpuAccounting::processCpuTime()
+{
+#if defined(Q_OS_UNIX)
+    return std::max(readClock(CLOCK_PROCESS_CPUTIME_ID), Q_INT64_C(0));
+#else
+    return 0;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void CpuAccounting::publish()
+{
+    auto &registry = MetricsRegistry::instance();
+
+    for (const auto &stats : snapshot())
+    {
+        qint64 &publishedCpuTime = m_publishedCpuTimes[stats.instance];
+        const qint64 delta = stats.cpuTime - publishedCpuTime;
+
+        if (delta > 0)
+        {
+            registry.counter(QStringLiteral("cppplugin_plugin_cpu_nanoseconds"),
+                             stats.instance,
+                             QStringLiteral("CPU time consumed by the plugin instance"))
+                    .increment(static_cast<quint64>(delta));
+            publishedCpuTime = stats.cpuTime;
+        }
+
+        registry.gauge(QStringLiteral("cppplugin_plugin_threads"),
+                       stats.instance,
+                       QStringLiteral("Number of registered threads of the plugin instance"))
+                .set(stats.threadCount);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void CpuAccounting::run()
+{
+    ThreadScope threadScope(QString(), QStringLiteral("cpf-cpu-sampler"));
+    bool stopRequested = false;
+
+    while (!stopRequested)
+    {
+        {
+            QMutexLocker locker(&m_samplingMutex);
+
+            if (!m_samplingStopRequested)
+            {
+                m_samplingCondition.wait(&m_samplingMutex,
+                                         static_cast<unsigned long>(m_samplingInterval));
+            }
+
+            stopRequested = m_samplingStopRequested;
+        }
+
+        publish();
+    }
+}
+
+} // namespace CppPluginFramework
@@ -0,0 +1,545 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds the dependency graph of the plugin instances
+ */
+
+// Own header
+#include <CppPluginFramework/DependencyGraph.hpp>
+
+// C++ Plugin Framework includes
+
+// Qt includes
+#include <QtCore/QStringBuilder>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+DependencyGraph::Range::Range(const int *first, const int *last)
+    : m_first(first),
+      m_last(last)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const int *DependencyGraph::Range::begin() const
+{
+    return m_first;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const int *DependencyGraph::Range::end() const
+{
+    return m_last;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int DependencyGraph::Range::size() const
+{
+    return static_cast<int>(m_last - m_first);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::Range::isEmpty() const
+{
+    return (m_first == m_last);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+DependencyGraph::DependencyGraph(const QStringList &nodeNames,
+                                 const std::vector<std::pair<int, int>> &edges)
+    : m_nodeNames(nodeNames)
+{
+    const int count = m_nodeNames.size();
+    m_nodeIds.reserve(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        m_nodeIds.insert(m_nodeNames.at(i), i);
+    }
+
+    // Count the edges of each node (counting sort into compressed sparse rows)
+    m_offsets.assign(static_cast<size_t>(count + 1), 0);
+    m_reverseOffsets.assign(static_cast<size_t>(count + 1), 0);
+
+    for (const auto &edge : edges)
+    {
+        if ((edge.first < 0) || (edge.first >= count) || (edge.second < 0) ||
+            (edge.second >= count))
+        {
+            continue;
+        }
+
+        m_offsets[static_cast<size_t>(edge.first + 1)]++;
+        m_reverseOffsets[static_cast<size_t>(edge.second + 1)]++;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        m_offsets[static_cast<size_t>(i + 1)] += m_offsets[static_cast<size_t>(i)];
+        m_reverseOffsets[static_cast<size_t>(i + 1)] += m_reverseOffsets[static_cast<size_t>(i)];
+    }
+
+    // Fill in the edges
+    m_targets.resize(static_cast<size_t>(m_offsets.back()));
+    m_reverseTargets.resize(static_cast<size_t>(m_reverseOffsets.back()));
+
+    std::vector<int> position(m_offsets.begin(), m_offsets.end() - 1);
+    std::vector<int> reversePosition(m_reverseOffsets.begin(), m_reverseOffsets.end() - 1);
+
+    for (const auto &edge : edges)
+    {
+        if ((edge.first < 0) || (edge.first >= count) || (edge.second < 0) ||
+            (edge.second >= count))
+        {
+            continue;
+        }
+
+        m_targets[static_cast<size_t>(position[static_cast<size_t>(edge.first)]++)] =
+                edge.second;
+        m_reverseTargets[static_cast<size_t>(
+                reversePosition[static_cast<size_t>(edge.second)]++)] = edge.first;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::fromDependencies(const std::map<QString, QStringList> &dependencies,
+                                       DependencyGraph *graph,
+                                       QString *error)
+{
+    QStringList nodeNames;
+    QHash<QString, int> nodeIds;
+    nodeNames.reserve(static_cast<int>(dependencies.size()));
+    nodeIds.reserve(static_cast<int>(dependencies.size()));
+
+    for (const auto &item : dependencies)
+    {
+        nodeIds.insert(item.first, nodeNames.size());
+        nodeNames.append(item.first);
+    }
+
+    std::vector<std::pair<int, int>> edges;
+
+    for (const auto &item : dependencies)
+    {
+        const int nodeId = nodeIds.value(item.first);
+
+        for (const QString &dependency : item.second)
+        {
+            auto it = nodeIds.constFind(dependency);
+
+            if (it == nodeIds.constEnd())
+            {
+                if (error != nullptr)
+                {
+                    *error = QString("Dependency [%1] of [%2] does not reference an actual plugin "
+                                     "instance!").arg(dependency, item.first);
+                }
+                return false;
+            }
+
+            edges.emplace_back(nodeId, it.value());
+        }
+    }
+
+    *graph = DependencyGraph(nodeNames, edges);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int DependencyGraph::nodeCount() const
+{
+    return m_nodeNames.size();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int DependencyGraph::edgeCount() const
+{
+    return static_cast<int>(m_targets.size());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int DependencyGraph::nodeId(const QString &nodeName) const
+{
+    return m_nodeIds.value(nodeName, -1);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString DependencyGraph::nodeName(int nodeId) const
+{
+    return m_nodeNames.value(nodeId);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList DependencyGraph::nodeNames() const
+{
+    return m_nodeNames;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+DependencyGraph::Range DependencyGraph::dependencies(int nodeId) const
+{
+    if ((nodeId < 0) || (nodeId >= nodeCount()))
+    {
+        return Range(nullptr, nullptr);
+    }
+
+    const int *data = m_targets.data();
+    return Range(data + m_offsets[static_cast<size_t>(nodeId)],
+                 data + m_offsets[static_cast<size_t>(nodeId + 1)]);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+DependencyGraph::Range DependencyGraph::dependents(int nodeId) const
+{
+    if ((nodeId < 0) || (nodeId >= nodeCount()))
+    {
+        return Range(nullptr, nullptr);
+    }
+
+    const int *data = m_reverseTargets.data();
+    return Range(data + m_reverseOffsets[static_cast<size_t>(nodeId)],
+                 data + m_reverseOffsets[static_cast<size_t>(nodeId + 1)]);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<std::vector<int>> DependencyGraph::cycles() const
+{
+    // Iterative version of Tarjan's algorithm (deep dependency chains must not overflow the stack)
+    struct Frame
+    {
+        int node;
+        int nextEdge;
+    };
+
+    const int count = nodeCount();
+    std::vector<int> index(static_cast<size_t>(count), -1);
+    std::vector<int> lowLink(static_cast<size_t>(count), 0);
+    std::vector<bool> onStack(static_cast<size_t>(count), false);
+    std::vector<int> stack;
+    std::vector<Frame> callStack;
+    std::vector<std::vector<int>> result;
+    int nextIndex = 0;
+
+    auto visit = [&](int node)
+    {
+        index[static_cast<size_t>(node)] = nextIndex;
+        lowLink[static_cast<size_t>(node)] = nextIndex;
+        nextIndex++;
+
+        stack.push_back(node);
+        onStack[static_cast<size_t>(node)] = true;
+        callStack.push_back({ node, m_offsets[static_cast<size_t>(node)] });
+    };
+
+    for (int root = 0; root < count; root++)
+    {
+        if (index[static_cast<size_t>(root)] >= 0)
+        {
+            continue;
+        }
+
+        visit(root);
+
+        while (!callStack.empty())
+        {
+            const int node = callStack.back().node;
+            const int edge = callStack.back().nextEdge;
+
+            if (edge < m_offsets[static_cast<size_t>(node + 1)])
+            {
+                callStack.back().nextEdge++;
+                const int target = m_targets[static_cast<size_t>(edge)];
+
+                if (index[static_cast<size_t>(target)] < 0)
+                {
+                    visit(target);
+                }
+                else if (onStack[static_cast<size_t>(target)])
+                {
+                    lowLink[static_cast<size_t>(node)] =
+                            std::min(lowLink[static_cast<size_t>(node)],
+                                     index[static_cast<size_t>(target)]);
+                }
+                continue;
+            }
+
+            // All edges of the node were visited
+            if (lowLink[static_cast<size_t>(node)] == index[static_cast<size_t>(node)])
+            {
+                std::vector<int> component;
+                int member = -1;
+
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[static_cast<size_t>(member)] = false;
+                    component.push_back(member);
+                }
+                while (member != node);
+
+                bool isCycle = (component.size() > 1U);
+
+                if (!isCycle)
+                {
+                    const auto nodeDependencies = dependencies(node);
+                    isCycle = (std::find(nodeDependencies.begin(), nodeDependencies.end(), node) !=
+                               nodeDependencies.end());
+                }
+
+                if (isCycle)
+                {
+                    std::sort(component.begin(), component.end());
+                    result.push_back(std::move(component));
+                }
+            }
+
+            callStack.pop_back();
+
+            if (!callStack.empty())
+            {
+                const int parent = callStack.back().node;
+                lowLink[static_cast<size_t>(parent)] =
+                        std::min(lowLink[static_cast<size_t>(parent)],
+                                 lowLink[static_cast<size_t>(node)]);
+            }
+        }
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString DependencyGraph::cyclesToString(const std::vector<std::vector<int>> &cycles) const
+{
+    QStringList items;
+
+    for (const auto &cycle : cycles)
+    {
+        QStringList names;
+
+        for (int nodeId : cycle)
+        {
+            names.append(nodeName(nodeId));
+        }
+
+        items.append(QStringLiteral("[") % names.join(QStringLiteral(", ")) %
+                     QStringLiteral("]"));
+    }
+
+    return items.join(QStringLiteral(", "));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::topologicalLayers(std::vector<std::vector<int>> *layers) const
+{
+    return computeLayers(m_offsets, m_reverseOffsets, m_reverseTargets, layers);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::reverseTopologicalLayers(std::vector<std::vector<int>> *layers) const
+{
+    return computeLayers(m_reverseOffsets, m_offsets, m_targets, layers);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::startupOrder(const std::vector<int> &priorities,
+                                   std::vector<int> *order) const
+{
+    std::vector<std::vector<int>> layers;
+
+    if (!topologicalLayers(&layers))
+    {
+        return false;
+    }
+
+    // Position of each node in the topological order
+    std::vector<int> positions(static_cast<size_t>(nodeCount()), 0);
+    int position = 0;
+
+    for (const auto &layer : layers)
+    {
+        for (int nodeId : layer)
+        {
+            positions[static_cast<size_t>(nodeId)] = position;
+            position++;
+        }
+    }
+
+    std::vector<bool> isOrdered(static_cast<size_t>(nodeCount()), false);
+    std::vector<int> pendingNodes;
+    std::vector<int> stack;
+
+    order->clear();
+    order->reserve(static_cast<size_t>(nodeCount()));
+
+    for (int nodeId : priorities)
+    {
+        if ((nodeId < 0) || (nodeId >= nodeCount()) || isOrdered[static_cast<size_t>(nodeId)])
+        {
+            continue;
+        }
+
+        // Prioritized node is preceded by its dependencies that are not ordered yet
+        pendingNodes.clear();
+        stack.assign(1U, nodeId);
+        isOrdered[static_cast<size_t>(nodeId)] = true;
+
+        while (!stack.empty())
+        {
+            const int currentNodeId = stack.back();
+            stack.pop_back();
+            pendingNodes.push_back(currentNodeId);
+
+            for (int dependencyId : dependencies(currentNodeId))
+            {
+                if (!isOrdered[static_cast<size_t>(dependencyId)])
+                {
+                    isOrdered[static_cast<size_t>(dependencyId)] = true;
+                    stack.push_back(dependencyId);
+                }
+            }
+        }
+
+        std::sort(pendingNodes.begin(),
+                  pendingNodes.end(),
+                  [&positions](const int left, const int right)
+                  {
+                      return positions[static_cast<size_t>(left)] <
+                              positions[static_cast<size_t>(right)];
+                  });
+
+        order->insert(order->end(), pendingNodes.begin(), pendingNodes.end());
+    }
+
+    for (const auto &layer : layers)
+    {
+        for (int nodeId : layer)
+        {
+            if (!isOrdered[static_cast<size_t>(nodeId)])
+            {
+                order->push_back(nodeId);
+            }
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::shutdownOrder(const std::vector<int> &priorities,
+                                    std::vector<int> *order) const
+{
+    if (!startupOrder(priorities, order))
+    {
+        return false;
+    }
+
+    std::reverse(order->begin(), order->end());
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool DependencyGraph::computeLayers(const std::vector<int> &offsets,
+                                    const std::vector<int> &reverseOffsets,
+                                    const std::vector<int> &reverseTargets,
+                                    std::vector<std::vector<int>> *layers) const
+{
+    const int count = nodeCount();
+    layers->clear();
+
+    // Number of edges that still block each node
+    std::vector<int> blockingEdges(static_cast<size_t>(count), 0);
+    std::vector<int> currentLayer;
+
+    for (int nodeId = 0; nodeId < count; nodeId++)
+    {
+        blockingEdges[static_cast<size_t>(nodeId)] = offsets[static_cast<size_t>(nodeId + 1)] -
+                                                     offsets[static_cast<size_t>(nodeId)];
+
+        if (blockingEdges[static_cast<size_t>(nodeId)] == 0)
+        {
+            currentLayer.push_back(nodeId);
+        }
+    }
+
+    int processedCount = 0;
+
+    while (!currentLayer.empty())
+    {
+        std::vector<int> nextLayer;
+
+        for (int nodeId : currentLayer)
+        {
+            for (int i = reverseOffsets[static_cast<size_t>(nodeId)];
+                 i < reverseOffsets[static_cast<size_t>(nodeId + 1)];
+                 i++)
+            {
+                const int releasedNodeId = reverseTargets[static_cast<size_t>(i)];
+
+                if (--blockingEdges[static_cast<size_t>(releasedNodeId)] == 0)
+                {
+                    nextLayer.push_back(releasedNodeId);
+                }
+            }
+        }
+
+        processedCount += static_cast<int>(currentLayer.size());
+        layers->push_back(std::move(currentLayer));
+        currentLayer = std::move(nextLayer);
+    }
+
+    if (processedCount != count)
+    {
+        layers->clear();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace CppPluginFramework
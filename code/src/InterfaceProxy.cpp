@@ -0,0 +1,433 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the instrumented proxies of the exported interfaces
+ */
+
+// Own header
+#include <CppPluginFramework/InterfaceProxy.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LatencyInjection.hpp>
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
+
+// Qt includes
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+#include <atomic>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+//! Holds the sampling rate (shared by all call sites)
+static std::atomic<int> s_samplingRate(100);
+
+// -------------------------------------------------------------------------------------------------
+
+//! Call stats of a call site
+struct ProxyRegistry::CallSite
+{
+    //! Number of calls
+    std::atomic<quint64> callCount { 0U };
+
+    //! Number of calls with measured latency
+    std::atomic<quint64> sampledCount { 0U };
+
+    //! Total latency of the sampled calls in nanoseconds
+    std::atomic<qint64> sampledDuration { 0 };
+
+    //! Maximum latency of the sampled calls in nanoseconds
+    std::atomic<qint64> maxDuration { 0 };
+
+    //! Injected delay of each call in microseconds
+    std::atomic<int> injectedDelay { 0 };
+
+    //! Maximum random delay added to the injected delay in microseconds
+    std::atomic<int> injectedJitter { 0 };
+};
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 ProxyRegistry::CallStats::meanDuration() const
+{
+    if (sampledCount == 0U)
+    {
+        return 0;
+    }
+
+    return sampledDuration / static_cast<qint64>(sampledCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 ProxyRegistry::CallStats::estimatedTotalDuration() const
+{
+    return meanDuration() * static_cast<qint64>(callCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ProxyRegistry &ProxyRegistry::instance()
+{
+    static ProxyRegistry registry;
+    return registry;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ProxyRegistry::ProxyRegistry()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ProxyRegistry::~ProxyRegistry()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyRegistry::registerProxyFactory(const QString &interface, const Factory &factory)
+{
+    if (interface.isEmpty() || (!factory))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Invalid proxy factory for interface:" << interface;
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_factories[interface] = factory;
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyRegistry::unregisterProxy(const QString &interface)
+{
+    QMutexLocker locker(&m_mutex);
+    m_factories.remove(interface);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyRegistry::hasProxy(const QString &interface) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_factories.contains(interface);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::unique_ptr<IPlugin> ProxyRegistry::createProxy(const QString &interface,
+                                                    const QString &callerName,
+                                                    IPlugin *target) const
+{
+    Factory factory;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        factory = m_factories.value(interface);
+    }
+
+    if ((!factory) || (target == nullptr))
+    {
+        return {};
+    }
+
+    // Factory is called without the lock because the proxy registers its call sites
+    return factory(callerName, target);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyRegistry::setSamplingRate(const int rate)
+{
+    s_samplingRate.store(std::max(rate, 1), std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int ProxyRegistry::samplingRate() const
+{
+    return s_samplingRate.load(std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyRegistry::setInjectedLatency(const QString &callee, const int delay, const int jitter)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (delay > 0)
+    {
+        m_injectedLatencies.insert(callee, qMakePair(delay, jitter));
+    }
+    else
+    {
+        m_injectedLatencies.remove(callee);
+    }
+
+    // Update the already registered call sites of the callee
+    for (auto &item : m_callSites)
+    {
+        if (std::get<1>(item.first) == callee)
+        {
+            item.second->injectedDelay.store(std::max(delay, 0), std::memory_order_relaxed);
+            item.second->injectedJitter.store(std::max(jitter, 0), std::memory_order_relaxed);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ProxyRegistry::CallSite *ProxyRegistry::callSite(const QString &caller,
+                                                 const QString &callee,
+                                                 const QString &interface,
+                                                 const QString &method)
+{
+    QMutexLocker locker(&m_mutex);
+    auto &callSite = m_callSites[std::make_tuple(caller, callee, interface, method)];
+
+    if (!callSite)
+    {
+        callSite.reset(new CallSite);
+
+        const auto injectedLatency = m_injectedLatencies.value(callee, qMakePair(0, 0));
+        callSite->injectedDelay.store(injectedLatency.first, std::memory_order_relaxed);
+        callSite->injectedJitter.store(injectedLatency.second, std::memory_order_relaxed);
+    }
+
+    return callSite.get();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 ProxyRegistry::beginCall(CallSite *callSite)
+{
+    const quint64 callIndex = callSite->callCount.fetch_add(1U, std::memory_order_relaxed);
+    const quint64 rate = static_cast<quint64>(s_samplingRate.load(std::memory_order_relaxed));
+
+    const qint64 startTime = ((callIndex % rate) == 0U) ? TraceRecorder::timestamp() : -1;
+
+    // Injected latency is a part of the call
+    const int injectedDelay = callSite->injectedDelay.load(std::memory_order_relaxed);
+
+    if (injectedDelay > 0)
+    {
+        LatencyInjection::injectDelay(injectedDelay,
+                                      callSite->injectedJitter.load(std::memory_order_relaxed));
+    }
+
+    return startTime;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyRegistry::endCall(CallSite *callSite, const qint64 startTime)
+{
+    const qint64 duration = TraceRecorder::timestamp() - startTime;
+
+    callSite->sampledCount.fetch_add(1U, std::memory_order_relaxed);
+    callSite->sampledDuration.fetch_add(duration, std::memory_order_relaxed);
+
+    qint64 maxDuration = callSite->maxDuration.load(std::memory_order_relaxed);
+
+    while ((duration > maxDuration) &&
+           (!callSite->maxDuration.compare_exchange_weak(maxDuration,
+                                                         duration,
+                                                         std::memory_order_relaxed)))
+    {
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<ProxyRegistry::CallStats> ProxyRegistry::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    std::vector<CallStats> result;
+    result.reserve(m_callSites.size());
+
+    for (const auto &item : m_callSites)
+    {
+        const CallSite &callSite = *item.second;
+
+        CallStats stats;
+        stats.caller = std::get<0>(item.first);
+        stats.callee = std::get<1>(item.first);
+        stats.interface = std::get<2>(item.first);
+        stats.method = std::get<3>(item.first);
+        stats.callCount = callSite.callCount.load(std::memory_order_relaxed);
+        stats.sampledCount = callSite.sampledCount.load(std::memory_order_relaxed);
+        stats.sampledDuration = callSite.sampledDuration.load(std::memory_order_relaxed);
+        stats.maxDuration = callSite.maxDuration.load(std::memory_order_relaxed);
+
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyRegistry::reset()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (auto &item : m_callSites)
+    {
+        CallSite &callSite = *item.second;
+        callSite.callCount.store(0U, std::memory_order_relaxed);
+        callSite.sampledCount.store(0U, std::memory_order_relaxed);
+        callSite.sampledDuration.store(0, std::memory_order_relaxed);
+        callSite.maxDuration.store(0, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ProxyPlugin::ProxyPlugin(const QString &interface, const QString &callerName, IPlugin *target)
+    : m_interface(interface),
+      m_callerName(callerName),
+      m_target(target)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString ProxyPlugin::name() const
+{
+    return m_target->name();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+VersionInfo ProxyPlugin::version() const
+{
+    return m_target->version();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString ProxyPlugin::description() const
+{
+    return m_target->description();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::isInterfaceExported(const QString &interface) const
+{
+    return (interface == m_interface);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QSet<QString> ProxyPlugin::exportedInterfaces() const
+{
+    return QSet<QString> { m_interface };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::loadConfig(const CppConfigFramework::ConfigObjectNode &config)
+{
+    Q_UNUSED(config);
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::injectDependency(IPlugin *plugin)
+{
+    Q_UNUSED(plugin);
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyPlugin::ejectDependencies()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::prepare()
+{
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::isStarted() const
+{
+    return m_target->isStarted();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool ProxyPlugin::start()
+{
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ProxyPlugin::stop()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<Readiness> ProxyPlugin::readiness() const
+{
+    return m_target->readiness();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString ProxyPlugin::proxiedInterface() const
+{
+    return m_interface;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString ProxyPlugin::callerName() const
+{
+    return m_callerName;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+IPlugin *ProxyPlugin::targetPlugin() const
+{
+    return m_target;
+}
+
+} // namespace CppPluginFramework
@@ -0,0 +1,128 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the latency injection into plugin instances for performance testing
+ */
+
+// Own header
+#include <CppPluginFramework/LatencyInjection.hpp>
+
+// C++ Plugin Framework includes
+
+// Qt includes
+
+// System includes
+#include <chrono>
+#include <random>
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+void LatencyInjection::setConfigs(const QList<LatencyInjectionConfig> &configs)
+{
+    m_configs.clear();
+
+    for (const auto &config : configs)
+    {
+        m_configs.insert(config.instanceName(), config);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QList<LatencyInjectionConfig> LatencyInjection::configs() const
+{
+    return m_configs.values();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjection::clear()
+{
+    m_configs.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LatencyInjection::isEmpty() const
+{
+    return m_configs.isEmpty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LatencyInjection::delaysCalls(const QString &instanceName) const
+{
+    auto it = m_configs.constFind(instanceName);
+    return ((it != m_configs.cend()) && (it->callDelay() > 0));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjection::inject(const QString &instanceName, const Operation operation) const
+{
+    auto it = m_configs.constFind(instanceName);
+
+    if (it == m_configs.cend())
+    {
+        return;
+    }
+
+    switch (operation)
+    {
+        case Operation::LoadConfig:
+            injectDelay(it->loadConfigDelay(), it->jitter());
+            break;
+
+        case Operation::Start:
+            injectDelay(it->startDelay(), it->jitter());
+            break;
+
+        case Operation::Stop:
+            injectDelay(it->stopDelay(), it->jitter());
+            break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjection::injectDelay(const int delay, const int jitter)
+{
+    if (delay <= 0)
+    {
+        return;
+    }
+
+    int totalDelay = delay;
+
+    if (jitter > 0)
+    {
+        thread_local std::minstd_rand generator(std::random_device{}());
+        totalDelay += std::uniform_int_distribution<int>(0, jitter)(generator);
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(totalDelay));
+}
+
+} // namespace CppPluginFramework
@@ -0,0 +1,241 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a config class for the Latency Injection into a Plugin Instance
+ */
+
+// Own header
+#include <CppPluginFramework/LatencyInjectionConfig.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/Validation.hpp>
+
+// Qt includes
+#include <QtCore/QStringBuilder>
+
+// System includes
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+LatencyInjectionConfig::LatencyInjectionConfig(const QString &instanceName,
+                                               const int loadConfigDelay,
+                                               const int startDelay,
+                                               const int stopDelay,
+                                               const int callDelay,
+                                               const int jitter)
+    : m_instanceName(instanceName),
+      m_loadConfigDelay(loadConfigDelay),
+      m_startDelay(startDelay),
+      m_stopDelay(stopDelay),
+      m_callDelay(callDelay),
+      m_jitter(jitter)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LatencyInjectionConfig::isValid() const
+{
+    return validateConfig().isEmpty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LatencyInjectionConfig::instanceName() const
+{
+    return m_instanceName;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setInstanceName(const QString &instanceName)
+{
+    m_instanceName = instanceName;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int LatencyInjectionConfig::loadConfigDelay() const
+{
+    return m_loadConfigDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setLoadConfigDelay(const int loadConfigDelay)
+{
+    m_loadConfigDelay = loadConfigDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int LatencyInjectionConfig::startDelay() const
+{
+    return m_startDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setStartDelay(const int startDelay)
+{
+    m_startDelay = startDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int LatencyInjectionConfig::stopDelay() const
+{
+    return m_stopDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setStopDelay(const int stopDelay)
+{
+    m_stopDelay = stopDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int LatencyInjectionConfig::callDelay() const
+{
+    return m_callDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setCallDelay(const int callDelay)
+{
+    m_callDelay = callDelay;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int LatencyInjectionConfig::jitter() const
+{
+    return m_jitter;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LatencyInjectionConfig::setJitter(const int jitter)
+{
+    m_jitter = jitter;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LatencyInjectionConfig::loadConfigParameters(
+        const CppConfigFramework::ConfigObjectNode &config)
+{
+    // Load name of the plugin instance
+    if (!loadRequiredConfigParameter(&m_instanceName, QStringLiteral("instance"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load latency injection's plugin instance name!";
+        return false;
+    }
+
+    // Load delays
+    const std::vector<std::pair<QString, int *>> delays
+    {
+        { QStringLiteral("load_config_delay_us"), &m_loadConfigDelay },
+        { QStringLiteral("start_delay_us"), &m_startDelay },
+        { QStringLiteral("stop_delay_us"), &m_stopDelay },
+        { QStringLiteral("call_delay_us"), &m_callDelay },
+        { QStringLiteral("jitter_us"), &m_jitter }
+    };
+
+    for (const auto &item : delays)
+    {
+        *item.second = 0;
+
+        if (!loadOptionalConfigParameter(item.second, item.first, config))
+        {
+            qCWarning(CppPluginFramework::LoggingCategory::Config)
+                    << "Failed to load latency injection's delay:" << item.first;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LatencyInjectionConfig::storeConfigParameters(CppConfigFramework::ConfigObjectNode *config)
+{
+    // Storing config parameters is currently not supported
+    Q_UNUSED(config)
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LatencyInjectionConfig::validateConfig() const
+{
+    // Check name of the plugin instance
+    if (!Validation::validatePluginInstanceName(m_instanceName))
+    {
+        return QStringLiteral("Plugin instance name is not valid: ") % m_instanceName;
+    }
+
+    // Check delays
+    if ((m_loadConfigDelay < 0) ||
+        (m_startDelay < 0) ||
+        (m_stopDelay < 0) ||
+        (m_callDelay < 0) ||
+        (m_jitter < 0))
+    {
+        return QStringLiteral("Delays of plugin instance [%1] must not be negative!")
+                .arg(m_instanceName);
+    }
+
+    return QString();
+}
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator==(const CppPluginFramework::LatencyInjectionConfig &left,
+                const CppPluginFramework::LatencyInjectionConfig &right)
+{
+    return ((left.instanceName() == right.instanceName()) &&
+            (left.loadConfigDelay() == right.loadConfigDelay()) &&
+            (left.startDelay() == right.startDelay()) &&
+            (left.stopDelay() == right.stopDelay()) &&
+            (left.callDelay() == right.callDelay()) &&
+            (left.jitter() == right.jitter()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator!=(const CppPluginFramework::LatencyInjectionConfig &left,
+                const CppPluginFramework::LatencyInjectionConfig &right)
+{
+    return !(left == right);
+}
@@ -0,0 +1,414 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds the timings of the plugin lifecycle phases
+ */
+
+// Own header
+#include <CppPluginFramework/LifecycleTimings.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
+
+// Qt includes
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+#include <cmath>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+constexpr int LifecycleTimings::PhaseCount;
+constexpr int LifecycleTimings::Histogram::BucketCount;
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Returns the index of the bucket for the duration
+ *
+ * \param   duration    Duration in nanoseconds
+ *
+ * \return  Bucket index
+ */
+static int bucketIndex(const qint64 duration)
+{
+    int index = 0;
+    quint64 value = static_cast<quint64>(std::max<qint64>(duration, 0)) >> 1;
+
+    while (value != 0U)
+    {
+        index++;
+        value >>= 1;
+    }
+
+    return index;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LifecycleTimings::Histogram::add(const qint64 duration)
+{
+    const qint64 value = std::max<qint64>(duration, 0);
+
+    if (m_count == 0U)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    m_buckets[static_cast<size_t>(bucketIndex(value))]++;
+    m_count++;
+    m_total += value;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LifecycleTimings::Histogram::merge(const Histogram &other)
+{
+    if (other.m_count == 0U)
+    {
+        return;
+    }
+
+    if (m_count == 0U)
+    {
+        *this = other;
+        return;
+    }
+
+    for (size_t i = 0; i < m_buckets.size(); i++)
+    {
+        m_buckets[i] += other.m_buckets[i];
+    }
+
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 LifecycleTimings::Histogram::count() const
+{
+    return m_count;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 LifecycleTimings::Histogram::total() const
+{
+    return m_total;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 LifecycleTimings::Histogram::min() const
+{
+    return m_min;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 LifecycleTimings::Histogram::max() const
+{
+    return m_max;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+double LifecycleTimings::Histogram::mean() const
+{
+    if (m_count == 0U)
+    {
+        return 0.0;
+    }
+
+    return static_cast<double>(m_total) / static_cast<double>(m_count);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 LifecycleTimings::Histogram::percentile(const double percentile) const
+{
+    if (m_count == 0U)
+    {
+        return 0;
+    }
+
+    const double clampedPercentile = std::max(0.0, std::min(percentile, 100.0));
+    const quint64 rank = std::max<quint64>(
+                             1U,
+                             static_cast<quint64>(std::ceil(clampedPercentile / 100.0 *
+                                                            static_cast<double>(m_count))));
+    quint64 accumulated = 0;
+
+    for (size_t i = 0; i < m_buckets.size(); i++)
+    {
+        accumulated += m_buckets[i];
+
+        if (accumulated >= rank)
+        {
+            const qint64 upperBound = (i >= 62U) ? m_max
+                                                 : static_cast<qint64>((Q_UINT64_C(2) << i) - 1U);
+            return std::max(m_min, std::min(upperBound, m_max));
+        }
+    }
+
+    return m_max;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const std::array<quint64, LifecycleTimings::Histogram::BucketCount> &
+LifecycleTimings::Histogram::buckets() const
+{
+    return m_buckets;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QJsonObject LifecycleTimings::Histogram::toJson() const
+{
+    QJsonObject buckets;
+
+    for (size_t i = 0; i < m_buckets.size(); i++)
+    {
+        if (m_buckets[i] != 0U)
+        {
+            // Key is the lower bound of the bucket
+            const quint64 lowerBound = (i == 0U) ? 0U : (Q_UINT64_C(1) << i);
+            buckets.insert(QString::number(lowerBound), static_cast<qint64>(m_buckets[i]));
+        }
+    }
+
+    return QJsonObject
+    {
+        { QStringLiteral("count"), static_cast<qint64>(m_count) },
+        { QStringLiteral("total_ns"), m_total },
+        { QStringLiteral("min_ns"), m_min },
+        { QStringLiteral("max_ns"), m_max },
+        { QStringLiteral("mean_ns"), mean() },
+        { QStringLiteral("p50_ns"), percentile(50.0) },
+        { QStringLiteral("p90_ns"), percentile(90.0) },
+        { QStringLiteral("p99_ns"), percentile(99.0) },
+        { QStringLiteral("buckets"), buckets }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LifecycleTimings::Scope::Scope(LifecycleTimings *timings, const Phase phase, const QString &name)
+    : m_timings(timings),
+      m_phase(phase),
+      m_name(name),
+      m_traceTimestamp(TraceRecorder::isEnabled() ? TraceRecorder::timestamp() : -1)
+{
+    if ((m_timings != nullptr) || (m_traceTimestamp >= 0))
+    {
+        m_timer.start();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LifecycleTimings::Scope::~Scope()
+{
+    if ((m_timings == nullptr) && (m_traceTimestamp < 0))
+    {
+        return;
+    }
+
+    const qint64 duration = m_timer.nsecsElapsed();
+
+    if (m_timings != nullptr)
+    {
+        m_timings->record(m_phase, m_name, duration);
+    }
+
+    if (m_traceTimestamp >= 0)
+    {
+        const QString phaseName = phaseToString(m_phase);
+
+        TraceRecorder::instance().addCompleteEvent(
+                    QStringLiteral("lifecycle"),
+                    m_name.isEmpty() ? phaseName : QString("%1 %2").arg(phaseName, m_name),
+                    m_name,
+                    m_traceTimestamp,
+                    duration);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LifecycleTimings::record(const Phase phase, const QString &name, const qint64 duration)
+{
+    const auto index = static_cast<size_t>(phase);
+
+    m_phaseHistograms[index].add(duration);
+
+    if (!name.isEmpty())
+    {
+        m_namedHistograms[index][name].add(duration);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LifecycleTimings::Histogram LifecycleTimings::histogram(const Phase phase) const
+{
+    return m_phaseHistograms[static_cast<size_t>(phase)];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LifecycleTimings::Histogram LifecycleTimings::histogram(const Phase phase,
+                                                        const QString &name) const
+{
+    return m_namedHistograms[static_cast<size_t>(phase)].value(name);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList LifecycleTimings::names(const Phase phase) const
+{
+    QStringList names = m_namedHistograms[static_cast<size_t>(phase)].keys();
+    names.sort();
+    return names;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LifecycleTimings::clear()
+{
+    for (size_t i = 0; i < m_phaseHistograms.size(); i++)
+    {
+        m_phaseHistograms[i] = Histogram();
+        m_namedHistograms[i].clear();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QJsonObject LifecycleTimings::toJson() const
+{
+    QJsonObject phases;
+
+    for (int i = 0; i < PhaseCount; i++)
+    {
+        const auto phase = static_cast<Phase>(i);
+        QJsonObject phaseObject = m_phaseHistograms[static_cast<size_t>(i)].toJson();
+        QJsonObject items;
+
+        for (const QString &name : names(phase))
+        {
+            items.insert(name, histogram(phase, name).toJson());
+        }
+
+        phaseObject.insert(QStringLiteral("items"), items);
+        phases.insert(phaseToString(phase), phaseObject);
+    }
+
+    return QJsonObject
+    {
+        { QStringLiteral("phases"), phases }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LifecycleTimings::writeJson(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to open the lifecycle timings file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+
+    if (!file.commit())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to write the lifecycle timings file:" << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LifecycleTimings::phaseToString(const Phase phase)
+{
+    switch (phase)
+    {
+        case Phase::ConfigValidation:
+            return QStringLiteral("config_validation");
+
+        case Phase::LibraryLoad:
+            return QStringLiteral("library_load");
+
+        case Phase::CreateInstance:
+            return QStringLiteral("create_instance");
+
+        case Phase::LoadConfig:
+            return QStringLiteral("load_config");
+
+        case Phase::VersionCheck:
+            return QStringLiteral("version_check");
+
+        case Phase::InjectDependency:
+            return QStringLiteral("inject_dependency");
+
+        case Phase::Prepare:
+            return QStringLiteral("prepare");
+
+        case Phase::Start:
+            return QStringLiteral("start");
+
+        case Phase::Stop:
+            return QStringLiteral("stop");
+
+        case Phase::Teardown:
+            return QStringLiteral("teardown");
+    }
+
+    return QString();
+}
+
+} // namespace CppPluginFramework
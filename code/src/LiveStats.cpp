@@ -0,0 +1,863 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the live stats of the plugin instances published in a shared-memory segment
+ */
+
+// Own header
+#include <CppPluginFramework/LiveStats.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+constexpr int LiveStats::NameSize;
+constexpr int LiveStats::DefaultInstanceCapacity;
+constexpr int LiveStats::DefaultMetricCapacity;
+
+//! Magic bytes at the start of the segment
+static const char s_magic[8] = { 'C', 'P', 'P', 'L', 'S', 'T', 'A', 'T' };
+
+//! Version of the segment layout
+static constexpr quint32 s_layoutVersion = 2U;
+
+//! Maximum number of attempts to read a record that is being updated
+static constexpr int s_maxReadAttempts = 1000;
+
+//! Data of the segment header that changes (protected by the header's sequence lock)
+struct HeaderData
+{
+    //! Number of used records in the plugin instance table
+    quint32 instanceCount;
+
+    //! Number of used records in the metric table
+    quint32 metricCount;
+
+    //! Time of the last update (milliseconds since epoch)
+    qint64 updateTime;
+};
+
+//! Header of the segment
+struct SegmentHeader
+{
+    //! Magic bytes (written last, after the segment is initialized)
+    char magic[8];
+
+    //! Version of the layout
+    quint32 version;
+
+    //! Size of the name fields
+    quint32 nameSize;
+
+    //! Number of lifecycle phases
+    quint32 phaseCount;
+
+    //! Capacity of the plugin instance table
+    quint32 instanceCapacity;
+
+    //! Capacity of the metric table
+    quint32 metricCapacity;
+
+    //! Reserved
+    quint32 reserved;
+
+    //! ID of the publishing process
+    qint64 processId;
+
+    //! Sequence lock (odd while the data is being updated)
+    std::atomic<quint64> sequence;
+
+    //! Data
+    HeaderData data;
+};
+
+//! Data of a plugin instance record
+struct InstanceData
+{
+    //! Name of the plugin instance (UTF-8, null-terminated)
+    char name[LiveStats::NameSize];
+
+    //! State of the plugin instance
+    quint32 state;
+
+    //! Reserved
+    quint32 reserved;
+
+    //! Time when the plugin instance was started (milliseconds since epoch)
+    qint64 startTime;
+
+    //! Total durations of the lifecycle phases in nanoseconds
+    qint64 phaseDurations[LifecycleTimings::PhaseCount];
+
+    //! Number of executions of the lifecycle phases
+    quint64 phaseCounts[LifecycleTimings::PhaseCount];
+};
+
+//! Record of a plugin instance
+struct InstanceRecord
+{
+    //! Sequence lock (odd while the data is being updated)
+    std::atomic<quint64> sequence;
+
+    //! Data
+    InstanceData data;
+};
+
+//! Data of a metric record
+struct MetricData
+{
+    //! Metric name (UTF-8, null-terminated)
+    char name[LiveStats::NameSize];
+
+    //! Name of the plugin instance (UTF-8, null-terminated)
+    char instance[LiveStats::NameSize];
+
+    //! Metric type
+    quint32 type;
+
+    //! Reserved
+    quint32 reserved;
+
+    //! Value of a counter or a gauge
+    qint64 value;
+
+    //! Number of values recorded in a histogram
+    quint64 count;
+
+    //! Sum of the values recorded in a histogram
+    quint64 sum;
+
+    //! Median of the values recorded in a histogram
+    quint64 p50;
+
+    //! 99th percentile of the values recorded in a histogram
+    quint64 p99;
+};
+
+//! Record of a metric
+struct MetricRecord
+{
+    //! Sequence lock (odd while the data is being updated)
+    std::atomic<quint64> sequence;
+
+    //! Data
+    MetricData data;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Calculates the size of the segment
+ *
+ * \param   instanceCapacity    Capacity of the plugin instance table
+ * \param   metricCapacity      Capacity of the metric table
+ *
+ * \return  Size of the segment
+ */
+static size_t segmentSize(const size_t instanceCapacity, const size_t metricCapacity)
+{
+    return sizeof(SegmentHeader) +
+            instanceCapacity * sizeof(InstanceRecord) +
+            metricCapacity * sizeof(MetricRecord);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the record of the plugin instance table
+ *
+ * \param   segment     Segment
+ * \param   index       Index of the record
+ *
+ * \return  Record
+ */
+template<typename Segment>
+static auto instanceRecord(Segment *segment, const size_t index)
+{
+    using Record = typename std::conditional<std::is_const<Segment>::value,
+                                             const InstanceRecord,
+                                             InstanceRecord>::type;
+    using Bytes = typename std::conditional<std::is_const<Segment>::value,
+                                            const char,
+                                            char>::type;
+
+    return reinterpret_cast<Record *>(reinterpret_cast<Bytes *>(segment) +
+                                      sizeof(SegmentHeader)) + index;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the record of the metric table
+ *
+ * \param   segment     Segment
+ * \param   index       Index of the record
+ *
+ * \return  Record
+ */
+template<typename Segment>
+static auto metricRecord(Segment *segment, const size_t index)
+{
+    using Record = typename std::conditional<std::is_const<Segment>::value,
+                                             const MetricRecord,
+                                             MetricRecord>::type;
+    using Bytes = typename std::conditional<std::is_const<Segment>::value,
+                                            const char,
+                                            char>::type;
+
+    const size_t instanceCapacity =
+            reinterpret_cast<const SegmentHeader *>(segment)->instanceCapacity;
+
+    return reinterpret_cast<Record *>(reinterpret_cast<Bytes *>(segment) +
+                                      segmentSize(instanceCapacity, 0U)) + index;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Updates the data of a record under its sequence lock
+ *
+ * \param   record  Record
+ * \param   update  Function that updates the data
+ */
+template<typename Record, typename Function>
+static void writeRecord(Record *record, Function update)
+{
+    const quint64 sequence = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    update(&record->data);
+
+    record->sequence.store(sequence + 2U, std::memory_order_release);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Reads the data of a record under its sequence lock
+ *
+ * \param       record  Record
+ * \param[out]  data    Copy of the data
+ *
+ * \retval  true    Success
+ * \retval  false   Failure (record was being updated in all attempts)
+ */
+template<typename Record, typename Data>
+static bool readRecord(const Record *record, Data *data)
+{
+    for (int attempt = 0; attempt < s_maxReadAttempts; attempt++)
+    {
+        const quint64 sequence = record->sequence.load(std::memory_order_acquire);
+
+        if ((sequence & 1U) != 0U)
+        {
+            continue;
+        }
+
+        std::memcpy(data, &record->data, sizeof(Data));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (record->sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Copies the string to a name field (truncated if needed)
+ *
+ * \param   text    Text
+ * \param   field   Name field
+ */
+static void copyName(const QString &text, char *field)
+{
+    const QByteArray utf8 = text.toUtf8();
+    const size_t size = std::min(static_cast<size_t>(utf8.size()),
+                                 static_cast<size_t>(LiveStats::NameSize - 1));
+
+    std::memcpy(field, utf8.constData(), size);
+    std::memset(field + size, 0, static_cast<size_t>(LiveStats::NameSize) - size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Reads the string from a name field
+ *
+ * \param   field   Name field
+ *
+ * \return  Text
+ */
+static QString readName(const char *field)
+{
+    return QString::fromUtf8(field, static_cast<int>(qstrnlen(field, LiveStats::NameSize)));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Normalizes the segment name
+ *
+ * \param   segmentName     Segment name
+ *
+ * \return  Segment name with a leading slash
+ */
+static QString normalizedSegmentName(const QString &segmentName)
+{
+    return segmentName.startsWith('/') ? segmentName : ('/' + segmentName);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LiveStats::LiveStats()
+    : m_segment(nullptr),
+      m_segmentSize(0U),
+      m_instanceCount(0),
+      m_metricCount(0)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LiveStats::~LiveStats()
+{
+    destroy();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LiveStats::defaultSegmentName(const qint64 processId)
+{
+    return QString("/cppplugin-%1").arg(processId);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LiveStats::create(const QString &segmentName,
+                       const int instanceCapacity,
+                       const int metricCapacity)
+{
+    if (isCreated())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Live stats segment is already created:" << m_segmentName;
+        return false;
+    }
+
+    if ((instanceCapacity < 0) || (metricCapacity < 0))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Invalid capacity of the live stats segment:" << instanceCapacity
+                << metricCapacity;
+        return false;
+    }
+
+#if defined(Q_OS_UNIX)
+    const QString name = normalizedSegmentName(segmentName);
+    const QByteArray encodedName = name.toLocal8Bit();
+    const size_t size = segmentSize(static_cast<size_t>(instanceCapacity),
+                                    static_cast<size_t>(metricCapacity));
+
+    const int fd = ::shm_open(encodedName.constData(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+
+    if (fd < 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to create the live stats segment:" << name << std::strerror(errno);
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to resize the live stats segment:" << name << std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(encodedName.constData());
+        return false;
+    }
+
+    void *segment = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (segment == MAP_FAILED)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to map the live stats segment:" << name << std::strerror(errno);
+        ::shm_unlink(encodedName.constData());
+        return false;
+    }
+
+    // Segment is zero-filled, only the header needs to be initialized (magic bytes last)
+    auto *header = static_cast<SegmentHeader *>(segment);
+    header->version = s_layoutVersion;
+    header->nameSize = static_cast<quint32>(NameSize);
+    header->phaseCount = static_cast<quint32>(LifecycleTimings::PhaseCount);
+    header->instanceCapacity = static_cast<quint32>(instanceCapacity);
+    header->metricCapacity = static_cast<quint32>(metricCapacity);
+    header->processId = QCoreApplication::applicationPid();
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, s_magic, sizeof(s_magic));
+
+    m_segmentName = name;
+    m_segment = segment;
+    m_segmentSize = size;
+    m_instanceCount = 0;
+    m_metricCount = 0;
+    m_instanceIndexes.clear();
+
+    updateHeader();
+    return true;
+#else
+    qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+            << "Live stats segments are not supported on this platform:" << segmentName;
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::destroy()
+{
+    if (!isCreated())
+    {
+        return;
+    }
+
+#if defined(Q_OS_UNIX)
+    ::munmap(m_segment, m_segmentSize);
+    ::shm_unlink(m_segmentName.toLocal8Bit().constData());
+#endif
+
+    m_segmentName.clear();
+    m_segment = nullptr;
+    m_segmentSize = 0U;
+    m_instanceCount = 0;
+    m_metricCount = 0;
+    m_instanceIndexes.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LiveStats::isCreated() const
+{
+    return (m_segment != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LiveStats::segmentName() const
+{
+    return m_segmentName;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::setInstances(const QStringList &instanceNames)
+{
+    if (!isCreated())
+    {
+        return;
+    }
+
+    const auto *header = static_cast<const SegmentHeader *>(m_segment);
+    const int capacity = static_cast<int>(header->instanceCapacity);
+
+    if (instanceNames.size() > capacity)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Live stats segment can hold only" << capacity << "plugin instances";
+    }
+
+    m_instanceCount = std::min(instanceNames.size(), capacity);
+    m_instanceIndexes.clear();
+
+    for (int i = 0; i < m_instanceCount; i++)
+    {
+        const QString &instanceName = instanceNames.at(i);
+        m_instanceIndexes.insert(instanceName, i);
+
+        writeRecord(instanceRecord(m_segment, static_cast<size_t>(i)),
+                    [&instanceName](InstanceData *data)
+                    {
+                        std::memset(data, 0, sizeof(InstanceData));
+                        copyName(instanceName, data->name);
+                        data->state = static_cast<quint32>(InstanceState::Loaded);
+                    });
+    }
+
+    updateHeader();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::setInstanceState(const QString &instanceName, const InstanceState state)
+{
+    const int index = m_instanceIndexes.value(instanceName, -1);
+
+    if ((!isCreated()) || (index < 0))
+    {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    writeRecord(instanceRecord(m_segment, static_cast<size_t>(index)),
+                [state, now](InstanceData *data)
+                {
+                    data->state = static_cast<quint32>(state);
+
+                    if (state == InstanceState::Started)
+                    {
+                        data->startTime = now;
+                    }
+                    else if (state == InstanceState::Stopped)
+                    {
+                        data->startTime = 0;
+                    }
+                });
+
+    updateHeader();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::setInstanceTimings(const QString &instanceName, const LifecycleTimings &timings)
+{
+    const int index = m_instanceIndexes.value(instanceName, -1);
+
+    if ((!isCreated()) || (index < 0))
+    {
+        return;
+    }
+
+    writeRecord(instanceRecord(m_segment, static_cast<size_t>(index)),
+                [&instanceName, &timings](InstanceData *data)
+                {
+                    for (int i = 0; i < LifecycleTimings::PhaseCount; i++)
+                    {
+                        const auto histogram =
+                                timings.histogram(static_cast<LifecycleTimings::Phase>(i),
+                                                  instanceName);
+                        data->phaseDurations[i] = histogram.total();
+                        data->phaseCounts[i] = histogram.count();
+                    }
+                });
+
+    updateHeader();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::setMetrics(const std::vector<MetricsRegistry::MetricSnapshot> &snapshots)
+{
+    if (!isCreated())
+    {
+        return;
+    }
+
+    const auto *header = static_cast<const SegmentHeader *>(m_segment);
+    const size_t count = std::min(snapshots.size(), static_cast<size_t>(header->metricCapacity));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto &snapshot = snapshots.at(i);
+
+        writeRecord(metricRecord(m_segment, i),
+                    [&snapshot](MetricData *data)
+                    {
+                        copyName(snapshot.name, data->name);
+                        copyName(snapshot.instance, data->instance);
+                        data->type = static_cast<quint32>(snapshot.type);
+                        data->value = snapshot.value;
+                        data->count = snapshot.count;
+                        data->sum = snapshot.sum;
+                        data->p50 = snapshot.percentile(50.0);
+                        data->p99 = snapshot.percentile(99.0);
+                    });
+    }
+
+    m_metricCount = static_cast<int>(count);
+    updateHeader();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString LiveStats::stateToString(const InstanceState state)
+{
+    switch (state)
+    {
+        case InstanceState::Loaded:
+            return QStringLiteral("loaded");
+
+        case InstanceState::Starting:
+            return QStringLiteral("starting");
+
+        case InstanceState::Started:
+            return QStringLiteral("started");
+
+        case InstanceState::Failed:
+            return QStringLiteral("failed");
+
+        case InstanceState::Stopping:
+            return QStringLiteral("stopping");
+
+        case InstanceState::Stopped:
+            return QStringLiteral("stopped");
+    }
+
+    return QString();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStats::updateHeader()
+{
+    const quint32 instanceCount = static_cast<quint32>(m_instanceCount);
+    const quint32 metricCount = static_cast<quint32>(m_metricCount);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    writeRecord(static_cast<SegmentHeader *>(m_segment),
+                [instanceCount, metricCount, now](HeaderData *data)
+                {
+                    data->instanceCount = instanceCount;
+                    data->metricCount = metricCount;
+                    data->updateTime = now;
+                });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LiveStatsReader::LiveStatsReader()
+    : m_segment(nullptr),
+      m_segmentSize(0U)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+LiveStatsReader::~LiveStatsReader()
+{
+    detach();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LiveStatsReader::attach(const QString &segmentName)
+{
+    detach();
+
+#if defined(Q_OS_UNIX)
+    const QString name = normalizedSegmentName(segmentName);
+    const int fd = ::shm_open(name.toLocal8Bit().constData(), O_RDONLY, 0);
+
+    if (fd < 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to open the live stats segment:" << name << std::strerror(errno);
+        return false;
+    }
+
+    struct stat status;
+
+    if ((::fstat(fd, &status) != 0) ||
+        (static_cast<size_t>(status.st_size) < sizeof(SegmentHeader)))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Invalid live stats segment:" << name;
+        ::close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+    void *segment = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (segment == MAP_FAILED)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to map the live stats segment:" << name << std::strerror(errno);
+        return false;
+    }
+
+    // Check the layout
+    const auto *header = static_cast<const SegmentHeader *>(segment);
+
+    const bool valid =
+            (std::memcmp(header->magic, s_magic, sizeof(s_magic)) == 0) &&
+            (header->version == s_layoutVersion) &&
+            (header->nameSize == static_cast<quint32>(LiveStats::NameSize)) &&
+            (header->phaseCount == static_cast<quint32>(LifecycleTimings::PhaseCount)) &&
+            (segmentSize(header->instanceCapacity, header->metricCapacity) <= size);
+
+    if (!valid)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Unsupported layout of the live stats segment:" << name;
+        ::munmap(segment, size);
+        return false;
+    }
+
+    m_segment = segment;
+    m_segmentSize = size;
+    return true;
+#else
+    qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+            << "Live stats segments are not supported on this platform:" << segmentName;
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void LiveStatsReader::detach()
+{
+    if (!isAttached())
+    {
+        return;
+    }
+
+#if defined(Q_OS_UNIX)
+    ::munmap(const_cast<void *>(m_segment), m_segmentSize);
+#endif
+
+    m_segment = nullptr;
+    m_segmentSize = 0U;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LiveStatsReader::isAttached() const
+{
+    return (m_segment != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LiveStatsReader::read(LiveStats::Snapshot *snapshot) const
+{
+    if (!isAttached())
+    {
+        return false;
+    }
+
+    const auto *header = static_cast<const SegmentHeader *>(m_segment);
+    HeaderData headerData;
+
+    if (!readRecord(header, &headerData))
+    {
+        return false;
+    }
+
+    LiveStats::Snapshot result;
+    result.processId = header->processId;
+    result.updateTime = headerData.updateTime;
+
+    // Plugin instances
+    const quint32 instanceCount = std::min(headerData.instanceCount, header->instanceCapacity);
+    result.instances.reserve(instanceCount);
+
+    for (quint32 i = 0; i < instanceCount; i++)
+    {
+        InstanceData data;
+
+        if (!readRecord(instanceRecord(m_segment, i), &data))
+        {
+            return false;
+        }
+
+        LiveStats::InstanceStats stats;
+        stats.name = readName(data.name);
+        stats.state = static_cast<LiveStats::InstanceState>(
+                          std::min(data.state,
+                                   static_cast<quint32>(LiveStats::InstanceState::Stopped)));
+        stats.startTime = data.startTime;
+
+        for (size_t phase = 0; phase < stats.phaseDurations.size(); phase++)
+        {
+            stats.phaseDurations[phase] = data.phaseDurations[phase];
+            stats.phaseCounts[phase] = data.phaseCounts[phase];
+        }
+
+        result.instances.push_back(stats);
+    }
+
+    // Metrics
+    const quint32 metricCount = std::min(headerData.metricCount, header->metricCapacity);
+    result.metrics.reserve(metricCount);
+
+    for (quint32 i = 0; i < metricCount; i++)
+    {
+        MetricData data;
+
+        if (!readRecord(metricRecord(m_segment, i), &data))
+        {
+            return false;
+        }
+
+        LiveStats::MetricStats stats;
+        stats.name = readName(data.name);
+        stats.instance = readName(data.instance);
+        stats.type = static_cast<MetricsRegistry::Type>(
+                         std::min(data.type,
+                                  static_cast<quint32>(MetricsRegistry::Type::Histogram)));
+        stats.value = data.value;
+        stats.count = data.count;
+        stats.sum = data.sum;
+        stats.p50 = data.p50;
+        stats.p99 = data.p99;
+
+        result.metrics.push_back(stats);
+    }
+
+    *snapshot = std::move(result);
+    return true;
+}
+
+} // namespace CppPluginFramework
@@ -0,0 +1,493 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the accounting of memory per plugin instance and per plugin library
+ */
+
+// Own header
+#include <CppPluginFramework/MemoryAccounting.hpp>
+
+// C++ Plugin Framework includes
+
+// Qt includes
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+// System includes
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+//! Account of a plugin instance
+struct MemoryAccounting::Account
+{
+    //! Name of the plugin instance
+    QString instanceName;
+
+    //! Total number of allocated bytes
+    std::atomic<quint64> allocatedBytes { 0U };
+
+    //! Total number of freed bytes
+    std::atomic<quint64> freedBytes { 0U };
+
+    //! Number of allocations
+    std::atomic<quint64> allocationCount { 0U };
+
+    //! Number of deallocations
+    std::atomic<quint64> freeCount { 0U };
+};
+
+//! Registry of the accounts
+struct AccountRegistry
+{
+    //! Enables thread-safe access to the accounts
+    QMutex mutex;
+
+    //! Holds the accounts keyed by name of the plugin instance
+    std::map<QString, MemoryAccounting::Account *> accounts;
+};
+
+//! Current tag of the thread (plain pointer so that it can be accessed from operator new)
+static thread_local MemoryAccounting::Account *t_currentAccount = nullptr;
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the registry of the accounts
+ *
+ * \return  Registry
+ *
+ * The registry and the accounts are intentionally never destroyed, because memory can still be
+ * freed after the static objects are destroyed.
+ */
+static AccountRegistry &accountRegistry()
+{
+    static auto *registry = new AccountRegistry();
+    return *registry;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Tag::Tag()
+    : m_account(nullptr)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Tag::Tag(Account *account)
+    : m_account(account)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MemoryAccounting::Tag::isValid() const
+{
+    return (m_account != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString MemoryAccounting::Tag::instanceName() const
+{
+    return isValid() ? m_account->instanceName : QString();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Scope::Scope(const QString &instanceName)
+    : Scope(MemoryAccounting::tag(instanceName))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Scope::Scope(const Tag &tag)
+    : m_previousAccount(t_currentAccount)
+{
+    t_currentAccount = tag.m_account;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Scope::~Scope()
+{
+    t_currentAccount = m_previousAccount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 MemoryAccounting::AllocationStats::liveBytes() const
+{
+    return static_cast<qint64>(allocatedBytes - freedBytes);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Tag MemoryAccounting::tag(const QString &instanceName)
+{
+    if (instanceName.isEmpty())
+    {
+        return Tag();
+    }
+
+    auto &registry = accountRegistry();
+    QMutexLocker locker(&registry.mutex);
+
+    auto it = registry.accounts.find(instanceName);
+
+    if (it == registry.accounts.end())
+    {
+        auto *account = new Account();
+        account->instanceName = instanceName;
+
+        it = registry.accounts.emplace(instanceName, account).first;
+    }
+
+    return Tag(it->second);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MemoryAccounting::Tag MemoryAccounting::currentTag()
+{
+    return Tag(t_currentAccount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MemoryAccounting::isAllocatorInterposed()
+{
+#if defined(CPPPLUGINFRAMEWORK_MEMORY_INTERPOSER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MemoryAccounting::AllocationStats> MemoryAccounting::allocationStats()
+{
+    auto &registry = accountRegistry();
+    QMutexLocker locker(&registry.mutex);
+
+    std::vector<AllocationStats> stats;
+    stats.reserve(registry.accounts.size());
+
+    for (const auto &item : registry.accounts)
+    {
+        const Account *account = item.second;
+
+        AllocationStats accountStats;
+        accountStats.instance = account->instanceName;
+        accountStats.allocatedBytes = account->allocatedBytes.load(std::memory_order_relaxed);
+        accountStats.freedBytes = account->freedBytes.load(std::memory_order_relaxed);
+        accountStats.allocationCount = account->allocationCount.load(std::memory_order_relaxed);
+        accountStats.freeCount = account->freeCount.load(std::memory_order_relaxed);
+
+        stats.push_back(accountStats);
+    }
+
+    return stats;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MemoryAccounting::MappingStats> MemoryAccounting::fileMappings()
+{
+#if defined(Q_OS_LINUX)
+    QFile file(QStringLiteral("/proc/self/smaps"));
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+
+    return parseSmaps(file.readAll());
+#else
+    return {};
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MemoryAccounting::MappingStats> MemoryAccounting::parseSmaps(
+        const QByteArray &contents)
+{
+    std::map<QString, MappingStats> mappings;
+    MappingStats *currentMapping = nullptr;
+
+    for (const QByteArray &line : contents.split('\n'))
+    {
+        const QByteArray trimmedLine = line.trimmed();
+
+        if (trimmedLine.isEmpty())
+        {
+            continue;
+        }
+
+        const int separator = trimmedLine.indexOf(' ');
+        const QByteArray firstField = (separator < 0) ? trimmedLine
+                                                      : trimmedLine.left(separator);
+
+        // Field of the current mapping, for example "Rss:    4 kB"
+        if (firstField.endsWith(':'))
+        {
+            if (currentMapping == nullptr)
+            {
+                continue;
+            }
+
+            const QList<QByteArray> fields = trimmedLine.simplified().split(' ');
+
+            if (fields.size() < 2)
+            {
+                continue;
+            }
+
+            const quint64 bytes = fields.at(1).toULongLong() * 1024U;
+
+            if (firstField == "Size:")
+            {
+                currentMapping->mappedBytes += bytes;
+            }
+            else if (firstField == "Rss:")
+            {
+                currentMapping->residentBytes += bytes;
+            }
+
+            continue;
+        }
+
+        // Header of a mapping: "address perms offset dev inode [path]" (path can contain spaces)
+        QByteArray path = trimmedLine;
+
+        for (int i = 0; i < 5; i++)
+        {
+            const int index = path.indexOf(' ');
+            path = (index < 0) ? QByteArray() : path.mid(index + 1).trimmed();
+        }
+
+        if (!path.startsWith('/'))
+        {
+            currentMapping = nullptr;
+            continue;
+        }
+
+        const QString filePath = QString::fromUtf8(path);
+        currentMapping = &mappings[filePath];
+        currentMapping->filePath = filePath;
+    }
+
+    std::vector<MappingStats> stats;
+    stats.reserve(mappings.size());
+
+    for (const auto &item : mappings)
+    {
+        stats.push_back(item.second);
+    }
+
+    return stats;
+}
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(CPPPLUGINFRAMEWORK_MEMORY_INTERPOSER)
+
+//! Header that is prepended to each allocation (keeps the alignment of malloc())
+struct alignas(16) AllocationHeader
+{
+    //! Account the allocation is attributed to (nullptr if no plugin instance was tagged)
+    CppPluginFramework::MemoryAccounting::Account *account;
+
+    //! Requested size
+    std::size_t size;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Allocates memory and attributes it to the current tag of the thread
+ *
+ * \param   size    Requested size
+ *
+ * \return  Allocated memory or nullptr in case of failure
+ */
+static void *accountedAllocate(const std::size_t size) noexcept
+{
+    if (size > (SIZE_MAX - sizeof(AllocationHeader)))
+    {
+        return nullptr;
+    }
+
+    auto *header = static_cast<AllocationHeader *>(std::malloc(sizeof(AllocationHeader) + size));
+
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto *account = CppPluginFramework::t_currentAccount;
+    header->account = account;
+    header->size = size;
+
+    if (account != nullptr)
+    {
+        account->allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        account->allocationCount.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    return header + 1;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Frees the memory and removes it from the account it was attributed to
+ *
+ * \param   pointer     Memory allocated with accountedAllocate()
+ */
+static void accountedFree(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+
+    auto *header = static_cast<AllocationHeader *>(pointer) - 1;
+    auto *account = header->account;
+
+    if (account != nullptr)
+    {
+        account->freedBytes.fetch_add(header->size, std::memory_order_relaxed);
+        account->freeCount.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    std::free(header);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new(std::size_t size)
+{
+    while (true)
+    {
+        void *pointer = accountedAllocate(size);
+
+        if (pointer != nullptr)
+        {
+            return pointer;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer) noexcept
+{
+    accountedFree(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer) noexcept
+{
+    accountedFree(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    accountedFree(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    accountedFree(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    accountedFree(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    accountedFree(pointer);
+}
+
+#endif
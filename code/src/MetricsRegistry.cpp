@@ -0,0 +1,804 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a registry of metrics (counters, gauges and histograms)
+ */
+
+// Own header
+#include <CppPluginFramework/MetricsRegistry.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtAlgorithms>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+constexpr int MetricsRegistry::ShardCount;
+constexpr int MetricsRegistry::SubBucketBits;
+constexpr int MetricsRegistry::BucketCount;
+
+//! Size of a cache line (used for padding of the shards)
+static constexpr size_t s_cacheLineSize = 64U;
+
+//! Shard of a counter (padded to a cache line so that the threads do not share it)
+struct CounterShard
+{
+    //! Holds the value
+    std::atomic<quint64> value;
+
+    //! Padding
+    char padding[s_cacheLineSize - sizeof(std::atomic<quint64>)];
+};
+
+//! Shard of a histogram
+struct HistogramShard
+{
+    //! Holds the buckets
+    std::array<std::atomic<quint64>, MetricsRegistry::BucketCount> buckets;
+
+    //! Holds the sum of the recorded values
+    std::atomic<quint64> sum;
+
+    //! Padding
+    char padding[s_cacheLineSize - sizeof(std::atomic<quint64>)];
+};
+
+//! Data of a metric
+struct MetricsRegistry::Metric
+{
+    /*!
+     * Constructor
+     *
+     * \param   metricType      Metric type
+     * \param   metricName      Metric name
+     * \param   metricInstance  Name of the plugin instance
+     * \param   metricHelp      Help text
+     */
+    Metric(const Type metricType,
+           const QString &metricName,
+           const QString &metricInstance,
+           const QString &metricHelp)
+        : type(metricType),
+          name(metricName),
+          instance(metricInstance),
+          help(metricHelp),
+          gaugeValue(0)
+    {
+        if (type == Type::Histogram)
+        {
+            histogramShards.reset(new HistogramShard[ShardCount]);
+        }
+
+        reset();
+    }
+
+    //! Resets the value to zero
+    void reset()
+    {
+        for (auto &shard : counterShards)
+        {
+            shard.value.store(0U, std::memory_order_relaxed);
+        }
+
+        gaugeValue.store(0, std::memory_order_relaxed);
+
+        if (histogramShards)
+        {
+            for (int i = 0; i < ShardCount; i++)
+            {
+                for (auto &bucket : histogramShards[i].buckets)
+                {
+                    bucket.store(0U, std::memory_order_relaxed);
+                }
+
+                histogramShards[i].sum.store(0U, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //! Holds the metric type
+    const Type type;
+
+    //! Holds the metric name
+    const QString name;
+
+    //! Holds the name of the plugin instance
+    const QString instance;
+
+    //! Holds the help text
+    const QString help;
+
+    //! Holds the shards of a counter
+    std::array<CounterShard, ShardCount> counterShards;
+
+    //! Holds the value of a gauge
+    std::atomic<qint64> gaugeValue;
+
+    //! Holds the shards of a histogram (only allocated for histograms)
+    std::unique_ptr<HistogramShard[]> histogramShards;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the shard of the calling thread
+ *
+ * \return  Shard index
+ *
+ * Threads are assigned to the shards in a round-robin fashion when they record their first value.
+ */
+static size_t threadShard()
+{
+    static std::atomic<unsigned int> s_nextShard(0U);
+    thread_local const size_t shard =
+            static_cast<size_t>(s_nextShard.fetch_add(1U, std::memory_order_relaxed)
+                                % static_cast<unsigned int>(MetricsRegistry::ShardCount));
+
+    return shard;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the index of the histogram bucket for the value
+ *
+ * \param   value   Value
+ *
+ * \return  Bucket index
+ *
+ * Values below 2^SubBucketBits have their own buckets, every higher power of two is split into
+ * 2^SubBucketBits buckets of equal width.
+ */
+static int bucketIndex(const quint64 value)
+{
+    const quint64 subBucketCount = Q_UINT64_C(1) << MetricsRegistry::SubBucketBits;
+
+    if (value < subBucketCount)
+    {
+        return static_cast<int>(value);
+    }
+
+    const int exponent = 63 - static_cast<int>(qCountLeadingZeroBits(value));
+    const int shift = exponent - MetricsRegistry::SubBucketBits;
+    const int subBucket = static_cast<int>((value >> shift) & (subBucketCount - 1U));
+
+    return ((shift + 1) << MetricsRegistry::SubBucketBits) + subBucket;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Checks if the metric name matches the OpenMetrics naming rules
+ *
+ * \param   name    Metric name
+ *
+ * \retval  true    Valid
+ * \retval  false   Invalid
+ */
+static bool isValidName(const QString &name)
+{
+    static const QRegularExpression regex("^[a-zA-Z_:][a-zA-Z0-9_:]*$");
+    return regex.match(name).hasMatch();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Escapes the text for the OpenMetrics text format
+ *
+ * \param   text            Text
+ * \param   escapeQuotes    Escape also the double quotes (needed for label values)
+ *
+ * \return  Escaped text
+ */
+static QByteArray escape(const QString &text, const bool escapeQuotes)
+{
+    QByteArray escaped;
+    const QByteArray utf8 = text.toUtf8();
+    escaped.reserve(utf8.size());
+
+    for (const char character : utf8)
+    {
+        switch (character)
+        {
+            case '\\':
+                escaped.append("\\\\");
+                break;
+
+            case '\n':
+                escaped.append("\\n");
+                break;
+
+            case '"':
+                escaped.append(escapeQuotes ? "\\\"" : "\"");
+                break;
+
+            default:
+                escaped.append(character);
+                break;
+        }
+    }
+
+    return escaped;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates the label set of a sample
+ *
+ * \param   instance    Name of the plugin instance
+ * \param   extraLabel  Additional label (for example le="100"), optional
+ *
+ * \return  Label set (empty if there are no labels)
+ */
+static QByteArray labelSet(const QString &instance, const QByteArray &extraLabel = QByteArray())
+{
+    QByteArrayList labels;
+
+    if (!instance.isEmpty())
+    {
+        labels.append("instance=\"" + escape(instance, true) + '"');
+    }
+
+    if (!extraLabel.isEmpty())
+    {
+        labels.append(extraLabel);
+    }
+
+    return labels.isEmpty() ? QByteArray() : ('{' + labels.join(',') + '}');
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Counter::Counter()
+    : m_metric(nullptr)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Counter::Counter(Metric *metric)
+    : m_metric(metric)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MetricsRegistry::Counter::isValid() const
+{
+    return (m_metric != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::Counter::increment(const quint64 value) const
+{
+    if (m_metric != nullptr)
+    {
+        m_metric->counterShards[threadShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Gauge::Gauge()
+    : m_metric(nullptr)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Gauge::Gauge(Metric *metric)
+    : m_metric(metric)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MetricsRegistry::Gauge::isValid() const
+{
+    return (m_metric != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::Gauge::set(const qint64 value) const
+{
+    if (m_metric != nullptr)
+    {
+        m_metric->gaugeValue.store(value, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::Gauge::add(const qint64 value) const
+{
+    if (m_metric != nullptr)
+    {
+        m_metric->gaugeValue.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Histogram::Histogram()
+    : m_metric(nullptr)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Histogram::Histogram(Metric *metric)
+    : m_metric(metric)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MetricsRegistry::Histogram::isValid() const
+{
+    return (m_metric != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::Histogram::record(const quint64 value) const
+{
+    if (m_metric != nullptr)
+    {
+        auto &shard = m_metric->histogramShards[threadShard()];
+        shard.buckets[static_cast<size_t>(bucketIndex(value))].fetch_add(
+                    1U, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::Histogram::recordElapsed(const QElapsedTimer &timer) const
+{
+    if (m_metric != nullptr)
+    {
+        record(static_cast<quint64>(std::max<qint64>(timer.nsecsElapsed(), 0)));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 MetricsRegistry::MetricSnapshot::percentile(const double percentile) const
+{
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    const double clampedPercentile = std::max(0.0, std::min(percentile, 100.0));
+    const quint64 rank = std::max<quint64>(
+                             1U,
+                             static_cast<quint64>(std::ceil(clampedPercentile / 100.0 *
+                                                            static_cast<double>(count))));
+    quint64 accumulated = 0U;
+
+    for (const auto &bucket : buckets)
+    {
+        accumulated += bucket.second;
+
+        if (accumulated >= rank)
+        {
+            return bucket.first;
+        }
+    }
+
+    return buckets.empty() ? 0U : buckets.back().first;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry &MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::MetricsRegistry() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Counter MetricsRegistry::counter(const QString &name,
+                                                  const QString &instance,
+                                                  const QString &help)
+{
+    // Suffix is added by the OpenMetrics format
+    QString metricName = name;
+
+    if (metricName.endsWith(QStringLiteral("_total")))
+    {
+        metricName.chop(6);
+    }
+
+    return Counter(registerMetric(Type::Counter, metricName, instance, help));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Gauge MetricsRegistry::gauge(const QString &name,
+                                              const QString &instance,
+                                              const QString &help)
+{
+    return Gauge(registerMetric(Type::Gauge, name, instance, help));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Histogram MetricsRegistry::histogram(const QString &name,
+                                                      const QString &instance,
+                                                      const QString &help)
+{
+    return Histogram(registerMetric(Type::Histogram, name, instance, help));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MetricsRegistry::MetricSnapshot> MetricsRegistry::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+    std::vector<MetricSnapshot> snapshots;
+    snapshots.reserve(m_metrics.size());
+
+    for (const auto &item : m_metrics)
+    {
+        const Metric &metric = *item.second;
+
+        MetricSnapshot snapshot;
+        snapshot.type = metric.type;
+        snapshot.name = metric.name;
+        snapshot.help = metric.help;
+        snapshot.instance = metric.instance;
+
+        switch (metric.type)
+        {
+            case Type::Counter:
+            {
+                quint64 value = 0U;
+
+                for (const auto &shard : metric.counterShards)
+                {
+                    value += shard.value.load(std::memory_order_relaxed);
+                }
+
+                snapshot.value = static_cast<qint64>(value);
+                break;
+            }
+
+            case Type::Gauge:
+            {
+                snapshot.value = metric.gaugeValue.load(std::memory_order_relaxed);
+                break;
+            }
+
+            case Type::Histogram:
+            {
+                // Count is calculated from the buckets so that it always matches them
+                for (int i = 0; i < BucketCount; i++)
+                {
+                    quint64 bucketCount = 0U;
+
+                    for (int shard = 0; shard < ShardCount; shard++)
+                    {
+                        bucketCount += metric.histogramShards[shard]
+                                       .buckets[static_cast<size_t>(i)]
+                                       .load(std::memory_order_relaxed);
+                    }
+
+                    if (bucketCount > 0U)
+                    {
+                        snapshot.buckets.emplace_back(bucketUpperBound(i), bucketCount);
+                        snapshot.count += bucketCount;
+                    }
+                }
+
+                for (int shard = 0; shard < ShardCount; shard++)
+                {
+                    snapshot.sum += metric.histogramShards[shard].sum.load(
+                                        std::memory_order_relaxed);
+                }
+                break;
+            }
+        }
+
+        snapshots.push_back(std::move(snapshot));
+    }
+
+    return snapshots;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void MetricsRegistry::reset()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (auto &item : m_metrics)
+    {
+        item.second->reset();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QByteArray MetricsRegistry::toOpenMetrics(const std::vector<MetricSnapshot> &snapshots)
+{
+    QByteArray text;
+    QString lastName;
+
+    for (const auto &snapshot : snapshots)
+    {
+        const QByteArray name = snapshot.name.toUtf8();
+
+        // Metric family metadata is written only once for all plugin instances
+        if (snapshot.name != lastName)
+        {
+            static const char *const typeNames[] = { "counter", "gauge", "histogram" };
+
+            text.append("# TYPE " + name + ' ' + typeNames[static_cast<int>(snapshot.type)] + '\n');
+
+            if (!snapshot.help.isEmpty())
+            {
+                text.append("# HELP " + name + ' ' + escape(snapshot.help, false) + '\n');
+            }
+
+            lastName = snapshot.name;
+        }
+
+        switch (snapshot.type)
+        {
+            case Type::Counter:
+                text.append(name + "_total" + labelSet(snapshot.instance) + ' ' +
+                            QByteArray::number(snapshot.value) + '\n');
+                break;
+
+            case Type::Gauge:
+                text.append(name + labelSet(snapshot.instance) + ' ' +
+                            QByteArray::number(snapshot.value) + '\n');
+                break;
+
+            case Type::Histogram:
+            {
+                quint64 accumulated = 0U;
+
+                for (const auto &bucket : snapshot.buckets)
+                {
+                    accumulated += bucket.second;
+                    text.append(name + "_bucket" +
+                                labelSet(snapshot.instance,
+                                         "le=\"" + QByteArray::number(bucket.first) + '"') +
+                                ' ' + QByteArray::number(accumulated) + '\n');
+                }
+
+                text.append(name + "_bucket" + labelSet(snapshot.instance, "le=\"+Inf\"") + ' ' +
+                            QByteArray::number(snapshot.count) + '\n');
+                text.append(name + "_count" + labelSet(snapshot.instance) + ' ' +
+                            QByteArray::number(snapshot.count) + '\n');
+                text.append(name + "_sum" + labelSet(snapshot.instance) + ' ' +
+                            QByteArray::number(snapshot.sum) + '\n');
+                break;
+            }
+        }
+    }
+
+    text.append("# EOF\n");
+    return text;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MetricsRegistry::writeOpenMetrics(const std::vector<MetricSnapshot> &snapshots,
+                                       const QString &filePath)
+{
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to open the metrics file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(toOpenMetrics(snapshots));
+
+    if (!file.commit())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to write the metrics file:" << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool MetricsRegistry::sendOpenMetrics(const std::vector<MetricSnapshot> &snapshots,
+                                      const QString &socketPath)
+{
+#if defined(Q_OS_UNIX)
+    const QByteArray path = socketPath.toLocal8Bit();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.isEmpty() || (static_cast<size_t>(path.size()) >= sizeof(address.sun_path)))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Invalid metrics socket path:" << socketPath;
+        return false;
+    }
+
+    std::memcpy(address.sun_path, path.constData(), static_cast<size_t>(path.size()));
+
+    const int socketFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (socketFd < 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to create the metrics socket:" << std::strerror(errno);
+        return false;
+    }
+
+    if (::connect(socketFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to connect to the metrics socket:" << socketPath
+                << std::strerror(errno);
+        ::close(socketFd);
+        return false;
+    }
+
+#if defined(MSG_NOSIGNAL)
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+
+    const QByteArray text = toOpenMetrics(snapshots);
+    size_t written = 0U;
+    bool success = true;
+
+    while (written < static_cast<size_t>(text.size()))
+    {
+        const ssize_t result = ::send(socketFd,
+                                      text.constData() + written,
+                                      static_cast<size_t>(text.size()) - written,
+                                      flags);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                    << "Failed to write to the metrics socket:" << socketPath
+                    << std::strerror(errno);
+            success = false;
+            break;
+        }
+
+        written += static_cast<size_t>(result);
+    }
+
+    ::close(socketFd);
+    return success;
+#else
+    Q_UNUSED(snapshots)
+
+    qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+            << "Local metrics sockets are not supported on this platform:" << socketPath;
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 MetricsRegistry::bucketUpperBound(const int index)
+{
+    const int subBucketCount = 1 << SubBucketBits;
+
+    if (index < subBucketCount)
+    {
+        return static_cast<quint64>(std::max(index, 0));
+    }
+
+    const int shift = (index >> SubBucketBits) - 1;
+    const quint64 subBucket = static_cast<quint64>(index & (subBucketCount - 1));
+    const quint64 lowerBound = (static_cast<quint64>(subBucketCount) + subBucket) << shift;
+
+    return lowerBound + ((Q_UINT64_C(1) << shift) - 1U);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+MetricsRegistry::Metric *MetricsRegistry::registerMetric(const Type type,
+                                                         const QString &name,
+                                                         const QString &instance,
+                                                         const QString &help)
+{
+    if (!isValidName(name))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Invalid metric name:" << name;
+        return nullptr;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    // Metrics with the same name need to have the same type in all plugin instances
+    auto it = m_metrics.lower_bound(std::make_pair(name, QString()));
+
+    if ((it != m_metrics.end()) && (it->first.first == name) && (it->second->type != type))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Metric is already registered with a different type:" << name;
+        return nullptr;
+    }
+
+    auto &metric = m_metrics[std::make_pair(name, instance)];
+
+    if (!metric)
+    {
+        metric.reset(new Metric(type, name, instance, help));
+    }
+
+    return metric.get();
+}
+
+} // namespace CppPluginFramework
@@ -22,9 +22,12 @@
 #include <CppPluginFramework/Plugin.hpp>
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncLogBackend.hpp>
 #include <CppPluginFramework/IPluginFactory.hpp>
 #include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/MemoryAccounting.hpp>
 #include <CppPluginFramework/Validation.hpp>
+#include "Tracepoints.hpp"
 
 // Qt includes
 #include <QtCore/QPluginLoader>
@@ -41,23 +44,67 @@
 namespace CppPluginFramework
 {
 
-std::vector<std::unique_ptr<IPlugin>> Plugin::loadInstances(const PluginConfig &pluginConfig)
+std::vector<std::unique_ptr<IPlugin>> Plugin::loadInstances(
+        const PluginConfig &pluginConfig,
+        const PluginCatalog *pluginCatalog,
+        LifecycleTimings *timings,
+        const LatencyInjection *latencyInjection,
+        QPluginLoader *pluginLoader)
 {
     // Check plugin config
     if (!pluginConfig.isValid())
     {
-        qCWarning(CppPluginFramework::LoggingCategory::Plugin) << "Plugin config is not valid!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Plugin config is not valid!");
         return {};
     }
 
+    const QString filePath = resolveFilePath(pluginConfig, pluginCatalog);
+
+    if (filePath.isEmpty())
+    {
+        return {};
+    }
+
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(load_instances_begin, qUtf8Printable(filePath));
+
+    QPluginLoader localLoader;
+    auto instances = loadLibraryInstances(filePath,
+                                          pluginConfig,
+                                          timings,
+                                          latencyInjection,
+                                          (pluginLoader != nullptr) ? pluginLoader : &localLoader);
+
+    CPPPLUGINFRAMEWORK_TRACEPOINT2(load_instances_end,
+                                   qUtf8Printable(filePath),
+                                   static_cast<int>(instances.size()));
+    return instances;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<std::unique_ptr<IPlugin>> Plugin::loadLibraryInstances(
+        const QString &filePath,
+        const PluginConfig &pluginConfig,
+        LifecycleTimings *timings,
+        const LatencyInjection *latencyInjection,
+        QPluginLoader *pluginLoader)
+{
     // Load plugin from the library and extract the plugin factory interface from it
-    QPluginLoader loader(pluginConfig.filePath());
-    auto *loaderInstance = loader.instance();
+    QPluginLoader &loader = *pluginLoader;
+    loader.setFileName(filePath);
+    QObject *loaderInstance = nullptr;
+
+    {
+        LifecycleTimings::Scope scope(timings, LifecycleTimings::Phase::LibraryLoad, filePath);
+        loaderInstance = loader.instance();
+    }
 
     if (loaderInstance == nullptr)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                << "Failed to load plugin:" << loader.fileName();
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Failed to load plugin: %1",
+                                   loader.fileName());
         return {};
     }
 
@@ -65,34 +112,53 @@ std::vector<std::unique_ptr<IPlugin>> Plugin::loadInstances(const PluginConfig &
 
     if (pluginFactory == nullptr)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                << QString("Loaded plugin [%1] does not implement the plugin factory interface!")
-                   .arg(loader.fileName());
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Loaded plugin [%1] does not implement the plugin factory "
+                                   "interface!",
+                                   loader.fileName());
         return {};
     }
 
     // Create plugin instances
+    const VersionRange versionRequirement = pluginConfig.versionRequirement();
     std::vector<std::unique_ptr<IPlugin>> instances;
 
     for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
     {
         // Create plugin instance
-        auto instance = loadInstance(*pluginFactory, instanceConfig);
+        auto instance = loadInstance(*pluginFactory,
+                                     instanceConfig,
+                                     filePath,
+                                     timings,
+                                     latencyInjection);
 
         if (!instance)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                    << QString("Failed to load the plugin instance [%1] from the plugin [%2]!")
-                       .arg(instanceConfig.name(), loader.fileName());
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                       "Failed to load the plugin instance [%1] from the plugin "
+                                       "[%2]!",
+                                       instanceConfig.name(),
+                                       loader.fileName());
             return {};
         }
 
         // Check plugin's version
-        if (!checkVersion(instance->version(), pluginConfig))
+        bool versionMatches = false;
+
+        {
+            LifecycleTimings::Scope scope(timings,
+                                          LifecycleTimings::Phase::VersionCheck,
+                                          instanceConfig.name());
+            versionMatches = checkVersion(instance->version(), versionRequirement);
+        }
+
+        if (!versionMatches)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                    << QString("Plugin instance [%1] from the plugin [%2] has an unsupported "
-                               "version!").arg(instanceConfig.name(), loader.fileName());
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                       "Plugin instance [%1] from the plugin [%2] has an "
+                                       "unsupported version!",
+                                       instanceConfig.name(),
+                                       loader.fileName());
             return {};
         }
 
@@ -105,63 +171,115 @@ std::vector<std::unique_ptr<IPlugin>> Plugin::loadInstances(const PluginConfig &
 
 // -------------------------------------------------------------------------------------------------
 
-std::unique_ptr<IPlugin> Plugin::loadInstance(const IPluginFactory &pluginFactory,
-                                              const PluginInstanceConfig &instanceConfig)
+QString Plugin::resolveFilePath(const PluginConfig &pluginConfig,
+                                const PluginCatalog *pluginCatalog)
 {
-    // Create plugin instance
-    auto instance = pluginFactory.createInstance(instanceConfig.name());
+    if (pluginConfig.interface().isEmpty())
+    {
+        return pluginConfig.filePath();
+    }
 
-    if (!instance)
+    if (pluginCatalog == nullptr)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                << "Failed to create the plugin instance!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Plugin catalog is needed to find the plugin for the interface "
+                                   "[%1]!",
+                                   pluginConfig.interface());
         return {};
     }
 
-    // Configure the plugin instance
-    if (!instance->loadConfig(instanceConfig.config()))
+    const auto *entry = pluginCatalog->findBestMatch(pluginConfig.interface(),
+                                                     pluginConfig.versionRequirement());
+
+    if (entry == nullptr)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                << "Failed to load the plugin instance's configuration!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "No plugin in the plugin catalog exports the interface [%1] "
+                                   "with the version range [%2]!",
+                                   pluginConfig.interface(),
+                                   pluginConfig.versionRequirement().toString());
         return {};
     }
 
-    return instance;
+    return entry->filePath;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool Plugin::checkVersion(const VersionInfo &pluginVersion, const PluginConfig &pluginConfig)
+std::unique_ptr<IPlugin> Plugin::loadInstance(const IPluginFactory &pluginFactory,
+                                              const PluginInstanceConfig &instanceConfig,
+                                              const QString &filePath,
+                                              LifecycleTimings *timings,
+                                              const LatencyInjection *latencyInjection)
 {
-    if (pluginConfig.isExactVersion())
+    CPPPLUGINFRAMEWORK_TRACEPOINT2(load_instance_begin,
+                                   qUtf8Printable(instanceConfig.name()),
+                                   qUtf8Printable(filePath));
+
+    // Create plugin instance (allocations while creating and configuring it are attributed to it)
+    MemoryAccounting::Scope memoryScope(instanceConfig.name());
+    std::unique_ptr<IPlugin> instance;
+
     {
-        // Plugin's version must match the exact version
-        if (pluginVersion != pluginConfig.version())
-        {
-            qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                    << QString("Loaded plugin's version [%1] does not match the expected version "
-                               "[%2]!").arg(pluginVersion.toString(),
-                                            pluginConfig.version().toString());
-            return false;
-        }
+        LifecycleTimings::Scope scope(timings,
+                                      LifecycleTimings::Phase::CreateInstance,
+                                      instanceConfig.name());
+        instance = pluginFactory.createInstance(instanceConfig.name());
+    }
+
+    if (!instance)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Failed to create the plugin instance!");
     }
     else
     {
-        // Plugin's version must be within the version range
-        if (!VersionInfo::isVersionInRange(pluginVersion,
-                                           pluginConfig.minVersion(),
-                                           pluginConfig.maxVersion()))
+        // Configure the plugin instance
+        bool configLoaded = false;
+
+        {
+            LifecycleTimings::Scope scope(timings,
+                                          LifecycleTimings::Phase::LoadConfig,
+                                          instanceConfig.name());
+            if (latencyInjection != nullptr)
+            {
+                latencyInjection->inject(instanceConfig.name(),
+                                         LatencyInjection::Operation::LoadConfig);
+            }
+
+            configLoaded = instance->loadConfig(instanceConfig.config());
+        }
+
+        if (!configLoaded)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::Plugin)
-                    << QString("Loaded plugin's version [%1] does not match the expected version "
-                               "range: min=[%2], max=[%3]!")
-                       .arg(pluginVersion.toString(),
-                            pluginConfig.minVersion().toString(),
-                            pluginConfig.maxVersion().toString());
-            return false;
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                       "Failed to load the plugin instance's configuration!");
+            instance.reset();
         }
     }
 
+    CPPPLUGINFRAMEWORK_TRACEPOINT3(load_instance_end,
+                                   qUtf8Printable(instanceConfig.name()),
+                                   qUtf8Printable(filePath),
+                                   instance ? 1 : 0);
+    return instance;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Plugin::checkVersion(const VersionInfo &pluginVersion,
+                          const VersionRange &versionRequirement)
+{
+    if (!versionRequirement.matches(pluginVersion))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Loaded plugin's version [%1] does not match the expected "
+                                   "version range [%2]!",
+                                   pluginVersion.toString(),
+                                   versionRequirement.toString());
+        return false;
+    }
+
     return true;
 }
 
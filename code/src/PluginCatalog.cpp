@@ -0,0 +1,509 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds an index of the available plugin libraries
+ */
+
+// Own header
+#include <CppPluginFramework/PluginCatalog.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncLogBackend.hpp>
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/Validation.hpp>
+
+// Qt includes
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLibrary>
+#include <QtCore/QPluginLoader>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+//! Version of the cache file format
+static const int s_cacheFormatVersion = 1;
+
+//! Custom suffix of plugin libraries (see README)
+static const QString s_pluginSuffix = QStringLiteral("plugin");
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates the key of the file in the index
+ *
+ * \param   filePath    Path to the file
+ *
+ * \return  Canonical path of the file (so that symbolic links to the same library share one
+ *          entry) or the absolute path if the file does not exist
+ */
+static QString indexKey(const QString &filePath)
+{
+    const QFileInfo fileInfo(filePath);
+    const QString canonicalFilePath = fileInfo.canonicalFilePath();
+
+    return canonicalFilePath.isEmpty() ? fileInfo.absoluteFilePath() : canonicalFilePath;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginCatalog::loadCache(const QString &cacheFilePath)
+{
+    QFile file(cacheFilePath);
+
+    if (!file.exists())
+    {
+        // Nothing is cached yet
+        return true;
+    }
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Failed to open the plugin catalog cache: %1",
+                                   cacheFilePath);
+        return false;
+    }
+
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    const QJsonObject cache = document.object();
+
+    if (cache.value(QStringLiteral("format")).toInt() != s_cacheFormatVersion)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Unsupported plugin catalog cache format: %1",
+                                   cacheFilePath);
+        return false;
+    }
+
+    std::vector<Entry> entries;
+
+    for (const QJsonValue &item : cache.value(QStringLiteral("entries")).toArray())
+    {
+        const QJsonObject object = item.toObject();
+        Entry entry;
+
+        entry.filePath = object.value(QStringLiteral("file_path")).toString();
+        entry.lastModified =
+                static_cast<qint64>(object.value(QStringLiteral("last_modified")).toDouble());
+        entry.size = static_cast<qint64>(object.value(QStringLiteral("size")).toDouble());
+        entry.isPlugin = object.value(QStringLiteral("is_plugin")).toBool();
+
+        if (entry.filePath.isEmpty())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                       "Invalid entry in the plugin catalog cache: %1",
+                                       cacheFilePath);
+            return false;
+        }
+
+        if (entry.isPlugin)
+        {
+            entry.version = VersionInfo(object.value(QStringLiteral("version")).toString());
+            entry.description = object.value(QStringLiteral("description")).toString();
+            entry.factoryClassName =
+                    object.value(QStringLiteral("factory_class_name")).toString();
+
+            for (const QJsonValue &interface :
+                 object.value(QStringLiteral("exported_interfaces")).toArray())
+            {
+                entry.exportedInterfaces.append(interface.toString());
+            }
+
+            if (!entry.version.isValid())
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                           "Invalid plugin version in the plugin catalog cache: %1",
+                                           cacheFilePath);
+                return false;
+            }
+        }
+
+        entries.push_back(entry);
+    }
+
+    // Replace the index with the cached one
+    m_entries = std::move(entries);
+    m_entryIndexes.clear();
+
+    for (int i = 0; i < static_cast<int>(m_entries.size()); i++)
+    {
+        m_entryIndexes.insert(m_entries.at(i).filePath, i);
+    }
+
+    rebuildIndex();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginCatalog::storeCache(const QString &cacheFilePath) const
+{
+    QJsonArray entries;
+
+    for (const Entry &entry : m_entries)
+    {
+        QJsonObject object
+        {
+            { QStringLiteral("file_path"), entry.filePath },
+            { QStringLiteral("last_modified"), static_cast<double>(entry.lastModified) },
+            { QStringLiteral("size"), static_cast<double>(entry.size) },
+            { QStringLiteral("is_plugin"), entry.isPlugin }
+        };
+
+        if (entry.isPlugin)
+        {
+            object.insert(QStringLiteral("version"), entry.version.toString());
+            object.insert(QStringLiteral("description"), entry.description);
+            object.insert(QStringLiteral("factory_class_name"), entry.factoryClassName);
+            object.insert(QStringLiteral("exported_interfaces"),
+                          QJsonArray::fromStringList(entry.exportedInterfaces));
+        }
+
+        entries.append(object);
+    }
+
+    const QJsonObject cache
+    {
+        { QStringLiteral("format"), s_cacheFormatVersion },
+        { QStringLiteral("entries"), entries }
+    };
+
+    // Write the cache atomically so that a crash does not leave a corrupted cache behind
+    QSaveFile file(cacheFilePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Failed to open the plugin catalog cache for writing: %1",
+                                   cacheFilePath);
+        return false;
+    }
+
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Failed to write the plugin catalog cache: %1",
+                                   cacheFilePath);
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginCatalog::scan(const QStringList &directories, int *metadataReads)
+{
+    std::vector<Entry> entries;
+    QHash<QString, int> entryIndexes;
+    int reads = 0;
+
+    for (const QString &directory : directories)
+    {
+        const QDir dir(directory);
+
+        if (!dir.exists())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                       "Plugin directory does not exist: %1",
+                                       directory);
+            return false;
+        }
+
+        QDirIterator it(dir.absolutePath(), QDir::Files);
+
+        while (it.hasNext())
+        {
+            const QString filePath = indexKey(it.next());
+            const QFileInfo fileInfo(filePath);
+
+            // Only read the metadata of libraries
+            if ((!QLibrary::isLibrary(filePath)) && (fileInfo.suffix() != s_pluginSuffix))
+            {
+                continue;
+            }
+
+            // Skip libraries that were already indexed through another directory or link
+            if (entryIndexes.contains(filePath))
+            {
+                continue;
+            }
+
+            // Reuse the indexed entry if the file was not changed, otherwise read its metadata
+            Entry entry;
+            const auto cached = m_entryIndexes.constFind(filePath);
+
+            if ((cached != m_entryIndexes.constEnd()) &&
+                (m_entries.at(cached.value()).lastModified ==
+                 fileInfo.lastModified().toMSecsSinceEpoch()) &&
+                (m_entries.at(cached.value()).size == fileInfo.size()))
+            {
+                entry = m_entries.at(cached.value());
+            }
+            else
+            {
+                readMetadata(filePath, &entry);
+                reads++;
+            }
+
+            entryIndexes.insert(filePath, static_cast<int>(entries.size()));
+            entries.push_back(entry);
+        }
+    }
+
+    m_entries = std::move(entries);
+    m_entryIndexes = std::move(entryIndexes);
+    rebuildIndex();
+
+    if (metadataReads != nullptr)
+    {
+        *metadataReads = reads;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const PluginCatalog::Entry *PluginCatalog::findBestMatch(const QString &interface,
+                                                         const VersionRange &versionRange) const
+{
+    const auto it = m_interfaceIndex.constFind(interface);
+
+    if ((it == m_interfaceIndex.constEnd()) || (!versionRange.isValid()))
+    {
+        return nullptr;
+    }
+
+    const std::vector<IndexItem> &items = it.value();
+    const IndexItem *bestMatch = nullptr;
+
+    for (const auto &interval : versionRange.intervals())
+    {
+        // Find the first plugin library above the interval's upper bound
+        auto candidate = items.end();
+
+        if (!interval.upper.unbounded)
+        {
+            candidate = std::upper_bound(
+                            items.begin(),
+                            items.end(),
+                            interval.upper,
+                            [](const VersionRange::Bound &bound, const IndexItem &item)
+                            {
+                                const int result = VersionRange::compare(item.key,
+                                                                         item.dev,
+                                                                         bound.key,
+                                                                         bound.dev);
+                                return ((result > 0) || ((result == 0) && (!bound.inclusive)));
+                            });
+        }
+
+        // Find the highest version in the interval (walking down only skips excluded development
+        // versions)
+        while (candidate != items.begin())
+        {
+            --candidate;
+
+            const int result = VersionRange::compare(candidate->key,
+                                                     candidate->dev,
+                                                     interval.lower.key,
+                                                     interval.lower.dev);
+
+            if ((result < 0) || ((result == 0) && (!interval.lower.inclusive)))
+            {
+                // Below the interval
+                break;
+            }
+
+            if (VersionRange::isInInterval(candidate->key, candidate->dev, interval))
+            {
+                if ((bestMatch == nullptr) ||
+                    (VersionRange::compare(candidate->key,
+                                           candidate->dev,
+                                           bestMatch->key,
+                                           bestMatch->dev) > 0))
+                {
+                    bestMatch = &(*candidate);
+                }
+                break;
+            }
+        }
+    }
+
+    if (bestMatch == nullptr)
+    {
+        return nullptr;
+    }
+
+    return &m_entries.at(bestMatch->entryIndex);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const PluginCatalog::Entry *PluginCatalog::entry(const QString &filePath) const
+{
+    const auto it = m_entryIndexes.constFind(indexKey(filePath));
+
+    if (it == m_entryIndexes.constEnd())
+    {
+        return nullptr;
+    }
+
+    return &m_entries.at(it.value());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<PluginCatalog::Entry> PluginCatalog::plugins() const
+{
+    std::vector<Entry> plugins;
+
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.isPlugin)
+        {
+            plugins.push_back(entry);
+        }
+    }
+
+    return plugins;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginCatalog::readMetadata(const QString &filePath, Entry *entry)
+{
+    Q_ASSERT(entry != nullptr);
+
+    const QFileInfo fileInfo(filePath);
+
+    *entry = Entry();
+    entry->filePath = fileInfo.absoluteFilePath();
+    entry->lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    entry->size = fileInfo.size();
+
+    // Read the metadata (this does not load the library)
+    const QPluginLoader loader(entry->filePath);
+    const QJsonObject metaData = loader.metaData();
+
+    if (metaData.value(QStringLiteral("IID")).toString() !=
+        QStringLiteral("CppPluginFramework::IPluginFactory"))
+    {
+        // Not a plugin library
+        return false;
+    }
+
+    const QJsonObject pluginMetaData = metaData.value(QStringLiteral("MetaData")).toObject();
+    const VersionInfo version(pluginMetaData.value(QStringLiteral("version")).toString());
+    QSet<QString> exportedInterfaces;
+
+    for (const QJsonValue &interface :
+         pluginMetaData.value(QStringLiteral("exported_interfaces")).toArray())
+    {
+        exportedInterfaces.insert(interface.toString());
+    }
+
+    if ((!version.isValid()) || (!Validation::validateExportedInterfaces(exportedInterfaces)))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::Plugin,
+                                   "Plugin library does not provide valid metadata: %1",
+                                   entry->filePath);
+        return false;
+    }
+
+    entry->isPlugin = true;
+    entry->version = version;
+    entry->description = pluginMetaData.value(QStringLiteral("description")).toString();
+    entry->exportedInterfaces = exportedInterfaces.values();
+    entry->exportedInterfaces.sort();
+    entry->factoryClassName = metaData.value(QStringLiteral("className")).toString();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginCatalog::rebuildIndex()
+{
+    m_interfaceIndex.clear();
+
+    for (int i = 0; i < static_cast<int>(m_entries.size()); i++)
+    {
+        const Entry &entry = m_entries.at(i);
+
+        if (!entry.isPlugin)
+        {
+            continue;
+        }
+
+        const IndexItem item
+        {
+            VersionRange::packVersion(entry.version),
+            entry.version.dev(),
+            i
+        };
+
+        for (const QString &interface : entry.exportedInterfaces)
+        {
+            m_interfaceIndex[interface].push_back(item);
+        }
+    }
+
+    // Sort the plugin libraries by version (and then by file path to make the order deterministic)
+    for (auto &items : m_interfaceIndex)
+    {
+        std::sort(items.begin(),
+                  items.end(),
+                  [this](const IndexItem &left, const IndexItem &right)
+                  {
+                      const int result = VersionRange::compare(left.key,
+                                                               left.dev,
+                                                               right.key,
+                                                               right.dev);
+
+                      if (result != 0)
+                      {
+                          return (result < 0);
+                      }
+
+                      return (m_entries.at(left.entryIndex).filePath <
+                              m_entries.at(right.entryIndex).filePath);
+                  });
+    }
+}
+
+} // namespace CppPluginFramework
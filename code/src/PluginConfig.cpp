@@ -63,6 +63,17 @@ PluginConfig::PluginConfig(const QString &filePath,
 
 // -------------------------------------------------------------------------------------------------
 
+PluginConfig::PluginConfig(const QString &filePath,
+                           const VersionRange &versionRange,
+                           const QList<PluginInstanceConfig> &instanceConfigs)
+    : m_filePath(filePath),
+      m_versionRange(versionRange),
+      m_instanceConfigs(instanceConfigs)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool PluginConfig::isValid() const
 {
     return validateConfig().isEmpty();
@@ -72,14 +83,30 @@ bool PluginConfig::isValid() const
 
 bool PluginConfig::isExactVersion() const
 {
-    return ((!m_version.isNull()) && m_minVersion.isNull() && m_maxVersion.isNull());
+    return ((!m_version.isNull()) &&
+            m_minVersion.isNull() &&
+            m_maxVersion.isNull() &&
+            m_versionRange.isNull());
 }
 
 // -------------------------------------------------------------------------------------------------
 
 bool PluginConfig::isVersionRange() const
 {
-    return (m_version.isNull() && (!m_minVersion.isNull()) && (!m_maxVersion.isNull()));
+    return (m_version.isNull() &&
+            (!m_minVersion.isNull()) &&
+            (!m_maxVersion.isNull()) &&
+            m_versionRange.isNull());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginConfig::isVersionRangeExpression() const
+{
+    return (m_version.isNull() &&
+            m_minVersion.isNull() &&
+            m_maxVersion.isNull() &&
+            (!m_versionRange.isNull()));
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -98,6 +125,32 @@ void PluginConfig::setFilePath(const QString &filePath)
 
 // -------------------------------------------------------------------------------------------------
 
+QString PluginConfig::interface() const
+{
+    return m_interface;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginConfig::setInterface(const QString &interface)
+{
+    m_interface = interface;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString PluginConfig::displayName() const
+{
+    if (m_interface.isEmpty())
+    {
+        return m_filePath;
+    }
+
+    return QString("%1 [%2]").arg(m_interface, versionRequirement().toString());
+}
+
+// -------------------------------------------------------------------------------------------------
+
 VersionInfo PluginConfig::version() const
 {
     return m_version;
@@ -140,6 +193,42 @@ void PluginConfig::setMaxVersion(const VersionInfo &maxVersion)
 
 // -------------------------------------------------------------------------------------------------
 
+VersionRange PluginConfig::versionRange() const
+{
+    return m_versionRange;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginConfig::setVersionRange(const VersionRange &versionRange)
+{
+    m_versionRange = versionRange;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+VersionRange PluginConfig::versionRequirement() const
+{
+    if (isExactVersion())
+    {
+        return VersionRange(m_version);
+    }
+
+    if (isVersionRange())
+    {
+        return VersionRange(m_minVersion, m_maxVersion);
+    }
+
+    if (isVersionRangeExpression())
+    {
+        return m_versionRange;
+    }
+
+    return VersionRange();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 const QList<PluginInstanceConfig> &PluginConfig::instanceConfigs() const
 {
     return m_instanceConfigs;
@@ -157,13 +246,32 @@ void PluginConfig::setInstanceConfigs(const QList<PluginInstanceConfig> &instanc
 bool PluginConfig::loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config)
 {
     // Load file path
-    if (!loadRequiredConfigParameter(&m_filePath, QStringLiteral("file_path"), config))
+    m_filePath.clear();
+
+    if (!loadOptionalConfigParameter(&m_filePath, QStringLiteral("file_path"), config))
     {
         qCWarning(CppPluginFramework::LoggingCategory::Config)
                 << "Failed to load plugin's file path!";
         return false;
     }
 
+    // Load interface
+    m_interface.clear();
+
+    if (!loadOptionalConfigParameter(&m_interface, QStringLiteral("interface"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin's interface!";
+        return false;
+    }
+
+    if (m_filePath.isEmpty() && m_interface.isEmpty())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Either plugin's file path or interface needs to be set!";
+        return false;
+    }
+
     // Load version
     m_version = VersionInfo();
 
@@ -194,6 +302,16 @@ bool PluginConfig::loadConfigParameters(const CppConfigFramework::ConfigObjectNo
         return false;
     }
 
+    // Load version range expression
+    m_versionRange = VersionRange();
+
+    if (!loadOptionalConfigParameter(&m_versionRange, QStringLiteral("version_range"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin's version range!";
+        return false;
+    }
+
     // Load instance configs
     if (!loadRequiredConfigContainer(&m_instanceConfigs, QStringLiteral("instances"), config))
     {
@@ -218,10 +336,26 @@ bool PluginConfig::storeConfigParameters(CppConfigFramework::ConfigObjectNode *c
 
 QString PluginConfig::validateConfig() const
 {
-    // Check file path
-    if (!Validation::validateFilePath(m_filePath))
+    // Check file path or interface (the plugin's library is then looked up in the plugin catalog)
+    if (m_interface.isEmpty())
+    {
+        if (!Validation::validateFilePath(m_filePath))
+        {
+            return QStringLiteral("File path is not valid: ") % m_filePath;
+        }
+    }
+    else
     {
-        return QStringLiteral("File path is not valid: ") % m_filePath;
+        if (!m_filePath.isEmpty())
+        {
+            return QStringLiteral("Either just the file path or just the interface needs to be "
+                                  "set!");
+        }
+
+        if (!Validation::validateInterfaceName(m_interface))
+        {
+            return QStringLiteral("Interface is not valid: ") % m_interface;
+        }
     }
 
     // Check version info
@@ -239,10 +373,18 @@ QString PluginConfig::validateConfig() const
             return QStringLiteral("Version range is not valid");
         }
     }
+    else if (isVersionRangeExpression())
+    {
+        if (!m_versionRange.isValid())
+        {
+            return QStringLiteral("Version range expression is not valid: ") %
+                    m_versionRange.toString();
+        }
+    }
     else
     {
-        return QStringLiteral("Either just the version parameter needs to be set or "
-                              "both min and max version parameters!");
+        return QStringLiteral("Either just the version parameter needs to be set, both min and "
+                              "max version parameters or just the version range parameter!");
     }
 
     // At least one plugin instance is required
@@ -281,9 +423,11 @@ bool operator==(const CppPluginFramework::PluginConfig &left,
                 const CppPluginFramework::PluginConfig &right)
 {
     if ((left.filePath() != right.filePath()) ||
+        (left.interface() != right.interface()) ||
         (left.version() != right.version()) ||
         (left.minVersion() != right.minVersion()) ||
-        (left.maxVersion() != right.maxVersion()))
+        (left.maxVersion() != right.maxVersion()) ||
+        (left.versionRange() != right.versionRange()))
     {
         return false;
     }
@@ -29,6 +29,7 @@
 #include <QtCore/QStringBuilder>
 
 // System includes
+#include <vector>
 
 // Forward declarations
 
@@ -41,10 +42,12 @@ namespace CppPluginFramework
 
 PluginInstanceConfig::PluginInstanceConfig(const QString &name,
                                            const CppConfigFramework::ConfigObjectNode &config,
-                                           const QSet<QString> &dependencies)
+                                           const QSet<QString> &dependencies,
+                                           const QMap<QString, Cardinality> &requiredInterfaces)
     : m_name(name),
       m_config(std::move(config.clone()->toObject())),
-      m_dependencies(dependencies)
+      m_dependencies(dependencies),
+      m_requiredInterfaces(requiredInterfaces)
 {
 }
 
@@ -53,7 +56,10 @@ PluginInstanceConfig::PluginInstanceConfig(const QString &name,
 PluginInstanceConfig::PluginInstanceConfig(const PluginInstanceConfig &other)
     : m_name(other.m_name),
       m_config(std::move(other.m_config.clone()->toObject())),
-      m_dependencies(other.m_dependencies)
+      m_dependencies(other.m_dependencies),
+      m_requiredInterfaces(other.m_requiredInterfaces),
+      m_activation(other.m_activation),
+      m_idleTimeout(other.m_idleTimeout)
 {
 }
 
@@ -69,6 +75,9 @@ PluginInstanceConfig &PluginInstanceConfig::operator=(const PluginInstanceConfig
     m_name = other.m_name;
     m_config = std::move(other.m_config.clone()->toObject());
     m_dependencies = other.m_dependencies;
+    m_requiredInterfaces = other.m_requiredInterfaces;
+    m_activation = other.m_activation;
+    m_idleTimeout = other.m_idleTimeout;
     return *this;
 }
 
@@ -123,6 +132,49 @@ void PluginInstanceConfig::setDependencies(const QSet<QString> &dependencies)
 
 // -------------------------------------------------------------------------------------------------
 
+QMap<QString, PluginInstanceConfig::Cardinality> PluginInstanceConfig::requiredInterfaces() const
+{
+    return m_requiredInterfaces;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginInstanceConfig::setRequiredInterfaces(
+        const QMap<QString, Cardinality> &requiredInterfaces)
+{
+    m_requiredInterfaces = requiredInterfaces;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+PluginInstanceConfig::Activation PluginInstanceConfig::activation() const
+{
+    return m_activation;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginInstanceConfig::setActivation(const Activation activation)
+{
+    m_activation = activation;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int PluginInstanceConfig::idleTimeout() const
+{
+    return m_idleTimeout;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginInstanceConfig::setIdleTimeout(const int idleTimeout)
+{
+    m_idleTimeout = idleTimeout;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool PluginInstanceConfig::loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config)
 {
     // Load name
@@ -163,6 +215,93 @@ bool PluginInstanceConfig::loadConfigParameters(const CppConfigFramework::Config
         return false;
     }
 
+    // Load required interfaces
+    m_requiredInterfaces.clear();
+    const auto *requiredInterfacesMember = config.member(QStringLiteral("required_interfaces"));
+
+    if (requiredInterfacesMember != nullptr)
+    {
+        if (!requiredInterfacesMember->isObject())
+        {
+            qCWarning(CppPluginFramework::LoggingCategory::Config)
+                    << "Plugin instance's required interfaces are not an Object! Type:"
+                    << CppConfigFramework::ConfigNode::typeToString(
+                           requiredInterfacesMember->type());
+            return false;
+        }
+
+        const auto requiredInterfacesNode = requiredInterfacesMember->clone();
+
+        const std::vector<std::pair<QString, Cardinality>> cardinalities
+        {
+            { QStringLiteral("one"), Cardinality::One },
+            { QStringLiteral("all"), Cardinality::All },
+            { QStringLiteral("optional"), Cardinality::Optional }
+        };
+
+        for (const auto &item : cardinalities)
+        {
+            QSet<QString> interfaces;
+
+            if (!loadOptionalConfigParameter(&interfaces,
+                                             item.first,
+                                             requiredInterfacesNode->toObject()))
+            {
+                qCWarning(CppPluginFramework::LoggingCategory::Config)
+                        << "Failed to load plugin instance's required interfaces:" << item.first;
+                return false;
+            }
+
+            for (const QString &interface : qAsConst(interfaces))
+            {
+                if (m_requiredInterfaces.contains(interface))
+                {
+                    qCWarning(CppPluginFramework::LoggingCategory::Config)
+                            << "Plugin instance's required interface is listed more than once:"
+                            << interface;
+                    return false;
+                }
+
+                m_requiredInterfaces.insert(interface, item.second);
+            }
+        }
+    }
+
+    // Load activation
+    QString activation = QStringLiteral("eager");
+
+    if (!loadOptionalConfigParameter(&activation, QStringLiteral("activation"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin instance's activation!";
+        return false;
+    }
+
+    if (activation == QStringLiteral("eager"))
+    {
+        m_activation = Activation::Eager;
+    }
+    else if (activation == QStringLiteral("lazy"))
+    {
+        m_activation = Activation::Lazy;
+    }
+    else
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Plugin instance's activation is not supported:" << activation;
+        return false;
+    }
+
+    // Load idle timeout
+    m_idleTimeout = 0;
+
+    if (!loadOptionalConfigParameter(&m_idleTimeout, QStringLiteral("idle_timeout"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin instance's idle timeout!";
+        return false;
+    }
+
     return true;
 }
 
@@ -206,6 +345,27 @@ QString PluginInstanceConfig::validateConfig() const
         }
     }
 
+    // Check (optional) required interfaces
+    for (auto it = m_requiredInterfaces.cbegin(); it != m_requiredInterfaces.cend(); it++)
+    {
+        if (!Validation::validateInterfaceName(it.key()))
+        {
+            return QStringLiteral("Required interface's name is not valid: ") % it.key();
+        }
+    }
+
+    // Check idle timeout (only lazy plugin instances can be activated again after an eviction)
+    if (m_idleTimeout < 0)
+    {
+        return QStringLiteral("Idle timeout is negative: ") % QString::number(m_idleTimeout);
+    }
+
+    if ((m_idleTimeout > 0) && (m_activation != Activation::Lazy))
+    {
+        return QStringLiteral("Idle timeout is only supported for lazy plugin instances: ") %
+                m_name;
+    }
+
     return QString();
 }
 
@@ -218,7 +378,10 @@ bool operator==(const CppPluginFramework::PluginInstanceConfig &left,
 {
     return ((left.name() == right.name()) &&
             (left.config() == right.config()) &&
-            (left.dependencies() == right.dependencies()));
+            (left.dependencies() == right.dependencies()) &&
+            (left.requiredInterfaces() == right.requiredInterfaces()) &&
+            (left.activation() == right.activation()) &&
+            (left.idleTimeout() == right.idleTimeout()));
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -22,16 +22,32 @@
 #include <CppPluginFramework/PluginManager.hpp>
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncLogBackend.hpp>
 #include <CppPluginFramework/LoggingCategories.hpp>
 #include <CppPluginFramework/Plugin.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
 #include <CppPluginFramework/Validation.hpp>
+#include "Tracepoints.hpp"
 
 // Qt includes
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
 #include <QtCore/QLibrary>
+#include <QtCore/QPluginLoader>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
 #include <QtCore/QtDebug>
 
 // System includes
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <vector>
 
 // Forward declarations
 
@@ -42,134 +58,2347 @@
 namespace CppPluginFramework
 {
 
+//! Lifecycle metrics shared by all plugin managers
+struct ManagerMetrics
+{
+    //! Constructor (registers the metrics)
+    ManagerMetrics()
+    {
+        auto &registry = MetricsRegistry::instance();
+
+        loads = registry.counter("cppplugin_manager_loads",
+                                 QString(),
+                                 "Number of plugin manager loads");
+        loadFailures = registry.counter("cppplugin_manager_load_failures",
+                                        QString(),
+                                        "Number of failed plugin manager loads");
+        startFailures = registry.counter("cppplugin_manager_start_failures",
+                                         QString(),
+                                         "Number of failed plugin manager starts");
+        loadedInstances = registry.gauge("cppplugin_plugin_instances_loaded",
+                                         QString(),
+                                         "Number of loaded plugin instances");
+        startedInstances = registry.gauge("cppplugin_plugin_instances_started",
+                                          QString(),
+                                          "Number of started plugin instances");
+        loadDuration = registry.histogram("cppplugin_manager_load_duration_nanoseconds",
+                                          QString(),
+                                          "Durations of the plugin manager loads");
+    }
+
+    //! Holds the number of loads
+    MetricsRegistry::Counter loads;
+
+    //! Holds the number of failed loads
+    MetricsRegistry::Counter loadFailures;
+
+    //! Holds the number of failed starts
+    MetricsRegistry::Counter startFailures;
+
+    //! Holds the number of loaded plugin instances
+    MetricsRegistry::Gauge loadedInstances;
+
+    //! Holds the number of started plugin instances
+    MetricsRegistry::Gauge startedInstances;
+
+    //! Holds the load durations
+    MetricsRegistry::Histogram loadDuration;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the lifecycle metrics shared by all plugin managers
+ *
+ * \return  Lifecycle metrics
+ */
+static const ManagerMetrics &managerMetrics()
+{
+    static const ManagerMetrics metrics;
+    return metrics;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the histogram of the start durations of the plugin instance
+ *
+ * \param   instanceName    Plugin instance name
+ *
+ * \return  Histogram handle
+ */
+static MetricsRegistry::Histogram startDurationHistogram(const QString &instanceName)
+{
+    return MetricsRegistry::instance().histogram("cppplugin_plugin_start_duration_nanoseconds",
+                                                 instanceName,
+                                                 "Start durations of the plugin instances");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the histogram of the stop durations of the plugin instance
+ *
+ * \param   instanceName    Plugin instance name
+ *
+ * \return  Histogram handle
+ */
+static MetricsRegistry::Histogram stopDurationHistogram(const QString &instanceName)
+{
+    return MetricsRegistry::instance().histogram("cppplugin_plugin_stop_duration_nanoseconds",
+                                                 instanceName,
+                                                 "Stop durations of the plugin instances");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the current time of the monotonic clock
+ *
+ * \return  Time in milliseconds
+ */
+static qint64 monotonicTime()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer.msecsSinceReference();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+//! Lazy plugin instance
+struct PluginManager::LazyInstance
+{
+    //! Plugin config with only the config of the lazy plugin instance
+    PluginConfig pluginConfig;
+
+    //! Interfaces exported by the plugin instance (read from the plugin's metadata)
+    QStringList exportedInterfaces;
+
+    //! Resolved dependencies of the plugin instance
+    QStringList dependencies;
+
+    //! Idle timeout in milliseconds (0 if the plugin instance is never evicted)
+    int idleTimeout = 0;
+
+    //! Time of the last lookup in milliseconds (only tracked if the idle timeout is set)
+    std::atomic<qint64> lastAccessTime { 0 };
+
+    //! Plugin loader that keeps the library loaded while the plugin instance is activated
+    std::unique_ptr<QPluginLoader> pluginLoader;
+
+    //! Plugin instance (created by the activation)
+    std::unique_ptr<IPlugin> instance;
+
+    //! Plugin instance published after a successful activation
+    std::atomic<IPlugin *> activatedInstance { nullptr };
+
+    //! Flag that indicates that the activation was already attempted
+    bool activationAttempted = false;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! Aggregate readiness of the plugin instances started by the plugin manager
+struct PluginManager::ReadinessTracker
+{
+    //! Constructor
+    ReadinessTracker()
+        : future(promise.get_future().share())
+    {
+    }
+
+    /*!
+     * Resolves the aggregate readiness (only the first call has an effect)
+     *
+     * \param   ready   Flag that indicates that all plugin instances are ready
+     *
+     * \note    Caller needs to hold the mutex
+     */
+    void resolve(const bool ready)
+    {
+        if (!resolved)
+        {
+            resolved = true;
+            promise.set_value(ready);
+        }
+    }
+
+    /*!
+     * Handles the settled readiness of a plugin instance (called from any thread)
+     *
+     * \param   state   Settled readiness state
+     */
+    void settled(const Readiness::State state)
+    {
+        QMutexLocker locker(&mutex);
+        pendingCount--;
+        generation++;
+
+        if (state == Readiness::State::Failed)
+        {
+            resolve(false);
+        }
+        else if (allStarted && (pendingCount == 0))
+        {
+            resolve(true);
+        }
+
+        condition.wakeAll();
+    }
+
+    //! Enables thread-safe access to the aggregate readiness
+    QMutex mutex;
+
+    //! Wakes up the plugin manager when a readiness is settled
+    QWaitCondition condition;
+
+    //! Number of the settled readiness changes
+    quint64 generation = 0U;
+
+    //! Number of the started plugin instances that are not ready yet
+    int pendingCount = 0;
+
+    //! Flag that indicates that all plugin instances are started
+    bool allStarted = false;
+
+    //! Flag that indicates that the aggregate readiness is resolved
+    bool resolved = false;
+
+    //! Promise of the aggregate readiness
+    std::promise<bool> promise;
+
+    //! Future of the aggregate readiness
+    std::shared_future<bool> future;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! Executor of the asynchronous operations (executes the queued operations one after another)
+struct PluginManager::Executor
+{
+    //! Queued task
+    struct Task
+    {
+        //! Handle of the asynchronous operation
+        std::shared_ptr<AsyncOperation> operation;
+
+        //! Function that executes the operation
+        std::function<void()> function;
+    };
+
+    //! Constructor (starts the executor thread)
+    Executor()
+        : thread(&Executor::run, this)
+    {
+    }
+
+    //! Destructor (cancels the queued and running operations and waits for them to finish)
+    ~Executor()
+    {
+        {
+            QMutexLocker locker(&mutex);
+            stopRequested = true;
+
+            if (runningOperation)
+            {
+                runningOperation->cancel();
+            }
+
+            for (const auto &task : tasks)
+            {
+                task.operation->cancel();
+            }
+
+            condition.wakeAll();
+        }
+
+        thread.join();
+    }
+
+    /*!
+     * Queues a task
+     *
+     * \param   operation   Handle of the asynchronous operation
+     * \param   function    Function that executes the operation
+     */
+    void post(const std::shared_ptr<AsyncOperation> &operation,
+              const std::function<void()> &function)
+    {
+        QMutexLocker locker(&mutex);
+        tasks.push_back(Task { operation, function });
+        condition.wakeAll();
+    }
+
+    //! Executes the queued tasks in the executor thread (the queue is drained before it stops)
+    void run()
+    {
+        CpuAccounting::ThreadScope threadScope(QString(), QStringLiteral("cpf-executor"));
+
+        while (true)
+        {
+            Task task;
+
+            {
+                QMutexLocker locker(&mutex);
+
+                while (tasks.empty() && (!stopRequested))
+                {
+                    condition.wait(&mutex);
+                }
+
+                if (tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                runningOperation = task.operation;
+            }
+
+            task.function();
+
+            QMutexLocker locker(&mutex);
+            runningOperation.reset();
+        }
+    }
+
+    //! Enables thread-safe access to the queue
+    QMutex mutex;
+
+    //! Wakes up the executor thread when a task is queued or when it needs to stop
+    QWaitCondition condition;
+
+    //! Queued tasks
+    std::deque<Task> tasks;
+
+    //! Handle of the running operation
+    std::shared_ptr<AsyncOperation> runningOperation;
+
+    //! Flag that requests the executor thread to stop
+    bool stopRequested = false;
+
+    //! Executor thread (needs to be the last member so that it is started after the others)
+    std::thread thread;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! Task of a pool of worker threads that executes the specified function
+class FunctionTask : public QRunnable
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param   function    Function to execute
+     */
+    explicit FunctionTask(const std::function<void()> &function)
+        : m_function(function)
+    {
+    }
+
+    //! Executes the function
+    void run() override
+    {
+        m_function();
+    }
+
+private:
+    //! Holds the function to execute
+    std::function<void()> m_function;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! Interval of the cancellation checks while waiting for the readiness in milliseconds
+static constexpr unsigned long s_cancellationCheckInterval = 100UL;
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Gets the readiness state of the plugin instance
+ *
+ * \param   instance    Plugin instance
+ *
+ * \return  Readiness state (Pending if the plugin instance is not started)
+ */
+static Readiness::State instanceReadiness(const IPlugin &instance)
+{
+    if (!instance.isStarted())
+    {
+        return Readiness::State::Pending;
+    }
+
+    const auto readiness = instance.readiness();
+    return readiness ? readiness->state() : Readiness::State::Ready;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 PluginManager::~PluginManager()
 {
+    // Asynchronous operations are cancelled before the plugins are unloaded
+    m_executor.reset();
     unload();
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool PluginManager::load(const PluginManagerConfig &pluginManagerConfig)
+bool PluginManager::load(const PluginManagerConfig &pluginManagerConfig,
+                         const QString &startupProfile)
+{
+    TraceRecorder::Span span("lifecycle", "load");
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool success = loadPlugins(pluginManagerConfig, startupProfile);
+
+    const auto &metrics = managerMetrics();
+    metrics.loads.increment();
+    metrics.loadDuration.recordElapsed(timer);
+
+    if (!success)
+    {
+        metrics.loadFailures.increment();
+    }
+
+    refreshLiveStats();
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<AsyncOperation> PluginManager::post(
+        const AsyncOperation::ProgressObserver &progressObserver,
+        const std::function<bool()> &precondition,
+        const std::function<bool()> &operation,
+        const std::function<void()> &rollback)
+{
+    auto asyncOperation = std::make_shared<AsyncOperation>(progressObserver);
+
+    if (!m_executor)
+    {
+        m_executor.reset(new Executor);
+    }
+
+    m_executor->post(asyncOperation, [this, asyncOperation, precondition, operation, rollback]()
+    {
+        // Operation is not executed at all if it was cancelled while it was queued or if its
+        // precondition is not met
+        if (asyncOperation->isCancellationRequested() || (precondition && (!precondition())))
+        {
+            asyncOperation->finish(false);
+            return;
+        }
+
+        asyncOperation->setRunning();
+        m_runningOperation = asyncOperation;
+
+        const bool success = operation();
+
+        // Rollback is neither reported as progress nor cancelled
+        m_runningOperation.reset();
+
+        if ((!success) && rollback)
+        {
+            rollback();
+        }
+
+        asyncOperation->finish(success);
+    });
+
+    return asyncOperation;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::reportProgress(const QString &instanceName,
+                                   const int completedCount,
+                                   const int totalCount) const
+{
+    if (!m_runningOperation)
+    {
+        return;
+    }
+
+    AsyncOperation::Progress progress;
+    progress.instanceName = instanceName;
+    progress.completedCount = completedCount;
+    progress.totalCount = totalCount;
+
+    m_runningOperation->reportProgress(progress);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::isCancellationRequested() const
+{
+    return m_runningOperation && m_runningOperation->isCancellationRequested();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::loadPlugins(const PluginManagerConfig &pluginManagerConfig,
+                                const QString &startupProfile)
+{
+    // Check if plugins are already loaded
+    if ((!m_pluginInstances.empty()) || (!m_lazyInstances.empty()))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Plugins are already loaded!");
+        return false;
+    }
+
+    // Check if config is valid
+    bool configValid = false;
+
+    {
+        LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                      LifecycleTimings::Phase::ConfigValidation,
+                                      QString());
+        configValid = pluginManagerConfig.isValid();
+    }
+
+    if (!configValid)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Plugin manager config is not valid!");
+        return false;
+    }
+
+    m_readinessTimeout = pluginManagerConfig.readinessTimeout();
+
+    // Set up the latency injection (calls are delayed by the proxies of the instrumented edges)
+    m_latencyInjection.setConfigs(pluginManagerConfig.latencyInjectionConfigs());
+
+    for (const auto &latencyInjectionConfig : pluginManagerConfig.latencyInjectionConfigs())
+    {
+        ProxyRegistry::instance().setInjectedLatency(latencyInjectionConfig.instanceName(),
+                                                     latencyInjectionConfig.callDelay(),
+                                                     latencyInjectionConfig.jitter());
+    }
+
+    // Update plugin catalog
+    if (!updatePluginCatalog(pluginManagerConfig))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to update the plugin catalog!");
+        return false;
+    }
+
+    // Prune the plugin instances that are not needed by the startup profile
+    QList<PluginConfig> pluginConfigs = pluginManagerConfig.pluginConfigs();
+    QStringList startupPriorities = pluginManagerConfig.pluginStartupPriorities();
+
+    if (!startupProfile.isEmpty())
+    {
+        const StartupProfileConfig startupProfileConfig =
+                pluginManagerConfig.startupProfile(startupProfile);
+
+        if (!startupProfileConfig.isValid())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Startup profile [%1] is not defined!",
+                                       startupProfile);
+            return false;
+        }
+
+        pruneToStartupProfile(startupProfileConfig, &pluginConfigs, &startupPriorities);
+    }
+
+    // Load all plugin instances
+    int totalCount = 0;
+    int loadedCount = 0;
+
+    for (const auto &pluginConfig : qAsConst(pluginConfigs))
+    {
+        totalCount += pluginConfig.instanceConfigs().size();
+    }
+
+    for (const auto &pluginConfig : qAsConst(pluginConfigs))
+    {
+        if (isCancellationRequested())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Loading of plugins was cancelled!");
+            return false;
+        }
+
+        // Lazy plugin instances are only registered (the library is loaded only if it also has
+        // eager plugin instances)
+        QList<PluginInstanceConfig> eagerInstanceConfigs;
+        QList<PluginInstanceConfig> lazyInstanceConfigs;
+
+        for (const auto &instanceConfig : pluginConfig.instanceConfigs())
+        {
+            if (instanceConfig.activation() == PluginInstanceConfig::Activation::Lazy)
+            {
+                lazyInstanceConfigs.append(instanceConfig);
+            }
+            else
+            {
+                eagerInstanceConfigs.append(instanceConfig);
+            }
+        }
+
+        if (!lazyInstanceConfigs.isEmpty())
+        {
+            PluginConfig lazyPluginConfig = pluginConfig;
+            lazyPluginConfig.setInstanceConfigs(lazyInstanceConfigs);
+
+            if (!registerLazyInstances(lazyPluginConfig))
+            {
+                return false;
+            }
+
+            for (const auto &instanceConfig : qAsConst(lazyInstanceConfigs))
+            {
+                loadedCount++;
+                reportProgress(instanceConfig.name(), loadedCount, totalCount);
+            }
+        }
+
+        if (eagerInstanceConfigs.isEmpty())
+        {
+            continue;
+        }
+
+        PluginConfig eagerPluginConfig = pluginConfig;
+        eagerPluginConfig.setInstanceConfigs(eagerInstanceConfigs);
+
+        // Load plugin instances
+        auto instances = Plugin::loadInstances(eagerPluginConfig,
+                                               &m_pluginCatalog,
+                                               &m_lifecycleTimings,
+                                               &m_latencyInjection);
+
+        if (instances.empty())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to load plugin: %1",
+                                       pluginConfig.displayName());
+            return false;
+        }
+
+        const QString libraryPath =
+                QFileInfo(Plugin::resolveFilePath(pluginConfig, &m_pluginCatalog))
+                .canonicalFilePath();
+
+        // Store the loaded instances
+        for (auto &instance : instances)
+        {
+            // Make sure that an instance with the same name is not already in the container
+            if (hasPluginInstance(instance->name()))
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "A plugin instance with the same name [%1] was already "
+                                           "loaded!",
+                                           instance->name());
+                return false;
+            }
+
+            // Store the instance in the container
+            const QString instanceName = instance->name();
+            m_pluginLibraryPaths.insert(instanceName, libraryPath);
+            m_pluginInstances.emplace(instanceName, std::move(instance));
+            managerMetrics().loadedInstances.add(1);
+
+            loadedCount++;
+            reportProgress(instanceName, loadedCount, totalCount);
+        }
+    }
+
+    if (isCancellationRequested())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Loading of plugins was cancelled!");
+        return false;
+    }
+
+    // Resolve dependencies
+    buildInterfaceIndex();
+
+    std::map<QString, QStringList> resolvedDependencies;
+
+    if (!resolveDependencies(pluginConfigs, &resolvedDependencies))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to resolve dependencies!");
+        return false;
+    }
+
+    // Startup order (instances from startup priorities first, then all others in dependency order)
+    if (!buildDependencyGraph(resolvedDependencies, startupPriorities))
+    {
+        return false;
+    }
+
+    // Dependencies of the lazy plugin instances are injected when they are activated
+    for (auto &item : m_lazyInstances)
+    {
+        item.second->dependencies = resolvedDependencies[item.first];
+    }
+
+    // Inject dependencies
+    if (!injectAllDependencies(resolvedDependencies))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to inject dependencies!");
+        return false;
+    }
+
+    // Prepare plugin instances
+    if (!prepareAllInstances())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to prepare plugin instances!");
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::unload()
+{
+    TraceRecorder::Span span("lifecycle", "unload");
+
+    // Make sure that all plugins are stopped
+    stop();
+
+    // Make sure that all of their dependencies are ejected
+    if (!ejectDependencies())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to unload eject dependencies!");
+        return false;
+    }
+
+    m_dependencyProxies.clear();
+
+    // Unload all plugin instances
+    int totalCount = static_cast<int>(m_pluginInstances.size());
+    int unloadedCount = 0;
+
+    for (const auto &item : m_lazyInstances)
+    {
+        if (item.second->instance)
+        {
+            totalCount++;
+        }
+    }
+
+    for (auto &item : m_pluginInstances)
+    {
+        {
+            LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                          LifecycleTimings::Phase::Teardown,
+                                          item.first);
+            item.second.reset();
+        }
+
+        unloadedCount++;
+        reportProgress(item.first, unloadedCount, totalCount);
+    }
+
+    for (auto &item : m_lazyInstances)
+    {
+        if (item.second->instance)
+        {
+            {
+                LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                              LifecycleTimings::Phase::Teardown,
+                                              item.first);
+                item.second->instance.reset();
+            }
+
+            unloadedCount++;
+            reportProgress(item.first, unloadedCount, totalCount);
+        }
+    }
+
+    m_pluginStartupOrder.clear();
+    m_pluginShutdownOrder.clear();
+    m_startDurations.clear();
+    m_startTraceTimestamps.clear();
+    m_startTraceThreadIds.clear();
+    m_dependencyGraph = DependencyGraph();
+    m_interfaceProviders.clear();
+    m_pluginLibraryPaths.clear();
+
+    for (const auto &latencyInjectionConfig : m_latencyInjection.configs())
+    {
+        ProxyRegistry::instance().setInjectedLatency(latencyInjectionConfig.instanceName(), 0);
+    }
+
+    m_latencyInjection.clear();
+    managerMetrics().loadedInstances.add(-static_cast<qint64>(totalCount));
+    m_pluginInstances.clear();
+    m_lazyInstances.clear();
+    refreshLiveStats();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::start()
+{
+    TraceRecorder::Span span("lifecycle", "start");
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(manager_start_begin, m_pluginStartupOrder.size());
+
+    std::fill(m_startDurations.begin(), m_startDurations.end(), 0);
+    std::fill(m_startTraceTimestamps.begin(), m_startTraceTimestamps.end(), -1);
+
+    m_started = true;
+    m_readinessTracker.reset(new ReadinessTracker);
+    bool success = true;
+
+    // Collect the plugin instances to start (lazy plugin instances are started when activated)
+    std::vector<std::pair<QString, IPlugin *>> pendingInstances;
+    pendingInstances.reserve(static_cast<size_t>(m_pluginStartupOrder.size()));
+
+    for (const QString &instanceName : qAsConst(m_pluginStartupOrder))
+    {
+        auto *instance = activatedPluginInstance(instanceName);
+
+        // Check if plugin instance is loaded
+        if (instance == nullptr)
+        {
+            if (m_lazyInstances.find(instanceName) != m_lazyInstances.end())
+            {
+                continue;
+            }
+
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance is null: %1",
+                                       instanceName);
+            success = false;
+            break;
+        }
+
+        if (instance->isStarted())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance is already started: %1",
+                                       instanceName);
+            success = false;
+            break;
+        }
+
+        pendingInstances.emplace_back(instanceName, instance);
+    }
+
+    // Start plugin instances in the defined startup order, each one after its dependencies are
+    // ready (plugin instances with dependencies that are still warming up are skipped until then)
+    ReadinessTracker &readinessTracker = *m_readinessTracker;
+    const int totalCount = static_cast<int>(pendingInstances.size());
+    int startedCount = 0;
+
+    // Time since the readiness of a started plugin instance was last settled
+    QElapsedTimer readinessTimer;
+
+    while (success && (!pendingInstances.empty()))
+    {
+        readinessTimer.start();
+        quint64 generation = 0U;
+
+        {
+            QMutexLocker locker(&readinessTracker.mutex);
+            generation = readinessTracker.generation;
+        }
+
+        bool progress = false;
+        auto it = pendingInstances.begin();
+
+        while (it != pendingInstances.end())
+        {
+            if (isCancellationRequested())
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "Startup of plugins was cancelled!");
+                success = false;
+                break;
+            }
+
+            const Readiness::State readiness = dependenciesReadiness(it->first);
+
+            if (readiness == Readiness::State::Pending)
+            {
+                it++;
+                continue;
+            }
+
+            if (readiness == Readiness::State::Failed)
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "Dependencies of plugin instance [%1] failed to become "
+                                           "ready!",
+                                           it->first);
+                success = false;
+                break;
+            }
+
+            if (!startInstance(it->first, it->second))
+            {
+                success = false;
+                break;
+            }
+
+            startedCount++;
+            reportProgress(it->first, startedCount, totalCount);
+
+            it = pendingInstances.erase(it);
+            progress = true;
+        }
+
+        // Wait until the readiness of any of the started plugin instances is settled (or until the
+        // startup is cancelled or the readiness timeout expires)
+        if (success && (!progress))
+        {
+            QMutexLocker locker(&readinessTracker.mutex);
+
+            while ((readinessTracker.generation == generation) && (!isCancellationRequested()))
+            {
+                unsigned long waitTime = s_cancellationCheckInterval;
+
+                if (m_readinessTimeout > 0)
+                {
+                    const qint64 remainingTime = m_readinessTimeout - readinessTimer.elapsed();
+
+                    if (remainingTime <= 0)
+                    {
+                        success = false;
+                        break;
+                    }
+
+                    waitTime = std::min(waitTime, static_cast<unsigned long>(remainingTime));
+                }
+
+                readinessTracker.condition.wait(&readinessTracker.mutex, waitTime);
+            }
+
+            if (!success)
+            {
+                for (const auto &item : pendingInstances)
+                {
+                    CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                               "Dependencies of plugin instance [%1] did not "
+                                               "become ready within the readiness timeout!",
+                                               item.first);
+                }
+            }
+        }
+    }
+
+    {
+        QMutexLocker locker(&readinessTracker.mutex);
+        readinessTracker.allStarted = success;
+
+        if (!success)
+        {
+            readinessTracker.resolve(false);
+        }
+        else if (readinessTracker.pendingCount == 0)
+        {
+            readinessTracker.resolve(true);
+        }
+    }
+
+    if (!success)
+    {
+        managerMetrics().startFailures.increment();
+    }
+
+    publishLiveStatsMetrics();
+
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(manager_start_end, success ? 1 : 0);
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::stop()
+{
+    TraceRecorder::Span span("lifecycle", "stop");
+    CPPPLUGINFRAMEWORK_TRACEPOINT1(manager_stop_begin, m_pluginShutdownOrder.size());
+
+    m_started = false;
+
+    int totalCount = 0;
+    int stoppedCount = 0;
+
+    for (const QString &instanceName : qAsConst(m_pluginShutdownOrder))
+    {
+        const auto *instance = activatedPluginInstance(instanceName);
+
+        if ((instance != nullptr) && (instance->isStarted()))
+        {
+            totalCount++;
+        }
+    }
+
+    // Stop plugin instances in the reverse order as they were started
+    for (const QString &instanceName : qAsConst(m_pluginShutdownOrder))
+    {
+        auto *instance = activatedPluginInstance(instanceName);
+
+        // Stop plugin instance
+        if ((instance != nullptr) && (instance->isStarted()))
+        {
+            stopInstance(instanceName, instance);
+
+            stoppedCount++;
+            reportProgress(instanceName, stoppedCount, totalCount);
+        }
+    }
+
+    // Aggregate readiness fails if any plugin instance is stopped before it gets ready
+    if (m_readinessTracker)
+    {
+        QMutexLocker locker(&m_readinessTracker->mutex);
+        m_readinessTracker->resolve(false);
+    }
+
+    publishLiveStatsMetrics();
+    CPPPLUGINFRAMEWORK_TRACEPOINT0(manager_stop_end);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_future<bool> PluginManager::readyFuture() const
+{
+    if (!m_readinessTracker)
+    {
+        // Plugin manager was not started yet
+        std::promise<bool> promise;
+        promise.set_value(false);
+        return promise.get_future().share();
+    }
+
+    return m_readinessTracker->future;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<AsyncOperation> PluginManager::loadAsync(
+        const PluginManagerConfig &pluginManagerConfig,
+        const QString &startupProfile,
+        const AsyncOperation::ProgressObserver &progressObserver)
+{
+    return post(progressObserver,
+                [this]()
+                {
+                    if ((!m_pluginInstances.empty()) || (!m_lazyInstances.empty()))
+                    {
+                        CPPPLUGINFRAMEWORK_WARNING(
+                                    CppPluginFramework::LoggingCategory::PluginManager,
+                                    "Plugins are already loaded!");
+                        return false;
+                    }
+
+                    return true;
+                },
+                [this, pluginManagerConfig, startupProfile]()
+                {
+                    return load(pluginManagerConfig, startupProfile);
+                },
+                [this]()
+                {
+                    unload();
+                });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<AsyncOperation> PluginManager::unloadAsync(
+        const AsyncOperation::ProgressObserver &progressObserver)
+{
+    return post(progressObserver,
+                {},
+                [this]()
+                {
+                    return unload();
+                },
+                {});
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<AsyncOperation> PluginManager::startAsync(
+        const AsyncOperation::ProgressObserver &progressObserver)
+{
+    return post(progressObserver,
+                [this]()
+                {
+                    if (m_started)
+                    {
+                        CPPPLUGINFRAMEWORK_WARNING(
+                                    CppPluginFramework::LoggingCategory::PluginManager,
+                                    "Plugins are already started!");
+                        return false;
+                    }
+
+                    return true;
+                },
+                [this]()
+                {
+                    return start();
+                },
+                [this]()
+                {
+                    stop();
+                });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::shared_ptr<AsyncOperation> PluginManager::stopAsync(
+        const AsyncOperation::ProgressObserver &progressObserver)
+{
+    return post(progressObserver,
+                {},
+                [this]()
+                {
+                    stop();
+                    return true;
+                },
+                {});
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int PluginManager::evictIdleInstances()
+{
+    TraceRecorder::Span span("lifecycle", "evict");
+    QMutexLocker locker(&m_activationMutex);
+
+    const qint64 currentTime = monotonicTime();
+    int evictedCount = 0;
+
+    // Dependents are evicted before their dependencies
+    for (const QString &instanceName : qAsConst(m_pluginShutdownOrder))
+    {
+        auto it = m_lazyInstances.find(instanceName);
+
+        if (it == m_lazyInstances.end())
+        {
+            continue;
+        }
+
+        const LazyInstance &lazyInstance = *it->second;
+
+        if ((lazyInstance.idleTimeout <= 0) ||
+            (lazyInstance.activatedInstance.load(std::memory_order_relaxed) == nullptr))
+        {
+            continue;
+        }
+
+        const qint64 idleTime =
+                currentTime - lazyInstance.lastAccessTime.load(std::memory_order_relaxed);
+
+        if ((idleTime < lazyInstance.idleTimeout) || hasActivatedDependents(instanceName))
+        {
+            continue;
+        }
+
+        evictLazyInstance(instanceName);
+        evictedCount++;
+    }
+
+    if (evictedCount > 0)
+    {
+        publishLiveStatsMetrics();
+    }
+
+    return evictedCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::hasPluginInstance(const QString &instanceName) const
+{
+    return ((m_pluginInstances.find(instanceName) != m_pluginInstances.end()) ||
+            (m_lazyInstances.find(instanceName) != m_lazyInstances.end()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::isPluginInstanceActivated(const QString &instanceName) const
+{
+    return (activatedPluginInstance(instanceName) != nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+IPlugin *PluginManager::pluginInstance(const QString &instanceName)
+{
+    auto it = m_pluginInstances.find(instanceName);
+
+    if (it != m_pluginInstances.end())
+    {
+        return it->second.get();
+    }
+
+    auto lazyIt = m_lazyInstances.find(instanceName);
+
+    if (lazyIt == m_lazyInstances.end())
+    {
+        return nullptr;
+    }
+
+    LazyInstance &lazyInstance = *lazyIt->second;
+
+    if (lazyInstance.idleTimeout > 0)
+    {
+        lazyInstance.lastAccessTime.store(monotonicTime(), std::memory_order_relaxed);
+    }
+
+    auto *instance = lazyInstance.activatedInstance.load(std::memory_order_acquire);
+
+    if (instance != nullptr)
+    {
+        return instance;
+    }
+
+    // Dependencies are looked up and their readiness is awaited before the activation mutex is
+    // locked, so that a slow warm-up of a dependency does not block the other lookups
+    if (m_started)
+    {
+        const int timeout = (m_readinessTimeout > 0) ? m_readinessTimeout : -1;
+
+        for (const QString &dependencyName : qAsConst(lazyInstance.dependencies))
+        {
+            const auto *dependency = pluginInstance(dependencyName);
+            const auto readiness = (dependency != nullptr) ? dependency->readiness() : nullptr;
+
+            if (readiness && (readiness->wait(timeout) == Readiness::State::Pending))
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "Dependency [%1] of plugin instance [%2] did not "
+                                           "become ready within the readiness timeout!",
+                                           dependencyName,
+                                           instanceName);
+
+                // Activation fails (unless a concurrent lookup already finished it)
+                QMutexLocker locker(&m_activationMutex);
+                lazyInstance.activationAttempted = true;
+                return lazyInstance.activatedInstance.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Only the first lookup activates the plugin instance, concurrent lookups wait for it
+    QMutexLocker locker(&m_activationMutex);
+    return activateLazyInstance(instanceName);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList PluginManager::pluginInstanceNames() const
+{
+    QStringList instanceNames;
+
+    for (const auto &item : m_pluginInstances)
+    {
+        instanceNames.append(item.first);
+    }
+
+    if (!m_lazyInstances.empty())
+    {
+        for (const auto &item : m_lazyInstances)
+        {
+            instanceNames.append(item.first);
+        }
+
+        instanceNames.sort();
+    }
+
+    return instanceNames;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList PluginManager::interfaceProviders(const QString &interface) const
+{
+    return m_interfaceProviders.value(interface);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const DependencyGraph &PluginManager::dependencyGraph() const
+{
+    return m_dependencyGraph;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList PluginManager::pluginStartupOrder() const
+{
+    return m_pluginStartupOrder;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+StartupAnalysis PluginManager::startupAnalysis() const
+{
+    return StartupAnalysis(m_dependencyGraph, m_startDurations);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const LifecycleTimings &PluginManager::lifecycleTimings() const
+{
+    return m_lifecycleTimings;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::clearLifecycleTimings()
+{
+    m_lifecycleTimings.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MetricsRegistry::MetricSnapshot> PluginManager::metricsSnapshot() const
+{
+    auto snapshots = MetricsRegistry::instance().snapshot();
+
+    // Metrics of the plugin instances that are not loaded by this plugin manager are skipped
+    snapshots.erase(std::remove_if(snapshots.begin(),
+                                   snapshots.end(),
+                                   [this](const MetricsRegistry::MetricSnapshot &snapshot)
+                                   {
+                                       return ((!snapshot.instance.isEmpty()) &&
+                                               (!hasPluginInstance(snapshot.instance)));
+                                   }),
+                    snapshots.end());
+    return snapshots;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MemoryAccounting::AllocationStats> PluginManager::memoryAllocationStats() const
+{
+    auto stats = MemoryAccounting::allocationStats();
+
+    stats.erase(std::remove_if(stats.begin(),
+                               stats.end(),
+                               [this](const MemoryAccounting::AllocationStats &item)
+                               {
+                                   return !hasPluginInstance(item.instance);
+                               }),
+                stats.end());
+    return stats;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<MemoryAccounting::MappingStats> PluginManager::pluginLibraryMappings() const
+{
+    const QSet<QString> libraryPaths = m_pluginLibraryPaths.values().toSet();
+    auto mappings = MemoryAccounting::fileMappings();
+
+    mappings.erase(std::remove_if(mappings.begin(),
+                                  mappings.end(),
+                                  [&libraryPaths](const MemoryAccounting::MappingStats &item)
+                                  {
+                                      return !libraryPaths.contains(item.filePath);
+                                  }),
+                   mappings.end());
+    return mappings;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<CpuAccounting::CpuStats> PluginManager::cpuStats() const
+{
+    auto stats = CpuAccounting::instance().snapshot();
+
+    stats.erase(std::remove_if(stats.begin(),
+                               stats.end(),
+                               [this](const CpuAccounting::CpuStats &item)
+                               {
+                                   return !hasPluginInstance(item.instance);
+                               }),
+                stats.end());
+    return stats;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString PluginManager::pluginLibraryPath(const QString &instanceName) const
+{
+    return m_pluginLibraryPaths.value(instanceName);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::instrumentDependency(const QString &instanceName,
+                                         const QString &dependencyName)
+{
+    m_instrumentedDependencies.insert(qMakePair(instanceName, dependencyName));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::clearInstrumentedDependencies()
+{
+    m_instrumentedDependencies.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::vector<ProxyRegistry::CallStats> PluginManager::callStats() const
+{
+    std::vector<ProxyRegistry::CallStats> result;
+
+    for (const auto &stats : ProxyRegistry::instance().snapshot())
+    {
+        if (hasPluginInstance(stats.caller))
+        {
+            result.push_back(stats);
+        }
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::publishLiveStats(const QString &segmentName)
+{
+    const QString name = segmentName.isEmpty()
+                         ? LiveStats::defaultSegmentName(QCoreApplication::applicationPid())
+                         : segmentName;
+
+    m_liveStats.destroy();
+
+    if (!m_liveStats.create(name))
+    {
+        return false;
+    }
+
+    refreshLiveStats();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::unpublishLiveStats()
+{
+    m_liveStats.destroy();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::publishLiveStatsMetrics()
+{
+    if (m_liveStats.isCreated())
+    {
+        m_liveStats.setMetrics(metricsSnapshot());
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const PluginCatalog &PluginManager::pluginCatalog() const
+{
+    return m_pluginCatalog;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::updatePluginCatalog(const PluginManagerConfig &pluginManagerConfig)
+{
+    if (pluginManagerConfig.pluginDirectories().isEmpty())
+    {
+        // Plugin catalog is not used
+        return true;
+    }
+
+    const QString cacheFilePath = pluginManagerConfig.pluginCatalogCache();
+
+    // Load the cache only once, afterwards the catalog in memory is already up to date
+    if ((!cacheFilePath.isEmpty()) && m_pluginCatalog.plugins().empty())
+    {
+        if (!m_pluginCatalog.loadCache(cacheFilePath))
+        {
+            // A broken cache only means that all of the plugin metadata needs to be read again
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Ignoring the plugin catalog cache: %1",
+                                       cacheFilePath);
+        }
+    }
+
+    // Rescan the plugin directories (only new or changed libraries are read)
+    if (!m_pluginCatalog.scan(pluginManagerConfig.pluginDirectories()))
+    {
+        return false;
+    }
+
+    if (!cacheFilePath.isEmpty())
+    {
+        if (!m_pluginCatalog.storeCache(cacheFilePath))
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to store the plugin catalog cache: %1",
+                                       cacheFilePath);
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::pruneToStartupProfile(const StartupProfileConfig &startupProfile,
+                                          QList<PluginConfig> *pluginConfigs,
+                                          QStringList *startupPriorities) const
+{
+    // Index the plugin instance configs
+    std::map<QString, PluginInstanceConfig> instanceConfigs;
+    bool interfacesRequired = false;
+
+    for (const PluginConfig &pluginConfig : qAsConst(*pluginConfigs))
+    {
+        for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+        {
+            instanceConfigs.emplace(instanceConfig.name(), instanceConfig);
+
+            if (!instanceConfig.requiredInterfaces().isEmpty())
+            {
+                interfacesRequired = true;
+            }
+        }
+    }
+
+    // Providers of the interfaces are needed only if any plugin instance requires an interface
+    QHash<QString, QStringList> interfaceProviders;
+
+    if (interfacesRequired)
+    {
+        for (const PluginConfig &pluginConfig : qAsConst(*pluginConfigs))
+        {
+            const QString filePath = Plugin::resolveFilePath(pluginConfig, &m_pluginCatalog);
+            PluginCatalog::Entry entry;
+
+            if (filePath.isEmpty() || (!PluginCatalog::readMetadata(filePath, &entry)))
+            {
+                // Plugins that are not deployed are fine as long as the profile does not need them
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "Failed to read the metadata of the plugin: %1",
+                                           filePath.isEmpty() ? pluginConfig.displayName()
+                                                              : filePath);
+                continue;
+            }
+
+            for (const QString &interface : qAsConst(entry.exportedInterfaces))
+            {
+                for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+                {
+                    interfaceProviders[interface].append(instanceConfig.name());
+                }
+            }
+        }
+    }
+
+    // Collect the root plugin instances and their transitive dependencies
+    QSet<QString> reachableInstances;
+    QStringList pendingInstances = startupProfile.rootInstances();
+
+    while (!pendingInstances.isEmpty())
+    {
+        const QString instanceName = pendingInstances.takeLast();
+
+        if (reachableInstances.contains(instanceName))
+        {
+            continue;
+        }
+
+        const auto instanceIt = instanceConfigs.find(instanceName);
+
+        if (instanceIt == instanceConfigs.end())
+        {
+            // Missing dependencies are reported by the dependency resolution
+            continue;
+        }
+
+        reachableInstances.insert(instanceName);
+
+        const PluginInstanceConfig &instanceConfig = instanceIt->second;
+        pendingInstances.append(instanceConfig.dependencies().values());
+
+        const auto requiredInterfaces = instanceConfig.requiredInterfaces();
+
+        for (auto it = requiredInterfaces.cbegin(); it != requiredInterfaces.cend(); it++)
+        {
+            pendingInstances.append(interfaceProviders.value(it.key()));
+        }
+    }
+
+    // Remove the unreachable plugin instances and the plugins that are left without any
+    QList<PluginConfig> prunedPluginConfigs;
+
+    for (const PluginConfig &pluginConfig : qAsConst(*pluginConfigs))
+    {
+        QList<PluginInstanceConfig> prunedInstanceConfigs;
+
+        for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+        {
+            if (reachableInstances.contains(instanceConfig.name()))
+            {
+                prunedInstanceConfigs.append(instanceConfig);
+            }
+        }
+
+        if (!prunedInstanceConfigs.isEmpty())
+        {
+            PluginConfig prunedPluginConfig = pluginConfig;
+            prunedPluginConfig.setInstanceConfigs(prunedInstanceConfigs);
+            prunedPluginConfigs.append(prunedPluginConfig);
+        }
+    }
+
+    QStringList prunedStartupPriorities;
+
+    for (const QString &instanceName : qAsConst(*startupPriorities))
+    {
+        if (reachableInstances.contains(instanceName))
+        {
+            prunedStartupPriorities.append(instanceName);
+        }
+    }
+
+    *pluginConfigs = prunedPluginConfigs;
+    *startupPriorities = prunedStartupPriorities;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::registerLazyInstances(const PluginConfig &pluginConfig)
+{
+    const QString filePath = Plugin::resolveFilePath(pluginConfig, &m_pluginCatalog);
+
+    if (filePath.isEmpty())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to resolve the plugin of the lazy plugin instances!");
+        return false;
+    }
+
+    // Exported interfaces are needed for the dependency resolution before the library is loaded
+    PluginCatalog::Entry entry;
+
+    if (!PluginCatalog::readMetadata(filePath, &entry))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to read the metadata of the plugin: %1",
+                                   filePath);
+        return false;
+    }
+
+    if (!pluginConfig.versionRequirement().matches(entry.version))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Plugin [%1] has an unsupported version: %2",
+                                   filePath,
+                                   entry.version.toString());
+        return false;
+    }
+
+    const QString libraryPath = QFileInfo(filePath).canonicalFilePath();
+
+    for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+    {
+        if (hasPluginInstance(instanceConfig.name()))
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "A plugin instance with the same name [%1] was already "
+                                       "loaded!",
+                                       instanceConfig.name());
+            return false;
+        }
+
+        std::unique_ptr<LazyInstance> lazyInstance(new LazyInstance);
+        lazyInstance->pluginConfig = pluginConfig;
+        lazyInstance->pluginConfig.setInstanceConfigs({ instanceConfig });
+        lazyInstance->exportedInterfaces = entry.exportedInterfaces;
+        lazyInstance->idleTimeout = instanceConfig.idleTimeout();
+
+        m_pluginLibraryPaths.insert(instanceConfig.name(), libraryPath);
+        m_lazyInstances.emplace(instanceConfig.name(), std::move(lazyInstance));
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+IPlugin *PluginManager::activatedPluginInstance(const QString &instanceName) const
+{
+    auto it = m_pluginInstances.find(instanceName);
+
+    if (it != m_pluginInstances.end())
+    {
+        return it->second.get();
+    }
+
+    auto lazyIt = m_lazyInstances.find(instanceName);
+
+    if (lazyIt == m_lazyInstances.end())
+    {
+        return nullptr;
+    }
+
+    return lazyIt->second->activatedInstance.load(std::memory_order_acquire);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+IPlugin *PluginManager::activateLazyInstance(const QString &instanceName)
+{
+    auto it = m_lazyInstances.find(instanceName);
+
+    if (it == m_lazyInstances.end())
+    {
+        return nullptr;
+    }
+
+    LazyInstance &lazyInstance = *it->second;
+
+    // Activation is attempted only once (another lookup might have finished it in the meantime)
+    if (lazyInstance.activationAttempted)
+    {
+        return lazyInstance.activatedInstance.load(std::memory_order_relaxed);
+    }
+
+    lazyInstance.activationAttempted = true;
+    TraceRecorder::Span span("lifecycle", "activate", instanceName);
+
+    // Activate the lazy dependencies first
+    for (const QString &dependencyName : qAsConst(lazyInstance.dependencies))
+    {
+        if ((m_lazyInstances.find(dependencyName) != m_lazyInstances.end()) &&
+            (activateLazyInstance(dependencyName) == nullptr))
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to activate dependency [%1] of plugin instance "
+                                       "[%2]!",
+                                       dependencyName,
+                                       instanceName);
+            return nullptr;
+        }
+    }
+
+    // Create and configure the plugin instance (with its own plugin loader so that the library can
+    // be unloaded when the plugin instance is evicted)
+    lazyInstance.pluginLoader.reset(new QPluginLoader);
+
+    auto instances = Plugin::loadInstances(lazyInstance.pluginConfig,
+                                           &m_pluginCatalog,
+                                           &m_lifecycleTimings,
+                                           &m_latencyInjection,
+                                           lazyInstance.pluginLoader.get());
+
+    if (instances.size() != 1U)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to activate plugin instance: %1",
+                                   instanceName);
+        releaseLazyInstance(instanceName);
+        return nullptr;
+    }
+
+    lazyInstance.instance = std::move(instances.front());
+    managerMetrics().loadedInstances.add(1);
+
+    auto *instance = lazyInstance.instance.get();
+
+    if ((!lazyInstance.dependencies.isEmpty()) &&
+        (!injectDependencies(instance, lazyInstance.dependencies)))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to inject dependencies to plugin instance: %1",
+                                   instanceName);
+        releaseLazyInstance(instanceName);
+        return nullptr;
+    }
+
+    bool prepared = false;
+
+    {
+        LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                      LifecycleTimings::Phase::Prepare,
+                                      instanceName);
+        MemoryAccounting::Scope memoryScope(instanceName);
+        prepared = instance->prepare();
+    }
+
+    if (!prepared)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to prepare plugin instance: %1",
+                                   instanceName);
+        releaseLazyInstance(instanceName);
+        return nullptr;
+    }
+
+    if (m_started)
+    {
+        // Dependencies need to be ready before the plugin instance is started (their readiness is
+        // awaited by pluginInstance() while the activation mutex is not locked)
+        if (dependenciesReadiness(instanceName) != Readiness::State::Ready)
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Dependencies of plugin instance [%1] are not ready!",
+                                       instanceName);
+            releaseLazyInstance(instanceName);
+            return nullptr;
+        }
+
+        if (!startInstance(instanceName, instance))
+        {
+            releaseLazyInstance(instanceName);
+            return nullptr;
+        }
+    }
+
+    // Publish the plugin instance only after it is fully activated
+    lazyInstance.lastAccessTime.store(monotonicTime(), std::memory_order_relaxed);
+    lazyInstance.activatedInstance.store(instance, std::memory_order_release);
+    return instance;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::hasActivatedDependents(const QString &instanceName) const
+{
+    const int nodeId = m_dependencyGraph.nodeId(instanceName);
+
+    if (nodeId < 0)
+    {
+        return false;
+    }
+
+    for (int dependent : m_dependencyGraph.dependents(nodeId))
+    {
+        if (activatedPluginInstance(m_dependencyGraph.nodeName(dependent)) != nullptr)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::evictLazyInstance(const QString &instanceName)
+{
+    LazyInstance &lazyInstance = *m_lazyInstances.at(instanceName);
+    auto *instance = lazyInstance.instance.get();
+
+    // Withdraw the plugin instance first so that the next lookup activates it again
+    lazyInstance.activatedInstance.store(nullptr, std::memory_order_release);
+    lazyInstance.activationAttempted = false;
+
+    if (instance->isStarted())
+    {
+        stopInstance(instanceName, instance);
+    }
+
+    releaseLazyInstance(instanceName);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::releaseLazyInstance(const QString &instanceName)
+{
+    LazyInstance &lazyInstance = *m_lazyInstances.at(instanceName);
+    auto *instance = lazyInstance.instance.get();
+
+    if (instance == nullptr)
+    {
+        // Creation of the plugin instance failed, only the library needs to be released
+        if (lazyInstance.pluginLoader)
+        {
+            lazyInstance.pluginLoader->unload();
+            lazyInstance.pluginLoader.reset();
+        }
+
+        return;
+    }
+
+    instance->ejectDependencies();
+
+    // Proxies that were created for the injections into or of the plugin instance are not used
+    const auto isUnusedProxy = [&instanceName, instance](const std::unique_ptr<IPlugin> &item)
+    {
+        const auto *proxy = dynamic_cast<const ProxyPlugin *>(item.get());
+
+        return ((proxy != nullptr) &&
+                ((proxy->callerName() == instanceName) || (proxy->targetPlugin() == instance)));
+    };
+
+    m_dependencyProxies.erase(std::remove_if(m_dependencyProxies.begin(),
+                                             m_dependencyProxies.end(),
+                                             isUnusedProxy),
+                              m_dependencyProxies.end());
+
+    {
+        LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                      LifecycleTimings::Phase::Teardown,
+                                      instanceName);
+        lazyInstance.instance.reset();
+    }
+
+    managerMetrics().loadedInstances.add(-1);
+
+    // Library stays loaded while other plugin loaders (plugin instances) still use it
+    lazyInstance.pluginLoader->unload();
+    lazyInstance.pluginLoader.reset();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManager::buildInterfaceIndex()
+{
+    m_interfaceProviders.clear();
+
+    // Plugin instances are iterated in order of their names so the provider lists are sorted
+    for (const auto &item : m_pluginInstances)
+    {
+        for (const QString &interface : item.second->exportedInterfaces())
+        {
+            m_interfaceProviders[interface].append(item.first);
+        }
+    }
+
+    if (m_lazyInstances.empty())
+    {
+        return;
+    }
+
+    for (const auto &item : m_lazyInstances)
+    {
+        for (const QString &interface : qAsConst(item.second->exportedInterfaces))
+        {
+            m_interfaceProviders[interface].append(item.first);
+        }
+    }
+
+    for (auto &providers : m_interfaceProviders)
+    {
+        providers.sort();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::resolveDependencies(
+        const QList<PluginConfig> &pluginConfigs,
+        std::map<QString, QStringList> *resolvedDependencies) const
+{
+    bool success = true;
+
+    // Iterate over all plugin configs
+    for (const PluginConfig &pluginConfig : pluginConfigs)
+    {
+        // Iterate over all plugin instance configs
+        for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+        {
+            const QString instanceName = instanceConfig.name();
+            const QSet<QString> explicitDependencies = instanceConfig.dependencies();
+
+            QSet<QString> dependencySet;
+            QStringList dependencies;
+
+            // Explicit dependencies
+            for (const QString &dependencyName : explicitDependencies)
+            {
+                if (!hasPluginInstance(dependencyName))
+                {
+                    CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                               "Dependency [%1] of plugin instance [%2] was not "
+                                               "found!",
+                                               dependencyName,
+                                               instanceName);
+                    success = false;
+                    continue;
+                }
+
+                dependencySet.insert(dependencyName);
+                dependencies.append(dependencyName);
+            }
+
+            // Providers of the required interfaces
+            const auto requiredInterfaces = instanceConfig.requiredInterfaces();
+
+            for (auto it = requiredInterfaces.cbegin(); it != requiredInterfaces.cend(); it++)
+            {
+                const QString &interface = it.key();
+                const auto cardinality = it.value();
+
+                QStringList providers;
+
+                for (const QString &provider : m_interfaceProviders.value(interface))
+                {
+                    // A plugin instance cannot depend on itself
+                    if (provider != instanceName)
+                    {
+                        providers.append(provider);
+                    }
+                }
+
+                if (providers.isEmpty() &&
+                    (cardinality != PluginInstanceConfig::Cardinality::Optional))
+                {
+                    CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                               "No provider of the interface [%1] required by "
+                                               "plugin instance [%2] was found!",
+                                               interface,
+                                               instanceName);
+                    success = false;
+                    continue;
+                }
+
+                if ((providers.size() > 1) &&
+                    (cardinality != PluginInstanceConfig::Cardinality::All))
+                {
+                    CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                               "The interface [%1] required by plugin instance "
+                                               "[%2] is ambiguous, it is exported by: %3",
+                                               interface,
+                                               instanceName,
+                                               providers.join(", "));
+                    success = false;
+                    continue;
+                }
+
+                for (const QString &provider : qAsConst(providers))
+                {
+                    if (!dependencySet.contains(provider))
+                    {
+                        dependencySet.insert(provider);
+                        dependencies.append(provider);
+                    }
+                }
+            }
+
+            (*resolvedDependencies)[instanceName] = dependencies;
+        }
+    }
+
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::buildDependencyGraph(
+        const std::map<QString, QStringList> &resolvedDependencies,
+        const QStringList &startupPriorities)
 {
-    // Check if plugins are already loaded
-    if (!m_pluginInstances.empty())
+    QString error;
+
+    if (!DependencyGraph::fromDependencies(resolvedDependencies, &m_dependencyGraph, &error))
     {
-        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                << "Plugins are already loaded!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "%1",
+                                   error);
         return false;
     }
 
-    // Check if config is valid
-    if (!pluginManagerConfig.isValid())
+    const auto cycles = m_dependencyGraph.cycles();
+
+    if (!cycles.empty())
     {
-        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                << "Plugin manager config is not valid!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Plugin instance dependencies contain cycles: %1",
+                                   m_dependencyGraph.cyclesToString(cycles));
         return false;
     }
 
-    // Load all plugin instances
-    for (const auto &pluginConfig : pluginManagerConfig.pluginConfigs())
+    std::vector<int> priorities;
+    priorities.reserve(static_cast<size_t>(startupPriorities.size()));
+
+    for (const QString &instanceName : startupPriorities)
     {
-        // Load plugin instances
-        auto instances = Plugin::loadInstances(pluginConfig);
+        priorities.push_back(m_dependencyGraph.nodeId(instanceName));
+    }
 
-        if (instances.empty())
+    std::vector<int> startupOrder;
+
+    if (!m_dependencyGraph.startupOrder(priorities, &startupOrder))
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to create the startup order!");
+        return false;
+    }
+
+    m_pluginStartupOrder.clear();
+    m_pluginShutdownOrder.clear();
+    m_startDurations.assign(static_cast<size_t>(m_dependencyGraph.nodeCount()), 0);
+    m_startTraceTimestamps.assign(static_cast<size_t>(m_dependencyGraph.nodeCount()), -1);
+    m_startTraceThreadIds.assign(static_cast<size_t>(m_dependencyGraph.nodeCount()), 0);
+
+    for (int nodeId : startupOrder)
+    {
+        m_pluginStartupOrder.append(m_dependencyGraph.nodeName(nodeId));
+        m_pluginShutdownOrder.prepend(m_dependencyGraph.nodeName(nodeId));
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool PluginManager::prepareAllInstances()
+{
+    //! Preparation of a plugin instance
+    struct Preparation
+    {
+        //! Name of the plugin instance
+        QString instanceName;
+
+        //! Plugin instance
+        IPlugin *instance = nullptr;
+
+        //! Preparation duration in nanoseconds
+        qint64 duration = 0;
+
+        //! Flag that indicates that the preparation was executed (it is skipped after cancellation)
+        bool executed = false;
+
+        //! Result of the preparation
+        bool prepared = false;
+
+        //! Flag that indicates that the preparation threw an exception
+        bool exceptionThrown = false;
+    };
+
+    // Lazy plugin instances are prepared when they are activated
+    std::vector<Preparation> preparations;
+    preparations.reserve(m_pluginInstances.size());
+
+    for (const auto &item : m_pluginInstances)
+    {
+        Preparation preparation;
+        preparation.instanceName = item.first;
+        preparation.instance = item.second.get();
+        preparations.push_back(preparation);
+    }
+
+    if (preparations.empty())
+    {
+        return true;
+    }
+
+    // Workers take the next plugin instance until all of them are prepared or until the loading is
+    // cancelled (lifecycle timings are not thread-safe so the workers only store the durations)
+    std::atomic<size_t> nextIndex(0U);
+    const bool traceEnabled = TraceRecorder::isEnabled();
+    const auto runningOperation = m_runningOperation;
+
+    auto prepareInstance = [traceEnabled](Preparation &preparation)
+    {
+        const qint64 traceTimestamp = traceEnabled ? TraceRecorder::timestamp() : -1;
+        QElapsedTimer timer;
+        timer.start();
+
+        try
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Failed to load plugin:" << pluginConfig.filePath();
-            return false;
+            MemoryAccounting::Scope memoryScope(preparation.instanceName);
+            preparation.prepared = preparation.instance->prepare();
+        }
+        catch (...)
+        {
+            preparation.prepared = false;
+            preparation.exceptionThrown = true;
         }
 
-        // Store the loaded instances
-        for (auto &instance : instances)
+        preparation.duration = timer.nsecsElapsed();
+        preparation.executed = true;
+
+        if (traceTimestamp >= 0)
         {
-            // Make sure that an instance with the same name is not already in the container
-            if (pluginInstance(instance->name()) != nullptr)
+            TraceRecorder::instance().addCompleteEvent(
+                        QStringLiteral("lifecycle"),
+                        QStringLiteral("prepare %1").arg(preparation.instanceName),
+                        preparation.instanceName,
+                        traceTimestamp,
+                        preparation.duration);
+        }
+    };
+
+    auto prepareInstances = [&preparations, &nextIndex, &prepareInstance, runningOperation](
+                            const bool workerThread)
+    {
+        while ((!runningOperation) || (!runningOperation->isCancellationRequested()))
+        {
+            const size_t index = nextIndex.fetch_add(1U, std::memory_order_relaxed);
+
+            if (index >= preparations.size())
             {
-                qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                        << QString("A plugin instance with the same name [%1] was already loaded!")
-                           .arg(instance->name());
-                return false;
+                return;
             }
 
-            // Store the instance in the container
-            m_pluginInstances.emplace(instance->name(), std::move(instance));
+            Preparation &preparation = preparations[index];
+
+            if (workerThread)
+            {
+                CpuAccounting::ThreadScope threadScope(preparation.instanceName,
+                                                       QStringLiteral("cpf-prepare"));
+                prepareInstance(preparation);
+            }
+            else
+            {
+                // Calling thread keeps its name and its own registration in the CPU accounting
+                const qint64 cpuTime = CpuAccounting::threadCpuTime();
+                prepareInstance(preparation);
+                CpuAccounting::instance().addCpuTime(preparation.instanceName,
+                                                     CpuAccounting::threadCpuTime() - cpuTime);
+            }
         }
+    };
+
+    // The calling thread takes part in the preparation, so only the other workers are started on
+    // the pool (one per CPU core, at most one per plugin instance)
+    const int idealThreadCount = std::max(QThread::idealThreadCount(), 1);
+
+    if (!m_preparePool)
+    {
+        m_preparePool.reset(new QThreadPool);
+        m_preparePool->setMaxThreadCount(std::max(idealThreadCount - 1, 1));
     }
 
-    // Inject dependencies
-    if (!injectAllDependencies(pluginManagerConfig.pluginConfigs()))
+    const size_t workerCount = std::min(static_cast<size_t>(idealThreadCount - 1),
+                                        preparations.size() - 1U);
+
+    for (size_t i = 0U; i < workerCount; i++)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                << "Failed to inject dependencies!";
-        return false;
+        m_preparePool->start(new FunctionTask([&prepareInstances]() { prepareInstances(true); }));
     }
 
-    // Startup order (instances from startup priorities first, then all others)
-    m_pluginStartupOrder = pluginManagerConfig.pluginStartupPriorities();
+    prepareInstances(false);
+    m_preparePool->waitForDone();
 
-    for (const QString &instanceName : pluginInstanceNames())
+    // Record the results
+    bool success = true;
+
+    for (const auto &preparation : preparations)
     {
-        if (!m_pluginStartupOrder.contains(instanceName))
+        if (!preparation.executed)
+        {
+            continue;
+        }
+
+        m_lifecycleTimings.record(LifecycleTimings::Phase::Prepare,
+                                  preparation.instanceName,
+                                  preparation.duration);
+
+        if (preparation.exceptionThrown)
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Exception thrown while preparing plugin instance: %1",
+                                       preparation.instanceName);
+        }
+
+        if (!preparation.prepared)
         {
-            m_pluginStartupOrder.append(instanceName);
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to prepare plugin instance: %1",
+                                       preparation.instanceName);
+            success = false;
         }
     }
 
-    return true;
+    if (isCancellationRequested())
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Preparation of plugin instances was cancelled!");
+        return false;
+    }
+
+    return success;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool PluginManager::unload()
+bool PluginManager::startInstance(const QString &instanceName, IPlugin *instance)
 {
-    // Make sure that all plugins are stopped
-    stop();
+    const qint64 traceTimestamp = TraceRecorder::isEnabled() ? TraceRecorder::timestamp() : -1;
+    m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Starting);
 
-    // Make sure that all of their dependencies are ejected
-    if (!ejectDependencies())
+    QElapsedTimer timer;
+    timer.start();
+
+    const qint64 cpuTime = CpuAccounting::threadCpuTime();
+    bool started = false;
+
+    {
+        MemoryAccounting::Scope memoryScope(instanceName);
+        m_latencyInjection.inject(instanceName, LatencyInjection::Operation::Start);
+        started = instance->start();
+    }
+
+    const qint64 duration = timer.nsecsElapsed();
+    CpuAccounting::instance().addCpuTime(instanceName, CpuAccounting::threadCpuTime() - cpuTime);
+    const int nodeId = m_dependencyGraph.nodeId(instanceName);
+
+    if (nodeId >= 0)
+    {
+        m_startDurations[static_cast<size_t>(nodeId)] = duration;
+    }
+
+    m_lifecycleTimings.record(LifecycleTimings::Phase::Start, instanceName, duration);
+    startDurationHistogram(instanceName).record(static_cast<quint64>(duration));
+
+    if ((traceTimestamp >= 0) && (nodeId >= 0))
+    {
+        traceStart(nodeId, traceTimestamp, duration);
+    }
+
+    m_liveStats.setInstanceTimings(instanceName, m_lifecycleTimings);
+
+    if (!started)
     {
-        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                << "Failed to unload eject dependencies!";
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Failed to start plugin instance: %1",
+                                   instanceName);
+        m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Failed);
         return false;
     }
 
-    // Unload all plugin instances
-    m_pluginInstances.clear();
-    return true;
-}
+    m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Started);
+    managerMetrics().startedInstances.add(1);
 
-// -------------------------------------------------------------------------------------------------
+    // Plugin instances that defer their readiness are tracked until it is settled
+    const auto readiness = instance->readiness();
 
-bool PluginManager::start()
-{
-    // Start plugin instances in the defined startup order
-    for (const QString &instanceName : qAsConst(m_pluginStartupOrder))
+    if (readiness && m_readinessTracker)
     {
-        auto *instance = pluginInstance(instanceName);
+        const auto readinessTracker = m_readinessTracker;
 
-        // Check if plugin instance is loaded
-        if (instance == nullptr)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Plugin instance is null:" << instanceName;
-            return false;
+            QMutexLocker locker(&readinessTracker->mutex);
+            readinessTracker->pendingCount++;
         }
 
-        // Start plugin instance
-        if (instance->isStarted())
+        readiness->setObserver([readinessTracker, instanceName](const Readiness::State state)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Plugin instance is already started:" << instanceName;
-            return false;
-        }
+            if (state == Readiness::State::Failed)
+            {
+                CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                           "Plugin instance failed to become ready: %1",
+                                           instanceName);
+            }
 
-        if (!instance->start())
-        {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Failed to start plugin instance:" << instanceName;
-            return false;
-        }
+            readinessTracker->settled(state);
+        });
     }
 
     return true;
@@ -177,81 +2406,165 @@ bool PluginManager::start()
 
 // -------------------------------------------------------------------------------------------------
 
-void PluginManager::stop()
+void PluginManager::stopInstance(const QString &instanceName, IPlugin *instance)
 {
-    // Stop plugin instances in the reverse order as they were started
-    for (auto it = m_pluginStartupOrder.rbegin(); it != m_pluginStartupOrder.rend(); it++)
+    m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Stopping);
+
+    // Readiness of a plugin instance that is stopped before it gets ready fails
+    const auto readiness = instance->readiness();
+
+    if (readiness)
     {
-        auto *instance = pluginInstance(*it);
+        readiness->setFailed(QStringLiteral("Plugin instance was stopped"));
+        readiness->setObserver(Readiness::Observer());
+    }
 
-        // Stop plugin instance
-        if ((instance != nullptr) && (instance->isStarted()))
-        {
-            instance->stop();
-        }
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 cpuTime = CpuAccounting::threadCpuTime();
+
+    {
+        LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                      LifecycleTimings::Phase::Stop,
+                                      instanceName);
+        MemoryAccounting::Scope memoryScope(instanceName);
+        m_latencyInjection.inject(instanceName, LatencyInjection::Operation::Stop);
+        instance->stop();
     }
+
+    stopDurationHistogram(instanceName).recordElapsed(timer);
+    CpuAccounting::instance().addCpuTime(instanceName, CpuAccounting::threadCpuTime() - cpuTime);
+    managerMetrics().startedInstances.add(-1);
+
+    m_liveStats.setInstanceTimings(instanceName, m_lifecycleTimings);
+    m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Stopped);
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool PluginManager::hasPluginInstance(const QString &instanceName) const
+Readiness::State PluginManager::dependenciesReadiness(const QString &instanceName) const
 {
-    auto it = m_pluginInstances.find(instanceName);
+    const int nodeId = m_dependencyGraph.nodeId(instanceName);
+
+    if (nodeId < 0)
+    {
+        return Readiness::State::Ready;
+    }
+
+    Readiness::State state = Readiness::State::Ready;
+
+    for (int dependency : m_dependencyGraph.dependencies(nodeId))
+    {
+        const auto *instance = activatedPluginInstance(m_dependencyGraph.nodeName(dependency));
+
+        const Readiness::State dependencyState = (instance != nullptr)
+                                                 ? instanceReadiness(*instance)
+                                                 : Readiness::State::Failed;
+
+        if (dependencyState == Readiness::State::Failed)
+        {
+            return Readiness::State::Failed;
+        }
+
+        if (dependencyState == Readiness::State::Pending)
+        {
+            state = Readiness::State::Pending;
+        }
+    }
 
-    return (it != m_pluginInstances.end());
+    return state;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-IPlugin *PluginManager::pluginInstance(const QString &instanceName)
+void PluginManager::traceStart(const int nodeId, const qint64 timestamp, const qint64 duration)
 {
-    auto it = m_pluginInstances.find(instanceName);
+    auto &recorder = TraceRecorder::instance();
+    const QString instanceName = m_dependencyGraph.nodeName(nodeId);
+    const int threadId = TraceRecorder::currentThreadId();
+
+    recorder.addCompleteEvent(QStringLiteral("lifecycle"),
+                              QString("start %1").arg(instanceName),
+                              instanceName,
+                              timestamp,
+                              duration);
+
+    m_startTraceTimestamps[static_cast<size_t>(nodeId)] = timestamp;
+    m_startTraceThreadIds[static_cast<size_t>(nodeId)] = threadId;
 
-    if (it == m_pluginInstances.end())
+    // Connect the start of each dependency (on the thread that started it) to the start of this
+    // plugin instance
+    for (int dependency : m_dependencyGraph.dependencies(nodeId))
     {
-        return nullptr;
-    }
+        const qint64 dependencyTimestamp = m_startTraceTimestamps[static_cast<size_t>(dependency)];
 
-    return it->second.get();
+        if (dependencyTimestamp >= 0)
+        {
+            recorder.addFlowEvent(QStringLiteral("dependency"),
+                                  dependencyTimestamp,
+                                  m_startTraceThreadIds[static_cast<size_t>(dependency)],
+                                  timestamp,
+                                  threadId);
+        }
+    }
 }
 
 // -------------------------------------------------------------------------------------------------
 
-QStringList PluginManager::pluginInstanceNames() const
+void PluginManager::refreshLiveStats()
 {
-    QStringList instanceNames;
+    if (!m_liveStats.isCreated())
+    {
+        return;
+    }
 
-    for (const auto &item : m_pluginInstances)
+    const QStringList instanceNames = pluginInstanceNames();
+    m_liveStats.setInstances(instanceNames);
+
+    for (const QString &instanceName : instanceNames)
     {
-        instanceNames.append(item.first);
+        const auto *instance = activatedPluginInstance(instanceName);
+
+        if ((instance != nullptr) && instance->isStarted())
+        {
+            m_liveStats.setInstanceState(instanceName, LiveStats::InstanceState::Started);
+        }
+
+        m_liveStats.setInstanceTimings(instanceName, m_lifecycleTimings);
     }
 
-    return instanceNames;
+    publishLiveStatsMetrics();
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool PluginManager::injectAllDependencies(const QList<PluginConfig> &pluginConfigs)
+bool PluginManager::injectAllDependencies(
+        const std::map<QString, QStringList> &resolvedDependencies)
 {
-    // Iterate over all plugin configs
-    for (const PluginConfig &pluginConfig : pluginConfigs)
+    for (const auto &item : resolvedDependencies)
     {
-        // Iterate over all plugin instance configs
-        for (const PluginInstanceConfig &instanceConfig : pluginConfig.instanceConfigs())
+        // Dependencies of the lazy plugin instances are injected when they are activated
+        if (item.second.isEmpty() || (m_lazyInstances.find(item.first) != m_lazyInstances.end()))
         {
-            // Inject dependencies to the selected plugin
-            const QSet<QString> dependencies = instanceConfig.dependencies();
+            continue;
+        }
 
-            if (!dependencies.isEmpty())
-            {
-                if (!injectDependencies(instanceConfig.name(), dependencies))
-                {
-                    qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                            << "Failed to inject dependencies to plugin instance:"
-                            << instanceConfig.name();
-                    return false;
-                }
-            }
+        auto *instance = activatedPluginInstance(item.first);
+
+        if (instance == nullptr)
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance was not found: %1",
+                                       item.first);
+            return false;
+        }
+
+        if (!injectDependencies(instance, item.second))
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to inject dependencies to plugin instance: %1",
+                                       item.first);
+            return false;
         }
     }
 
@@ -260,18 +2573,15 @@ bool PluginManager::injectAllDependencies(const QList<PluginConfig> &pluginConfi
 
 // -------------------------------------------------------------------------------------------------
 
-bool PluginManager::injectDependencies(const QString &instanceName,
-                                       const QSet<QString> &dependencies)
+bool PluginManager::injectDependencies(IPlugin *instance, const QStringList &dependencies)
 {
-    // Find plugin instance
-    auto *instance = pluginInstance(instanceName);
+    const QString instanceName = instance->name();
 
-    if (instance == nullptr)
-    {
-        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                << "Plugin instance was not found:" << instanceName;
-        return false;
-    }
+    CPPPLUGINFRAMEWORK_TRACEPOINT2(inject_dependencies_begin,
+                                   qUtf8Printable(instanceName),
+                                   dependencies.size());
+
+    bool success = true;
 
     // Inject plugin's dependencies
     for (const QString &dependencyName : dependencies)
@@ -281,21 +2591,81 @@ bool PluginManager::injectDependencies(const QString &instanceName,
 
         if (dependency == nullptr)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Dependency was not found:" << dependencyName;
-            return false;
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Dependency was not found: %1",
+                                       dependencyName);
+            success = false;
+            break;
         }
 
-        if (!instance->injectDependency(dependency))
+        bool injected = false;
+
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << QString("Failed to inject dependency [%1] into plugin instance [%2]!")
-                       .arg(dependencyName, instanceName);
-            return false;
+            LifecycleTimings::Scope scope(&m_lifecycleTimings,
+                                          LifecycleTimings::Phase::InjectDependency,
+                                          instanceName);
+            injected = instance->injectDependency(instrumentedDependency(instanceName,
+                                                                         dependency));
+        }
+
+        if (!injected)
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Failed to inject dependency [%1] into plugin instance "
+                                       "[%2]!",
+                                       dependencyName,
+                                       instanceName);
+            success = false;
+            break;
         }
     }
 
-    return true;
+    CPPPLUGINFRAMEWORK_TRACEPOINT2(inject_dependencies_end,
+                                   qUtf8Printable(instanceName),
+                                   success ? 1 : 0);
+    return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+IPlugin *PluginManager::instrumentedDependency(const QString &instanceName, IPlugin *dependency)
+{
+    // Calls of a dependency with injected latency can only be delayed through a proxy
+    if ((!m_instrumentedDependencies.contains(qMakePair(instanceName, dependency->name()))) &&
+        (!m_instrumentedDependencies.contains(qMakePair(instanceName, QString()))) &&
+        (!m_latencyInjection.delaysCalls(dependency->name())))
+    {
+        return dependency;
+    }
+
+    // A proxy exports only one interface so it can stand in only for a single-interface dependency
+    const QSet<QString> interfaces = dependency->exportedInterfaces();
+
+    if (interfaces.size() != 1)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "Dependency [%1] of plugin instance [%2] exports more than one "
+                                   "interface and cannot be instrumented!",
+                                   dependency->name(),
+                                   instanceName);
+        return dependency;
+    }
+
+    auto proxy = ProxyRegistry::instance().createProxy(*interfaces.begin(),
+                                                       instanceName,
+                                                       dependency);
+
+    if (!proxy)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                   "No proxy is registered for interface [%1] of dependency [%2]!",
+                                   *interfaces.begin(),
+                                   dependency->name());
+        return dependency;
+    }
+
+    m_dependencyProxies.push_back(std::move(proxy));
+    return m_dependencyProxies.back().get();
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -310,16 +2680,18 @@ bool PluginManager::ejectDependencies()
         // Check if plugin instance is loaded
         if (instance == nullptr)
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Plugin instance is null:" << item.first;
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance is null: %1",
+                                       item.first);
             return false;
         }
 
         // Check if plugin instance is started
         if (instance->isStarted())
         {
-            qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
-                    << "Plugin instance is not stopped:" << instance->name();
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance is not stopped: %1",
+                                       instance->name());
             return false;
         }
 
@@ -327,6 +2699,27 @@ bool PluginManager::ejectDependencies()
         instance->ejectDependencies();
     }
 
+    // Lazy plugin instances have dependencies only if they were created
+    for (auto &item : m_lazyInstances)
+    {
+        auto *instance = item.second->instance.get();
+
+        if (instance == nullptr)
+        {
+            continue;
+        }
+
+        if (instance->isStarted())
+        {
+            CPPPLUGINFRAMEWORK_WARNING(CppPluginFramework::LoggingCategory::PluginManager,
+                                       "Plugin instance is not stopped: %1",
+                                       instance->name());
+            return false;
+        }
+
+        instance->ejectDependencies();
+    }
+
     return true;
 }
 
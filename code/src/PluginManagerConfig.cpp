@@ -22,9 +22,11 @@
 #include <CppPluginFramework/PluginManagerConfig.hpp>
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/DependencyGraph.hpp>
 #include <CppPluginFramework/LoggingCategories.hpp>
 
 // Qt includes
+#include <QtCore/QHash>
 #include <QtCore/QStringBuilder>
 
 // System includes
@@ -73,6 +75,92 @@ void PluginManagerConfig::setPluginStartupPriorities(const QStringList &startupP
 
 // -------------------------------------------------------------------------------------------------
 
+const QStringList &PluginManagerConfig::pluginDirectories() const
+{
+    return m_pluginDirectories;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManagerConfig::setPluginDirectories(const QStringList &pluginDirectories)
+{
+    m_pluginDirectories = pluginDirectories;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString PluginManagerConfig::pluginCatalogCache() const
+{
+    return m_pluginCatalogCache;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManagerConfig::setPluginCatalogCache(const QString &pluginCatalogCache)
+{
+    m_pluginCatalogCache = pluginCatalogCache;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const QList<LatencyInjectionConfig> &PluginManagerConfig::latencyInjectionConfigs() const
+{
+    return m_latencyInjectionConfigs;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManagerConfig::setLatencyInjectionConfigs(
+        const QList<LatencyInjectionConfig> &latencyInjectionConfigs)
+{
+    m_latencyInjectionConfigs = latencyInjectionConfigs;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const QList<StartupProfileConfig> &PluginManagerConfig::startupProfiles() const
+{
+    return m_startupProfiles;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManagerConfig::setStartupProfiles(const QList<StartupProfileConfig> &startupProfiles)
+{
+    m_startupProfiles = startupProfiles;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int PluginManagerConfig::readinessTimeout() const
+{
+    return m_readinessTimeout;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void PluginManagerConfig::setReadinessTimeout(const int readinessTimeout)
+{
+    m_readinessTimeout = readinessTimeout;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+StartupProfileConfig PluginManagerConfig::startupProfile(const QString &name) const
+{
+    for (const auto &startupProfile : m_startupProfiles)
+    {
+        if (startupProfile.name() == name)
+        {
+            return startupProfile;
+        }
+    }
+
+    return StartupProfileConfig();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool PluginManagerConfig::loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config)
 {
     // Load plugin configs
@@ -95,6 +183,72 @@ bool PluginManagerConfig::loadConfigParameters(const CppConfigFramework::ConfigO
         return false;
     }
 
+    // Load plugin directories
+    m_pluginDirectories.clear();
+
+    if (!loadOptionalConfigParameter(&m_pluginDirectories,
+                                     QStringLiteral("plugin_directories"),
+                                     config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin directories!";
+        return false;
+    }
+
+    // Load plugin catalog cache
+    m_pluginCatalogCache.clear();
+
+    if (!loadOptionalConfigParameter(&m_pluginCatalogCache,
+                                     QStringLiteral("plugin_catalog_cache"),
+                                     config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load plugin catalog cache!";
+        return false;
+    }
+
+    // Load latency injection configs
+    m_latencyInjectionConfigs.clear();
+
+    if (config.member(QStringLiteral("latency_injection")) != nullptr)
+    {
+        if (!loadRequiredConfigContainer(&m_latencyInjectionConfigs,
+                                         QStringLiteral("latency_injection"),
+                                         config))
+        {
+            qCWarning(CppPluginFramework::LoggingCategory::Config)
+                    << "Failed to load latency injection configurations!";
+            return false;
+        }
+    }
+
+    // Load startup profiles
+    m_startupProfiles.clear();
+
+    if (config.member(QStringLiteral("startup_profiles")) != nullptr)
+    {
+        if (!loadRequiredConfigContainer(&m_startupProfiles,
+                                         QStringLiteral("startup_profiles"),
+                                         config))
+        {
+            qCWarning(CppPluginFramework::LoggingCategory::Config)
+                    << "Failed to load startup profiles!";
+            return false;
+        }
+    }
+
+    // Load readiness timeout
+    m_readinessTimeout = DefaultReadinessTimeout;
+
+    if (!loadOptionalConfigParameter(&m_readinessTimeout,
+                                     QStringLiteral("readiness_timeout"),
+                                     config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load readiness timeout!";
+        return false;
+    }
+
     return true;
 }
 
@@ -114,23 +268,31 @@ QString PluginManagerConfig::validateConfig() const
     // Check individual plugins are valid and extract all instance names
     QSet<QString> plugins;
     QSet<QString> instanceNames;
-    QSet<QString> dependencies;
+    std::map<QString, QStringList> dependencies;
 
     for (const auto &pluginConfig : m_pluginConfigs)
     {
         // Check individual plugins are valid
         if (!pluginConfig.isValid())
         {
-            return QStringLiteral("Plugin config is not valid: ") % pluginConfig.filePath();
+            return QStringLiteral("Plugin config is not valid: ") % pluginConfig.displayName();
         }
 
-        // Check for duplicate plugins
-        if (plugins.contains(pluginConfig.filePath()))
+        // Check for duplicate plugins (plugins referenced by interface are resolved at load time)
+        if (pluginConfig.interface().isEmpty())
         {
-            return QStringLiteral("Duplicated plugin: [%1]") % pluginConfig.filePath();
-        }
+            if (plugins.contains(pluginConfig.filePath()))
+            {
+                return QStringLiteral("Duplicated plugin: [%1]") % pluginConfig.filePath();
+            }
 
-        plugins.insert(pluginConfig.filePath());
+            plugins.insert(pluginConfig.filePath());
+        }
+        else if (m_pluginDirectories.isEmpty())
+        {
+            return QString("Plugin is referenced by interface [%1], but no plugin directories are "
+                           "configured!").arg(pluginConfig.interface());
+        }
 
         // Check for plugin instances of this plugin
         for (const auto &instanceConfig : pluginConfig.instanceConfigs())
@@ -139,28 +301,38 @@ QString PluginManagerConfig::validateConfig() const
             if (instanceNames.contains(instanceConfig.name()))
             {
                 return QString("Plugin [%1] has an instance with a duplicated name [%2]!")
-                        .arg(pluginConfig.filePath(),
+                        .arg(pluginConfig.displayName(),
                              instanceConfig.name());
             }
 
             instanceNames.insert(instanceConfig.name());
 
             // Keep track of all dependencies
-            dependencies.unite(instanceConfig.dependencies());
+            dependencies[instanceConfig.name()] = instanceConfig.dependencies().values();
         }
     }
 
-    // Check if dependencies reference actual plugin instances
-    for (const QString &dependency : dependencies)
+    // Check if dependencies reference actual plugin instances and that they do not form cycles
+    // (dependencies from required interfaces can only be checked when the plugins are loaded)
+    DependencyGraph dependencyGraph;
+    QString error;
+
+    if (!DependencyGraph::fromDependencies(dependencies, &dependencyGraph, &error))
     {
-        if (!instanceNames.contains(dependency))
-        {
-            return QString("Dependency [%1] does not reference an actual plugin instance!")
-                    .arg(dependency);
-        }
+        return error;
+    }
+
+    const auto cycles = dependencyGraph.cycles();
+
+    if (!cycles.empty())
+    {
+        return QStringLiteral("Dependency cycles: ") % dependencyGraph.cyclesToString(cycles);
     }
 
     // Check if the startup priorities reference actual plugin instances
+    QHash<QString, int> priorityPositions;
+    priorityPositions.reserve(m_pluginStartupPriorities.size());
+
     for (const QString &instanceName : m_pluginStartupPriorities)
     {
         if (!instanceNames.contains(instanceName))
@@ -170,11 +342,96 @@ QString PluginManagerConfig::validateConfig() const
                     .arg(instanceName);
         }
 
-        if (m_pluginStartupPriorities.count(instanceName) != 1)
+        if (priorityPositions.contains(instanceName))
         {
             return QString("Duplicate plugin instance [%1] in the startup priorities!")
                     .arg(instanceName);
         }
+
+        priorityPositions.insert(instanceName, priorityPositions.size());
+    }
+
+    // Check that no explicit dependency of a prioritized plugin instance is prioritized after it
+    // (dependencies that are not prioritized are started before it automatically)
+    for (const QString &instanceName : m_pluginStartupPriorities)
+    {
+        const int position = priorityPositions.value(instanceName);
+
+        for (const QString &dependencyName : dependencies[instanceName])
+        {
+            const int dependencyPosition = priorityPositions.value(dependencyName, -1);
+
+            if (dependencyPosition > position)
+            {
+                return QString("Plugin instance [%1] is in the startup priorities before its "
+                               "dependency [%2]!")
+                        .arg(instanceName, dependencyName);
+            }
+        }
+    }
+
+    // Check if the latency injection configs reference actual plugin instances
+    QSet<QString> latencyInjectionInstances;
+
+    for (const auto &latencyInjectionConfig : m_latencyInjectionConfigs)
+    {
+        if (!latencyInjectionConfig.isValid())
+        {
+            return QStringLiteral("Latency injection config is not valid: ") %
+                    latencyInjectionConfig.instanceName();
+        }
+
+        const QString instanceName = latencyInjectionConfig.instanceName();
+
+        if (!instanceNames.contains(instanceName))
+        {
+            return QString("Plugin instance [%1] referenced in the latency injection does not "
+                           "reference an actual plugin instance!")
+                    .arg(instanceName);
+        }
+
+        if (latencyInjectionInstances.contains(instanceName))
+        {
+            return QString("Duplicate plugin instance [%1] in the latency injection!")
+                    .arg(instanceName);
+        }
+
+        latencyInjectionInstances.insert(instanceName);
+    }
+
+    // Check if the startup profiles reference actual plugin instances
+    QSet<QString> startupProfileNames;
+
+    for (const auto &startupProfile : m_startupProfiles)
+    {
+        if (!startupProfile.isValid())
+        {
+            return QStringLiteral("Startup profile is not valid: ") % startupProfile.name();
+        }
+
+        if (startupProfileNames.contains(startupProfile.name()))
+        {
+            return QString("Duplicate startup profile [%1]!").arg(startupProfile.name());
+        }
+
+        startupProfileNames.insert(startupProfile.name());
+
+        for (const QString &instanceName : startupProfile.rootInstances())
+        {
+            if (!instanceNames.contains(instanceName))
+            {
+                return QString("Plugin instance [%1] referenced in the startup profile [%2] does "
+                               "not reference an actual plugin instance!")
+                        .arg(instanceName, startupProfile.name());
+            }
+        }
+    }
+
+    // Check the readiness timeout
+    if (m_readinessTimeout < 0)
+    {
+        return QStringLiteral("Readiness timeout is negative: ") %
+                QString::number(m_readinessTimeout);
     }
 
     return QString();
@@ -188,7 +445,12 @@ bool operator==(const CppPluginFramework::PluginManagerConfig &left,
                 const CppPluginFramework::PluginManagerConfig &right)
 {
     return ((left.pluginConfigs() == right.pluginConfigs()) &&
-            (left.pluginStartupPriorities() == right.pluginStartupPriorities()));
+            (left.pluginStartupPriorities() == right.pluginStartupPriorities()) &&
+            (left.pluginDirectories() == right.pluginDirectories()) &&
+            (left.pluginCatalogCache() == right.pluginCatalogCache()) &&
+            (left.latencyInjectionConfigs() == right.latencyInjectionConfigs()) &&
+            (left.startupProfiles() == right.startupProfiles()) &&
+            (left.readinessTimeout() == right.readinessTimeout()));
 }
 
 // -------------------------------------------------------------------------------------------------
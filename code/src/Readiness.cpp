@@ -0,0 +1,146 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the readiness of a started plugin instance
+ */
+
+// Own header
+#include <CppPluginFramework/Readiness.hpp>
+
+// C++ Plugin Framework includes
+
+// Qt includes
+#include <QtCore/QElapsedTimer>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+Readiness::Readiness()
+    : m_state(State::Pending)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Readiness::~Readiness()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Readiness::State Readiness::state() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_state;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString Readiness::error() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_error;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Readiness::setReady()
+{
+    return settle(State::Ready, QString());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Readiness::setFailed(const QString &error)
+{
+    return settle(State::Failed, error);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Readiness::State Readiness::wait(const int timeout) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QMutexLocker locker(&m_mutex);
+
+    while (m_state == State::Pending)
+    {
+        if (timeout < 0)
+        {
+            m_condition.wait(&m_mutex);
+            continue;
+        }
+
+        const qint64 remainingTime = timeout - timer.elapsed();
+
+        if ((remainingTime <= 0) ||
+            (!m_condition.wait(&m_mutex, static_cast<unsigned long>(remainingTime))))
+        {
+            break;
+        }
+    }
+
+    return m_state;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Readiness::setObserver(const Observer &observer)
+{
+    QMutexLocker locker(&m_mutex);
+    m_observer = observer;
+
+    if (m_observer && (m_state != State::Pending))
+    {
+        m_observer(m_state);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Readiness::settle(const State state, const QString &error)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_state != State::Pending)
+    {
+        return false;
+    }
+
+    m_state = state;
+    m_error = error;
+    m_condition.wakeAll();
+
+    if (m_observer)
+    {
+        m_observer(m_state);
+    }
+
+    return true;
+}
+
+} // namespace CppPluginFramework
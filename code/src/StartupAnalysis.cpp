@@ -0,0 +1,352 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that analyzes the critical path of the plugin instance startup
+ */
+
+// Own header
+#include <CppPluginFramework/StartupAnalysis.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+/*!
+ * Writes the data to a file atomically
+ *
+ * \param   filePath    Path to the file
+ * \param   data        Data to write
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+static bool writeFile(const QString &filePath, const QByteArray &data)
+{
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to open the file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(data);
+
+    if (!file.commit())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to write the file:" << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Converts the duration to milliseconds
+ *
+ * \param   duration    Duration in nanoseconds
+ *
+ * \return  Duration in milliseconds
+ */
+static QString toMilliseconds(const qint64 duration)
+{
+    return QString::number(static_cast<double>(duration) / 1000000.0, 'f', 3);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+StartupAnalysis::StartupAnalysis(const DependencyGraph &graph,
+                                 const std::vector<qint64> &durations)
+    : m_graph(graph)
+{
+    const int count = m_graph.nodeCount();
+
+    if (durations.size() != static_cast<size_t>(count))
+    {
+        return;
+    }
+
+    std::vector<std::vector<int>> layers;
+
+    if (!m_graph.topologicalLayers(&layers))
+    {
+        return;
+    }
+
+    m_instanceTimings.resize(static_cast<size_t>(count));
+
+    // Forward pass (in dependency order): earliest start and finish
+    for (const auto &layer : layers)
+    {
+        for (int nodeId : layer)
+        {
+            auto &timing = m_instanceTimings[static_cast<size_t>(nodeId)];
+            timing.name = m_graph.nodeName(nodeId);
+            timing.duration = std::max<qint64>(0, durations[static_cast<size_t>(nodeId)]);
+
+            for (int dependency : m_graph.dependencies(nodeId))
+            {
+                timing.earliestStart =
+                        std::max(timing.earliestStart,
+                                 m_instanceTimings[static_cast<size_t>(dependency)].earliestFinish);
+            }
+
+            timing.earliestFinish = timing.earliestStart + timing.duration;
+
+            m_totalDuration += timing.duration;
+            m_criticalPathDuration = std::max(m_criticalPathDuration, timing.earliestFinish);
+        }
+    }
+
+    // Backward pass (in reverse dependency order): latest start and finish
+    for (auto layerIt = layers.rbegin(); layerIt != layers.rend(); layerIt++)
+    {
+        for (int nodeId : *layerIt)
+        {
+            auto &timing = m_instanceTimings[static_cast<size_t>(nodeId)];
+            timing.latestFinish = m_criticalPathDuration;
+
+            for (int dependent : m_graph.dependents(nodeId))
+            {
+                timing.latestFinish =
+                        std::min(timing.latestFinish,
+                                 m_instanceTimings[static_cast<size_t>(dependent)].latestStart);
+            }
+
+            timing.latestStart = timing.latestFinish - timing.duration;
+            timing.slack = timing.latestStart - timing.earliestStart;
+        }
+    }
+
+    // Critical path: start at the plugin instance (without dependents) that finishes last and walk
+    // back through the dependencies that finish last
+    int nodeId = -1;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (m_graph.dependents(i).isEmpty() &&
+            ((nodeId < 0) ||
+             (m_instanceTimings[static_cast<size_t>(i)].earliestFinish >
+              m_instanceTimings[static_cast<size_t>(nodeId)].earliestFinish)))
+        {
+            nodeId = i;
+        }
+    }
+
+    while (nodeId >= 0)
+    {
+        m_criticalPath.push_back(nodeId);
+        m_instanceTimings[static_cast<size_t>(nodeId)].isCritical = true;
+
+        int criticalDependency = -1;
+
+        for (int dependency : m_graph.dependencies(nodeId))
+        {
+            if ((criticalDependency < 0) ||
+                (m_instanceTimings[static_cast<size_t>(dependency)].earliestFinish >
+                 m_instanceTimings[static_cast<size_t>(criticalDependency)].earliestFinish))
+            {
+                criticalDependency = dependency;
+            }
+        }
+
+        nodeId = criticalDependency;
+    }
+
+    std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+    m_valid = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupAnalysis::isValid() const
+{
+    return m_valid;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 StartupAnalysis::criticalPathDuration() const
+{
+    return m_criticalPathDuration;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 StartupAnalysis::totalDuration() const
+{
+    return m_totalDuration;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+double StartupAnalysis::parallelism() const
+{
+    if (m_criticalPathDuration <= 0)
+    {
+        return 1.0;
+    }
+
+    return static_cast<double>(m_totalDuration) / static_cast<double>(m_criticalPathDuration);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QStringList StartupAnalysis::criticalPath() const
+{
+    QStringList names;
+
+    for (int nodeId : m_criticalPath)
+    {
+        names.append(m_graph.nodeName(nodeId));
+    }
+
+    return names;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const std::vector<StartupAnalysis::InstanceTiming> &StartupAnalysis::instanceTimings() const
+{
+    return m_instanceTimings;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QJsonObject StartupAnalysis::toJson() const
+{
+    QJsonArray instances;
+
+    for (size_t i = 0; i < m_instanceTimings.size(); i++)
+    {
+        const auto &timing = m_instanceTimings[i];
+        QJsonArray dependencies;
+
+        for (int dependency : m_graph.dependencies(static_cast<int>(i)))
+        {
+            dependencies.append(m_graph.nodeName(dependency));
+        }
+
+        instances.append(QJsonObject
+                         {
+                             { QStringLiteral("name"), timing.name },
+                             { QStringLiteral("duration_ns"), timing.duration },
+                             { QStringLiteral("earliest_start_ns"), timing.earliestStart },
+                             { QStringLiteral("earliest_finish_ns"), timing.earliestFinish },
+                             { QStringLiteral("latest_start_ns"), timing.latestStart },
+                             { QStringLiteral("latest_finish_ns"), timing.latestFinish },
+                             { QStringLiteral("slack_ns"), timing.slack },
+                             { QStringLiteral("critical"), timing.isCritical },
+                             { QStringLiteral("dependencies"), dependencies }
+                         });
+    }
+
+    return QJsonObject
+    {
+        { QStringLiteral("valid"), m_valid },
+        { QStringLiteral("critical_path_ns"), m_criticalPathDuration },
+        { QStringLiteral("total_ns"), m_totalDuration },
+        { QStringLiteral("parallelism"), parallelism() },
+        { QStringLiteral("critical_path"), QJsonArray::fromStringList(criticalPath()) },
+        { QStringLiteral("instances"), instances }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString StartupAnalysis::toDot() const
+{
+    QString dot;
+    dot += QStringLiteral("digraph startup {\n");
+    dot += QStringLiteral("    rankdir=LR;\n");
+    dot += QStringLiteral("    node [shape=box];\n");
+    dot += QString("    label=\"critical path: %1 ms, total: %2 ms, parallelism: %3\";\n")
+           .arg(toMilliseconds(m_criticalPathDuration),
+                toMilliseconds(m_totalDuration),
+                QString::number(parallelism(), 'f', 2));
+
+    for (size_t i = 0; i < m_instanceTimings.size(); i++)
+    {
+        const auto &timing = m_instanceTimings[i];
+
+        dot += QString("    \"%1\" [label=\"%1\\nstart: %2 ms\\nslack: %3 ms\"%4];\n")
+               .arg(timing.name,
+                    toMilliseconds(timing.duration),
+                    toMilliseconds(timing.slack),
+                    timing.isCritical ? QStringLiteral(", color=red, penwidth=2") : QString());
+    }
+
+    // Edges point from a dependency to its dependent (startup direction)
+    for (size_t i = 0; i < m_instanceTimings.size(); i++)
+    {
+        const auto &timing = m_instanceTimings[i];
+
+        for (int dependency : m_graph.dependencies(static_cast<int>(i)))
+        {
+            const auto &dependencyTiming = m_instanceTimings[static_cast<size_t>(dependency)];
+            const bool isCriticalEdge =
+                    timing.isCritical &&
+                    dependencyTiming.isCritical &&
+                    (dependencyTiming.earliestFinish == timing.earliestStart);
+
+            dot += QString("    \"%1\" -> \"%2\"%3;\n")
+                   .arg(dependencyTiming.name,
+                        timing.name,
+                        isCriticalEdge ? QStringLiteral(" [color=red, penwidth=2]") : QString());
+        }
+    }
+
+    dot += QStringLiteral("}\n");
+    return dot;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupAnalysis::writeJson(const QString &filePath) const
+{
+    return writeFile(filePath, QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupAnalysis::writeDot(const QString &filePath) const
+{
+    return writeFile(filePath, toDot().toUtf8());
+}
+
+} // namespace CppPluginFramework
@@ -0,0 +1,166 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a config class for the Startup Profile of the Plugin Manager
+ */
+
+// Own header
+#include <CppPluginFramework/StartupProfileConfig.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+#include <CppPluginFramework/Validation.hpp>
+
+// Qt includes
+#include <QtCore/QStringBuilder>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+StartupProfileConfig::StartupProfileConfig(const QString &name, const QStringList &rootInstances)
+    : m_name(name),
+      m_rootInstances(rootInstances)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupProfileConfig::isValid() const
+{
+    return validateConfig().isEmpty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString StartupProfileConfig::name() const
+{
+    return m_name;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void StartupProfileConfig::setName(const QString &name)
+{
+    m_name = name;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const QStringList &StartupProfileConfig::rootInstances() const
+{
+    return m_rootInstances;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void StartupProfileConfig::setRootInstances(const QStringList &rootInstances)
+{
+    m_rootInstances = rootInstances;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupProfileConfig::loadConfigParameters(const CppConfigFramework::ConfigObjectNode &config)
+{
+    // Load name of the startup profile
+    if (!loadRequiredConfigParameter(&m_name, QStringLiteral("name"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load startup profile's name!";
+        return false;
+    }
+
+    // Load root plugin instances
+    if (!loadRequiredConfigParameter(&m_rootInstances, QStringLiteral("roots"), config))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << "Failed to load startup profile's root plugin instances:" << m_name;
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool StartupProfileConfig::storeConfigParameters(CppConfigFramework::ConfigObjectNode *config)
+{
+    // Storing config parameters is currently not supported
+    Q_UNUSED(config)
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString StartupProfileConfig::validateConfig() const
+{
+    // Check name of the startup profile (same rules as for the plugin instance names)
+    if (!Validation::validatePluginInstanceName(m_name))
+    {
+        return QStringLiteral("Startup profile name is not valid: ") % m_name;
+    }
+
+    // Check root plugin instances
+    if (m_rootInstances.isEmpty())
+    {
+        return QString("Startup profile [%1] has no root plugin instances!").arg(m_name);
+    }
+
+    for (const QString &instanceName : m_rootInstances)
+    {
+        if (!Validation::validatePluginInstanceName(instanceName))
+        {
+            return QString("Startup profile [%1] has an invalid root plugin instance name [%2]!")
+                    .arg(m_name, instanceName);
+        }
+
+        if (m_rootInstances.count(instanceName) != 1)
+        {
+            return QString("Startup profile [%1] has a duplicated root plugin instance [%2]!")
+                    .arg(m_name, instanceName);
+        }
+    }
+
+    return QString();
+}
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator==(const CppPluginFramework::StartupProfileConfig &left,
+                const CppPluginFramework::StartupProfileConfig &right)
+{
+    return ((left.name() == right.name()) &&
+            (left.rootInstances() == right.rootInstances()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator!=(const CppPluginFramework::StartupProfileConfig &left,
+                const CppPluginFramework::StartupProfileConfig &right)
+{
+    return !(left == right);
+}
@@ -0,0 +1,334 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that records trace events in the Chrome trace event format
+ */
+
+// Own header
+#include <CppPluginFramework/TraceRecorder.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <chrono>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Converts the duration to microseconds (unit used in the Chrome trace event format)
+ *
+ * \param   duration    Duration in nanoseconds
+ *
+ * \return  Duration in microseconds
+ */
+static double toMicroseconds(const qint64 duration)
+{
+    return static_cast<double>(duration) / 1000.0;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+TraceRecorder::Span::Span(Span &&other) noexcept
+    : m_active(other.m_active),
+      m_category(std::move(other.m_category)),
+      m_name(std::move(other.m_name)),
+      m_instance(std::move(other.m_instance)),
+      m_timestamp(other.m_timestamp)
+{
+    other.m_active = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::Span::begin(const char *category, const char *name, const QString &instance)
+{
+    // Strings need to be copied because the span can be created in a plugin library that could
+    // already be unloaded when the trace is written
+    m_category = QString::fromUtf8(category);
+    m_name = QString::fromUtf8(name);
+    m_instance = instance;
+    m_timestamp = TraceRecorder::timestamp();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::Span::end()
+{
+    TraceRecorder::instance().addCompleteEvent(m_category,
+                                               m_name,
+                                               m_instance,
+                                               m_timestamp,
+                                               TraceRecorder::timestamp() - m_timestamp);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+TraceRecorder &TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+qint64 TraceRecorder::timestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int TraceRecorder::currentThreadId()
+{
+    static std::atomic<int> s_lastThreadId(0);
+    thread_local const int threadId = ++s_lastThreadId;
+
+    return threadId;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::start()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_events.clear();
+    m_threadNames.clear();
+    m_startTimestamp = timestamp();
+    s_enabled.store(true);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::stop()
+{
+    s_enabled.store(false);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_events.clear();
+    m_threadNames.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::addCompleteEvent(const QString &category,
+                                     const QString &name,
+                                     const QString &instance,
+                                     const qint64 timestamp,
+                                     const qint64 duration)
+{
+    addEvent(Event { 'X', category, name, instance, timestamp, duration, currentThreadId(), 0U });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::addFlowEvent(const QString &name,
+                                 const qint64 fromTimestamp,
+                                 const int fromThreadId,
+                                 const qint64 toTimestamp,
+                                 const int toThreadId)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    m_lastFlowId++;
+
+    m_events.push_back(Event { 's', QStringLiteral("flow"), name, QString(), fromTimestamp, 0,
+                               fromThreadId, m_lastFlowId });
+    m_events.push_back(Event { 'f', QStringLiteral("flow"), name, QString(), toTimestamp, 0,
+                               toThreadId, m_lastFlowId });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int TraceRecorder::eventCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_events.size());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QJsonObject TraceRecorder::toJson() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    // Metadata
+    traceEvents.append(QJsonObject
+                       {
+                           { QStringLiteral("ph"), QStringLiteral("M") },
+                           { QStringLiteral("name"), QStringLiteral("process_name") },
+                           { QStringLiteral("pid"), pid },
+                           { QStringLiteral("args"), QJsonObject
+                               {
+                                   { QStringLiteral("name"), QCoreApplication::applicationName() }
+                               }
+                           }
+                       });
+
+    for (auto it = m_threadNames.cbegin(); it != m_threadNames.cend(); it++)
+    {
+        traceEvents.append(QJsonObject
+                           {
+                               { QStringLiteral("ph"), QStringLiteral("M") },
+                               { QStringLiteral("name"), QStringLiteral("thread_name") },
+                               { QStringLiteral("pid"), pid },
+                               { QStringLiteral("tid"), it.key() },
+                               { QStringLiteral("args"), QJsonObject
+                                   {
+                                       { QStringLiteral("name"), it.value() }
+                                   }
+                               }
+                           });
+    }
+
+    // Events
+    for (const Event &event : m_events)
+    {
+        QJsonObject object
+        {
+            { QStringLiteral("ph"), QString(QChar::fromLatin1(event.type)) },
+            { QStringLiteral("cat"), event.category },
+            { QStringLiteral("name"), event.name },
+            { QStringLiteral("pid"), pid },
+            { QStringLiteral("tid"), event.threadId },
+            { QStringLiteral("ts"), toMicroseconds(event.timestamp - m_startTimestamp) }
+        };
+
+        if (event.type == 'X')
+        {
+            object.insert(QStringLiteral("dur"), toMicroseconds(event.duration));
+
+            if (!event.instance.isEmpty())
+            {
+                object.insert(QStringLiteral("args"),
+                              QJsonObject { { QStringLiteral("instance"), event.instance } });
+            }
+        }
+        else
+        {
+            object.insert(QStringLiteral("id"), static_cast<qint64>(event.flowId));
+
+            // Flow end is bound to the enclosing event (instead of the next one)
+            if (event.type == 'f')
+            {
+                object.insert(QStringLiteral("bp"), QStringLiteral("e"));
+            }
+        }
+
+        traceEvents.append(object);
+    }
+
+    return QJsonObject
+    {
+        { QStringLiteral("traceEvents"), traceEvents },
+        { QStringLiteral("displayTimeUnit"), QStringLiteral("ns") }
+    };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool TraceRecorder::writeJson(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to open the trace file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::PluginManager)
+                << "Failed to write the trace file:" << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TraceRecorder::addEvent(Event &&event)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Events that end after the recording was stopped are dropped
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    if (!m_threadNames.contains(event.threadId))
+    {
+        QString threadName = QThread::currentThread()->objectName();
+
+        if (threadName.isEmpty())
+        {
+            const auto *application = QCoreApplication::instance();
+
+            threadName = ((application != nullptr) &&
+                          (application->thread() == QThread::currentThread()))
+                         ? QStringLiteral("Main thread")
+                         : QString("Thread %1").arg(event.threadId);
+        }
+
+        m_threadNames.insert(event.threadId, threadName);
+    }
+
+    m_events.push_back(std::move(event));
+}
+
+} // namespace CppPluginFramework
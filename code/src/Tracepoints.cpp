@@ -0,0 +1,52 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the semaphores of the statically defined (USDT) tracepoints of the plugin lifecycle
+ */
+
+// Own header
+#include "Tracepoints.hpp"
+
+// C++ Plugin Framework includes
+
+// Qt includes
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(CPPPLUGINFRAMEWORK_TRACEPOINTS)
+
+/*!
+ * Defines the semaphore of the tracepoint
+ *
+ * The tracer increments the semaphore while it is attached to the tracepoint. Semaphores need to be
+ * placed in the ".probes" section so that the tracers can find them.
+ */
+#define CPPPLUGINFRAMEWORK_DEFINE_TRACEPOINT_SEMAPHORE(NAME) \
+    extern "C" \
+    { \
+        __attribute__((section(".probes"))) unsigned short cppplugin_##NAME##_semaphore = 0; \
+    }
+
+CPPPLUGINFRAMEWORK_FOR_EACH_TRACEPOINT(CPPPLUGINFRAMEWORK_DEFINE_TRACEPOINT_SEMAPHORE)
+
+#endif
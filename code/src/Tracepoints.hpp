@@ -0,0 +1,143 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the statically defined (USDT) tracepoints of the plugin lifecycle
+ *
+ * All tracepoints belong to the "cppplugin" provider. Strings are passed as UTF-8 encoded C strings
+ * and the results as integers (1 for success and 0 for failure, or the number of loaded plugin
+ * instances). Each tracepoint has a semaphore so the arguments are only converted while a tracer
+ * (for example bpftrace or perf) is attached to it.
+ *
+ * The tracepoints are compiled in only if CPPPLUGINFRAMEWORK_TRACEPOINTS is defined (CMake option
+ * "CppPluginFramework_Tracepoints"), otherwise the macros expand to nothing.
+ *
+ * \note    This is a private header of the library (it is not installed)
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+
+// Qt includes
+
+// System includes
+#if defined(CPPPLUGINFRAMEWORK_TRACEPOINTS)
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#endif
+
+// Forward declarations
+
+// Macros
+
+/*!
+ * Calls the macro for each tracepoint
+ *
+ * Tracepoints (and their arguments):
+ * - load_instances_begin (library path)
+ * - load_instances_end (library path, number of loaded plugin instances)
+ * - load_instance_begin (instance name, library path)
+ * - load_instance_end (instance name, library path, result)
+ * - inject_dependencies_begin (instance name, number of dependencies)
+ * - inject_dependencies_end (instance name, result)
+ * - manager_start_begin (number of plugin instances)
+ * - manager_start_end (result)
+ * - manager_stop_begin (number of plugin instances)
+ * - manager_stop_end ()
+ * - plugin_start_begin (instance name)
+ * - plugin_start_end (instance name, result)
+ * - plugin_stop_begin (instance name)
+ * - plugin_stop_end (instance name)
+ */
+#define CPPPLUGINFRAMEWORK_FOR_EACH_TRACEPOINT(MACRO) \
+    MACRO(load_instances_begin) \
+    MACRO(load_instances_end) \
+    MACRO(load_instance_begin) \
+    MACRO(load_instance_end) \
+    MACRO(inject_dependencies_begin) \
+    MACRO(inject_dependencies_end) \
+    MACRO(manager_start_begin) \
+    MACRO(manager_start_end) \
+    MACRO(manager_stop_begin) \
+    MACRO(manager_stop_end) \
+    MACRO(plugin_start_begin) \
+    MACRO(plugin_start_end) \
+    MACRO(plugin_stop_begin) \
+    MACRO(plugin_stop_end)
+
+#if defined(CPPPLUGINFRAMEWORK_TRACEPOINTS)
+
+//! Declares the semaphore of the tracepoint (its name is defined by sys/sdt.h)
+#define CPPPLUGINFRAMEWORK_DECLARE_TRACEPOINT_SEMAPHORE(NAME) \
+    extern "C" __attribute__((visibility("hidden"))) unsigned short cppplugin_##NAME##_semaphore;
+
+CPPPLUGINFRAMEWORK_FOR_EACH_TRACEPOINT(CPPPLUGINFRAMEWORK_DECLARE_TRACEPOINT_SEMAPHORE)
+
+//! Checks if a tracer is attached to the tracepoint
+#define CPPPLUGINFRAMEWORK_TRACEPOINT_ENABLED(NAME) \
+    __builtin_expect(cppplugin_##NAME##_semaphore != 0, 0)
+
+//! Tracepoint without arguments
+#define CPPPLUGINFRAMEWORK_TRACEPOINT0(NAME) \
+    do \
+    { \
+        if (CPPPLUGINFRAMEWORK_TRACEPOINT_ENABLED(NAME)) \
+        { \
+            DTRACE_PROBE(cppplugin, NAME); \
+        } \
+    } while (false)
+
+//! Tracepoint with one argument
+#define CPPPLUGINFRAMEWORK_TRACEPOINT1(NAME, ARG1) \
+    do \
+    { \
+        if (CPPPLUGINFRAMEWORK_TRACEPOINT_ENABLED(NAME)) \
+        { \
+            DTRACE_PROBE1(cppplugin, NAME, ARG1); \
+        } \
+    } while (false)
+
+//! Tracepoint with two arguments
+#define CPPPLUGINFRAMEWORK_TRACEPOINT2(NAME, ARG1, ARG2) \
+    do \
+    { \
+        if (CPPPLUGINFRAMEWORK_TRACEPOINT_ENABLED(NAME)) \
+        { \
+            DTRACE_PROBE2(cppplugin, NAME, ARG1, ARG2); \
+        } \
+    } while (false)
+
+//! Tracepoint with three arguments
+#define CPPPLUGINFRAMEWORK_TRACEPOINT3(NAME, ARG1, ARG2, ARG3) \
+    do \
+    { \
+        if (CPPPLUGINFRAMEWORK_TRACEPOINT_ENABLED(NAME)) \
+        { \
+            DTRACE_PROBE3(cppplugin, NAME, ARG1, ARG2, ARG3); \
+        } \
+    } while (false)
+
+#else
+
+#define CPPPLUGINFRAMEWORK_TRACEPOINT0(NAME) do {} while (false)
+#define CPPPLUGINFRAMEWORK_TRACEPOINT1(NAME, ARG1) do {} while (false)
+#define CPPPLUGINFRAMEWORK_TRACEPOINT2(NAME, ARG1, ARG2) do {} while (false)
+#define CPPPLUGINFRAMEWORK_TRACEPOINT3(NAME, ARG1, ARG2, ARG3) do {} while (false)
+
+#endif
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,881 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a class that holds a compiled version range expression
+ */
+
+// Own header
+#include <CppPluginFramework/VersionRange.hpp>
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <QtCore/QtDebug>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+
+constexpr int VersionRange::MaxVersionPart;
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+//! Holds a (partial) version parsed from a version range expression
+struct PartialVersion
+{
+    //! Major version part (-1 if it is a wildcard or missing)
+    int major = -1;
+
+    //! Minor version part (-1 if it is a wildcard or missing)
+    int minor = -1;
+
+    //! Patch version part (-1 if it is a wildcard or missing)
+    int patch = -1;
+
+    //! Development version string
+    QString dev;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Packs the version parts to a single integer
+ *
+ * \param   major   Major version part
+ * \param   minor   Minor version part
+ * \param   patch   Patch version part
+ *
+ * \return  Packed version
+ */
+quint64 packVersionParts(const qint64 major, const qint64 minor, const qint64 patch)
+{
+    const auto clamp = [](const qint64 value)
+    {
+        const qint64 maxValue = VersionRange::MaxVersionPart;
+        return static_cast<quint64>(std::max<qint64>(0, std::min<qint64>(value, maxValue)));
+    };
+
+    return (clamp(major) << 42) | (clamp(minor) << 21) | clamp(patch);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Checks if all version parts of the version can be packed without clamping
+ *
+ * \param   version     Version
+ *
+ * \retval  true    All version parts can be packed
+ * \retval  false   At least one version part is greater than VersionRange::MaxVersionPart
+ */
+bool isPackable(const VersionInfo &version)
+{
+    return (version.major() <= VersionRange::MaxVersionPart) &&
+           (version.minor() <= VersionRange::MaxVersionPart) &&
+           (version.patch() <= VersionRange::MaxVersionPart);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates a bound
+ *
+ * \param   major       Major version part
+ * \param   minor       Minor version part
+ * \param   patch       Patch version part
+ * \param   dev         Development version string
+ * \param   inclusive   Inclusive bound flag
+ *
+ * \return  Bound (unbounded if any of the version parts can not be packed)
+ *
+ * \note    An unbounded bound is only meaningful as an upper bound, so lower bounds must be created
+ *          only from version parts that can be packed
+ */
+VersionRange::Bound makeBound(const qint64 major,
+                              const qint64 minor,
+                              const qint64 patch,
+                              const QString &dev,
+                              const bool inclusive)
+{
+    VersionRange::Bound bound;
+
+    if ((major > VersionRange::MaxVersionPart) ||
+        (minor > VersionRange::MaxVersionPart) ||
+        (patch > VersionRange::MaxVersionPart))
+    {
+        bound.unbounded = true;
+        return bound;
+    }
+
+    bound.key = packVersionParts(major, minor, patch);
+    bound.dev = dev;
+    bound.inclusive = inclusive;
+    return bound;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates a bound from the lowest version that matches the partial version
+ *
+ * \param   version     Partial version
+ * \param   inclusive   Inclusive bound flag
+ *
+ * \return  Bound
+ */
+VersionRange::Bound lowestBound(const PartialVersion &version, const bool inclusive)
+{
+    return makeBound(std::max(version.major, 0),
+                     std::max(version.minor, 0),
+                     std::max(version.patch, 0),
+                     version.dev,
+                     inclusive);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates a bound from the lowest version that is greater than all versions that match the partial
+ * version
+ *
+ * \param   version     Partial version (major version part must be set)
+ *
+ * \return  Exclusive bound
+ */
+VersionRange::Bound nextBound(const PartialVersion &version)
+{
+    if (version.minor < 0)
+    {
+        return makeBound(static_cast<qint64>(version.major) + 1, 0, 0, {}, false);
+    }
+
+    if (version.patch < 0)
+    {
+        return makeBound(version.major, static_cast<qint64>(version.minor) + 1, 0, {}, false);
+    }
+
+    return makeBound(version.major,
+                     version.minor,
+                     static_cast<qint64>(version.patch) + 1,
+                     {},
+                     false);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Creates an interval that matches all versions
+ *
+ * \return  Interval
+ */
+VersionRange::Interval allVersions()
+{
+    VersionRange::Interval interval;
+    interval.upper.unbounded = true;
+    return interval;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Compares two lower bounds or two (bounded) upper bounds
+ *
+ * \param   left        Left bound
+ * \param   right       Right bound
+ * \param   lowerBounds Flag that indicates that lower bounds are compared
+ *
+ * \return  Negative value if the left bound is tighter, 0 if they are equal and positive value if
+ *          the right bound is tighter
+ */
+int compareBounds(const VersionRange::Bound &left,
+                  const VersionRange::Bound &right,
+                  const bool lowerBounds)
+{
+    int result = VersionRange::compare(left.key, left.dev, right.key, right.dev);
+
+    if ((result == 0) && (left.inclusive != right.inclusive))
+    {
+        // Exclusive bound is tighter
+        result = left.inclusive ? 1 : -1;
+    }
+    else if (lowerBounds)
+    {
+        // Greater lower bound is tighter
+        result = -result;
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Intersects two intervals
+ *
+ * \param   left    Left interval
+ * \param   right   Right interval
+ *
+ * \return  Intersection of the intervals
+ */
+VersionRange::Interval intersect(const VersionRange::Interval &left,
+                                 const VersionRange::Interval &right)
+{
+    VersionRange::Interval interval;
+
+    interval.lower = (compareBounds(left.lower, right.lower, true) <= 0) ? left.lower
+                                                                         : right.lower;
+
+    if (left.upper.unbounded)
+    {
+        interval.upper = right.upper;
+    }
+    else if (right.upper.unbounded)
+    {
+        interval.upper = left.upper;
+    }
+    else
+    {
+        interval.upper = (compareBounds(left.upper, right.upper, false) <= 0) ? left.upper
+                                                                              : right.upper;
+    }
+
+    interval.excludeDev = (left.excludeDev || right.excludeDev);
+    return interval;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Checks if the interval is empty
+ *
+ * \param   interval    Interval
+ *
+ * \retval  true    Interval is empty
+ * \retval  false   Interval is not empty
+ */
+bool isEmpty(const VersionRange::Interval &interval)
+{
+    if (interval.upper.unbounded)
+    {
+        return false;
+    }
+
+    if (interval.excludeDev)
+    {
+        // Interval must contain at least one release version so the lowest release version that
+        // is not below the lower bound needs to be checked against the upper bound
+        quint64 key = interval.lower.key;
+
+        if ((!interval.lower.dev.isEmpty()) || (!interval.lower.inclusive))
+        {
+            key++;
+        }
+
+        const int result = VersionRange::compare(key,
+                                                 {},
+                                                 interval.upper.key,
+                                                 interval.upper.dev);
+
+        return ((result > 0) || ((result == 0) && (!interval.upper.inclusive)));
+    }
+
+    const int result = VersionRange::compare(interval.lower.key,
+                                             interval.lower.dev,
+                                             interval.upper.key,
+                                             interval.upper.dev);
+
+    if (result == 0)
+    {
+        return !(interval.lower.inclusive && interval.upper.inclusive);
+    }
+
+    return (result > 0);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Parses a (partial) version
+ *
+ * \param   text        Version text
+ * \param[out]  version Parsed version
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+bool parsePartialVersion(const QString &text, PartialVersion *version)
+{
+    static const QRegularExpression regex(
+                "^(?<major>[0-9]+|[xX*])"
+                "(\\.(?<minor>[0-9]+|[xX*]))?"
+                "(\\.(?<patch>[0-9]+|[xX*]))?"
+                "(-(?<dev>.+))?$");
+
+    const auto match = regex.match(text);
+
+    if (!match.hasMatch())
+    {
+        return false;
+    }
+
+    const QStringList parts
+    {
+        match.captured(QStringLiteral("major")),
+        match.captured(QStringLiteral("minor")),
+        match.captured(QStringLiteral("patch"))
+    };
+    int values[3] = { -1, -1, -1 };
+    bool wildcard = false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        const QString &part = parts.at(i);
+
+        if (part.isEmpty() ||
+            (part == QStringLiteral("x")) ||
+            (part == QStringLiteral("X")) ||
+            (part == QStringLiteral("*")))
+        {
+            wildcard = true;
+            continue;
+        }
+
+        if (wildcard)
+        {
+            // Version part is not allowed after a wildcard
+            return false;
+        }
+
+        bool ok = false;
+        values[i] = part.toInt(&ok);
+
+        if ((!ok) || (values[i] > VersionRange::MaxVersionPart))
+        {
+            return false;
+        }
+    }
+
+    version->major = values[0];
+    version->minor = values[1];
+    version->patch = values[2];
+    version->dev = match.captured(QStringLiteral("dev"));
+
+    // Development version string is only allowed with a full version
+    return (version->dev.isEmpty() || (version->patch >= 0));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Compiles a single comparator
+ *
+ * \param   op          Comparator's operator
+ * \param   version     Comparator's (partial) version
+ * \param[out]  interval    Compiled interval
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+bool compileComparator(const QString &op,
+                       const PartialVersion &version,
+                       VersionRange::Interval *interval)
+{
+    *interval = allVersions();
+
+    const bool anyVersion = (version.major < 0);
+    const bool fullVersion = (version.patch >= 0);
+
+    if (op.isEmpty() || (op == QStringLiteral("=")))
+    {
+        if (!anyVersion)
+        {
+            interval->lower = lowestBound(version, true);
+            interval->upper = fullVersion ? lowestBound(version, true) : nextBound(version);
+        }
+    }
+    else if (op == QStringLiteral(">="))
+    {
+        interval->lower = lowestBound(version, true);
+    }
+    else if (op == QStringLiteral(">"))
+    {
+        if (anyVersion)
+        {
+            return false;
+        }
+
+        interval->lower = fullVersion ? lowestBound(version, false) : nextBound(version);
+
+        if (interval->lower.unbounded)
+        {
+            return false;
+        }
+
+        interval->lower.inclusive = (!fullVersion);
+    }
+    else if (op == QStringLiteral("<"))
+    {
+        if (anyVersion)
+        {
+            return false;
+        }
+
+        interval->upper = lowestBound(version, false);
+    }
+    else if (op == QStringLiteral("<="))
+    {
+        if (!anyVersion)
+        {
+            interval->upper = fullVersion ? lowestBound(version, true) : nextBound(version);
+        }
+    }
+    else if (op == QStringLiteral("^"))
+    {
+        if (anyVersion)
+        {
+            return false;
+        }
+
+        interval->lower = lowestBound(version, true);
+
+        if ((version.major > 0) || (version.minor < 0))
+        {
+            interval->upper = makeBound(static_cast<qint64>(version.major) + 1, 0, 0, {}, false);
+        }
+        else if ((version.minor > 0) || (version.patch < 0))
+        {
+            interval->upper = makeBound(0, static_cast<qint64>(version.minor) + 1, 0, {}, false);
+        }
+        else
+        {
+            interval->upper = makeBound(0, 0, static_cast<qint64>(version.patch) + 1, {}, false);
+        }
+    }
+    else if (op == QStringLiteral("~"))
+    {
+        if (anyVersion)
+        {
+            return false;
+        }
+
+        interval->lower = lowestBound(version, true);
+
+        PartialVersion prefix = version;
+        prefix.patch = -1;
+        interval->upper = nextBound(prefix);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Compiles a comparator set (comparators that all need to be satisfied)
+ *
+ * \param   text        Comparator set text
+ * \param[out]  interval    Compiled interval
+ *
+ * \retval  true    Success
+ * \retval  false   Failure
+ */
+bool compileComparatorSet(const QString &text, VersionRange::Interval *interval)
+{
+    static const QRegularExpression whitespaceRegex("\\s+");
+    static const QRegularExpression comparatorRegex("^(?<op>>=|<=|>|<|=|\\^|~)?(?<version>.*)$");
+    static const QStringList operators
+    {
+        QStringLiteral(">="),
+        QStringLiteral("<="),
+        QStringLiteral(">"),
+        QStringLiteral("<"),
+        QStringLiteral("="),
+        QStringLiteral("^"),
+        QStringLiteral("~")
+    };
+
+    // Split the comparator set to tokens and join the standalone operators with their versions
+    QStringList tokens;
+
+    for (const QString &item : text.split(whitespaceRegex))
+    {
+        if (item.isEmpty())
+        {
+            continue;
+        }
+
+        if ((!tokens.isEmpty()) && operators.contains(tokens.last()))
+        {
+            tokens.last().append(item);
+        }
+        else
+        {
+            tokens.append(item);
+        }
+    }
+
+    if (tokens.isEmpty())
+    {
+        return false;
+    }
+
+    // Compile comparators
+    *interval = allVersions();
+
+    for (int i = 0; i < tokens.size(); i++)
+    {
+        const QString &token = tokens.at(i);
+        VersionRange::Interval comparator;
+
+        if (token == QStringLiteral("!dev"))
+        {
+            interval->excludeDev = true;
+            continue;
+        }
+
+        if (((i + 2) < tokens.size()) && (tokens.at(i + 1) == QStringLiteral("-")))
+        {
+            // Hyphen range
+            PartialVersion from;
+            PartialVersion to;
+
+            if ((!parsePartialVersion(token, &from)) ||
+                (!parsePartialVersion(tokens.at(i + 2), &to)) ||
+                (from.major < 0) ||
+                (to.major < 0))
+            {
+                return false;
+            }
+
+            comparator = allVersions();
+            comparator.lower = lowestBound(from, true);
+            comparator.upper = (to.patch >= 0) ? lowestBound(to, true) : nextBound(to);
+            i += 2;
+        }
+        else
+        {
+            const auto match = comparatorRegex.match(token);
+            PartialVersion version;
+
+            if ((!match.hasMatch()) ||
+                (!parsePartialVersion(match.captured(QStringLiteral("version")), &version)) ||
+                (!compileComparator(match.captured(QStringLiteral("op")), version, &comparator)))
+            {
+                return false;
+            }
+        }
+
+        *interval = intersect(*interval, comparator);
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+// -------------------------------------------------------------------------------------------------
+
+VersionRange::VersionRange()
+    : m_expression(),
+      m_intervals(),
+      m_valid(false)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+VersionRange::VersionRange(const QString &expression)
+    : m_expression(expression.trimmed()),
+      m_intervals(),
+      m_valid(false)
+{
+    m_valid = compile(m_expression);
+
+    if (!m_valid)
+    {
+        m_intervals.clear();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+VersionRange::VersionRange(const VersionInfo &version)
+    : m_expression(QStringLiteral("=") + version.toString()),
+      m_intervals(),
+      m_valid(version.isValid() && isPackable(version))
+{
+    if (m_valid)
+    {
+        Interval interval;
+        interval.lower = makeBound(version.major(),
+                                   version.minor(),
+                                   version.patch(),
+                                   version.dev(),
+                                   true);
+        interval.upper = interval.lower;
+        m_intervals.push_back(interval);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+VersionRange::VersionRange(const VersionInfo &minVersion, const VersionInfo &maxVersion)
+    : m_expression(QString(">=%1 <%2").arg(minVersion.toString(), maxVersion.toString())),
+      m_intervals(),
+      m_valid(VersionInfo::isRangeValid(minVersion, maxVersion) &&
+              isPackable(minVersion) &&
+              isPackable(maxVersion))
+{
+    if (m_valid)
+    {
+        Interval interval;
+        interval.lower = makeBound(minVersion.major(),
+                                   minVersion.minor(),
+                                   minVersion.patch(),
+                                   minVersion.dev(),
+                                   true);
+        interval.upper = makeBound(maxVersion.major(),
+                                   maxVersion.minor(),
+                                   maxVersion.patch(),
+                                   maxVersion.dev(),
+                                   false);
+        m_intervals.push_back(interval);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool VersionRange::isNull() const
+{
+    return m_expression.isEmpty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool VersionRange::isValid() const
+{
+    return m_valid;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool VersionRange::matches(const VersionInfo &version) const
+{
+    if ((!m_valid) || (!version.isValid()))
+    {
+        return false;
+    }
+
+    const quint64 key = packVersion(version);
+    const QString dev = version.dev();
+
+    for (const auto &interval : m_intervals)
+    {
+        if (isInInterval(key, dev, interval))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+const std::vector<VersionRange::Interval> &VersionRange::intervals() const
+{
+    return m_intervals;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+QString VersionRange::toString() const
+{
+    return m_expression;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 VersionRange::packVersion(const VersionInfo &version)
+{
+    return packVersionParts(version.major(), version.minor(), version.patch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool VersionRange::isInInterval(const quint64 key, const QString &dev, const Interval &interval)
+{
+    if (interval.excludeDev && (!dev.isEmpty()))
+    {
+        return false;
+    }
+
+    // Check lower bound
+    int result = compare(key, dev, interval.lower.key, interval.lower.dev);
+
+    if ((result < 0) || ((result == 0) && (!interval.lower.inclusive)))
+    {
+        return false;
+    }
+
+    // Check upper bound
+    if (!interval.upper.unbounded)
+    {
+        result = compare(key, dev, interval.upper.key, interval.upper.dev);
+
+        if ((result > 0) || ((result == 0) && (!interval.upper.inclusive)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int VersionRange::compare(const quint64 leftKey,
+                          const QString &leftDev,
+                          const quint64 rightKey,
+                          const QString &rightDev)
+{
+    // Check packed version parts
+    if (leftKey != rightKey)
+    {
+        return (leftKey < rightKey) ? -1 : 1;
+    }
+
+    // Check Dev version part (same rules as for VersionInfo)
+    if (leftDev.isEmpty() || rightDev.isEmpty())
+    {
+        return (leftDev.isEmpty() ? 0 : 1) - (rightDev.isEmpty() ? 0 : 1);
+    }
+
+    return QString::compare(leftDev, rightDev);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool VersionRange::compile(const QString &expression)
+{
+    m_intervals.clear();
+
+    if (expression.isEmpty())
+    {
+        return false;
+    }
+
+    // Compile each comparator set
+    for (const QString &comparatorSet : expression.split(QStringLiteral("||")))
+    {
+        Interval interval;
+
+        if (!compileComparatorSet(comparatorSet, &interval))
+        {
+            qCWarning(CppPluginFramework::LoggingCategory::Config)
+                    << QString("Invalid comparator set [%1] in version range [%2]!")
+                       .arg(comparatorSet.trimmed(), expression);
+            return false;
+        }
+
+        // Comparator sets that can't be satisfied are skipped
+        if (!isEmpty(interval))
+        {
+            m_intervals.push_back(interval);
+        }
+    }
+
+    if (m_intervals.empty())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << QString("Version range [%1] can't be satisfied by any version!")
+                   .arg(expression);
+        return false;
+    }
+
+    // Sort the intervals by their lower bound
+    std::sort(m_intervals.begin(),
+              m_intervals.end(),
+              [](const Interval &left, const Interval &right)
+              {
+                  return (compareBounds(left.lower, right.lower, true) > 0);
+              });
+
+    return true;
+}
+
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator==(const CppPluginFramework::VersionRange &left,
+                const CppPluginFramework::VersionRange &right)
+{
+    return ((left.isValid() == right.isValid()) && (left.toString() == right.toString()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool operator!=(const CppPluginFramework::VersionRange &left,
+                const CppPluginFramework::VersionRange &right)
+{
+    return !(left == right);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+template<>
+bool CedarFramework::deserialize(const QJsonValue &json, CppPluginFramework::VersionRange *value)
+{
+    Q_ASSERT(value != nullptr);
+
+    if (!json.isString())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config)
+                << QStringLiteral("JSON value is not a string:") << json;
+        return false;
+    }
+
+    CppPluginFramework::VersionRange versionRange(json.toString());
+
+    if (!versionRange.isValid())
+    {
+        qCWarning(CppPluginFramework::LoggingCategory::Config) << "Version range is not valid";
+        return false;
+    }
+
+    *value = versionRange;
+    return true;
+}
@@ -0,0 +1,232 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a test utility that counts the heap allocations of the calling thread
+ */
+
+// Own header
+#include "AllocationCounter.hpp"
+
+// System includes
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+//! Holds the number of heap allocations made by the thread
+static thread_local quint64 t_allocationCount = 0U;
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace TestUtils
+{
+
+AllocationCounter::AllocationCounter()
+    : m_startCount(t_allocationCount)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+quint64 AllocationCounter::allocationCount() const
+{
+    return t_allocationCount - m_startCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool AllocationCounter::isMallocInterposed()
+{
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace TestUtils
+} // namespace CppPluginFramework
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(__GLIBC__)
+
+// The executable's definitions take precedence over the ones in the C library for all loaded
+// libraries, the original implementations are still available under their internal names
+extern "C"
+{
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *pointer, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void *pointer);
+
+// -------------------------------------------------------------------------------------------------
+
+void *malloc(std::size_t size) noexcept
+{
+    t_allocationCount++;
+    return __libc_malloc(size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+    t_allocationCount++;
+    return __libc_calloc(count, size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *realloc(void *pointer, std::size_t size) noexcept
+{
+    t_allocationCount++;
+    return __libc_realloc(pointer, size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *memalign(std::size_t alignment, std::size_t size) noexcept
+{
+    t_allocationCount++;
+    return __libc_memalign(alignment, size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+{
+    t_allocationCount++;
+    return __libc_memalign(alignment, size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int posix_memalign(void **pointer, std::size_t alignment, std::size_t size) noexcept
+{
+    t_allocationCount++;
+    void *memory = __libc_memalign(alignment, size);
+
+    if (memory == nullptr)
+    {
+        return ENOMEM;
+    }
+
+    *pointer = memory;
+    return 0;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void free(void *pointer) noexcept
+{
+    __libc_free(pointer);
+}
+
+} // extern "C"
+
+#else
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new(std::size_t size)
+{
+    t_allocationCount++;
+    void *pointer = std::malloc((size == 0U) ? 1U : size);
+
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    t_allocationCount++;
+    return std::malloc((size == 0U) ? 1U : size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    std::free(pointer);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
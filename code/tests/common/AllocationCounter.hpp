@@ -0,0 +1,85 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a test utility that counts the heap allocations of the calling thread
+ */
+
+#pragma once
+
+// Qt includes
+#include <QtCore/QtGlobal>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace TestUtils
+{
+
+/*!
+ * This class counts the heap allocations made by the calling thread during its lifetime
+ *
+ * The test executable that compiles "AllocationCounter.cpp" interposes the allocation functions:
+ * with glibc the whole malloc() family is replaced (which covers operator new and the allocations
+ * of Qt containers), otherwise only the global operator new is replaced. Allocations are counted
+ * per thread, so that the background threads of the framework do not disturb the measurement.
+ *
+ * Usage:
+ *
+ * \code
+ * const QString name("instance1");
+ * pluginManager.pluginInstance(name);         // Warm up
+ *
+ * TestUtils::AllocationCounter counter;
+ * pluginManager.pluginInstance(name);
+ * QCOMPARE(counter.allocationCount(), Q_UINT64_C(0));
+ * \endcode
+ */
+class AllocationCounter
+{
+public:
+    //! Constructor (starts counting)
+    AllocationCounter();
+
+    /*!
+     * Gets the number of heap allocations made by the calling thread since the construction
+     *
+     * \return  Number of allocations
+     */
+    quint64 allocationCount() const;
+
+    /*!
+     * Checks if the malloc() family is interposed (and not only the global operator new)
+     *
+     * \retval  true    All heap allocations are counted
+     * \retval  false   Only the allocations made with operator new are counted
+     */
+    static bool isMallocInterposed();
+
+private:
+    //! Holds the allocation count of the thread at the construction
+    quint64 m_startCount;
+};
+
+} // namespace TestUtils
+} // namespace CppPluginFramework
@@ -0,0 +1,276 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains integration tests for PluginCatalog class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/PluginCatalog.hpp>
+#include <CppPluginFramework/PluginManager.hpp>
+#include "../TestPlugins/ITestPlugin2.hpp"
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigValueNode.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppConfigFramework;
+using namespace CppPluginFramework;
+
+class TestPluginCatalog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testScan();
+    void testScanLinksAndOtherFiles();
+    void testFindBestMatch();
+    void testCache();
+    void testLoadByInterface();
+
+private:
+    QString m_testPluginsPath;
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestPluginCatalog::initTestCase()
+{
+    QDir testPluginsDir(QCoreApplication::applicationDirPath());
+    QVERIFY(testPluginsDir.cd("../TestPlugins"));
+
+    m_testPluginsPath = testPluginsDir.absolutePath();
+}
+
+void TestPluginCatalog::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestPluginCatalog::init()
+{
+}
+
+void TestPluginCatalog::cleanup()
+{
+}
+
+// Test: scanning of plugin directories ------------------------------------------------------------
+
+void TestPluginCatalog::testScan()
+{
+    PluginCatalog catalog;
+    int metadataReads = 0;
+
+    QVERIFY(catalog.scan({ m_testPluginsPath }, &metadataReads));
+    QVERIFY(metadataReads >= 2);
+
+    const auto plugins = catalog.plugins();
+    QCOMPARE(plugins.size(), static_cast<size_t>(2));
+
+    const auto *entry = catalog.entry(QDir(m_testPluginsPath).filePath("TestPlugin1.plugin"));
+    QVERIFY(entry != nullptr);
+    QVERIFY(entry->isPlugin);
+    QCOMPARE(entry->version, VersionInfo(1, 0, 0));
+    QCOMPARE(entry->description, QString("test plugin 1"));
+    QCOMPARE(entry->exportedInterfaces,
+             QStringList { "CppPluginFramework::TestPlugins::ITestPlugin1" });
+    QCOMPARE(entry->factoryClassName, QString("PluginFactory"));
+
+    // Rescan must not read the metadata again
+    QVERIFY(catalog.scan({ m_testPluginsPath }, &metadataReads));
+    QCOMPARE(metadataReads, 0);
+
+    // Scan of a directory that does not exist
+    QVERIFY(!catalog.scan({ QDir(m_testPluginsPath).filePath("nonExistingDirectory") }));
+}
+
+// Test: scanning of links and files that are not libraries ----------------------------------------
+
+void TestPluginCatalog::testScanLinksAndOtherFiles()
+{
+    QTemporaryDir linkDir;
+    QVERIFY(linkDir.isValid());
+
+    const QString libraryPath = QDir(m_testPluginsPath).filePath("TestPlugin1.plugin");
+    const QString linkPath = linkDir.filePath("libTestPlugin1.so.1");
+
+    QVERIFY(QFile::link(libraryPath, linkPath));
+    QVERIFY(QFile::link(libraryPath, linkDir.filePath("libTestPlugin1.so")));
+
+    QFile textFile(linkDir.filePath("notes.txt"));
+    QVERIFY(textFile.open(QIODevice::WriteOnly));
+    textFile.write("not a library");
+    textFile.close();
+
+    // Both links share one entry and the text file is skipped
+    PluginCatalog catalog;
+    int metadataReads = -1;
+
+    QVERIFY(catalog.scan({ linkDir.path() }, &metadataReads));
+    QCOMPARE(metadataReads, 1);
+    QCOMPARE(catalog.plugins().size(), static_cast<size_t>(1));
+    QVERIFY(catalog.entry(textFile.fileName()) == nullptr);
+
+    const auto *entry = catalog.entry(linkPath);
+    QVERIFY(entry != nullptr);
+    QVERIFY(entry == catalog.entry(libraryPath));
+    QCOMPARE(entry->filePath, QFileInfo(libraryPath).canonicalFilePath());
+
+    // The library is not indexed again through the plugin directory
+    QVERIFY(catalog.scan({ linkDir.path(), m_testPluginsPath }));
+    QCOMPARE(catalog.plugins().size(), static_cast<size_t>(2));
+}
+
+// Test: finding the best match --------------------------------------------------------------------
+
+void TestPluginCatalog::testFindBestMatch()
+{
+    PluginCatalog catalog;
+    QVERIFY(catalog.scan({ m_testPluginsPath }));
+
+    const auto *entry = catalog.findBestMatch("CppPluginFramework::TestPlugins::ITestPlugin2",
+                                              VersionRange("^1.0"));
+    QVERIFY(entry != nullptr);
+    QCOMPARE(QFileInfo(entry->filePath).fileName(), QString("TestPlugin2.plugin"));
+
+    entry = catalog.findBestMatch("CppPluginFramework::TestPlugins::ITestPlugin1",
+                                  VersionRange("<0.9 || 1.0.0 !dev"));
+    QVERIFY(entry != nullptr);
+    QCOMPARE(QFileInfo(entry->filePath).fileName(), QString("TestPlugin1.plugin"));
+
+    QVERIFY(catalog.findBestMatch("CppPluginFramework::TestPlugins::ITestPlugin1",
+                                  VersionRange("^2.0")) == nullptr);
+    QVERIFY(catalog.findBestMatch("CppPluginFramework::TestPlugins::IUnknown",
+                                  VersionRange("*")) == nullptr);
+    QVERIFY(catalog.findBestMatch("CppPluginFramework::TestPlugins::ITestPlugin1",
+                                  VersionRange()) == nullptr);
+}
+
+// Test: plugin catalog cache ----------------------------------------------------------------------
+
+void TestPluginCatalog::testCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString cacheFilePath = cacheDir.filePath("catalog.json");
+
+    // Missing cache is not an error
+    PluginCatalog catalog1;
+    QVERIFY(catalog1.loadCache(cacheFilePath));
+
+    QVERIFY(catalog1.scan({ m_testPluginsPath }));
+    QVERIFY(catalog1.storeCache(cacheFilePath));
+
+    // Load the cache and rescan (no metadata needs to be read)
+    PluginCatalog catalog2;
+    QVERIFY(catalog2.loadCache(cacheFilePath));
+    QCOMPARE(catalog2.plugins().size(), static_cast<size_t>(2));
+
+    int metadataReads = -1;
+    QVERIFY(catalog2.scan({ m_testPluginsPath }, &metadataReads));
+    QCOMPARE(metadataReads, 0);
+    QCOMPARE(catalog2.plugins().size(), static_cast<size_t>(2));
+
+    // Corrupted cache
+    QFile cacheFile(cacheFilePath);
+    QVERIFY(cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    cacheFile.write("{ \"format\": 0 }");
+    cacheFile.close();
+
+    PluginCatalog catalog3;
+    QVERIFY(!catalog3.loadCache(cacheFilePath));
+}
+
+// Test: loading of plugins referenced by interface ------------------------------------------------
+
+void TestPluginCatalog::testLoadByInterface()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    // Prepare config
+    PluginConfig plugin1Config(QDir(m_testPluginsPath).filePath("TestPlugin1.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance1",
+                                       ConfigObjectNode { { "value", ConfigValueNode("value1") } })
+                               });
+
+    PluginConfig plugin2Config(QString(),
+                               VersionRange("^1.0"),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance2",
+                                       ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                                       { "instance1" })
+                               });
+    plugin2Config.setInterface("CppPluginFramework::TestPlugins::ITestPlugin2");
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(!pluginManagerConfig.isValid());
+
+    pluginManagerConfig.setPluginDirectories({ m_testPluginsPath });
+    pluginManagerConfig.setPluginCatalogCache(cacheDir.filePath("catalog.json"));
+    QVERIFY(pluginManagerConfig.isValid());
+
+    // Load and start plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QCOMPARE(pluginManager.pluginCatalog().plugins().size(), static_cast<size_t>(2));
+    QVERIFY(QFileInfo::exists(cacheDir.filePath("catalog.json")));
+
+    QVERIFY(pluginManager.start());
+
+    auto *instance2 = pluginManager.pluginInstance("instance2");
+    QVERIFY(instance2 != nullptr);
+    QCOMPARE(instance2->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+             QStringLiteral("value1"));
+
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestPluginCatalog)
+#include "testPluginCatalog.moc"
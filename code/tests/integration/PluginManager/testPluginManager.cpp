@@ -19,24 +19,42 @@
  */
 
 // C++ Plugin Framework includes
+#include <CppPluginFramework/MetricsRegistry.hpp>
 #include <CppPluginFramework/PluginManager.hpp>
 #include <CppPluginFramework/PluginManagerConfig.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
 #include "../TestPlugins/ITestPlugin1.hpp"
+#include "../TestPlugins/ITestPlugin1Proxy.hpp"
 #include "../TestPlugins/ITestPlugin2.hpp"
+#include "../../common/AllocationCounter.hpp"
 
 // C++ Config Framework includes
 #include <CppConfigFramework/ConfigReader.hpp>
+#include <CppConfigFramework/ConfigValueNode.hpp>
 
 // Qt includes
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMap>
+#include <QtCore/QThread>
 #include <QtTest/QTest>
 
 // System includes
+#include <pthread.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
 
 // Forward declarations
 
 // Macros
 
+// Test types --------------------------------------------------------------------------------------
+
+Q_DECLARE_METATYPE(CppPluginFramework::PluginInstanceConfig::Cardinality)
+
 // Test class declaration --------------------------------------------------------------------------
 
 using namespace CppConfigFramework;
@@ -58,9 +76,25 @@ private slots:
     // Test functions
     void testLoad();
     void testLoadAfterStart();
+    void testTrace();
+    void testMetrics();
+    void testMemoryAccounting();
+    void testInstrumentedDependencies();
+    void testLatencyInjection();
+    void testSteadyStateAllocations();
+    void testLazyActivation();
+    void testFailedLazyActivation();
+    void testIdleEviction();
+    void testStartupProfile();
+    void testDeferredReadiness();
+    void testConcurrentPreparation();
+    void testAsyncOperations();
     void testLoadPluginsWithInvalidConfig();
     void testLoadPluginsWithUnsupportedDependency();
     void testLoadPluginsWithInvalidStartupOrder();
+    void testLoadWithAutoWiring();
+    void testLoadWithUnresolvedAutoWiring();
+    void testLoadWithUnresolvedAutoWiring_data();
 };
 
 // Test Case init/cleanup methods ------------------------------------------------------------------
@@ -135,11 +169,41 @@ void TestPluginManager::testLoad()
     QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
              QStringLiteral("value1;value2"));
 
+    // Check startup analysis
+    const auto startupAnalysis = pluginManager.startupAnalysis();
+    QVERIFY(startupAnalysis.isValid());
+    QCOMPARE(startupAnalysis.criticalPath().size(), 2);
+    QCOMPARE(startupAnalysis.criticalPath().last(), QStringLiteral("instance3"));
+    QVERIFY(startupAnalysis.criticalPathDuration() <= startupAnalysis.totalDuration());
+    QVERIFY(startupAnalysis.toDot().contains("\"instance1\" -> \"instance3\""));
+
     // Stop plugins
     pluginManager.stop();
 
     // Unload plugins
     QVERIFY(pluginManager.unload());
+
+    // Check lifecycle timings
+    using Phase = LifecycleTimings::Phase;
+    const auto &timings = pluginManager.lifecycleTimings();
+
+    QCOMPARE(timings.histogram(Phase::ConfigValidation).count(), Q_UINT64_C(1));
+    QCOMPARE(timings.histogram(Phase::LibraryLoad).count(), Q_UINT64_C(2));
+    QCOMPARE(timings.histogram(Phase::CreateInstance).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::LoadConfig).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::VersionCheck).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::InjectDependency).count(), Q_UINT64_C(2));
+    QCOMPARE(timings.histogram(Phase::InjectDependency, "instance3").count(), Q_UINT64_C(2));
+    QCOMPARE(timings.histogram(Phase::Prepare).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::Start).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::Stop).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::Teardown).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.names(Phase::Start), QStringList({ "instance1", "instance2", "instance3" }));
+
+    QVERIFY(timings.toJson().value("phases").toObject().contains("library_load"));
+
+    pluginManager.clearLifecycleTimings();
+    QCOMPARE(pluginManager.lifecycleTimings().histogram(Phase::Start).count(), Q_UINT64_C(0));
 }
 
 // Test: loading of plugins after the plugins were already started ---------------------------------
@@ -178,6 +242,1153 @@ void TestPluginManager::testLoadAfterStart()
     QVERIFY(pluginManager.unload());
 }
 
+// Test: trace of the plugin lifecycle -------------------------------------------------------------
+
+void TestPluginManager::testTrace()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfig.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    // Execute the whole lifecycle while recording the trace
+    TraceRecorder::instance().start();
+
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+
+    TraceRecorder::instance().stop();
+
+    // Check the trace
+    QStringList eventNames;
+    QString pluginSpanInstance;
+    QStringList startSlices;
+    QStringList flowStarts;
+    int flowCount = 0;
+
+    const QJsonArray traceEvents =
+            TraceRecorder::instance().toJson().value("traceEvents").toArray();
+
+    for (const QJsonValue &value : traceEvents)
+    {
+        const QJsonObject event = value.toObject();
+        const QString type = event.value("ph").toString();
+
+        // Slices and flow events are identified by their thread and timestamp
+        const QString slice = event.value("tid").toVariant().toString() + '/' +
+                              event.value("ts").toVariant().toString();
+
+        if (type == QStringLiteral("X"))
+        {
+            eventNames.append(event.value("name").toString());
+
+            if (event.value("name").toString().startsWith(QStringLiteral("start ")))
+            {
+                startSlices.append(slice);
+            }
+
+            if (event.value("cat").toString() == QStringLiteral("plugin"))
+            {
+                pluginSpanInstance = event.value("args").toObject().value("instance").toString();
+            }
+        }
+        else if (type == QStringLiteral("s"))
+        {
+            flowStarts.append(slice);
+            flowCount++;
+        }
+    }
+
+    for (const QString &name : { "load", "start", "stop", "unload", "config_validation",
+                                 "create_instance instance1", "load_config instance2",
+                                 "inject_dependency instance3", "prepare instance2",
+                                 "start instance1",
+                                 "start instance3", "stop instance2", "teardown instance3",
+                                 "check_dependencies" })
+    {
+        QVERIFY2(eventNames.contains(name), qPrintable(name));
+    }
+
+    // Plugin span is recorded for the plugin instance that emitted it
+    QCOMPARE(pluginSpanInstance, QStringLiteral("instance3"));
+
+    // Dependencies of instance3 are shown as flows that start at the slices of their starts
+    QCOMPARE(flowCount, 2);
+
+    for (const QString &flowStart : qAsConst(flowStarts))
+    {
+        QVERIFY2(startSlices.contains(flowStart), qPrintable(flowStart));
+    }
+
+    TraceRecorder::instance().clear();
+}
+
+// Test: metrics of the plugin lifecycle -----------------------------------------------------------
+
+void TestPluginManager::testMetrics()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfig.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    MetricsRegistry::instance().reset();
+
+    // Load and start plugins and use a plugin instance that records its own metrics
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    auto instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+    instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues();
+
+    // Check the metrics
+    QMap<QString, MetricsRegistry::MetricSnapshot> metrics;
+
+    for (const auto &snapshot : pluginManager.metricsSnapshot())
+    {
+        metrics.insert(snapshot.name + '/' + snapshot.instance, snapshot);
+    }
+
+    QCOMPARE(metrics.value("cppplugin_manager_loads/").value, Q_INT64_C(1));
+    QCOMPARE(metrics.value("cppplugin_manager_load_failures/").value, Q_INT64_C(0));
+    QCOMPARE(metrics.value("cppplugin_manager_load_duration_nanoseconds/").count, Q_UINT64_C(1));
+    QCOMPARE(metrics.value("cppplugin_plugin_instances_loaded/").value, Q_INT64_C(3));
+    QCOMPARE(metrics.value("cppplugin_plugin_instances_started/").value, Q_INT64_C(3));
+
+    for (const QString &instanceName : { "instance1", "instance2", "instance3" })
+    {
+        const auto histogram =
+                metrics.value("cppplugin_plugin_start_duration_nanoseconds/" + instanceName);
+        QCOMPARE(histogram.count, Q_UINT64_C(1));
+    }
+
+    QCOMPARE(metrics.value("test_plugin2_joined_values/instance3").value, Q_INT64_C(1));
+    QVERIFY(MetricsRegistry::toOpenMetrics(pluginManager.metricsSnapshot())
+            .contains("test_plugin2_joined_values_total{instance=\"instance3\"} 1\n"));
+
+    // Stop plugins
+    pluginManager.stop();
+    metrics.clear();
+
+    for (const auto &snapshot : pluginManager.metricsSnapshot())
+    {
+        metrics.insert(snapshot.name + '/' + snapshot.instance, snapshot);
+    }
+
+    QCOMPARE(metrics.value("cppplugin_plugin_instances_started/").value, Q_INT64_C(0));
+    QCOMPARE(metrics.value("cppplugin_plugin_stop_duration_nanoseconds/instance2").count,
+             Q_UINT64_C(1));
+
+    // Unload plugins
+    QVERIFY(pluginManager.unload());
+    metrics.clear();
+
+    for (const auto &snapshot : pluginManager.metricsSnapshot())
+    {
+        metrics.insert(snapshot.name + '/' + snapshot.instance, snapshot);
+    }
+
+    // Metrics of the unloaded plugin instances are no longer included
+    QVERIFY(!metrics.contains("test_plugin2_joined_values/instance3"));
+    QCOMPARE(metrics.value("cppplugin_plugin_instances_loaded/").value, Q_INT64_C(0));
+}
+
+// Test: memory accounting of the plugin instances -------------------------------------------------
+
+void TestPluginManager::testMemoryAccounting()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfig.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    // Load and start plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    // Each loaded plugin instance has an account
+    QStringList accountedInstances;
+
+    for (const auto &stats : pluginManager.memoryAllocationStats())
+    {
+        accountedInstances.append(stats.instance);
+
+        if (MemoryAccounting::isAllocatorInterposed())
+        {
+            QVERIFY(stats.allocationCount > 0U);
+        }
+    }
+
+    QCOMPARE(accountedInstances, QStringList({"instance1", "instance2", "instance3"}));
+
+    // Libraries of the plugin instances are mapped
+    QVERIFY(pluginManager.pluginLibraryPath("instance1").endsWith(".plugin"));
+    QVERIFY(pluginManager.pluginLibraryPath("unknown").isEmpty());
+
+#if defined(Q_OS_LINUX)
+    const auto mappings = pluginManager.pluginLibraryMappings();
+    QCOMPARE(mappings.size(), static_cast<size_t>(2));
+
+    for (const auto &mapping : mappings)
+    {
+        QVERIFY(mapping.filePath.endsWith(".plugin"));
+        QVERIFY(mapping.mappedBytes > 0U);
+    }
+#endif
+
+    // Stats of the unloaded plugin instances are no longer included
+    QVERIFY(pluginManager.unload());
+    QVERIFY(pluginManager.memoryAllocationStats().empty());
+    QVERIFY(pluginManager.pluginLibraryMappings().empty());
+}
+
+// Test: instrumented dependencies -----------------------------------------------------------------
+
+void TestPluginManager::testInstrumentedDependencies()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfig.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    // Register the proxy and measure the latency of every other call
+    auto &proxyRegistry = ProxyRegistry::instance();
+    QVERIFY(proxyRegistry.registerProxy<TestPlugins::ITestPlugin1Proxy>(
+                "CppPluginFramework::TestPlugins::ITestPlugin1"));
+    proxyRegistry.setSamplingRate(2);
+    proxyRegistry.reset();
+
+    // Load and start plugins with only one instrumented dependency edge
+    PluginManager pluginManager;
+    pluginManager.instrumentDependency("instance3", "instance1");
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    auto instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+
+    const QString joinedValues = instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues();
+
+    for (int i = 0; i < 4; i++)
+    {
+        QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+                 joinedValues);
+    }
+
+    // Check the call stats
+    const auto callStats = pluginManager.callStats();
+    QCOMPARE(callStats.size(), static_cast<size_t>(1));
+
+    const auto &stats = callStats.front();
+    QCOMPARE(stats.caller, QString("instance3"));
+    QCOMPARE(stats.callee, QString("instance1"));
+    QCOMPARE(stats.interface, QString("CppPluginFramework::TestPlugins::ITestPlugin1"));
+    QCOMPARE(stats.method, QString("value"));
+    QCOMPARE(stats.callCount, Q_UINT64_C(5));
+    QCOMPARE(stats.sampledCount, Q_UINT64_C(3));
+    QVERIFY(stats.maxDuration >= stats.meanDuration());
+    QCOMPARE(stats.estimatedTotalDuration(), stats.meanDuration() * Q_INT64_C(5));
+
+    // Call stats of the unloaded plugin instances are no longer included
+    QVERIFY(pluginManager.unload());
+    QVERIFY(pluginManager.callStats().empty());
+
+    proxyRegistry.unregisterProxy("CppPluginFramework::TestPlugins::ITestPlugin1");
+    proxyRegistry.setSamplingRate(100);
+}
+
+// Test: latency injection from the config ---------------------------------------------------------
+
+void TestPluginManager::testLatencyInjection()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfigWithLatencyInjection.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+    QCOMPARE(pluginManagerConfig.latencyInjectionConfigs().size(), 1);
+
+    // Calls are delayed through the proxy (latency of every call is measured)
+    auto &proxyRegistry = ProxyRegistry::instance();
+    QVERIFY(proxyRegistry.registerProxy<TestPlugins::ITestPlugin1Proxy>(
+                "CppPluginFramework::TestPlugins::ITestPlugin1"));
+    proxyRegistry.setSamplingRate(1);
+    proxyRegistry.reset();
+
+    // Load, start and stop plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    auto instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+    QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+             QString("value1;value2"));
+
+    pluginManager.stop();
+
+    // Check the delays of the lifecycle operations
+    using Phase = LifecycleTimings::Phase;
+    const auto &timings = pluginManager.lifecycleTimings();
+
+    QVERIFY(timings.histogram(Phase::LoadConfig, "instance1").min() >= Q_INT64_C(10000000));
+    QVERIFY(timings.histogram(Phase::Start, "instance1").min() >= Q_INT64_C(20000000));
+    QVERIFY(timings.histogram(Phase::Stop, "instance1").min() >= Q_INT64_C(30000000));
+    QVERIFY(timings.histogram(Phase::Start, "instance2").max() < Q_INT64_C(20000000));
+
+    // Check the delay of the call (only the edge to the delayed plugin instance is instrumented)
+    const auto callStats = pluginManager.callStats();
+    QCOMPARE(callStats.size(), static_cast<size_t>(1));
+    QCOMPARE(callStats.front().callee, QString("instance1"));
+    QCOMPARE(callStats.front().callCount, Q_UINT64_C(1));
+    QVERIFY(callStats.front().maxDuration >= Q_INT64_C(5000000));
+
+    QVERIFY(pluginManager.unload());
+
+    proxyRegistry.unregisterProxy("CppPluginFramework::TestPlugins::ITestPlugin1");
+    proxyRegistry.setSamplingRate(100);
+}
+
+// Test: steady-state APIs do not allocate --------------------------------------------------------
+
+void TestPluginManager::testSteadyStateAllocations()
+{
+    if (!TestUtils::AllocationCounter::isMallocInterposed())
+    {
+        QSKIP("malloc() is not interposed on this platform");
+    }
+
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfig.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    {},
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    // Load and start plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    // Arguments are created before the measurement
+    const QString instanceName("instance1");
+    const QString unknownInstanceName("unknown");
+    const QString interface("CppPluginFramework::TestPlugins::ITestPlugin1");
+    const QString unknownInterface("CppPluginFramework::TestPlugins::IUnknown");
+
+    IPlugin *instance = pluginManager.pluginInstance(instanceName);
+    QVERIFY(instance != nullptr);
+
+    // Warm up
+    QVERIFY(pluginManager.hasPluginInstance(instanceName));
+    QVERIFY(instance->isStarted());
+    QVERIFY(instance->isInterfaceExported(interface));
+    QVERIFY(instance->interface<TestPlugins::ITestPlugin1>() != nullptr);
+
+    // Measure
+    TestUtils::AllocationCounter counter;
+    int failureCount = 0;
+
+    for (int i = 0; i < 100; i++)
+    {
+        failureCount += (pluginManager.pluginInstance(instanceName) == instance) ? 0 : 1;
+        failureCount += (pluginManager.pluginInstance(unknownInstanceName) == nullptr) ? 0 : 1;
+        failureCount += pluginManager.hasPluginInstance(instanceName) ? 0 : 1;
+        failureCount += pluginManager.hasPluginInstance(unknownInstanceName) ? 1 : 0;
+        failureCount += instance->isStarted() ? 0 : 1;
+        failureCount += instance->isInterfaceExported(interface) ? 0 : 1;
+        failureCount += instance->isInterfaceExported(unknownInterface) ? 1 : 0;
+        failureCount += (instance->interface<TestPlugins::ITestPlugin1>() != nullptr) ? 0 : 1;
+        failureCount += (instance->interface<TestPlugins::ITestPlugin2>() == nullptr) ? 0 : 1;
+    }
+
+    const quint64 allocationCount = counter.allocationCount();
+
+    QCOMPARE(failureCount, 0);
+    QCOMPARE(allocationCount, Q_UINT64_C(0));
+
+    // Stop and unload plugins
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: lazy activation of plugin instances -------------------------------------------------------
+
+void TestPluginManager::testLazyActivation()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginInstanceConfig instance2Config(
+                "instance2",
+                ConfigObjectNode { { "value", ConfigValueNode("value2") } });
+    instance2Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+
+    PluginInstanceConfig instance3Config(
+                "instance3",
+                ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                {},
+                {
+                    {
+                        "CppPluginFramework::TestPlugins::ITestPlugin1",
+                        PluginInstanceConfig::Cardinality::All
+                    }
+                });
+    instance3Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+
+    PluginConfig plugin1Config(QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance1",
+                                       ConfigObjectNode { { "value", ConfigValueNode("value1") } }),
+                                   instance2Config
+                               });
+
+    PluginConfig plugin2Config(QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                               VersionInfo(1, 0, 0),
+                               { instance3Config });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    // Load plugins (lazy plugin instances are only registered)
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+
+    QCOMPARE(pluginManager.pluginInstanceNames(),
+             QStringList({ "instance1", "instance2", "instance3" }));
+    QVERIFY(pluginManager.hasPluginInstance("instance3"));
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance1"));
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance2"));
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance3"));
+    QCOMPARE(pluginManager.interfaceProviders("CppPluginFramework::TestPlugins::ITestPlugin1"),
+             QStringList({ "instance1", "instance2" }));
+    QCOMPARE(pluginManager.pluginStartupOrder().size(), 3);
+
+    // Start plugins (lazy plugin instances are not started yet)
+    QVERIFY(pluginManager.start());
+
+    using Phase = LifecycleTimings::Phase;
+    const auto &timings = pluginManager.lifecycleTimings();
+
+    QCOMPARE(timings.names(Phase::CreateInstance), QStringList({ "instance1" }));
+    QCOMPARE(timings.names(Phase::Start), QStringList({ "instance1" }));
+
+    // Concurrent lookups activate the plugin instance and its lazy dependency exactly once
+    std::vector<IPlugin *> instances(8U, nullptr);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0U; i < instances.size(); i++)
+    {
+        threads.emplace_back([&pluginManager, &instances, i]()
+        {
+            instances[i] = pluginManager.pluginInstance("instance3");
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    auto *instance3 = instances.front();
+    QVERIFY(instance3 != nullptr);
+
+    for (auto *instance : instances)
+    {
+        QCOMPARE(instance, instance3);
+    }
+
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance2"));
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance3"));
+    QVERIFY(pluginManager.pluginInstance("instance2")->isStarted());
+    QVERIFY(instance3->isStarted());
+    QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+             QStringLiteral("value1;value2"));
+
+    QCOMPARE(timings.histogram(Phase::CreateInstance).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::InjectDependency, "instance3").count(), Q_UINT64_C(2));
+    QCOMPARE(timings.names(Phase::Start), QStringList({ "instance1", "instance2", "instance3" }));
+
+    // Stop and unload plugins
+    pluginManager.stop();
+    QVERIFY(!instance3->isStarted());
+
+    QVERIFY(pluginManager.unload());
+    QVERIFY(pluginManager.pluginInstanceNames().isEmpty());
+    QCOMPARE(timings.histogram(Phase::Teardown).count(), Q_UINT64_C(3));
+}
+
+// Test: failed activation of lazy plugin instances ------------------------------------------------
+
+void TestPluginManager::testFailedLazyActivation()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    // Dependencies cannot be injected into the test plugin 1 so the activation of instance2 fails
+    PluginInstanceConfig instance2Config(
+                "instance2",
+                ConfigObjectNode { { "value", ConfigValueNode("value2") } },
+                { "instance1" });
+    instance2Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+
+    PluginInstanceConfig instance3Config(
+                "instance3",
+                ConfigObjectNode { { "value", ConfigValueNode("value3") } });
+    instance3Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+
+    PluginConfig plugin1Config(QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance1",
+                                       ConfigObjectNode
+                                       {
+                                           { "value", ConfigValueNode("value1") },
+                                           { "ready_delay_ms", ConfigValueNode(1000) }
+                                       }),
+                                   instance2Config,
+                                   instance3Config
+                               });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    MetricsRegistry::instance().reset();
+
+    // Load and start plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    // Lookup of instance2 waits for the readiness of instance1 without blocking other lookups
+    QElapsedTimer timer;
+    timer.start();
+
+    auto instance2Future = std::async(std::launch::async, [&pluginManager]()
+    {
+        return pluginManager.pluginInstance("instance2");
+    });
+
+    QThread::msleep(100);
+
+    auto *instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+    QVERIFY(instance3->isStarted());
+    QVERIFY(timer.elapsed() < 1000);
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance2"));
+
+    // Failed activation is rolled back and it is not repeated
+    QVERIFY(instance2Future.get() == nullptr);
+    QVERIFY(pluginManager.pluginInstance("instance2") == nullptr);
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance2"));
+
+    QMap<QString, MetricsRegistry::MetricSnapshot> metrics;
+
+    for (const auto &snapshot : pluginManager.metricsSnapshot())
+    {
+        metrics.insert(snapshot.name + '/' + snapshot.instance, snapshot);
+    }
+
+    QCOMPARE(metrics.value("cppplugin_plugin_instances_loaded/").value, Q_INT64_C(2));
+
+    // Stop and unload plugins
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+
+    // Activation fails if a dependency does not become ready within the readiness timeout
+    pluginManagerConfig.setReadinessTimeout(100);
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    timer.restart();
+    QVERIFY(pluginManager.pluginInstance("instance2") == nullptr);
+    QVERIFY(timer.elapsed() < 1000);
+    QVERIFY(pluginManager.pluginInstance("instance2") == nullptr);
+
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: eviction of idle plugin instances ---------------------------------------------------------
+
+void TestPluginManager::testIdleEviction()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginInstanceConfig instance2Config(
+                "instance2",
+                ConfigObjectNode { { "value", ConfigValueNode("value2") } });
+    instance2Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+    instance2Config.setIdleTimeout(200);
+
+    PluginInstanceConfig instance3Config(
+                "instance3",
+                ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                {},
+                {
+                    {
+                        "CppPluginFramework::TestPlugins::ITestPlugin1",
+                        PluginInstanceConfig::Cardinality::All
+                    }
+                });
+    instance3Config.setActivation(PluginInstanceConfig::Activation::Lazy);
+    instance3Config.setIdleTimeout(200);
+
+    PluginConfig plugin1Config(QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance1",
+                                       ConfigObjectNode { { "value", ConfigValueNode("value1") } }),
+                                   instance2Config
+                               });
+
+    PluginConfig plugin2Config(QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                               VersionInfo(1, 0, 0),
+                               { instance3Config });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    // Load and start plugins and activate the lazy plugin instances
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(pluginManager.start());
+
+    QVERIFY(pluginManager.pluginInstance("instance3") != nullptr);
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance2"));
+    QCOMPARE(pluginManager.evictIdleInstances(), 0);
+
+    // Idle plugin instance is pinned while its dependent is activated
+    QTest::qSleep(300);
+    QVERIFY(pluginManager.pluginInstance("instance3") != nullptr);
+
+    QCOMPARE(pluginManager.evictIdleInstances(), 0);
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance2"));
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance3"));
+
+    // Whole idle dependency chain is evicted (eager plugin instances are never evicted)
+    QTest::qSleep(300);
+
+    QCOMPARE(pluginManager.evictIdleInstances(), 2);
+    QVERIFY(pluginManager.isPluginInstanceActivated("instance1"));
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance2"));
+    QVERIFY(!pluginManager.isPluginInstanceActivated("instance3"));
+    QVERIFY(pluginManager.hasPluginInstance("instance3"));
+
+    using Phase = LifecycleTimings::Phase;
+    const auto &timings = pluginManager.lifecycleTimings();
+
+    QCOMPARE(timings.histogram(Phase::Stop).count(), Q_UINT64_C(2));
+    QCOMPARE(timings.histogram(Phase::Teardown).count(), Q_UINT64_C(2));
+
+    // Next lookup activates the evicted plugin instances again
+    auto *instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+    QVERIFY(instance3->isStarted());
+    QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+             QStringLiteral("value1;value2"));
+    QCOMPARE(timings.histogram(Phase::CreateInstance, "instance3").count(), Q_UINT64_C(2));
+
+    // Stop and unload plugins
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: startup profiles --------------------------------------------------------------------------
+
+void TestPluginManager::testStartupProfile()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginConfig plugin1Config(
+                QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance1",
+                        ConfigObjectNode { { "value", ConfigValueNode("value1") } }),
+                    PluginInstanceConfig(
+                        "instance2",
+                        ConfigObjectNode { { "value", ConfigValueNode("value2") } })
+                });
+
+    PluginConfig plugin2Config(
+                QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance3",
+                        ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                        { "instance2" }),
+                    PluginInstanceConfig(
+                        "instance4",
+                        ConfigObjectNode { { "delimiter", ConfigValueNode(",") } },
+                        {},
+                        {
+                            {
+                                "CppPluginFramework::TestPlugins::ITestPlugin1",
+                                PluginInstanceConfig::Cardinality::All
+                            }
+                        })
+                });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    pluginManagerConfig.setPluginStartupPriorities({ "instance1", "instance2" });
+    pluginManagerConfig.setStartupProfiles(
+                {
+                    StartupProfileConfig("cli", { "instance1" }),
+                    StartupProfileConfig("tool", { "instance3" }),
+                    StartupProfileConfig("server", { "instance4" })
+                });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    // Only the root is loaded and the library of the unreachable plugin instances is not loaded
+    {
+        PluginManager pluginManager;
+        QVERIFY(pluginManager.load(pluginManagerConfig, "cli"));
+
+        QCOMPARE(pluginManager.pluginInstanceNames(), QStringList({ "instance1" }));
+        QCOMPARE(pluginManager.pluginStartupOrder(), QStringList({ "instance1" }));
+        QVERIFY(pluginManager.pluginLibraryPath("instance3").isEmpty());
+
+        QVERIFY(pluginManager.start());
+        pluginManager.stop();
+        QVERIFY(pluginManager.unload());
+    }
+
+    // Explicit dependencies are followed
+    {
+        PluginManager pluginManager;
+        QVERIFY(pluginManager.load(pluginManagerConfig, "tool"));
+
+        QCOMPARE(pluginManager.pluginInstanceNames(), QStringList({ "instance2", "instance3" }));
+        QCOMPARE(pluginManager.pluginStartupOrder(), QStringList({ "instance2", "instance3" }));
+
+        QVERIFY(pluginManager.start());
+
+        auto *instance3 = pluginManager.pluginInstance("instance3");
+        QVERIFY(instance3 != nullptr);
+        QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+                 QStringLiteral("value2"));
+
+        pluginManager.stop();
+        QVERIFY(pluginManager.unload());
+    }
+
+    // Providers of the required interfaces are followed
+    {
+        PluginManager pluginManager;
+        QVERIFY(pluginManager.load(pluginManagerConfig, "server"));
+
+        QCOMPARE(pluginManager.pluginInstanceNames(),
+                 QStringList({ "instance1", "instance2", "instance4" }));
+        QVERIFY(pluginManager.start());
+        pluginManager.stop();
+        QVERIFY(pluginManager.unload());
+    }
+
+    // Startup profile needs to be defined
+    {
+        PluginManager pluginManager;
+        QVERIFY(!pluginManager.load(pluginManagerConfig, "unknown"));
+        QVERIFY(pluginManager.pluginInstanceNames().isEmpty());
+    }
+}
+
+// Test: deferred readiness ------------------------------------------------------------------------
+
+void TestPluginManager::testDeferredReadiness()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginConfig plugin1Config(
+                QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance1",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value1") },
+                            { "ready_delay_ms", ConfigValueNode(300) }
+                        }),
+                    PluginInstanceConfig(
+                        "instance2",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value2") },
+                            { "ready_delay_ms", ConfigValueNode(300) }
+                        }),
+                    PluginInstanceConfig(
+                        "instance4",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value4") },
+                            { "ready_delay_ms", ConfigValueNode(800) }
+                        })
+                });
+
+    PluginConfig plugin2Config(
+                QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance3",
+                        ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                        { "instance1", "instance2" })
+                });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    QVERIFY(!pluginManager.readyFuture().get());
+
+    // Dependent is started after its dependencies are ready, their warm-ups overlap
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(pluginManager.start());
+    const qint64 startDuration = timer.elapsed();
+
+    QVERIFY(startDuration >= 300);
+    QVERIFY(startDuration < 600);
+
+    auto *instance1 = pluginManager.pluginInstance("instance1");
+    auto *instance3 = pluginManager.pluginInstance("instance3");
+    auto *instance4 = pluginManager.pluginInstance("instance4");
+    QVERIFY(instance1 != nullptr);
+    QVERIFY(instance3 != nullptr);
+    QVERIFY(instance4 != nullptr);
+
+    QVERIFY(instance3->isStarted());
+    QVERIFY(instance3->readiness() == nullptr);
+    QCOMPARE(instance1->readiness()->state(), Readiness::State::Ready);
+
+    // Plugin instance without dependents can still be warming up
+    auto readyFuture = pluginManager.readyFuture();
+    QCOMPARE(instance4->readiness()->state(), Readiness::State::Pending);
+    QVERIFY(readyFuture.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready);
+
+    QVERIFY(readyFuture.get());
+    QCOMPARE(instance4->readiness()->state(), Readiness::State::Ready);
+    QVERIFY(timer.elapsed() >= 800);
+
+    pluginManager.stop();
+
+    // Aggregate readiness fails if the plugin manager is stopped first
+    QVERIFY(pluginManager.start());
+    pluginManager.stop();
+    QVERIFY(!pluginManager.readyFuture().get());
+
+    QVERIFY(pluginManager.unload());
+
+    // Startup fails if the dependencies do not become ready within the readiness timeout
+    pluginManagerConfig.setReadinessTimeout(100);
+    QVERIFY(pluginManagerConfig.isValid());
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+
+    timer.restart();
+    QVERIFY(!pluginManager.start());
+    QVERIFY(timer.elapsed() < 300);
+    QVERIFY(!pluginManager.readyFuture().get());
+
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: concurrent preparation of plugin instances ------------------------------------------------
+
+void TestPluginManager::testConcurrentPreparation()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginConfig plugin1Config(
+                QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance1",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value1") },
+                            { "prepare_delay_ms", ConfigValueNode(300) }
+                        }),
+                    PluginInstanceConfig(
+                        "instance2",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value2") },
+                            { "prepare_delay_ms", ConfigValueNode(300) }
+                        })
+                });
+
+    PluginConfig plugin2Config(
+                QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance3",
+                        ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                        { "instance1", "instance2" })
+                });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    // Plugin instances are prepared when they are loaded (the calling thread takes part)
+    PluginManager pluginManager;
+
+#if defined(Q_OS_LINUX)
+    QVERIFY(CpuAccounting::instance().registerThread("caller", "test-caller"));
+#endif
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+    const qint64 loadDuration = timer.elapsed();
+
+    QVERIFY(loadDuration >= 300);
+
+#if defined(Q_OS_LINUX)
+    // Calling thread keeps its name and its registration in the CPU accounting
+    char threadName[16] = {};
+    pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+    QCOMPARE(QString(threadName), QString("test-caller"));
+
+    int callerThreadCount = 0;
+
+    for (const auto &stats : CpuAccounting::instance().snapshot())
+    {
+        if (stats.instance == "caller")
+        {
+            callerThreadCount = stats.threadCount;
+        }
+    }
+
+    CpuAccounting::instance().unregisterThread();
+    QCOMPARE(callerThreadCount, 1);
+#endif
+
+    // Preparations overlap if there are enough worker threads
+    if (QThread::idealThreadCount() >= 2)
+    {
+        QVERIFY(loadDuration < 600);
+    }
+
+    using Phase = LifecycleTimings::Phase;
+    const auto &timings = pluginManager.lifecycleTimings();
+
+    QCOMPARE(timings.histogram(Phase::Prepare).count(), Q_UINT64_C(3));
+    QVERIFY(timings.histogram(Phase::Prepare, "instance1").min() >= Q_INT64_C(300000000));
+    QVERIFY(timings.histogram(Phase::Prepare, "instance2").min() >= Q_INT64_C(300000000));
+
+    // Startup only contains the ordered work
+    timer.restart();
+    QVERIFY(pluginManager.start());
+    QVERIFY(timer.elapsed() < 300);
+
+    // Started plugin instance cannot be prepared again
+    auto *instance1 = pluginManager.pluginInstance("instance1");
+    QVERIFY(instance1 != nullptr);
+    QVERIFY(!instance1->prepare());
+
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: asynchronous operations -------------------------------------------------------------------
+
+void TestPluginManager::testAsyncOperations()
+{
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginConfig plugin1Config(
+                QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance1",
+                        ConfigObjectNode
+                        {
+                            { "value", ConfigValueNode("value1") },
+                            { "ready_delay_ms", ConfigValueNode(300) }
+                        }),
+                    PluginInstanceConfig(
+                        "instance2",
+                        ConfigObjectNode { { "value", ConfigValueNode("value2") } })
+                });
+
+    PluginConfig plugin2Config(
+                QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                VersionInfo(1, 0, 0),
+                {
+                    PluginInstanceConfig(
+                        "instance3",
+                        ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                        { "instance1", "instance2" })
+                });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    PluginManager pluginManager;
+
+    // Progress is reported from the executor thread (the future synchronizes with it)
+    QStringList loadedInstances;
+    int loadTotalCount = 0;
+
+    auto loadOperation = pluginManager.loadAsync(
+                             pluginManagerConfig,
+                             QString(),
+                             [&](const AsyncOperation::Progress &progress)
+                             {
+                                 loadedInstances.append(progress.instanceName);
+                                 loadTotalCount = progress.totalCount;
+                             });
+
+    QVERIFY(loadOperation->future().get());
+    QCOMPARE(loadOperation->state(), AsyncOperation::State::Succeeded);
+    loadedInstances.sort();
+    QCOMPARE(loadedInstances, QStringList({ "instance1", "instance2", "instance3" }));
+    QCOMPARE(loadTotalCount, 3);
+
+    // Loading fails without changing the already loaded plugins
+    auto reloadOperation = pluginManager.loadAsync(pluginManagerConfig);
+    QVERIFY(!reloadOperation->future().get());
+    QCOMPARE(reloadOperation->state(), AsyncOperation::State::Failed);
+    QVERIFY(pluginManager.hasPluginInstance("instance1"));
+
+    // Operation that is cancelled while it is queued is not executed
+    QStringList startedInstances;
+
+    auto startOperation = pluginManager.startAsync(
+                              [&](const AsyncOperation::Progress &progress)
+                              {
+                                  startedInstances.append(progress.instanceName);
+                              });
+    auto stopOperation = pluginManager.stopAsync();
+    stopOperation->cancel();
+
+    QVERIFY(startOperation->future().get());
+    QVERIFY(!stopOperation->future().get());
+    QCOMPARE(stopOperation->state(), AsyncOperation::State::Cancelled);
+    QCOMPARE(startedInstances.size(), 3);
+    QCOMPARE(startedInstances.last(), QStringLiteral("instance3"));
+
+    auto *instance1 = pluginManager.pluginInstance("instance1");
+    auto *instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance1 != nullptr);
+    QVERIFY(instance3 != nullptr);
+    QVERIFY(instance3->isStarted());
+
+    stopOperation = pluginManager.stopAsync();
+    QVERIFY(stopOperation->future().get());
+    QVERIFY(!instance1->isStarted());
+
+    // Startup that is cancelled while it waits for the readiness is rolled back
+    startOperation = pluginManager.startAsync();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    startOperation->cancel();
+
+    QVERIFY(!startOperation->future().get());
+    QCOMPARE(startOperation->state(), AsyncOperation::State::Cancelled);
+    QVERIFY(!instance1->isStarted());
+    QVERIFY(!instance3->isStarted());
+
+    // Unloading reports all plugin instances
+    int unloadedCount = 0;
+
+    auto unloadOperation = pluginManager.unloadAsync(
+                               [&](const AsyncOperation::Progress &progress)
+                               {
+                                   unloadedCount = progress.completedCount;
+                               });
+
+    QVERIFY(unloadOperation->future().get());
+    QCOMPARE(unloadedCount, 3);
+    QVERIFY(!pluginManager.hasPluginInstance("instance1"));
+}
+
 // Test: loading of plugins with invalid config ----------------------------------------------------
 
 void TestPluginManager::testLoadPluginsWithInvalidConfig()
@@ -236,8 +1447,123 @@ void TestPluginManager::testLoadPluginsWithInvalidStartupOrder()
     PluginManager pluginManager;
     QVERIFY(pluginManager.load(pluginManagerConfig));
 
-    // Start plugins (must fail)
-    QVERIFY(!pluginManager.start());
+    // Start plugins (dependencies of the prioritized instance are started before it)
+    QVERIFY(pluginManager.start());
+    QCOMPARE(pluginManager.pluginStartupOrder().last(), QString("instance3"));
+
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+}
+
+// Test: loading of plugins with auto-wired dependencies -------------------------------------------
+
+void TestPluginManager::testLoadWithAutoWiring()
+{
+    // First load the config
+    ConfigReader configReader;
+    EnvironmentVariables environmentVariables;
+
+    auto config = configReader.read(":/TestData/AppConfigWithAutoWiring.json",
+                                    QDir(QCoreApplication::applicationDirPath()),
+                                    ConfigNodePath::ROOT_PATH,
+                                    ConfigNodePath::ROOT_PATH,
+                                    std::vector<const ConfigObjectNode *>(),
+                                    &environmentVariables);
+    QVERIFY(config);
+
+    PluginManagerConfig pluginManagerConfig;
+    QVERIFY(pluginManagerConfig.loadConfig(*config));
+
+    // Load plugins
+    PluginManager pluginManager;
+    QVERIFY(pluginManager.load(pluginManagerConfig));
+
+    QCOMPARE(pluginManager.interfaceProviders("CppPluginFramework::TestPlugins::ITestPlugin1"),
+             QStringList({ "instance1", "instance2" }));
+    QCOMPARE(pluginManager.interfaceProviders("CppPluginFramework::TestPlugins::ITestPlugin2"),
+             QStringList({ "instance3" }));
+    QVERIFY(pluginManager.interfaceProviders("CppPluginFramework::TestPlugins::IUnknown")
+            .isEmpty());
+
+    // Start plugins
+    QVERIFY(pluginManager.start());
+
+    auto instance3 = pluginManager.pluginInstance("instance3");
+    QVERIFY(instance3 != nullptr);
+    QCOMPARE(instance3->interface<TestPlugins::ITestPlugin2>()->joinedValues(),
+             QStringLiteral("value1;value2"));
+
+    // Stop and unload plugins
+    pluginManager.stop();
+    QVERIFY(pluginManager.unload());
+    QVERIFY(pluginManager.interfaceProviders("CppPluginFramework::TestPlugins::ITestPlugin1")
+            .isEmpty());
+}
+
+// Test: loading of plugins with auto-wired dependencies that cannot be resolved -------------------
+
+void TestPluginManager::testLoadWithUnresolvedAutoWiring()
+{
+    QFETCH(QString, requiredInterface);
+    QFETCH(PluginInstanceConfig::Cardinality, cardinality);
+    QFETCH(bool, expectedResult);
+
+    const QString testPluginsPath = QDir(QCoreApplication::applicationDirPath())
+                                    .absoluteFilePath("../TestPlugins");
+
+    PluginConfig plugin1Config(QDir(testPluginsPath).filePath("TestPlugin1.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance1",
+                                       ConfigObjectNode { { "value", ConfigValueNode("value1") } }),
+                                   PluginInstanceConfig(
+                                       "instance2",
+                                       ConfigObjectNode { { "value", ConfigValueNode("value2") } })
+                               });
+
+    PluginConfig plugin2Config(QDir(testPluginsPath).filePath("TestPlugin2.plugin"),
+                               VersionInfo(1, 0, 0),
+                               {
+                                   PluginInstanceConfig(
+                                       "instance3",
+                                       ConfigObjectNode { { "delimiter", ConfigValueNode(";") } },
+                                       { "instance1" },
+                                       { { requiredInterface, cardinality } })
+                               });
+
+    PluginManagerConfig pluginManagerConfig;
+    pluginManagerConfig.setPluginConfigs({ plugin1Config, plugin2Config });
+    QVERIFY(pluginManagerConfig.isValid());
+
+    PluginManager pluginManager;
+    QCOMPARE(pluginManager.load(pluginManagerConfig), expectedResult);
+}
+
+void TestPluginManager::testLoadWithUnresolvedAutoWiring_data()
+{
+    QTest::addColumn<QString>("requiredInterface");
+    QTest::addColumn<PluginInstanceConfig::Cardinality>("cardinality");
+    QTest::addColumn<bool>("expectedResult");
+
+    const QString interface1 = "CppPluginFramework::TestPlugins::ITestPlugin1";
+    const QString interface2 = "CppPluginFramework::TestPlugins::ITestPlugin2";
+    const QString unknownInterface = "CppPluginFramework::TestPlugins::IUnknown";
+
+    QTest::newRow("ambiguous: one")
+            << interface1 << PluginInstanceConfig::Cardinality::One << false;
+    QTest::newRow("ambiguous: optional")
+            << interface1 << PluginInstanceConfig::Cardinality::Optional << false;
+    QTest::newRow("missing: one")
+            << unknownInterface << PluginInstanceConfig::Cardinality::One << false;
+    QTest::newRow("missing: all")
+            << unknownInterface << PluginInstanceConfig::Cardinality::All << false;
+    QTest::newRow("missing: optional")
+            << unknownInterface << PluginInstanceConfig::Cardinality::Optional << true;
+    QTest::newRow("self: optional")
+            << interface2 << PluginInstanceConfig::Cardinality::Optional << true;
+    QTest::newRow("self: one")
+            << interface2 << PluginInstanceConfig::Cardinality::One << false;
 }
 
 // Main function -----------------------------------------------------------------------------------
@@ -0,0 +1,60 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains the instrumented proxy of the interface for the "test plugin 1"
+ */
+
+#pragma once
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/InterfaceProxy.hpp>
+#include "ITestPlugin1.hpp"
+
+// Qt includes
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+namespace CppPluginFramework
+{
+namespace TestPlugins
+{
+
+class ITestPlugin1Proxy : public InterfaceProxy<ITestPlugin1>
+{
+public:
+    ITestPlugin1Proxy(const QString &callerName, IPlugin *target)
+        : InterfaceProxy("CppPluginFramework::TestPlugins::ITestPlugin1",
+                         {"value"},
+                         callerName,
+                         target)
+    {
+    }
+
+    QString value() const override
+    {
+        return call(0, [this]() { return target()->value(); });
+    }
+};
+
+} // namespace TestPlugins
+} // namespace CppPluginFramework
@@ -28,8 +28,10 @@
 #include <CedarFramework/Deserialization.hpp>
 
 // Qt includes
+#include <QtCore/QJsonObject>
 
 // System includes
+#include <chrono>
 
 // Forward declarations
 
@@ -60,6 +62,16 @@ TestPlugin1::TestPlugin1(const QString &name)
 
 // -------------------------------------------------------------------------------------------------
 
+TestPlugin1::~TestPlugin1()
+{
+    if (m_warmUpThread.joinable())
+    {
+        m_warmUpThread.join();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool TestPlugin1::loadConfig(const CppConfigFramework::ConfigObjectNode &config)
 {
     const auto jsonValue = CppConfigFramework::ConfigWriter::convertToJsonValue(config);
@@ -69,7 +81,29 @@ bool TestPlugin1::loadConfig(const CppConfigFramework::ConfigObjectNode &config)
         return false;
     }
 
-    return CedarFramework::deserializeNode(jsonValue, "value", &m_configuredValue);
+    if (!CedarFramework::deserializeNode(jsonValue, "value", &m_configuredValue))
+    {
+        return false;
+    }
+
+    // Optional delay of the preparation (simulates parsing of a large file)
+    m_prepareDelay = 0;
+
+    if (jsonValue.toObject().contains("prepare_delay_ms") &&
+        (!CedarFramework::deserializeNode(jsonValue, "prepare_delay_ms", &m_prepareDelay)))
+    {
+        return false;
+    }
+
+    // Optional delay of the readiness (simulates a warm-up)
+    m_readyDelay = 0;
+
+    if (jsonValue.toObject().contains("ready_delay_ms"))
+    {
+        return CedarFramework::deserializeNode(jsonValue, "ready_delay_ms", &m_readyDelay);
+    }
+
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -94,5 +128,46 @@ QString TestPlugin1::value() const
     return m_configuredValue;
 }
 
+// -------------------------------------------------------------------------------------------------
+
+bool TestPlugin1::onPrepare()
+{
+    if (m_prepareDelay > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_prepareDelay));
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool TestPlugin1::onStart()
+{
+    if (m_readyDelay > 0)
+    {
+        const auto readiness = deferReadiness();
+        const int readyDelay = m_readyDelay;
+
+        m_warmUpThread = std::thread([readiness, readyDelay]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(readyDelay));
+            readiness->setReady();
+        });
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TestPlugin1::onStop()
+{
+    if (m_warmUpThread.joinable())
+    {
+        m_warmUpThread.join();
+    }
+}
+
 } // namespace TestPlugins
 } // namespace CppPluginFramework
@@ -28,6 +28,7 @@
 // Qt includes
 
 // System includes
+#include <thread>
 
 // Forward declarations
 
@@ -44,7 +45,7 @@ class TestPlugin1 : public CppPluginFramework::AbstractPlugin, public ITestPlugi
 {
 public:
     TestPlugin1(const QString &name);
-    ~TestPlugin1() = default;
+    ~TestPlugin1() override;
 
     bool loadConfig(const CppConfigFramework::ConfigObjectNode &config) override;
     bool injectDependency(IPlugin *plugin) override;
@@ -52,8 +53,16 @@ public:
 
     virtual QString value() const override;
 
+private:
+    bool onPrepare() override;
+    bool onStart() override;
+    void onStop() override;
+
 private:
     QString m_configuredValue;
+    int m_prepareDelay = 0;
+    int m_readyDelay = 0;
+    std::thread m_warmUpThread;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -61,7 +70,7 @@ private:
 class Q_DECL_EXPORT PluginFactory : public QObject, public PluginFactoryTemplate<TestPlugin1>
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "CppPluginFramework::IPluginFactory")
+    Q_PLUGIN_METADATA(IID "CppPluginFramework::IPluginFactory" FILE "TestPlugin1.json")
     Q_INTERFACES(CppPluginFramework::IPluginFactory)
 
 public:
@@ -54,7 +54,9 @@ static const QSet<QString> s_exportedInterfaces
 // -------------------------------------------------------------------------------------------------
 
 TestPlugin2::TestPlugin2(const QString &name)
-    : CppPluginFramework::AbstractPlugin(name, s_version, s_description, s_exportedInterfaces)
+    : CppPluginFramework::AbstractPlugin(name, s_version, s_description, s_exportedInterfaces),
+      m_joinedValuesCounter(registerCounter("test_plugin2_joined_values",
+                                            "Number of joinedValues() calls"))
 {
 }
 
@@ -111,6 +113,8 @@ void TestPlugin2::ejectDependencies()
 
 QString TestPlugin2::joinedValues() const
 {
+    m_joinedValuesCounter.increment();
+
     QStringList values;
 
     for (auto *dependency : m_dependencies)
@@ -128,6 +132,8 @@ QString TestPlugin2::joinedValues() const
 
 bool TestPlugin2::onStart()
 {
+    auto span = traceSpan("check_dependencies");
+
     if (m_dependencies.isEmpty())
     {
         return false;
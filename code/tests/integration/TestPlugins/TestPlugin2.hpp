@@ -59,6 +59,7 @@ private:
 private:
     QString m_configuredDelimiter;
     QList<IPlugin*> m_dependencies;
+    MetricsRegistry::Counter m_joinedValuesCounter;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -66,7 +67,7 @@ private:
 class Q_DECL_EXPORT PluginFactory : public QObject, public PluginFactoryTemplate<TestPlugin2>
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "CppPluginFramework::IPluginFactory")
+    Q_PLUGIN_METADATA(IID "CppPluginFramework::IPluginFactory" FILE "TestPlugin2.json")
     Q_INTERFACES(CppPluginFramework::IPluginFactory)
 
 public:
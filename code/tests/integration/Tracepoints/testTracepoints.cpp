@@ -0,0 +1,258 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains integration tests for the USDT tracepoints in the C++ Plugin Framework library
+ */
+
+// C++ Plugin Framework includes
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QMap>
+#include <QtTest/QTest>
+
+// System includes
+#include <elf.h>
+#include <cstring>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+class TestTracepoints : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testTracepoint();
+    void testTracepoint_data();
+
+private:
+    //! Tracepoint read from the ELF notes
+    struct Tracepoint
+    {
+        //! Address of the semaphore
+        quint64 semaphore;
+
+        //! Number of arguments
+        int argumentCount;
+    };
+
+    /*!
+     * Reads the tracepoints of the "cppplugin" provider from the ELF notes of the library
+     *
+     * \param       filePath    Path to the library
+     * \param[out]  tracepoints Tracepoints keyed by name
+     *
+     * \retval  true    Success
+     * \retval  false   Failure
+     */
+    static bool readTracepoints(const QString &filePath, QMap<QString, Tracepoint> *tracepoints);
+
+private:
+    //! Holds the tracepoints read from the library
+    QMap<QString, Tracepoint> m_tracepoints;
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestTracepoints::initTestCase()
+{
+    QVERIFY(readTracepoints(CPPPLUGINFRAMEWORK_LIBRARY_PATH, &m_tracepoints));
+}
+
+void TestTracepoints::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestTracepoints::init()
+{
+}
+
+void TestTracepoints::cleanup()
+{
+}
+
+// Test: tracepoints in the ELF notes --------------------------------------------------------------
+
+void TestTracepoints::testTracepoint()
+{
+    QFETCH(QString, name);
+    QFETCH(int, argumentCount);
+
+    QVERIFY2(m_tracepoints.contains(name), qPrintable(name));
+
+    const Tracepoint tracepoint = m_tracepoints.value(name);
+    QCOMPARE(tracepoint.argumentCount, argumentCount);
+
+    // Arguments are converted only while a tracer is attached so each tracepoint needs a semaphore
+    QVERIFY(tracepoint.semaphore != 0U);
+}
+
+void TestTracepoints::testTracepoint_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<int>("argumentCount");
+
+    QTest::newRow("load_instances_begin") << "load_instances_begin" << 1;
+    QTest::newRow("load_instances_end") << "load_instances_end" << 2;
+    QTest::newRow("load_instance_begin") << "load_instance_begin" << 2;
+    QTest::newRow("load_instance_end") << "load_instance_end" << 3;
+    QTest::newRow("inject_dependencies_begin") << "inject_dependencies_begin" << 2;
+    QTest::newRow("inject_dependencies_end") << "inject_dependencies_end" << 2;
+    QTest::newRow("manager_start_begin") << "manager_start_begin" << 1;
+    QTest::newRow("manager_start_end") << "manager_start_end" << 1;
+    QTest::newRow("manager_stop_begin") << "manager_stop_begin" << 1;
+    QTest::newRow("manager_stop_end") << "manager_stop_end" << 0;
+    QTest::newRow("plugin_start_begin") << "plugin_start_begin" << 1;
+    QTest::newRow("plugin_start_end") << "plugin_start_end" << 2;
+    QTest::newRow("plugin_stop_begin") << "plugin_stop_begin" << 1;
+    QTest::newRow("plugin_stop_end") << "plugin_stop_end" << 1;
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+bool TestTracepoints::readTracepoints(const QString &filePath,
+                                      QMap<QString, Tracepoint> *tracepoints)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Failed to open the library:" << filePath;
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    const auto size = static_cast<size_t>(data.size());
+
+    // Only 64-bit ELF files are supported
+    if ((size < sizeof(Elf64_Ehdr)) ||
+        (std::memcmp(data.constData(), ELFMAG, SELFMAG) != 0) ||
+        (data.at(EI_CLASS) != ELFCLASS64))
+    {
+        qWarning() << "Library is not a 64-bit ELF file:" << filePath;
+        return false;
+    }
+
+    Elf64_Ehdr header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+
+    const size_t sectionTableEnd = header.e_shoff + header.e_shnum * sizeof(Elf64_Shdr);
+
+    if ((header.e_shstrndx >= header.e_shnum) || (sectionTableEnd > size))
+    {
+        qWarning() << "Invalid section table:" << filePath;
+        return false;
+    }
+
+    auto section = [&data, &header](const size_t index)
+    {
+        Elf64_Shdr sectionHeader;
+        std::memcpy(&sectionHeader,
+                    data.constData() + header.e_shoff + index * sizeof(Elf64_Shdr),
+                    sizeof(sectionHeader));
+        return sectionHeader;
+    };
+
+    const Elf64_Shdr stringTable = section(header.e_shstrndx);
+
+    for (size_t i = 0; i < header.e_shnum; i++)
+    {
+        const Elf64_Shdr noteSection = section(i);
+
+        if ((noteSection.sh_type != SHT_NOTE) ||
+            (stringTable.sh_offset + noteSection.sh_name >= size) ||
+            (std::strcmp(data.constData() + stringTable.sh_offset + noteSection.sh_name,
+                         ".note.stapsdt") != 0) ||
+            (noteSection.sh_offset + noteSection.sh_size > size))
+        {
+            continue;
+        }
+
+        // Each note holds: PC, base address and semaphore address followed by the provider, name
+        // and argument strings
+        size_t offset = noteSection.sh_offset;
+        const size_t end = noteSection.sh_offset + noteSection.sh_size;
+
+        while (offset + sizeof(Elf64_Nhdr) <= end)
+        {
+            Elf64_Nhdr noteHeader;
+            std::memcpy(&noteHeader, data.constData() + offset, sizeof(noteHeader));
+
+            const size_t nameOffset = offset + sizeof(noteHeader);
+            const size_t descOffset = nameOffset + ((noteHeader.n_namesz + 3U) & ~3U);
+            offset = descOffset + ((noteHeader.n_descsz + 3U) & ~3U);
+
+            if ((offset > end) ||
+                (noteHeader.n_descsz < 3U * sizeof(quint64)) ||
+                (std::strcmp(data.constData() + nameOffset, "stapsdt") != 0))
+            {
+                continue;
+            }
+
+            quint64 addresses[3];
+            std::memcpy(addresses, data.constData() + descOffset, sizeof(addresses));
+
+            const QList<QByteArray> strings =
+                    data.mid(static_cast<int>(descOffset + sizeof(addresses)),
+                             static_cast<int>(noteHeader.n_descsz - sizeof(addresses)))
+                    .split('\0');
+
+            if ((strings.size() < 3) || (strings.at(0) != "cppplugin"))
+            {
+                continue;
+            }
+
+            const QByteArray arguments = strings.at(2).trimmed();
+
+            Tracepoint tracepoint;
+            tracepoint.semaphore = addresses[2];
+            tracepoint.argumentCount =
+                    arguments.isEmpty() ? 0 : (arguments.simplified().count(' ') + 1);
+
+            tracepoints->insert(QString::fromUtf8(strings.at(1)), tracepoint);
+        }
+    }
+
+    if (tracepoints->isEmpty())
+    {
+        qWarning() << "Library does not contain any tracepoints:" << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestTracepoints)
+#include "testTracepoints.moc"
@@ -0,0 +1,147 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for AllocationCounter class
+ */
+
+// C++ Plugin Framework includes
+#include "../../common/AllocationCounter.hpp"
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <memory>
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestAllocationCounter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testOperatorNew();
+    void testQtContainers();
+    void testOtherThread();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestAllocationCounter::initTestCase()
+{
+}
+
+void TestAllocationCounter::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestAllocationCounter::init()
+{
+}
+
+void TestAllocationCounter::cleanup()
+{
+}
+
+// Test: allocations with operator new -------------------------------------------------------------
+
+void TestAllocationCounter::testOperatorNew()
+{
+    TestUtils::AllocationCounter counter;
+    QCOMPARE(counter.allocationCount(), Q_UINT64_C(0));
+
+    // Volatile size prevents the compiler from eliding the allocations
+    volatile int size = 16;
+    std::unique_ptr<char[]> first(new char[size]);
+    std::unique_ptr<char[]> second(new char[size]);
+
+    QCOMPARE(counter.allocationCount(), Q_UINT64_C(2));
+
+    // Deallocations are not counted
+    first.reset();
+    second.reset();
+    QCOMPARE(counter.allocationCount(), Q_UINT64_C(2));
+}
+
+// Test: allocations of Qt containers --------------------------------------------------------------
+
+void TestAllocationCounter::testQtContainers()
+{
+    if (!TestUtils::AllocationCounter::isMallocInterposed())
+    {
+        QSKIP("malloc() is not interposed on this platform");
+    }
+
+    const QString source("value");
+    TestUtils::AllocationCounter counter;
+
+    // Implicitly shared copy does not allocate
+    QString copy = source;
+    QCOMPARE(counter.allocationCount(), Q_UINT64_C(0));
+
+    // Detaching allocates
+    copy.append("1");
+    QVERIFY(counter.allocationCount() >= Q_UINT64_C(1));
+}
+
+// Test: allocations in another thread -------------------------------------------------------------
+
+void TestAllocationCounter::testOtherThread()
+{
+    quint64 otherThreadCount = 0U;
+
+    std::thread thread([&otherThreadCount]()
+    {
+        TestUtils::AllocationCounter counter;
+
+        volatile int size = 16;
+        std::unique_ptr<char[]> memory(new char[size]);
+
+        otherThreadCount = counter.allocationCount();
+    });
+
+    // Allocations of the other thread are not counted in this thread
+    TestUtils::AllocationCounter counter;
+    thread.join();
+
+    QCOMPARE(otherThreadCount, Q_UINT64_C(1));
+    QCOMPARE(counter.allocationCount(), Q_UINT64_C(0));
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestAllocationCounter)
+#include "testAllocationCounter.moc"
@@ -0,0 +1,294 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for AsyncLogBackend class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncLogBackend.hpp>
+#include <CppPluginFramework/LoggingCategories.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestAsyncLogBackend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testSynchronous();
+    void testAsynchronous();
+    void testMultipleThreads();
+    void testMessageHandler();
+    void testRateLimit();
+    void testDroppedMessages();
+
+private:
+    //! Creates the backend options with a sink that stores the messages
+    AsyncLogBackend::Options createOptions();
+
+    //! Gets the messages written to the sink
+    QStringList messages();
+
+private:
+    //! Enables thread-safe access to the messages
+    QMutex m_mutex;
+
+    //! Holds the messages written to the sink (in format "category: message")
+    QStringList m_messages;
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestAsyncLogBackend::initTestCase()
+{
+}
+
+void TestAsyncLogBackend::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestAsyncLogBackend::init()
+{
+    QMutexLocker locker(&m_mutex);
+    m_messages.clear();
+}
+
+void TestAsyncLogBackend::cleanup()
+{
+    AsyncLogBackend::instance().stop();
+}
+
+// Test: logging without the backend ---------------------------------------------------------------
+
+void TestAsyncLogBackend::testSynchronous()
+{
+    QVERIFY(!AsyncLogBackend::instance().isRunning());
+
+    QTest::ignoreMessage(QtWarningMsg, "Failed to load plugin: a [1]");
+    CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Plugin, "Failed to load plugin: %1 [%2]", "a", 1);
+}
+
+// Test: logging with the backend ------------------------------------------------------------------
+
+void TestAsyncLogBackend::testAsynchronous()
+{
+    auto &backend = AsyncLogBackend::instance();
+    QVERIFY(backend.start(createOptions()));
+    QVERIFY(backend.isRunning());
+
+    // Backend cannot be started twice
+    QVERIFY(!backend.start(createOptions()));
+
+    // Placeholders inside of the arguments are not replaced
+    CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Plugin, "Message %1 %2", QString("%2"), 1);
+    CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::PluginManager, "Message without arguments");
+    backend.flush();
+
+    QCOMPARE(messages(), QStringList({ "CppPluginFramework.Plugin: Message %2 1",
+                                       "CppPluginFramework.PluginManager: Message without "
+                                       "arguments" }));
+
+    // Messages queued before stopping are still written
+    CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Config, "Last message");
+    backend.stop();
+    QVERIFY(!backend.isRunning());
+    QCOMPARE(messages().last(), QString("CppPluginFramework.Config: Last message"));
+}
+
+// Test: logging from multiple threads -------------------------------------------------------------
+
+void TestAsyncLogBackend::testMultipleThreads()
+{
+    const int threadCount = 4;
+    const int messageCount = 50;
+
+    auto options = createOptions();
+    options.rateLimit = 0;
+
+    auto &backend = AsyncLogBackend::instance();
+    QVERIFY(backend.start(options));
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back([i]()
+        {
+            for (int j = 0; j < messageCount; j++)
+            {
+                CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Plugin, "%1/%2", i, j);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    backend.stop();
+
+    const QStringList loggedMessages = messages();
+    QCOMPARE(static_cast<quint64>(loggedMessages.size()) + backend.droppedMessageCount(),
+             static_cast<quint64>(threadCount * messageCount));
+
+    // Messages of each thread are written in order
+    for (int i = 0; i < threadCount; i++)
+    {
+        int lastIndex = -1;
+
+        for (const QString &message : loggedMessages)
+        {
+            const QStringList parts = message.section(' ', 1).split('/');
+
+            if (parts.first().toInt() == i)
+            {
+                QVERIFY(parts.last().toInt() > lastIndex);
+                lastIndex = parts.last().toInt();
+            }
+        }
+    }
+}
+
+// Test: interception of the framework's logging categories ----------------------------------------
+
+void TestAsyncLogBackend::testMessageHandler()
+{
+    auto &backend = AsyncLogBackend::instance();
+    QVERIFY(backend.start(createOptions()));
+
+    qCWarning(LoggingCategory::PluginManager).noquote() << "Intercepted message";
+
+    // Other categories are passed to the previous message handler
+    QTest::ignoreMessage(QtWarningMsg, "Not intercepted");
+    qWarning("Not intercepted");
+
+    backend.flush();
+
+    QCOMPARE(messages(),
+             QStringList({ "CppPluginFramework.PluginManager: Intercepted message" }));
+}
+
+// Test: rate limiting -----------------------------------------------------------------------------
+
+void TestAsyncLogBackend::testRateLimit()
+{
+    auto options = createOptions();
+    options.rateLimit = 5;
+
+    auto &backend = AsyncLogBackend::instance();
+    QVERIFY(backend.start(options));
+
+    for (int i = 0; i < 20; i++)
+    {
+        CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Plugin, "Plugin %1", i);
+        CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Config, "Config %1", i);
+    }
+
+    backend.flush();
+
+    // Each category has its own limit (unless the test crossed the boundary of the window)
+    const quint64 rateLimitedCount = backend.rateLimitedMessageCount();
+    QVERIFY(rateLimitedCount >= Q_UINT64_C(20));
+    QVERIFY(rateLimitedCount <= Q_UINT64_C(30));
+    QCOMPARE(static_cast<quint64>(messages().size()) + rateLimitedCount, Q_UINT64_C(40));
+    QCOMPARE(backend.droppedMessageCount(), Q_UINT64_C(0));
+
+    // Summary of the dropped messages is written when the backend is stopped
+    backend.stop();
+    QVERIFY(messages().last().startsWith("CppPluginFramework: Dropped log messages: 0 (ring "
+                                         "buffer full)"));
+}
+
+// Test: dropping of messages when the ring buffer is full -----------------------------------------
+
+void TestAsyncLogBackend::testDroppedMessages()
+{
+    const int messageCount = 1000;
+
+    auto options = createOptions();
+    options.ringCapacity = 3;
+    options.rateLimit = 0;
+
+    auto &backend = AsyncLogBackend::instance();
+    QVERIFY(backend.start(options));
+
+    // Ring buffer is created for a new thread with the capacity rounded up to 4
+    std::thread thread([]()
+    {
+        for (int i = 0; i < messageCount; i++)
+        {
+            CPPPLUGINFRAMEWORK_WARNING(LoggingCategory::Plugin, "Message %1", i);
+        }
+    });
+    thread.join();
+
+    backend.flush();
+
+    const quint64 loggedCount = static_cast<quint64>(messages().size());
+    QVERIFY(backend.droppedMessageCount() > Q_UINT64_C(0));
+    QCOMPARE(loggedCount + backend.droppedMessageCount(), static_cast<quint64>(messageCount));
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+AsyncLogBackend::Options TestAsyncLogBackend::createOptions()
+{
+    AsyncLogBackend::Options options;
+    options.sink = [this](QtMsgType, const QString &category, const QString &message)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_messages.append(QString("%1: %2").arg(category, message));
+    };
+
+    return options;
+}
+
+QStringList TestAsyncLogBackend::messages()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_messages;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestAsyncLogBackend)
+#include "testAsyncLogBackend.moc"
@@ -0,0 +1,159 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for AsyncOperation class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AsyncOperation.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <chrono>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestAsyncOperation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testFinish();
+    void testCancel();
+    void testProgress();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestAsyncOperation::initTestCase()
+{
+}
+
+void TestAsyncOperation::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestAsyncOperation::init()
+{
+}
+
+void TestAsyncOperation::cleanup()
+{
+}
+
+// Test: finishing of the operation ----------------------------------------------------------------
+
+void TestAsyncOperation::testFinish()
+{
+    AsyncOperation succeeded;
+    QCOMPARE(succeeded.state(), AsyncOperation::State::Queued);
+    QVERIFY(succeeded.future().wait_for(std::chrono::milliseconds(0)) !=
+            std::future_status::ready);
+
+    succeeded.setRunning();
+    QCOMPARE(succeeded.state(), AsyncOperation::State::Running);
+
+    succeeded.finish(true);
+    QCOMPARE(succeeded.state(), AsyncOperation::State::Succeeded);
+    QVERIFY(succeeded.future().get());
+
+    // Only the first call has an effect
+    succeeded.finish(false);
+    succeeded.setRunning();
+    QCOMPARE(succeeded.state(), AsyncOperation::State::Succeeded);
+
+    AsyncOperation failed;
+    failed.setRunning();
+    failed.finish(false);
+    QCOMPARE(failed.state(), AsyncOperation::State::Failed);
+    QVERIFY(!failed.future().get());
+}
+
+// Test: cancellation of the operation -------------------------------------------------------------
+
+void TestAsyncOperation::testCancel()
+{
+    AsyncOperation cancelled;
+    QVERIFY(!cancelled.isCancellationRequested());
+
+    cancelled.cancel();
+    QVERIFY(cancelled.isCancellationRequested());
+
+    cancelled.finish(false);
+    QCOMPARE(cancelled.state(), AsyncOperation::State::Cancelled);
+    QVERIFY(!cancelled.future().get());
+
+    // Operation that succeeds regardless of the cancellation is not cancelled
+    AsyncOperation succeeded;
+    succeeded.setRunning();
+    succeeded.cancel();
+    succeeded.finish(true);
+    QCOMPARE(succeeded.state(), AsyncOperation::State::Succeeded);
+    QVERIFY(succeeded.future().get());
+}
+
+// Test: progress of the operation -----------------------------------------------------------------
+
+void TestAsyncOperation::testProgress()
+{
+    QList<AsyncOperation::Progress> progresses;
+
+    AsyncOperation operation([&progresses](const AsyncOperation::Progress &progress)
+    {
+        progresses.append(progress);
+    });
+
+    AsyncOperation::Progress progress;
+    progress.instanceName = "instance1";
+    progress.completedCount = 1;
+    progress.totalCount = 2;
+    operation.reportProgress(progress);
+
+    QCOMPARE(progresses.size(), 1);
+    QCOMPARE(progresses.first().instanceName, QStringLiteral("instance1"));
+    QCOMPARE(progresses.first().completedCount, 1);
+    QCOMPARE(progresses.first().totalCount, 2);
+
+    // Operation without a progress observer ignores the progress
+    AsyncOperation withoutObserver;
+    withoutObserver.reportProgress(progress);
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestAsyncOperation)
+#include "testAsyncOperation.moc"
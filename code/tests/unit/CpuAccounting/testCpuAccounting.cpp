@@ -0,0 +1,265 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for CpuAccounting class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/CpuAccounting.hpp>
+#include <CppPluginFramework/MetricsRegistry.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <pthread.h>
+#include <atomic>
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestCpuAccounting : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testRegisteredThread();
+    void testReregisteredThread();
+    void testAddCpuTime();
+    void testSampling();
+
+private:
+    /*!
+     * Finds the CPU time of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     *
+     * \return  CPU time (with instance name "<none>" if the plugin instance has no CPU time)
+     */
+    static CpuAccounting::CpuStats findStats(const QString &instanceName);
+
+    /*!
+     * Consumes CPU time in the calling thread
+     *
+     * \param   cpuTime     CPU time to consume in nanoseconds
+     */
+    static void consumeCpuTime(qint64 cpuTime);
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestCpuAccounting::initTestCase()
+{
+}
+
+void TestCpuAccounting::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestCpuAccounting::init()
+{
+}
+
+void TestCpuAccounting::cleanup()
+{
+    CpuAccounting::instance().stopSampling();
+}
+
+// Test: registered thread -------------------------------------------------------------------------
+
+void TestCpuAccounting::testRegisteredThread()
+{
+    std::atomic<bool> registered(false);
+    std::atomic<bool> finish(false);
+    QByteArray threadName;
+
+    std::thread thread([&]()
+    {
+        CpuAccounting::ThreadScope threadScope("instance1", "worker-of-instance1");
+
+        char name[16] = {};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        threadName = name;
+
+        consumeCpuTime(20000000);
+        registered = true;
+
+        while (!finish)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    while (!registered)
+    {
+        std::this_thread::yield();
+    }
+
+    // CPU time of a running thread is read from its clock
+    const auto running = findStats("instance1");
+    QCOMPARE(running.threadCount, 1);
+    QVERIFY(running.cpuTime >= Q_INT64_C(20000000));
+
+    finish = true;
+    thread.join();
+
+    // CPU time stays attributed after the thread is unregistered
+    const auto finished = findStats("instance1");
+    QCOMPARE(finished.threadCount, 0);
+    QVERIFY(finished.cpuTime >= running.cpuTime);
+
+    // Linux limits the thread names to 15 bytes
+    QCOMPARE(threadName, QByteArray("worker-of-insta"));
+}
+
+// Test: thread that is registered to another plugin instance --------------------------------------
+
+void TestCpuAccounting::testReregisteredThread()
+{
+    bool registered2 = false;
+    bool registered3 = false;
+
+    std::thread thread([&]()
+    {
+        auto &cpuAccounting = CpuAccounting::instance();
+
+        registered2 = cpuAccounting.registerThread("instance2");
+        consumeCpuTime(10000000);
+
+        registered3 = cpuAccounting.registerThread("instance3");
+        consumeCpuTime(10000000);
+
+        // Second call does nothing
+        cpuAccounting.unregisterThread();
+        cpuAccounting.unregisterThread();
+    });
+    thread.join();
+
+    QVERIFY(registered2);
+    QVERIFY(registered3);
+
+    const auto instance2 = findStats("instance2");
+    const auto instance3 = findStats("instance3");
+
+    QVERIFY(instance2.cpuTime >= Q_INT64_C(10000000));
+    QVERIFY(instance3.cpuTime >= Q_INT64_C(10000000));
+    QCOMPARE(instance2.threadCount, 0);
+    QCOMPARE(instance3.threadCount, 0);
+}
+
+// Test: added CPU time ----------------------------------------------------------------------------
+
+void TestCpuAccounting::testAddCpuTime()
+{
+    const qint64 before = findStats("instance4").cpuTime;
+
+    CpuAccounting::instance().addCpuTime("instance4", 1000);
+    CpuAccounting::instance().addCpuTime("instance4", 2000);
+
+    QCOMPARE(findStats("instance4").cpuTime - before, Q_INT64_C(3000));
+
+    const qint64 threadCpuTime = CpuAccounting::threadCpuTime();
+    consumeCpuTime(1000000);
+    QVERIFY((CpuAccounting::threadCpuTime() - threadCpuTime) >= Q_INT64_C(1000000));
+    QVERIFY(CpuAccounting::processCpuTime() >= CpuAccounting::threadCpuTime());
+}
+
+// Test: sampling into the metrics registry --------------------------------------------------------
+
+void TestCpuAccounting::testSampling()
+{
+    auto &cpuAccounting = CpuAccounting::instance();
+    cpuAccounting.addCpuTime("instance5", 5000);
+
+    QVERIFY(!cpuAccounting.startSampling(0));
+    QVERIFY(cpuAccounting.startSampling(10));
+    QVERIFY(cpuAccounting.isSampling());
+    QVERIFY(!cpuAccounting.startSampling(10));
+
+    QTest::qWait(50);
+
+    // Sampling thread is registered to the framework
+    QCOMPARE(findStats(QString()).threadCount, 1);
+
+    cpuAccounting.stopSampling();
+    QVERIFY(!cpuAccounting.isSampling());
+
+    bool found = false;
+
+    for (const auto &snapshot : MetricsRegistry::instance().snapshot())
+    {
+        if ((snapshot.name == "cppplugin_plugin_cpu_nanoseconds") &&
+            (snapshot.instance == "instance5"))
+        {
+            found = true;
+            QCOMPARE(snapshot.value, Q_INT64_C(5000));
+        }
+    }
+
+    QVERIFY(found);
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+CpuAccounting::CpuStats TestCpuAccounting::findStats(const QString &instanceName)
+{
+    for (const auto &stats : CpuAccounting::instance().snapshot())
+    {
+        if (stats.instance == instanceName)
+        {
+            return stats;
+        }
+    }
+
+    CpuAccounting::CpuStats stats;
+    stats.instance = "<none>";
+    return stats;
+}
+
+void TestCpuAccounting::consumeCpuTime(const qint64 cpuTime)
+{
+    const qint64 start = CpuAccounting::threadCpuTime();
+    volatile quint64 value = 0U;
+
+    while ((CpuAccounting::threadCpuTime() - start) < cpuTime)
+    {
+        value = value + 1U;
+    }
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestCpuAccounting)
+#include "testCpuAccounting.moc"
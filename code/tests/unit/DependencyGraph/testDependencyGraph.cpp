@@ -0,0 +1,268 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for DependencyGraph class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/DependencyGraph.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test types --------------------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+using Edges = std::vector<std::pair<int, int>>;
+using Layers = std::vector<std::vector<int>>;
+
+Q_DECLARE_METATYPE(Edges)
+Q_DECLARE_METATYPE(Layers)
+
+// Test class declaration --------------------------------------------------------------------------
+
+class TestDependencyGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testConstruction();
+    void testFromDependencies();
+    void testCycles();
+    void testCycles_data();
+    void testLayers();
+    void testStartupOrder();
+    void testLargeGraph();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestDependencyGraph::initTestCase()
+{
+}
+
+void TestDependencyGraph::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestDependencyGraph::init()
+{
+}
+
+void TestDependencyGraph::cleanup()
+{
+}
+
+// Test: construction ------------------------------------------------------------------------------
+
+void TestDependencyGraph::testConstruction()
+{
+    // Default constructed
+    {
+        DependencyGraph graph;
+        QCOMPARE(graph.nodeCount(), 0);
+        QCOMPARE(graph.edgeCount(), 0);
+        QCOMPARE(graph.nodeId("a"), -1);
+        QVERIFY(graph.nodeName(0).isEmpty());
+        QVERIFY(graph.dependencies(0).isEmpty());
+        QVERIFY(graph.cycles().empty());
+    }
+
+    // Constructed with edges (invalid edges are ignored)
+    {
+        DependencyGraph graph({ "a", "b", "c" }, { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 3, 0 } });
+        QCOMPARE(graph.nodeCount(), 3);
+        QCOMPARE(graph.edgeCount(), 3);
+        QCOMPARE(graph.nodeNames(), QStringList({ "a", "b", "c" }));
+        QCOMPARE(graph.nodeId("b"), 1);
+        QCOMPARE(graph.nodeName(2), QString("c"));
+
+        const auto dependencies = graph.dependencies(0);
+        QCOMPARE(dependencies.size(), 2);
+        QCOMPARE(std::vector<int>(dependencies.begin(), dependencies.end()),
+                 std::vector<int>({ 1, 2 }));
+
+        const auto dependents = graph.dependents(2);
+        QCOMPARE(dependents.size(), 2);
+        QCOMPARE(std::vector<int>(dependents.begin(), dependents.end()),
+                 std::vector<int>({ 0, 1 }));
+
+        QVERIFY(graph.dependencies(2).isEmpty());
+        QVERIFY(graph.dependents(0).isEmpty());
+    }
+}
+
+// Test: fromDependencies() method -----------------------------------------------------------------
+
+void TestDependencyGraph::testFromDependencies()
+{
+    DependencyGraph graph;
+    QString error;
+
+    QVERIFY(DependencyGraph::fromDependencies({ { "a", { "b", "c" } }, { "b", {} }, { "c", {} } },
+                                              &graph,
+                                              &error));
+    QVERIFY(error.isEmpty());
+    QCOMPARE(graph.nodeCount(), 3);
+    QCOMPARE(graph.edgeCount(), 2);
+
+    QVERIFY(!DependencyGraph::fromDependencies({ { "a", { "b" } } }, &graph, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+// Test: cycles() method ---------------------------------------------------------------------------
+
+void TestDependencyGraph::testCycles()
+{
+    QFETCH(int, nodeCount);
+    QFETCH(Edges, edges);
+    QFETCH(Layers, expectedCycles);
+
+    QStringList nodeNames;
+
+    for (int i = 0; i < nodeCount; i++)
+    {
+        nodeNames.append(QString("node%1").arg(i));
+    }
+
+    DependencyGraph graph(nodeNames, edges);
+    const auto cycles = graph.cycles();
+
+    QCOMPARE(cycles, expectedCycles);
+
+    Layers layers;
+    QCOMPARE(graph.topologicalLayers(&layers), expectedCycles.empty());
+}
+
+void TestDependencyGraph::testCycles_data()
+{
+    QTest::addColumn<int>("nodeCount");
+    QTest::addColumn<Edges>("edges");
+    QTest::addColumn<Layers>("expectedCycles");
+
+    QTest::newRow("no edges") << 3 << Edges() << Layers();
+    QTest::newRow("chain") << 3 << Edges { { 0, 1 }, { 1, 2 } } << Layers();
+    QTest::newRow("diamond") << 4 << Edges { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 2, 3 } } << Layers();
+    QTest::newRow("self") << 2 << Edges { { 1, 1 } } << Layers { { 1 } };
+    QTest::newRow("two nodes") << 2 << Edges { { 0, 1 }, { 1, 0 } } << Layers { { 0, 1 } };
+    QTest::newRow("ring with tail")
+            << 4 << Edges { { 3, 0 }, { 0, 1 }, { 1, 2 }, { 2, 0 } } << Layers { { 0, 1, 2 } };
+    QTest::newRow("two rings")
+            << 5 << Edges { { 0, 1 }, { 1, 0 }, { 2, 3 }, { 3, 4 }, { 4, 2 }, { 1, 2 } }
+            << Layers { { 2, 3, 4 }, { 0, 1 } };
+}
+
+// Test: topologicalLayers() and reverseTopologicalLayers() methods --------------------------------
+
+void TestDependencyGraph::testLayers()
+{
+    // a -> b, a -> c, b -> d, c -> d, e
+    DependencyGraph graph({ "a", "b", "c", "d", "e" }, { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 2, 3 } });
+
+    Layers layers;
+    QVERIFY(graph.topologicalLayers(&layers));
+    QCOMPARE(layers, Layers({ { 3, 4 }, { 1, 2 }, { 0 } }));
+
+    QVERIFY(graph.reverseTopologicalLayers(&layers));
+    QCOMPARE(layers, Layers({ { 0, 4 }, { 1, 2 }, { 3 } }));
+}
+
+// Test: startupOrder() and shutdownOrder() methods ------------------------------------------------
+
+void TestDependencyGraph::testStartupOrder()
+{
+    // a -> b, a -> c, b -> d, c -> d, e
+    DependencyGraph graph({ "a", "b", "c", "d", "e" }, { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 2, 3 } });
+
+    std::vector<int> order;
+    QVERIFY(graph.startupOrder({}, &order));
+    QCOMPARE(order, std::vector<int>({ 3, 4, 1, 2, 0 }));
+
+    // Priorities are kept in front, preceded by their dependencies
+    QVERIFY(graph.startupOrder({ 4, 2 }, &order));
+    QCOMPARE(order, std::vector<int>({ 4, 3, 2, 1, 0 }));
+
+    QVERIFY(graph.shutdownOrder({ 4, 2 }, &order));
+    QCOMPARE(order, std::vector<int>({ 0, 1, 2, 3, 4 }));
+
+    QVERIFY(graph.startupOrder({ 0 }, &order));
+    QCOMPARE(order, std::vector<int>({ 3, 1, 2, 0, 4 }));
+
+    // Cyclic graph
+    DependencyGraph cyclicGraph({ "a", "b" }, { { 0, 1 }, { 1, 0 } });
+    QVERIFY(!cyclicGraph.startupOrder({}, &order));
+    QVERIFY(!cyclicGraph.shutdownOrder({}, &order));
+}
+
+// Test: large graph -------------------------------------------------------------------------------
+
+void TestDependencyGraph::testLargeGraph()
+{
+    // Long dependency chain (must not overflow the stack)
+    const int nodeCount = 100000;
+    QStringList nodeNames;
+    Edges edges;
+
+    for (int i = 0; i < nodeCount; i++)
+    {
+        nodeNames.append(QString::number(i));
+
+        if (i > 0)
+        {
+            edges.emplace_back(i, i - 1);
+        }
+    }
+
+    DependencyGraph graph(nodeNames, edges);
+    QVERIFY(graph.cycles().empty());
+
+    Layers layers;
+    QVERIFY(graph.topologicalLayers(&layers));
+    QCOMPARE(static_cast<int>(layers.size()), nodeCount);
+
+    // Close the chain into a single cycle
+    edges.emplace_back(0, nodeCount - 1);
+    DependencyGraph cyclicGraph(nodeNames, edges);
+
+    const auto cycles = cyclicGraph.cycles();
+    QCOMPARE(cycles.size(), static_cast<size_t>(1));
+    QCOMPARE(static_cast<int>(cycles.front().size()), nodeCount);
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestDependencyGraph)
+#include "testDependencyGraph.moc"
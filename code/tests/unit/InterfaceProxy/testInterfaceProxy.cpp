@@ -0,0 +1,284 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for InterfaceProxy class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/AbstractPlugin.hpp>
+#include <CppPluginFramework/InterfaceProxy.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test types --------------------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class ICounter
+{
+public:
+    virtual ~ICounter() = default;
+    virtual int increment(int step) = 0;
+    virtual void reset() = 0;
+};
+
+class CounterPlugin : public AbstractPlugin, public ICounter
+{
+public:
+    explicit CounterPlugin(const QString &name)
+        : AbstractPlugin(name, VersionInfo(1, 0, 0), "counter", {"ICounter", "IOther"})
+    {
+    }
+
+    bool loadConfig(const CppConfigFramework::ConfigObjectNode &) override
+    {
+        return true;
+    }
+
+    bool injectDependency(IPlugin *) override
+    {
+        return false;
+    }
+
+    void ejectDependencies() override
+    {
+    }
+
+    int increment(const int step) override
+    {
+        m_value += step;
+        return m_value;
+    }
+
+    void reset() override
+    {
+        m_value = 0;
+    }
+
+private:
+    int m_value = 0;
+};
+
+class CounterProxy : public InterfaceProxy<ICounter>
+{
+public:
+    CounterProxy(const QString &callerName, IPlugin *target)
+        : InterfaceProxy("ICounter", {"increment", "reset"}, callerName, target)
+    {
+    }
+
+    int increment(const int step) override
+    {
+        return call(0, [&]() { return target()->increment(step); });
+    }
+
+    void reset() override
+    {
+        call(1, [this]() { target()->reset(); });
+    }
+};
+
+// Test class declaration --------------------------------------------------------------------------
+
+class TestInterfaceProxy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testProxyPlugin();
+    void testSampling();
+    void testRegistry();
+
+private:
+    /*!
+     * Finds the call stats of the method
+     *
+     * \param   caller  Name of the calling plugin instance
+     * \param   method  Method name
+     *
+     * \return  Call stats (with an empty method name if the call site does not exist)
+     */
+    static ProxyRegistry::CallStats findStats(const QString &caller, const QString &method);
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestInterfaceProxy::initTestCase()
+{
+}
+
+void TestInterfaceProxy::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestInterfaceProxy::init()
+{
+    ProxyRegistry::instance().reset();
+}
+
+void TestInterfaceProxy::cleanup()
+{
+    ProxyRegistry::instance().setSamplingRate(100);
+    ProxyRegistry::instance().unregisterProxy("ICounter");
+}
+
+// Test: proxy as a plugin instance ----------------------------------------------------------------
+
+void TestInterfaceProxy::testProxyPlugin()
+{
+    CounterPlugin target("counter1");
+    CounterProxy proxy("caller1", &target);
+
+    QCOMPARE(proxy.name(), QString("counter1"));
+    QCOMPARE(proxy.version(), VersionInfo(1, 0, 0));
+    QCOMPARE(proxy.description(), QString("counter"));
+    QCOMPARE(proxy.proxiedInterface(), QString("ICounter"));
+    QCOMPARE(proxy.callerName(), QString("caller1"));
+    QCOMPARE(proxy.targetPlugin(), static_cast<IPlugin *>(&target));
+
+    // Only the proxied interface is exported
+    QVERIFY(proxy.isInterfaceExported("ICounter"));
+    QVERIFY(!proxy.isInterfaceExported("IOther"));
+    QCOMPARE(proxy.exportedInterfaces(), QSet<QString>({"ICounter"}));
+
+    // Lifecycle is not forwarded
+    QVERIFY(!proxy.start());
+    QVERIFY(!proxy.isStarted());
+    QVERIFY(target.start());
+    QVERIFY(proxy.isStarted());
+    proxy.stop();
+    QVERIFY(target.isStarted());
+    target.stop();
+
+    // Calls are forwarded through the interface
+    IPlugin *plugin = &proxy;
+    QCOMPARE(plugin->interface<ICounter>()->increment(2), 2);
+    QCOMPARE(target.increment(1), 3);
+}
+
+// Test: 1-in-N sampling ---------------------------------------------------------------------------
+
+void TestInterfaceProxy::testSampling()
+{
+    ProxyRegistry::instance().setSamplingRate(0);
+    QCOMPARE(ProxyRegistry::instance().samplingRate(), 1);
+
+    ProxyRegistry::instance().setSamplingRate(3);
+    QCOMPARE(ProxyRegistry::instance().samplingRate(), 3);
+
+    CounterPlugin target("counter2");
+    CounterProxy proxy("caller2", &target);
+
+    for (int i = 0; i < 10; i++)
+    {
+        proxy.increment(1);
+    }
+
+    proxy.reset();
+
+    const auto increment = findStats("caller2", "increment");
+    QCOMPARE(increment.callee, QString("counter2"));
+    QCOMPARE(increment.interface, QString("ICounter"));
+    QCOMPARE(increment.callCount, Q_UINT64_C(10));
+    QCOMPARE(increment.sampledCount, Q_UINT64_C(4));
+    QVERIFY(increment.sampledDuration >= increment.maxDuration);
+    QCOMPARE(increment.estimatedTotalDuration(), increment.meanDuration() * Q_INT64_C(10));
+
+    const auto reset = findStats("caller2", "reset");
+    QCOMPARE(reset.callCount, Q_UINT64_C(1));
+    QCOMPARE(reset.sampledCount, Q_UINT64_C(1));
+
+    // Call sites of another caller are separate
+    CounterProxy otherProxy("caller3", &target);
+    otherProxy.increment(1);
+
+    QCOMPARE(findStats("caller2", "increment").callCount, Q_UINT64_C(10));
+    QCOMPARE(findStats("caller3", "increment").callCount, Q_UINT64_C(1));
+
+    // Reset keeps the call sites
+    ProxyRegistry::instance().reset();
+    QCOMPARE(findStats("caller2", "increment").method, QString("increment"));
+    QCOMPARE(findStats("caller2", "increment").callCount, Q_UINT64_C(0));
+    QCOMPARE(findStats("caller2", "increment").meanDuration(), Q_INT64_C(0));
+}
+
+// Test: registry of proxy factories ---------------------------------------------------------------
+
+void TestInterfaceProxy::testRegistry()
+{
+    auto &registry = ProxyRegistry::instance();
+    CounterPlugin target("counter4");
+
+    QVERIFY(!registry.hasProxy("ICounter"));
+    QVERIFY(!registry.createProxy("ICounter", "caller4", &target));
+
+    QVERIFY(!registry.registerProxyFactory(QString(), ProxyRegistry::Factory()));
+    QVERIFY(!registry.registerProxyFactory("ICounter", ProxyRegistry::Factory()));
+
+    QVERIFY(registry.registerProxy<CounterProxy>("ICounter"));
+    QVERIFY(registry.hasProxy("ICounter"));
+
+    auto proxy = registry.createProxy("ICounter", "caller4", &target);
+    QVERIFY(proxy);
+    QVERIFY(!registry.createProxy("ICounter", "caller4", nullptr));
+
+    QCOMPARE(proxy->interface<ICounter>()->increment(5), 5);
+    QCOMPARE(findStats("caller4", "increment").callCount, Q_UINT64_C(1));
+
+    registry.unregisterProxy("ICounter");
+    QVERIFY(!registry.hasProxy("ICounter"));
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+ProxyRegistry::CallStats TestInterfaceProxy::findStats(const QString &caller,
+                                                       const QString &method)
+{
+    for (const auto &stats : ProxyRegistry::instance().snapshot())
+    {
+        if ((stats.caller == caller) && (stats.method == method))
+        {
+            return stats;
+        }
+    }
+
+    return {};
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestInterfaceProxy)
+#include "testInterfaceProxy.moc"
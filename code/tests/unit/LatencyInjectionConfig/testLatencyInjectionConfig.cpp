@@ -0,0 +1,267 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for LatencyInjectionConfig and LatencyInjection classes
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LatencyInjection.hpp>
+#include <CppPluginFramework/LatencyInjectionConfig.hpp>
+
+// C++ Config Framework includes
+#include <CppConfigFramework/ConfigValueNode.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test types --------------------------------------------------------------------------------------
+
+using namespace CppConfigFramework;
+using namespace CppPluginFramework;
+
+using ConfigObjectNodePtr = std::shared_ptr<ConfigObjectNode>;
+
+Q_DECLARE_METATYPE(ConfigObjectNodePtr)
+Q_DECLARE_METATYPE(LatencyInjectionConfig)
+
+// Test class declaration --------------------------------------------------------------------------
+class TestLatencyInjectionConfig : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testIsValid();
+    void testIsValid_data();
+
+    void testLoadConfig();
+    void testLoadConfig_data();
+
+    void testInject();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestLatencyInjectionConfig::initTestCase()
+{
+}
+
+void TestLatencyInjectionConfig::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestLatencyInjectionConfig::init()
+{
+}
+
+void TestLatencyInjectionConfig::cleanup()
+{
+}
+
+// Test: validity ----------------------------------------------------------------------------------
+
+void TestLatencyInjectionConfig::testIsValid()
+{
+    QFETCH(LatencyInjectionConfig, config);
+    QFETCH(bool, result);
+
+    QCOMPARE(config.isValid(), result);
+}
+
+void TestLatencyInjectionConfig::testIsValid_data()
+{
+    QTest::addColumn<LatencyInjectionConfig>("config");
+    QTest::addColumn<bool>("result");
+
+    // Valid results
+    QTest::newRow("valid: only name") << LatencyInjectionConfig("instance1") << true;
+
+    QTest::newRow("valid: all delays")
+            << LatencyInjectionConfig("instance1", 1, 2, 3, 4, 5)
+            << true;
+
+    // Invalid results
+    QTest::newRow("invalid: default constructed") << LatencyInjectionConfig() << false;
+    QTest::newRow("invalid: invalid name") << LatencyInjectionConfig("1instance") << false;
+
+    QTest::newRow("invalid: negative delay")
+            << LatencyInjectionConfig("instance1", 0, -1)
+            << false;
+
+    QTest::newRow("invalid: negative jitter")
+            << LatencyInjectionConfig("instance1", 0, 0, 0, 0, -1)
+            << false;
+}
+
+// Test: loadConfig() method -----------------------------------------------------------------------
+
+void TestLatencyInjectionConfig::testLoadConfig()
+{
+    QFETCH(ConfigObjectNodePtr, configNode);
+    QFETCH(LatencyInjectionConfig, expectedConfig);
+    QFETCH(bool, expectedResult);
+
+    LatencyInjectionConfig config;
+    const bool result = config.loadConfig("latency", *configNode);
+
+    QCOMPARE(result, expectedResult);
+
+    if (result)
+    {
+        QCOMPARE(config, expectedConfig);
+    }
+}
+
+void TestLatencyInjectionConfig::testLoadConfig_data()
+{
+    QTest::addColumn<ConfigObjectNodePtr>("configNode");
+    QTest::addColumn<LatencyInjectionConfig>("expectedConfig");
+    QTest::addColumn<bool>("expectedResult");
+
+    // Valid: just name
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "latency", ConfigObjectNode
+                {
+                    { "instance", ConfigValueNode("test1") }
+                }
+            }
+        };
+
+        QTest::newRow("valid: only name")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << LatencyInjectionConfig("test1")
+                << true;
+    }
+
+    // Valid: all params
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "latency", ConfigObjectNode
+                {
+                    { "instance", ConfigValueNode("test2") },
+                    { "load_config_delay_us", ConfigValueNode(100) },
+                    { "start_delay_us", ConfigValueNode(200) },
+                    { "stop_delay_us", ConfigValueNode(300) },
+                    { "call_delay_us", ConfigValueNode(400) },
+                    { "jitter_us", ConfigValueNode(50) }
+                }
+            }
+        };
+
+        QTest::newRow("valid: all params")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << LatencyInjectionConfig("test2", 100, 200, 300, 400, 50)
+                << true;
+    }
+
+    // Invalid: missing name
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "latency", ConfigObjectNode
+                {
+                    { "start_delay_us", ConfigValueNode(200) }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: missing name")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << LatencyInjectionConfig()
+                << false;
+    }
+
+    // Invalid: negative delay
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "latency", ConfigObjectNode
+                {
+                    { "instance", ConfigValueNode("test3") },
+                    { "stop_delay_us", ConfigValueNode(-1) }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: negative delay")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << LatencyInjectionConfig()
+                << false;
+    }
+}
+
+// Test: injection of the delays -------------------------------------------------------------------
+
+void TestLatencyInjectionConfig::testInject()
+{
+    LatencyInjection latencyInjection;
+    QVERIFY(latencyInjection.isEmpty());
+
+    latencyInjection.setConfigs({ LatencyInjectionConfig("instance1", 0, 20000, 0, 1000, 5000),
+                                  LatencyInjectionConfig("instance2") });
+    QVERIFY(!latencyInjection.isEmpty());
+    QCOMPARE(latencyInjection.configs().size(), 2);
+    QVERIFY(latencyInjection.delaysCalls("instance1"));
+    QVERIFY(!latencyInjection.delaysCalls("instance2"));
+    QVERIFY(!latencyInjection.delaysCalls("instance3"));
+
+    // Delay with jitter
+    QElapsedTimer timer;
+    timer.start();
+    latencyInjection.inject("instance1", LatencyInjection::Operation::Start);
+    QVERIFY(timer.nsecsElapsed() >= Q_INT64_C(20000000));
+
+    // Operations without a delay are not delayed (jitter is added only to non-zero delays)
+    timer.restart();
+    latencyInjection.inject("instance1", LatencyInjection::Operation::Stop);
+    latencyInjection.inject("instance2", LatencyInjection::Operation::Start);
+    latencyInjection.inject("instance3", LatencyInjection::Operation::LoadConfig);
+    QVERIFY(timer.nsecsElapsed() < Q_INT64_C(5000000));
+
+    latencyInjection.clear();
+    QVERIFY(latencyInjection.isEmpty());
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestLatencyInjectionConfig)
+#include "testLatencyInjectionConfig.moc"
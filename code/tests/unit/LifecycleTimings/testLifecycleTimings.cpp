@@ -0,0 +1,229 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for LifecycleTimings class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LifecycleTimings.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestLifecycleTimings : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testHistogram();
+    void testHistogramMerge();
+    void testRecord();
+    void testScope();
+    void testJson();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestLifecycleTimings::initTestCase()
+{
+}
+
+void TestLifecycleTimings::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestLifecycleTimings::init()
+{
+}
+
+void TestLifecycleTimings::cleanup()
+{
+}
+
+// Test: histogram ---------------------------------------------------------------------------------
+
+void TestLifecycleTimings::testHistogram()
+{
+    LifecycleTimings::Histogram histogram;
+    QCOMPARE(histogram.count(), Q_UINT64_C(0));
+    QCOMPARE(histogram.mean(), 0.0);
+    QCOMPARE(histogram.percentile(50.0), Q_INT64_C(0));
+
+    for (const qint64 duration : { 0, 1, 2, 3, 4, 100, 1000 })
+    {
+        histogram.add(duration);
+    }
+
+    QCOMPARE(histogram.count(), Q_UINT64_C(7));
+    QCOMPARE(histogram.total(), Q_INT64_C(1110));
+    QCOMPARE(histogram.min(), Q_INT64_C(0));
+    QCOMPARE(histogram.max(), Q_INT64_C(1000));
+    QCOMPARE(histogram.mean(), 1110.0 / 7.0);
+
+    QCOMPARE(histogram.buckets().at(0), Q_UINT64_C(2));
+    QCOMPARE(histogram.buckets().at(1), Q_UINT64_C(2));
+    QCOMPARE(histogram.buckets().at(2), Q_UINT64_C(1));
+    QCOMPARE(histogram.buckets().at(6), Q_UINT64_C(1));
+    QCOMPARE(histogram.buckets().at(9), Q_UINT64_C(1));
+
+    QCOMPARE(histogram.percentile(50.0), Q_INT64_C(3));
+    QCOMPARE(histogram.percentile(80.0), Q_INT64_C(127));
+    QCOMPARE(histogram.percentile(100.0), Q_INT64_C(1000));
+
+    // Negative durations are recorded as zero
+    histogram.add(-5);
+    QCOMPARE(histogram.buckets().at(0), Q_UINT64_C(3));
+    QCOMPARE(histogram.min(), Q_INT64_C(0));
+}
+
+// Test: histogram merge ---------------------------------------------------------------------------
+
+void TestLifecycleTimings::testHistogramMerge()
+{
+    LifecycleTimings::Histogram histogram1;
+    histogram1.add(10);
+    histogram1.add(20);
+
+    LifecycleTimings::Histogram histogram2;
+    histogram2.add(5);
+    histogram2.add(40);
+
+    LifecycleTimings::Histogram merged;
+    merged.merge(histogram1);
+    merged.merge(histogram2);
+
+    QCOMPARE(merged.count(), Q_UINT64_C(4));
+    QCOMPARE(merged.total(), Q_INT64_C(75));
+    QCOMPARE(merged.min(), Q_INT64_C(5));
+    QCOMPARE(merged.max(), Q_INT64_C(40));
+}
+
+// Test: recording of durations --------------------------------------------------------------------
+
+void TestLifecycleTimings::testRecord()
+{
+    using Phase = LifecycleTimings::Phase;
+
+    LifecycleTimings timings;
+    timings.record(Phase::Start, "instance1", 100);
+    timings.record(Phase::Start, "instance2", 300);
+    timings.record(Phase::Start, "instance1", 200);
+    timings.record(Phase::ConfigValidation, QString(), 50);
+
+    QCOMPARE(timings.histogram(Phase::Start).count(), Q_UINT64_C(3));
+    QCOMPARE(timings.histogram(Phase::Start).total(), Q_INT64_C(600));
+    QCOMPARE(timings.histogram(Phase::Start, "instance1").count(), Q_UINT64_C(2));
+    QCOMPARE(timings.histogram(Phase::Start, "instance1").total(), Q_INT64_C(300));
+    QCOMPARE(timings.histogram(Phase::Start, "unknown").count(), Q_UINT64_C(0));
+    QCOMPARE(timings.names(Phase::Start), QStringList({ "instance1", "instance2" }));
+
+    QCOMPARE(timings.histogram(Phase::ConfigValidation).count(), Q_UINT64_C(1));
+    QVERIFY(timings.names(Phase::ConfigValidation).isEmpty());
+    QCOMPARE(timings.histogram(Phase::Stop).count(), Q_UINT64_C(0));
+
+    timings.clear();
+    QCOMPARE(timings.histogram(Phase::Start).count(), Q_UINT64_C(0));
+    QVERIFY(timings.names(Phase::Start).isEmpty());
+}
+
+// Test: scoped measurement ------------------------------------------------------------------------
+
+void TestLifecycleTimings::testScope()
+{
+    using Phase = LifecycleTimings::Phase;
+
+    LifecycleTimings timings;
+
+    {
+        LifecycleTimings::Scope scope(&timings, Phase::LibraryLoad, "library");
+        QThread::msleep(2);
+    }
+
+    QCOMPARE(timings.histogram(Phase::LibraryLoad, "library").count(), Q_UINT64_C(1));
+    QVERIFY(timings.histogram(Phase::LibraryLoad, "library").total() >= 1000000);
+
+    // Scope without timings
+    {
+        LifecycleTimings::Scope scope(nullptr, Phase::LibraryLoad, "library");
+    }
+
+    QCOMPARE(timings.histogram(Phase::LibraryLoad).count(), Q_UINT64_C(1));
+}
+
+// Test: JSON --------------------------------------------------------------------------------------
+
+void TestLifecycleTimings::testJson()
+{
+    using Phase = LifecycleTimings::Phase;
+
+    LifecycleTimings timings;
+    timings.record(Phase::Start, "instance1", 100);
+    timings.record(Phase::Start, "instance1", 300);
+
+    const QJsonObject phases = timings.toJson().value("phases").toObject();
+    QCOMPARE(phases.size(), LifecycleTimings::PhaseCount);
+
+    for (int i = 0; i < LifecycleTimings::PhaseCount; i++)
+    {
+        QVERIFY(phases.contains(LifecycleTimings::phaseToString(static_cast<Phase>(i))));
+    }
+
+    const QJsonObject start = phases.value("start").toObject();
+    QCOMPARE(start.value("count").toInt(), 2);
+    QCOMPARE(start.value("total_ns").toInt(), 400);
+    QCOMPARE(start.value("min_ns").toInt(), 100);
+    QCOMPARE(start.value("max_ns").toInt(), 300);
+    QCOMPARE(start.value("buckets").toObject().value("64").toInt(), 1);
+    QCOMPARE(start.value("buckets").toObject().value("256").toInt(), 1);
+    QCOMPARE(start.value("items").toObject().value("instance1").toObject().value("count").toInt(),
+             2);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(timings.writeJson(dir.filePath("timings.json")));
+    QVERIFY(QFileInfo(dir.filePath("timings.json")).size() > 0);
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestLifecycleTimings)
+#include "testLifecycleTimings.moc"
@@ -0,0 +1,315 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for LiveStats and LiveStatsReader classes
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LiveStats.hpp>
+
+// Qt includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestLiveStats : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testCreate();
+    void testInstanceStates();
+    void testInstanceTimings();
+    void testMetrics();
+    void testCapacity();
+    void testInvalidSegment();
+
+private:
+    //! Name of the segment used by the tests
+    QString m_segmentName;
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestLiveStats::initTestCase()
+{
+    m_segmentName = QString("/cppplugin-test-%1").arg(QCoreApplication::applicationPid());
+}
+
+void TestLiveStats::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestLiveStats::init()
+{
+}
+
+void TestLiveStats::cleanup()
+{
+}
+
+// Test: creation of the segment -------------------------------------------------------------------
+
+void TestLiveStats::testCreate()
+{
+    LiveStats liveStats;
+    QVERIFY(!liveStats.isCreated());
+    QVERIFY(liveStats.segmentName().isEmpty());
+
+    QVERIFY(liveStats.create(m_segmentName));
+    QVERIFY(liveStats.isCreated());
+    QCOMPARE(liveStats.segmentName(), m_segmentName);
+
+    // Segment can only be created once
+    QVERIFY(!liveStats.create(m_segmentName));
+
+    // Read the empty segment (leading slash is optional)
+    LiveStatsReader reader;
+    QVERIFY(!reader.isAttached());
+    QVERIFY(reader.attach(m_segmentName.mid(1)));
+    QVERIFY(reader.isAttached());
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.processId, QCoreApplication::applicationPid());
+    QVERIFY(snapshot.updateTime > 0);
+    QVERIFY(snapshot.instances.empty());
+    QVERIFY(snapshot.metrics.empty());
+
+    // Removed segment cannot be attached to anymore
+    reader.detach();
+    QVERIFY(!reader.isAttached());
+
+    liveStats.destroy();
+    QVERIFY(!liveStats.isCreated());
+    QVERIFY(!reader.attach(m_segmentName));
+
+    QCOMPARE(LiveStats::defaultSegmentName(1234), QString("/cppplugin-1234"));
+}
+
+// Test: states of the plugin instances ------------------------------------------------------------
+
+void TestLiveStats::testInstanceStates()
+{
+    LiveStats liveStats;
+    QVERIFY(liveStats.create(m_segmentName));
+    liveStats.setInstances({"instance1", "instance2"});
+
+    LiveStatsReader reader;
+    QVERIFY(reader.attach(m_segmentName));
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.size(), static_cast<size_t>(2));
+    QCOMPARE(snapshot.instances.at(0).name, QString("instance1"));
+    QCOMPARE(snapshot.instances.at(0).state, LiveStats::InstanceState::Loaded);
+    QCOMPARE(snapshot.instances.at(0).startTime, Q_INT64_C(0));
+    QCOMPARE(snapshot.instances.at(1).name, QString("instance2"));
+    QCOMPARE(snapshot.instances.at(1).state, LiveStats::InstanceState::Loaded);
+
+    // Start the first instance and fail to start the second one
+    const qint64 startTime = QDateTime::currentMSecsSinceEpoch();
+    liveStats.setInstanceState("instance1", LiveStats::InstanceState::Started);
+    liveStats.setInstanceState("instance2", LiveStats::InstanceState::Failed);
+    liveStats.setInstanceState("unknown", LiveStats::InstanceState::Started);
+
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.size(), static_cast<size_t>(2));
+    QCOMPARE(snapshot.instances.at(0).state, LiveStats::InstanceState::Started);
+    QVERIFY(snapshot.instances.at(0).startTime >= startTime);
+    QCOMPARE(snapshot.instances.at(1).state, LiveStats::InstanceState::Failed);
+    QCOMPARE(snapshot.instances.at(1).startTime, Q_INT64_C(0));
+
+    // Stop the first instance
+    liveStats.setInstanceState("instance1", LiveStats::InstanceState::Stopped);
+
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.at(0).state, LiveStats::InstanceState::Stopped);
+    QCOMPARE(snapshot.instances.at(0).startTime, Q_INT64_C(0));
+
+    // Unload all instances
+    liveStats.setInstances({});
+
+    QVERIFY(reader.read(&snapshot));
+    QVERIFY(snapshot.instances.empty());
+
+    QCOMPARE(LiveStats::stateToString(LiveStats::InstanceState::Stopping), QString("stopping"));
+}
+
+// Test: lifecycle timings of the plugin instances -------------------------------------------------
+
+void TestLiveStats::testInstanceTimings()
+{
+    LiveStats liveStats;
+    QVERIFY(liveStats.create(m_segmentName));
+    liveStats.setInstances({"instance1"});
+
+    LifecycleTimings timings;
+    timings.record(LifecycleTimings::Phase::LibraryLoad, "instance1", 1000);
+    timings.record(LifecycleTimings::Phase::Start, "instance1", 2000);
+    timings.record(LifecycleTimings::Phase::Start, "instance1", 3000);
+    timings.record(LifecycleTimings::Phase::Start, "instance2", 4000);
+    liveStats.setInstanceTimings("instance1", timings);
+
+    LiveStatsReader reader;
+    QVERIFY(reader.attach(m_segmentName));
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.size(), static_cast<size_t>(1));
+
+    const auto &instance = snapshot.instances.at(0);
+    const auto libraryLoad = static_cast<size_t>(LifecycleTimings::Phase::LibraryLoad);
+    const auto start = static_cast<size_t>(LifecycleTimings::Phase::Start);
+    const auto stop = static_cast<size_t>(LifecycleTimings::Phase::Stop);
+
+    QCOMPARE(instance.phaseDurations[libraryLoad], Q_INT64_C(1000));
+    QCOMPARE(instance.phaseCounts[libraryLoad], Q_UINT64_C(1));
+    QCOMPARE(instance.phaseDurations[start], Q_INT64_C(5000));
+    QCOMPARE(instance.phaseCounts[start], Q_UINT64_C(2));
+    QCOMPARE(instance.phaseDurations[stop], Q_INT64_C(0));
+    QCOMPARE(instance.phaseCounts[stop], Q_UINT64_C(0));
+}
+
+// Test: metrics -----------------------------------------------------------------------------------
+
+void TestLiveStats::testMetrics()
+{
+    LiveStats liveStats;
+    QVERIFY(liveStats.create(m_segmentName));
+
+    MetricsRegistry::MetricSnapshot counter;
+    counter.type = MetricsRegistry::Type::Counter;
+    counter.name = "test_live_stats_counter";
+    counter.instance = "instance1";
+    counter.value = 42;
+
+    MetricsRegistry::MetricSnapshot histogram;
+    histogram.type = MetricsRegistry::Type::Histogram;
+    histogram.name = "test_live_stats_histogram";
+    histogram.count = 10U;
+    histogram.sum = 100U;
+    histogram.buckets = { {5U, 5U}, {15U, 4U}, {30U, 1U} };
+
+    liveStats.setMetrics({counter, histogram});
+
+    LiveStatsReader reader;
+    QVERIFY(reader.attach(m_segmentName));
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.metrics.size(), static_cast<size_t>(2));
+
+    QCOMPARE(snapshot.metrics.at(0).name, counter.name);
+    QCOMPARE(snapshot.metrics.at(0).instance, counter.instance);
+    QCOMPARE(snapshot.metrics.at(0).type, MetricsRegistry::Type::Counter);
+    QCOMPARE(snapshot.metrics.at(0).value, Q_INT64_C(42));
+
+    QCOMPARE(snapshot.metrics.at(1).name, histogram.name);
+    QVERIFY(snapshot.metrics.at(1).instance.isEmpty());
+    QCOMPARE(snapshot.metrics.at(1).type, MetricsRegistry::Type::Histogram);
+    QCOMPARE(snapshot.metrics.at(1).count, Q_UINT64_C(10));
+    QCOMPARE(snapshot.metrics.at(1).sum, Q_UINT64_C(100));
+    QCOMPARE(snapshot.metrics.at(1).p50, histogram.percentile(50.0));
+    QCOMPARE(snapshot.metrics.at(1).p99, histogram.percentile(99.0));
+
+    // Replace the metrics
+    liveStats.setMetrics({counter});
+
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.metrics.size(), static_cast<size_t>(1));
+}
+
+// Test: capacity of the segment -------------------------------------------------------------------
+
+void TestLiveStats::testCapacity()
+{
+    LiveStats liveStats;
+    QVERIFY(liveStats.create(m_segmentName, 2, 1));
+
+    // Long names are truncated
+    const QString longName(LiveStats::NameSize * 2, QChar('x'));
+    liveStats.setInstances({"instance1", longName, "instance3"});
+
+    MetricsRegistry::MetricSnapshot metric;
+    metric.name = "test_live_stats_metric";
+    liveStats.setMetrics({metric, metric});
+
+    LiveStatsReader reader;
+    QVERIFY(reader.attach(m_segmentName));
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.size(), static_cast<size_t>(2));
+    QCOMPARE(snapshot.instances.at(0).name, QString("instance1"));
+    QCOMPARE(snapshot.instances.at(1).name, longName.left(LiveStats::NameSize - 1));
+    QCOMPARE(snapshot.metrics.size(), static_cast<size_t>(1));
+
+    // Instances over the capacity are ignored
+    liveStats.setInstanceState("instance3", LiveStats::InstanceState::Started);
+    QVERIFY(reader.read(&snapshot));
+    QCOMPARE(snapshot.instances.size(), static_cast<size_t>(2));
+
+    LiveStats invalidLiveStats;
+    QVERIFY(!invalidLiveStats.create(m_segmentName + "-invalid", -1, 1));
+}
+
+// Test: invalid segment ---------------------------------------------------------------------------
+
+void TestLiveStats::testInvalidSegment()
+{
+    LiveStatsReader reader;
+    QVERIFY(!reader.attach(m_segmentName + "-missing"));
+    QVERIFY(!reader.isAttached());
+
+    LiveStats::Snapshot snapshot;
+    QVERIFY(!reader.read(&snapshot));
+
+    // Updates without a segment are ignored
+    LiveStats liveStats;
+    liveStats.setInstances({"instance1"});
+    liveStats.setInstanceState("instance1", LiveStats::InstanceState::Started);
+    liveStats.setMetrics({});
+    QVERIFY(!liveStats.isCreated());
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestLiveStats)
+#include "testLiveStats.moc"
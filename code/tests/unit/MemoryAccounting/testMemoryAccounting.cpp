@@ -0,0 +1,255 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for MemoryAccounting class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/MemoryAccounting.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <memory>
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestMemoryAccounting : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testScope();
+    void testThreadPropagation();
+    void testAllocationStats();
+    void testParseSmaps();
+    void testFileMappings();
+
+private:
+    /*!
+     * Finds the allocation stats of the plugin instance
+     *
+     * \param   instanceName    Name of the plugin instance
+     *
+     * \return  Allocation stats (with an empty instance name if the account does not exist)
+     */
+    static MemoryAccounting::AllocationStats findStats(const QString &instanceName);
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestMemoryAccounting::initTestCase()
+{
+}
+
+void TestMemoryAccounting::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestMemoryAccounting::init()
+{
+}
+
+void TestMemoryAccounting::cleanup()
+{
+}
+
+// Test: scopes ------------------------------------------------------------------------------------
+
+void TestMemoryAccounting::testScope()
+{
+    QVERIFY(!MemoryAccounting::currentTag().isValid());
+    QVERIFY(!MemoryAccounting::tag(QString()).isValid());
+
+    {
+        MemoryAccounting::Scope scope1("instance1");
+        QCOMPARE(MemoryAccounting::currentTag().instanceName(), QString("instance1"));
+
+        {
+            MemoryAccounting::Scope scope2("instance2");
+            QCOMPARE(MemoryAccounting::currentTag().instanceName(), QString("instance2"));
+
+            // Invalid tag clears the current tag
+            MemoryAccounting::Scope scope3 { MemoryAccounting::Tag() };
+            QVERIFY(!MemoryAccounting::currentTag().isValid());
+        }
+
+        QCOMPARE(MemoryAccounting::currentTag().instanceName(), QString("instance1"));
+    }
+
+    QVERIFY(!MemoryAccounting::currentTag().isValid());
+    QCOMPARE(findStats("instance1").instance, QString("instance1"));
+    QCOMPARE(findStats("instance2").instance, QString("instance2"));
+}
+
+// Test: propagation of the tag to another thread --------------------------------------------------
+
+void TestMemoryAccounting::testThreadPropagation()
+{
+    MemoryAccounting::Scope scope("instance1");
+    const auto tag = MemoryAccounting::currentTag();
+
+    QString untaggedName("unset");
+    QString taggedName;
+
+    std::thread thread([&]()
+    {
+        untaggedName = MemoryAccounting::currentTag().instanceName();
+
+        MemoryAccounting::Scope threadScope(tag);
+        taggedName = MemoryAccounting::currentTag().instanceName();
+    });
+    thread.join();
+
+    QVERIFY(untaggedName.isEmpty());
+    QCOMPARE(taggedName, QString("instance1"));
+}
+
+// Test: allocation stats --------------------------------------------------------------------------
+
+void TestMemoryAccounting::testAllocationStats()
+{
+    const auto before = findStats("allocating_instance");
+    std::unique_ptr<char[]> buffer;
+
+    {
+        MemoryAccounting::Scope scope("allocating_instance");
+        buffer.reset(new char[1000]);
+    }
+
+    const auto allocated = findStats("allocating_instance");
+    QCOMPARE(allocated.instance, QString("allocating_instance"));
+
+    // Memory freed outside of the scope is still removed from the account that allocated it
+    buffer.reset();
+    const auto freed = findStats("allocating_instance");
+
+    if (!MemoryAccounting::isAllocatorInterposed())
+    {
+        QCOMPARE(allocated.allocatedBytes, Q_UINT64_C(0));
+        QCOMPARE(freed.freedBytes, Q_UINT64_C(0));
+        return;
+    }
+
+    QCOMPARE(allocated.allocatedBytes - before.allocatedBytes, Q_UINT64_C(1000));
+    QCOMPARE(allocated.allocationCount - before.allocationCount, Q_UINT64_C(1));
+    QCOMPARE(allocated.liveBytes(), before.liveBytes() + Q_INT64_C(1000));
+    QCOMPARE(freed.freedBytes - before.freedBytes, Q_UINT64_C(1000));
+    QCOMPARE(freed.freeCount - before.freeCount, Q_UINT64_C(1));
+    QCOMPARE(freed.liveBytes(), before.liveBytes());
+}
+
+// Test: parsing of smaps --------------------------------------------------------------------------
+
+void TestMemoryAccounting::testParseSmaps()
+{
+    const QByteArray contents =
+            "55d0c0a00000-55d0c0a02000 r--p 00000000 08:01 123 /usr/lib/libexample.so\n"
+            "Size:                  8 kB\n"
+            "Rss:                   4 kB\n"
+            "Pss:                   4 kB\n"
+            "VmFlags: rd mr mw me sd\n"
+            "55d0c0a02000-55d0c0a06000 r-xp 00002000 08:01 123 /usr/lib/libexample.so\n"
+            "Size:                 16 kB\n"
+            "Rss:                  12 kB\n"
+            "55d0c1000000-55d0c1021000 rw-p 00000000 00:00 0 [heap]\n"
+            "Size:                132 kB\n"
+            "Rss:                 100 kB\n"
+            "7f0000000000-7f0000001000 rw-p 00000000 00:00 0\n"
+            "Size:                  4 kB\n"
+            "Rss:                   4 kB\n"
+            "7f0000001000-7f0000002000 r--p 00000000 08:01 456 /opt/my plugins/libplugin.so\n"
+            "Size:                  4 kB\n"
+            "Rss:                   0 kB\n";
+
+    const auto mappings = MemoryAccounting::parseSmaps(contents);
+    QCOMPARE(mappings.size(), static_cast<size_t>(2));
+
+    QCOMPARE(mappings.at(0).filePath, QString("/opt/my plugins/libplugin.so"));
+    QCOMPARE(mappings.at(0).mappedBytes, Q_UINT64_C(4096));
+    QCOMPARE(mappings.at(0).residentBytes, Q_UINT64_C(0));
+
+    QCOMPARE(mappings.at(1).filePath, QString("/usr/lib/libexample.so"));
+    QCOMPARE(mappings.at(1).mappedBytes, Q_UINT64_C(24576));
+    QCOMPARE(mappings.at(1).residentBytes, Q_UINT64_C(16384));
+
+    QVERIFY(MemoryAccounting::parseSmaps(QByteArray()).empty());
+}
+
+// Test: mappings of the process -------------------------------------------------------------------
+
+void TestMemoryAccounting::testFileMappings()
+{
+#if defined(Q_OS_LINUX)
+    const auto mappings = MemoryAccounting::fileMappings();
+    bool frameworkLibraryFound = false;
+
+    for (const auto &mapping : mappings)
+    {
+        if (mapping.filePath.contains("CppPluginFramework"))
+        {
+            frameworkLibraryFound = true;
+            QVERIFY(mapping.mappedBytes > 0U);
+            QVERIFY(mapping.residentBytes > 0U);
+        }
+    }
+
+    QVERIFY(frameworkLibraryFound);
+#else
+    QSKIP("Mappings are only supported on Linux");
+#endif
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+MemoryAccounting::AllocationStats TestMemoryAccounting::findStats(const QString &instanceName)
+{
+    for (const auto &stats : MemoryAccounting::allocationStats())
+    {
+        if (stats.instance == instanceName)
+        {
+            return stats;
+        }
+    }
+
+    return {};
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestMemoryAccounting)
+#include "testMemoryAccounting.moc"
@@ -0,0 +1,415 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for MetricsRegistry class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/MetricsRegistry.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+// System includes
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestMetricsRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testCounter();
+    void testGauge();
+    void testHistogram();
+    void testBucketUpperBound();
+    void testInvalidMetrics();
+    void testMultipleThreads();
+    void testOpenMetrics();
+    void testWriteOpenMetrics();
+    void testSendOpenMetrics();
+
+private:
+    /*!
+     * Finds the snapshot of the metric
+     *
+     * \param   name        Metric name
+     * \param   instance    Name of the plugin instance
+     *
+     * \return  Snapshot (with an empty name if the metric is not registered)
+     */
+    static MetricsRegistry::MetricSnapshot findSnapshot(const QString &name,
+                                                        const QString &instance = QString());
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestMetricsRegistry::initTestCase()
+{
+}
+
+void TestMetricsRegistry::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestMetricsRegistry::init()
+{
+    MetricsRegistry::instance().reset();
+}
+
+void TestMetricsRegistry::cleanup()
+{
+}
+
+// Test: counter -----------------------------------------------------------------------------------
+
+void TestMetricsRegistry::testCounter()
+{
+    auto &registry = MetricsRegistry::instance();
+
+    const auto counter = registry.counter("test_requests_total", "instance1", "Requests");
+    QVERIFY(counter.isValid());
+
+    counter.increment();
+    counter.increment(4U);
+
+    // Registering the same counter again returns the same metric ("_total" suffix is optional)
+    registry.counter("test_requests", "instance1").increment();
+
+    // Each plugin instance has its own counter
+    registry.counter("test_requests", "instance2").increment(10U);
+
+    const auto snapshot = findSnapshot("test_requests", "instance1");
+    QCOMPARE(snapshot.type, MetricsRegistry::Type::Counter);
+    QCOMPARE(snapshot.help, QStringLiteral("Requests"));
+    QCOMPARE(snapshot.value, Q_INT64_C(6));
+    QCOMPARE(findSnapshot("test_requests", "instance2").value, Q_INT64_C(10));
+
+    // Invalid handle does nothing
+    MetricsRegistry::Counter invalidCounter;
+    QVERIFY(!invalidCounter.isValid());
+    invalidCounter.increment();
+
+    // Reset keeps the handles valid
+    registry.reset();
+    QCOMPARE(findSnapshot("test_requests", "instance1").value, Q_INT64_C(0));
+    counter.increment();
+    QCOMPARE(findSnapshot("test_requests", "instance1").value, Q_INT64_C(1));
+}
+
+// Test: gauge -------------------------------------------------------------------------------------
+
+void TestMetricsRegistry::testGauge()
+{
+    const auto gauge = MetricsRegistry::instance().gauge("test_queue_size", "instance1");
+    QVERIFY(gauge.isValid());
+
+    gauge.set(10);
+    gauge.add(5);
+    gauge.add(-8);
+
+    const auto snapshot = findSnapshot("test_queue_size", "instance1");
+    QCOMPARE(snapshot.type, MetricsRegistry::Type::Gauge);
+    QCOMPARE(snapshot.value, Q_INT64_C(7));
+}
+
+// Test: histogram ---------------------------------------------------------------------------------
+
+void TestMetricsRegistry::testHistogram()
+{
+    const auto histogram = MetricsRegistry::instance().histogram("test_latency_nanoseconds");
+    QVERIFY(histogram.isValid());
+
+    QCOMPARE(findSnapshot("test_latency_nanoseconds").percentile(50.0), Q_UINT64_C(0));
+
+    for (quint64 value = 1U; value <= 100U; value++)
+    {
+        histogram.record(value * 1000U);
+    }
+
+    const auto snapshot = findSnapshot("test_latency_nanoseconds");
+    QCOMPARE(snapshot.type, MetricsRegistry::Type::Histogram);
+    QCOMPARE(snapshot.count, Q_UINT64_C(100));
+    QCOMPARE(snapshot.sum, Q_UINT64_C(5050000));
+
+    quint64 bucketCount = 0U;
+
+    for (const auto &bucket : snapshot.buckets)
+    {
+        bucketCount += bucket.second;
+    }
+
+    QCOMPARE(bucketCount, snapshot.count);
+
+    // Percentiles are within the relative error of the buckets
+    const quint64 median = snapshot.percentile(50.0);
+    QVERIFY(median >= Q_UINT64_C(50000));
+    QVERIFY(median <= Q_UINT64_C(56250));
+
+    const quint64 maximum = snapshot.percentile(100.0);
+    QVERIFY(maximum >= Q_UINT64_C(100000));
+    QVERIFY(maximum <= Q_UINT64_C(112500));
+
+    // Elapsed time of a timer
+    QElapsedTimer timer;
+    timer.start();
+    histogram.recordElapsed(timer);
+    QCOMPARE(findSnapshot("test_latency_nanoseconds").count, Q_UINT64_C(101));
+}
+
+// Test: bucket upper bounds -----------------------------------------------------------------------
+
+void TestMetricsRegistry::testBucketUpperBound()
+{
+    QCOMPARE(MetricsRegistry::bucketUpperBound(0), Q_UINT64_C(0));
+    QCOMPARE(MetricsRegistry::bucketUpperBound(7), Q_UINT64_C(7));
+    QCOMPARE(MetricsRegistry::bucketUpperBound(8), Q_UINT64_C(8));
+    QCOMPARE(MetricsRegistry::bucketUpperBound(16), Q_UINT64_C(17));
+    QCOMPARE(MetricsRegistry::bucketUpperBound(MetricsRegistry::BucketCount - 1),
+             std::numeric_limits<quint64>::max());
+
+    // Upper bounds are strictly increasing
+    for (int i = 1; i < MetricsRegistry::BucketCount; i++)
+    {
+        QVERIFY(MetricsRegistry::bucketUpperBound(i) > MetricsRegistry::bucketUpperBound(i - 1));
+    }
+
+    // Maximum value is recorded to the last bucket
+    MetricsRegistry::instance().histogram("test_maximum").record(
+                std::numeric_limits<quint64>::max());
+
+    const auto snapshot = findSnapshot("test_maximum");
+    QCOMPARE(snapshot.buckets.size(), static_cast<size_t>(1));
+    QCOMPARE(snapshot.buckets.front().first, std::numeric_limits<quint64>::max());
+}
+
+// Test: invalid metrics ---------------------------------------------------------------------------
+
+void TestMetricsRegistry::testInvalidMetrics()
+{
+    auto &registry = MetricsRegistry::instance();
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Invalid metric name"));
+    QVERIFY(!registry.counter("invalid name").isValid());
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Invalid metric name"));
+    QVERIFY(!registry.gauge("0invalid").isValid());
+
+    // Same name cannot be used for different metric types (not even in another plugin instance)
+    QVERIFY(registry.counter("test_conflict", "instance1").isValid());
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("different type"));
+    QVERIFY(!registry.gauge("test_conflict", "instance2").isValid());
+}
+
+// Test: recording from multiple threads -----------------------------------------------------------
+
+void TestMetricsRegistry::testMultipleThreads()
+{
+    const int threadCount = 16;
+    const int valueCount = 10000;
+
+    const auto counter = MetricsRegistry::instance().counter("test_threads");
+    const auto histogram = MetricsRegistry::instance().histogram("test_threads_nanoseconds");
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back([&counter, &histogram]()
+        {
+            for (int j = 0; j < valueCount; j++)
+            {
+                counter.increment();
+                histogram.record(static_cast<quint64>(j));
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    QCOMPARE(findSnapshot("test_threads").value,
+             static_cast<qint64>(threadCount * valueCount));
+    QCOMPARE(findSnapshot("test_threads_nanoseconds").count,
+             static_cast<quint64>(threadCount * valueCount));
+}
+
+// Test: OpenMetrics text format -------------------------------------------------------------------
+
+void TestMetricsRegistry::testOpenMetrics()
+{
+    std::vector<MetricsRegistry::MetricSnapshot> snapshots(4);
+
+    snapshots[0].type = MetricsRegistry::Type::Counter;
+    snapshots[0].name = "requests";
+    snapshots[0].help = "Number of \"requests\"\nper instance";
+    snapshots[0].instance = "instance1";
+    snapshots[0].value = 3;
+
+    snapshots[1].type = MetricsRegistry::Type::Counter;
+    snapshots[1].name = "requests";
+    snapshots[1].instance = "instance\"2\"";
+    snapshots[1].value = 4;
+
+    snapshots[2].type = MetricsRegistry::Type::Gauge;
+    snapshots[2].name = "queue_size";
+    snapshots[2].value = -2;
+
+    snapshots[3].type = MetricsRegistry::Type::Histogram;
+    snapshots[3].name = "latency_nanoseconds";
+    snapshots[3].count = 3U;
+    snapshots[3].sum = 30U;
+    snapshots[3].buckets = { { 7U, 1U }, { 11U, 2U } };
+
+    const QByteArray expected =
+            "# TYPE requests counter\n"
+            "# HELP requests Number of \"requests\"\\nper instance\n"
+            "requests_total{instance=\"instance1\"} 3\n"
+            "requests_total{instance=\"instance\\\"2\\\"\"} 4\n"
+            "# TYPE queue_size gauge\n"
+            "queue_size -2\n"
+            "# TYPE latency_nanoseconds histogram\n"
+            "latency_nanoseconds_bucket{le=\"7\"} 1\n"
+            "latency_nanoseconds_bucket{le=\"11\"} 3\n"
+            "latency_nanoseconds_bucket{le=\"+Inf\"} 3\n"
+            "latency_nanoseconds_count 3\n"
+            "latency_nanoseconds_sum 30\n"
+            "# EOF\n";
+
+    QCOMPARE(MetricsRegistry::toOpenMetrics(snapshots), expected);
+}
+
+// Test: writing to a file -------------------------------------------------------------------------
+
+void TestMetricsRegistry::testWriteOpenMetrics()
+{
+    MetricsRegistry::instance().counter("test_written").increment();
+    const auto snapshots = MetricsRegistry::instance().snapshot();
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    const QString filePath = directory.filePath("metrics.txt");
+    QVERIFY(MetricsRegistry::writeOpenMetrics(snapshots, filePath));
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const QByteArray text = file.readAll();
+    QCOMPARE(text, MetricsRegistry::toOpenMetrics(snapshots));
+    QVERIFY(text.contains("test_written_total 1\n"));
+}
+
+// Test: sending to a local socket -----------------------------------------------------------------
+
+void TestMetricsRegistry::testSendOpenMetrics()
+{
+    MetricsRegistry::instance().counter("test_sent").increment(2U);
+    const auto snapshots = MetricsRegistry::instance().snapshot();
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    // Sending fails if nobody is listening
+    const QString socketPath = directory.filePath("metrics.sock");
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Failed to connect"));
+    QVERIFY(!MetricsRegistry::sendOpenMetrics(snapshots, socketPath));
+
+    // Listen on the socket (the connection is accepted after the document is already written)
+    const QByteArray path = socketPath.toLocal8Bit();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.constData(), static_cast<size_t>(path.size()));
+
+    const int serverFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    QVERIFY(serverFd >= 0);
+    QCOMPARE(::bind(serverFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)), 0);
+    QCOMPARE(::listen(serverFd, 1), 0);
+
+    QVERIFY(MetricsRegistry::sendOpenMetrics(snapshots, socketPath));
+
+    const int clientFd = ::accept(serverFd, nullptr, nullptr);
+    QVERIFY(clientFd >= 0);
+
+    QByteArray text;
+    char buffer[4096];
+    ssize_t size = 0;
+
+    while ((size = ::read(clientFd, buffer, sizeof(buffer))) > 0)
+    {
+        text.append(buffer, static_cast<int>(size));
+    }
+
+    ::close(clientFd);
+    ::close(serverFd);
+
+    QCOMPARE(text, MetricsRegistry::toOpenMetrics(snapshots));
+    QVERIFY(text.contains("test_sent_total 2\n"));
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+MetricsRegistry::MetricSnapshot TestMetricsRegistry::findSnapshot(const QString &name,
+                                                                  const QString &instance)
+{
+    for (const auto &snapshot : MetricsRegistry::instance().snapshot())
+    {
+        if ((snapshot.name == name) && (snapshot.instance == instance))
+        {
+            return snapshot;
+        }
+    }
+
+    return MetricsRegistry::MetricSnapshot();
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestMetricsRegistry)
+#include "testMetricsRegistry.moc"
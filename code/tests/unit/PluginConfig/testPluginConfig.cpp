@@ -125,6 +125,17 @@ void TestPluginConfig::testIsValid_data()
                                                           validVersion2,
                                                           validInstanceConfigs) << true;
 
+    QTest::newRow("valid: version range expression")
+            << PluginConfig(validFilePath, VersionRange(">=1.0 <1.4 || ^2.0"), validInstanceConfigs)
+            << true;
+
+    {
+        PluginConfig config(QString(), VersionRange("^1.0"), validInstanceConfigs);
+        config.setInterface("Test::IInterface");
+
+        QTest::newRow("valid: interface") << config << true;
+    }
+
     // Invalid results
     QTest::newRow("invalid: default constructed") << PluginConfig() << false;
 
@@ -163,6 +174,24 @@ void TestPluginConfig::testIsValid_data()
             << PluginConfig(validFilePath, validVersion2, validVersion1, validInstanceConfigs)
             << false;
 
+    QTest::newRow("invalid: version range expression")
+            << PluginConfig(validFilePath, VersionRange(">=2.0 <1.0"), validInstanceConfigs)
+            << false;
+
+    {
+        PluginConfig config(validFilePath, VersionRange("^1.0"), validInstanceConfigs);
+        config.setInterface("Test::IInterface");
+
+        QTest::newRow("invalid: file path and interface") << config << false;
+    }
+
+    {
+        PluginConfig config(QString(), VersionRange("^1.0"), validInstanceConfigs);
+        config.setInterface("Test:IInterface");
+
+        QTest::newRow("invalid: interface") << config << false;
+    }
+
     QTest::newRow("invalid: no instance configs")
             << PluginConfig(validFilePath, validVersion1, QList<PluginInstanceConfig>())
             << false;
@@ -200,6 +229,14 @@ void TestPluginConfig::testFilePath()
 
         config = PluginConfig("file2.so", VersionInfo(), VersionInfo(), {});
         QCOMPARE(config.filePath(), QString("file2.so"));
+        QCOMPARE(config.displayName(), QString("file2.so"));
+    }
+
+    // Plugin referenced by an interface
+    {
+        PluginConfig config(QString(), VersionRange("^1.0"), {});
+        config.setInterface("Test::IInterface");
+        QCOMPARE(config.displayName(), QString("Test::IInterface [^1.0]"));
     }
 }
 
@@ -405,6 +442,26 @@ void TestPluginConfig::testLoadConfig_data()
                 << true;
     }
 
+    // Valid: version range expression
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "plugin", ConfigObjectNode
+                {
+                    { "file_path", ConfigValueNode(validFilePath) },
+                    { "version_range", ConfigValueNode("^1.0 !dev") },
+                    { "instances", std::move(instances.clone()->toObject()) }
+                }
+            }
+        };
+
+        QTest::newRow("valid: version range expression")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << PluginConfig(validFilePath, VersionRange("^1.0 !dev"), validInstanceConfigs)
+                << true;
+    }
+
     // Invalid: file path missing
     {
         ConfigObjectNode configNode
@@ -65,6 +65,9 @@ private slots:
     void testName();
     void testConfig();
     void testDependencies();
+    void testRequiredInterfaces();
+    void testActivation();
+    void testIdleTimeout();
 
     void testLoadConfig();
     void testLoadConfig_data();
@@ -117,6 +120,22 @@ void TestPluginInstanceConfig::testIsValid_data()
             << PluginInstanceConfig("instance2", {}, { "instance3", "instance4"} )
             << true;
 
+    QTest::newRow("valid: name and required interfaces")
+            << PluginInstanceConfig("instance2",
+                                    {},
+                                    {},
+                                    {
+                                        { "IFoo", PluginInstanceConfig::Cardinality::One },
+                                        { "Ns::IBar", PluginInstanceConfig::Cardinality::All }
+                                    })
+            << true;
+
+    PluginInstanceConfig lazyConfig("instance2");
+    lazyConfig.setActivation(PluginInstanceConfig::Activation::Lazy);
+    lazyConfig.setIdleTimeout(1000);
+
+    QTest::newRow("valid: lazy with idle timeout") << lazyConfig << true;
+
     // Invalid results
     QTest::newRow("invalid: default constructed") << PluginInstanceConfig() << false;
     QTest::newRow("invalid: only invalid name") << PluginInstanceConfig("1instance") << false;
@@ -132,6 +151,21 @@ void TestPluginInstanceConfig::testIsValid_data()
     QTest::newRow("invalid: valid name and dependency to itself")
             << PluginInstanceConfig("instance2", {}, { "instance2" } )
             << false;
+
+    QTest::newRow("invalid: valid name and invalid required interface")
+            << PluginInstanceConfig("instance2",
+                                    {},
+                                    {},
+                                    { { "Ns:IBar", PluginInstanceConfig::Cardinality::Optional } })
+            << false;
+
+    PluginInstanceConfig eagerConfig("instance2");
+    eagerConfig.setIdleTimeout(1000);
+
+    QTest::newRow("invalid: eager with idle timeout") << eagerConfig << false;
+
+    lazyConfig.setIdleTimeout(-1);
+    QTest::newRow("invalid: negative idle timeout") << lazyConfig << false;
 }
 
 // Test: instance name -----------------------------------------------------------------------------
@@ -218,6 +252,66 @@ void TestPluginInstanceConfig::testDependencies()
     }
 }
 
+// Test: required interfaces -----------------------------------------------------------------------
+
+void TestPluginInstanceConfig::testRequiredInterfaces()
+{
+    const QMap<QString, PluginInstanceConfig::Cardinality> requiredInterfaces
+    {
+        { "IFoo", PluginInstanceConfig::Cardinality::One },
+        { "IBar", PluginInstanceConfig::Cardinality::Optional }
+    };
+
+    // Default constructed
+    {
+        PluginInstanceConfig instanceConfig;
+        QVERIFY(instanceConfig.requiredInterfaces().isEmpty());
+
+        instanceConfig.setRequiredInterfaces(requiredInterfaces);
+        QCOMPARE(instanceConfig.requiredInterfaces(), requiredInterfaces);
+    }
+
+    // Constructed with initial required interfaces
+    {
+        PluginInstanceConfig instanceConfig("aaa", {}, {}, requiredInterfaces);
+        QCOMPARE(instanceConfig.requiredInterfaces(), requiredInterfaces);
+
+        auto otherInstanceConfig = instanceConfig;
+        QVERIFY(otherInstanceConfig == instanceConfig);
+
+        otherInstanceConfig.setRequiredInterfaces({});
+        QVERIFY(otherInstanceConfig != instanceConfig);
+    }
+}
+
+// Test: activation --------------------------------------------------------------------------------
+
+void TestPluginInstanceConfig::testActivation()
+{
+    PluginInstanceConfig instanceConfig("aaa");
+    QCOMPARE(instanceConfig.activation(), PluginInstanceConfig::Activation::Eager);
+
+    auto otherInstanceConfig = instanceConfig;
+    QVERIFY(otherInstanceConfig == instanceConfig);
+
+    otherInstanceConfig.setActivation(PluginInstanceConfig::Activation::Lazy);
+    QCOMPARE(otherInstanceConfig.activation(), PluginInstanceConfig::Activation::Lazy);
+    QVERIFY(otherInstanceConfig != instanceConfig);
+}
+
+// Test: idle timeout ------------------------------------------------------------------------------
+
+void TestPluginInstanceConfig::testIdleTimeout()
+{
+    PluginInstanceConfig instanceConfig("aaa");
+    QCOMPARE(instanceConfig.idleTimeout(), 0);
+
+    auto otherInstanceConfig = instanceConfig;
+    otherInstanceConfig.setIdleTimeout(500);
+    QCOMPARE(otherInstanceConfig.idleTimeout(), 500);
+    QVERIFY(otherInstanceConfig != instanceConfig);
+}
+
 // Test: loadConfig() method -----------------------------------------------------------------------
 
 void TestPluginInstanceConfig::testLoadConfig()
@@ -347,6 +441,67 @@ void TestPluginInstanceConfig::testLoadConfig_data()
                 << true;
     }
 
+    // Valid: name and required interfaces
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test5") },
+                    {
+                        "required_interfaces", ConfigObjectNode
+                        {
+                            { "one", ConfigValueNode(QJsonArray { "IFoo" }) },
+                            { "all", ConfigValueNode(QJsonArray { "Ns::IBar", "Ns::IBaz" }) },
+                            { "optional", ConfigValueNode(QJsonArray { "IQux" }) }
+                        }
+                    }
+                }
+            }
+        };
+
+        auto instanceConfig = PluginInstanceConfig(
+                                  "test5",
+                                  {},
+                                  {},
+                                  {
+                                      { "IFoo", PluginInstanceConfig::Cardinality::One },
+                                      { "Ns::IBar", PluginInstanceConfig::Cardinality::All },
+                                      { "Ns::IBaz", PluginInstanceConfig::Cardinality::All },
+                                      { "IQux", PluginInstanceConfig::Cardinality::Optional }
+                                  });
+
+        QTest::newRow("valid: name and required interfaces")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << instanceConfig
+                << true;
+    }
+
+    // Valid: name and activation
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test6") },
+                    { "activation", ConfigValueNode("lazy") },
+                    { "idle_timeout", ConfigValueNode(60000) }
+                }
+            }
+        };
+
+        auto instanceConfig = PluginInstanceConfig("test6");
+        instanceConfig.setActivation(PluginInstanceConfig::Activation::Lazy);
+        instanceConfig.setIdleTimeout(60000);
+
+        QTest::newRow("valid: name and activation")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << instanceConfig
+                << true;
+    }
+
     // Invalid: name
     {
         ConfigObjectNode configNode1
@@ -450,6 +605,105 @@ void TestPluginInstanceConfig::testLoadConfig_data()
                 << false;
     }
 
+    // Invalid: required interfaces
+    {
+        ConfigObjectNode configNode1
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test") },
+                    { "required_interfaces", ConfigValueNode(QJsonArray { "IFoo" }) }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: required interfaces 1")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode1))
+                << PluginInstanceConfig()
+                << false;
+
+        ConfigObjectNode configNode2
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test") },
+                    {
+                        "required_interfaces", ConfigObjectNode
+                        {
+                            { "one", ConfigValueNode(QJsonArray { "IFoo" }) },
+                            { "optional", ConfigValueNode(QJsonArray { "IFoo" }) }
+                        }
+                    }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: required interfaces 2")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode2))
+                << PluginInstanceConfig()
+                << false;
+
+        ConfigObjectNode configNode3
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test") },
+                    {
+                        "required_interfaces", ConfigObjectNode
+                        {
+                            { "all", ConfigValueNode(QJsonArray { "0IFoo" }) }
+                        }
+                    }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: required interfaces 3")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode3))
+                << PluginInstanceConfig()
+                << false;
+    }
+
+    // Invalid: activation
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test") },
+                    { "activation", ConfigValueNode("later") }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: activation")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << PluginInstanceConfig()
+                << false;
+    }
+
+    // Invalid: idle timeout
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "instance", ConfigObjectNode
+                {
+                    { "name", ConfigValueNode("test") },
+                    { "idle_timeout", ConfigValueNode(1000) }
+                }
+            }
+        };
+
+        QTest::newRow("invalid: idle timeout")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << PluginInstanceConfig()
+                << false;
+    }
 }
 
 // Main function -----------------------------------------------------------------------------------
@@ -125,6 +125,17 @@ void TestPluginManagerConfig::testIsValid_data()
         QTest::newRow("valid: non-empty with startup priorities") << managerConfig << true;
     }
 
+    // Valid: startup profiles
+    {
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(validPluginConfigs);
+        managerConfig.setStartupProfiles({ StartupProfileConfig("cli", { "instance1" }),
+                                           StartupProfileConfig("full", { "instance1",
+                                                                          "instance2" }) });
+
+        QTest::newRow("valid: startup profiles") << managerConfig << true;
+    }
+
     // Invalid: plugin config
     {
         PluginManagerConfig managerConfig;
@@ -181,6 +192,26 @@ void TestPluginManagerConfig::testIsValid_data()
         QTest::newRow("invalid: dependency") << managerConfig << false;
     }
 
+    // Invalid: dependency cycle
+    {
+        auto instanceConfigs1 = validInstanceConfigs1;
+        instanceConfigs1.first().setDependencies({ "instance2" });
+
+        auto instanceConfigs2 = validInstanceConfigs2;
+        instanceConfigs2.first().setDependencies({ "instance1" });
+
+        const QList<PluginConfig> pluginConfigs
+        {
+            PluginConfig(validFilePath1, validVersion, instanceConfigs1),
+            PluginConfig(validFilePath2, validVersion, instanceConfigs2)
+        };
+
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(pluginConfigs);
+
+        QTest::newRow("invalid: dependency cycle") << managerConfig << false;
+    }
+
     // Invalid: startup priorities
     {
         PluginManagerConfig managerConfig;
@@ -191,6 +222,52 @@ void TestPluginManagerConfig::testIsValid_data()
 
         managerConfig.setPluginStartupPriorities({ "instance1", "instance2", "instance1" });
         QTest::newRow("invalid: startup priorities 2") << managerConfig << false;
+
+        const QList<PluginConfig> pluginConfigs
+        {
+            PluginConfig(validFilePath1, validVersion, validInstanceConfigs1),
+            PluginConfig(validFilePath2,
+                         validVersion,
+                         { PluginInstanceConfig("instance2", {}, { "instance1" }) })
+        };
+
+        managerConfig.setPluginConfigs(pluginConfigs);
+        managerConfig.setPluginStartupPriorities({ "instance2", "instance1" });
+        QTest::newRow("invalid: startup priorities 3") << managerConfig << false;
+
+        managerConfig.setPluginStartupPriorities({ "instance1", "instance2" });
+        QTest::newRow("valid: startup priorities after dependencies") << managerConfig << true;
+
+        managerConfig.setPluginStartupPriorities({ "instance2" });
+        QTest::newRow("valid: startup priorities without dependencies") << managerConfig << true;
+    }
+
+    // Invalid: startup profiles
+    {
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(validPluginConfigs);
+
+        managerConfig.setStartupProfiles({ StartupProfileConfig("cli", { "instance3" }) });
+        QTest::newRow("invalid: startup profile root") << managerConfig << false;
+
+        managerConfig.setStartupProfiles({ StartupProfileConfig("cli", {}) });
+        QTest::newRow("invalid: startup profile without roots") << managerConfig << false;
+
+        managerConfig.setStartupProfiles({ StartupProfileConfig("1cli", { "instance1" }) });
+        QTest::newRow("invalid: startup profile name") << managerConfig << false;
+
+        managerConfig.setStartupProfiles({ StartupProfileConfig("cli", { "instance1" }),
+                                           StartupProfileConfig("cli", { "instance2" }) });
+        QTest::newRow("invalid: duplicated startup profile") << managerConfig << false;
+    }
+
+    // Invalid: readiness timeout
+    {
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(validPluginConfigs);
+        managerConfig.setReadinessTimeout(-1);
+
+        QTest::newRow("invalid: readiness timeout") << managerConfig << false;
     }
 }
 
@@ -312,6 +389,63 @@ void TestPluginManagerConfig::testLoadConfig_data()
                 << true;
     }
 
+    // Valid: non-empty with startup profiles
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "plugins", ConfigObjectNode
+                {
+                    { "plugin1", std::move(plugin.clone()->toObject()) }
+                }
+            },
+            {
+                "startup_profiles", ConfigObjectNode
+                {
+                    {
+                        "cli", ConfigObjectNode
+                        {
+                            { "name", ConfigValueNode("cli") },
+                            { "roots", ConfigValueNode(QJsonArray { "instance2" }) }
+                        }
+                    }
+                }
+            }
+        };
+
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(validPluginConfigs);
+        managerConfig.setStartupProfiles({ StartupProfileConfig("cli", { "instance2" }) });
+
+        QTest::newRow("valid: non-empty with startup profiles")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << managerConfig
+                << true;
+    }
+
+    // Valid: non-empty with readiness timeout
+    {
+        ConfigObjectNode configNode
+        {
+            {
+                "plugins", ConfigObjectNode
+                {
+                    { "plugin1", std::move(plugin.clone()->toObject()) }
+                }
+            },
+            { "readiness_timeout", ConfigValueNode(5000) }
+        };
+
+        PluginManagerConfig managerConfig;
+        managerConfig.setPluginConfigs(validPluginConfigs);
+        managerConfig.setReadinessTimeout(5000);
+
+        QTest::newRow("valid: non-empty with readiness timeout")
+                << std::make_shared<ConfigObjectNode>(std::move(configNode))
+                << managerConfig
+                << true;
+    }
+
     // Invalid: plugins node
     {
         ConfigObjectNode configNode
@@ -0,0 +1,159 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for Readiness class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/Readiness.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestReadiness : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testSettle();
+    void testWait();
+    void testObserver();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestReadiness::initTestCase()
+{
+}
+
+void TestReadiness::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestReadiness::init()
+{
+}
+
+void TestReadiness::cleanup()
+{
+}
+
+// Test: settling of the readiness -----------------------------------------------------------------
+
+void TestReadiness::testSettle()
+{
+    Readiness readiness1;
+    QCOMPARE(readiness1.state(), Readiness::State::Pending);
+
+    // Readiness is settled only once
+    QVERIFY(readiness1.setReady());
+    QCOMPARE(readiness1.state(), Readiness::State::Ready);
+    QVERIFY(!readiness1.setFailed("error"));
+    QCOMPARE(readiness1.state(), Readiness::State::Ready);
+    QVERIFY(readiness1.error().isEmpty());
+
+    Readiness readiness2;
+    QVERIFY(readiness2.setFailed("error"));
+    QCOMPARE(readiness2.state(), Readiness::State::Failed);
+    QCOMPARE(readiness2.error(), QString("error"));
+    QVERIFY(!readiness2.setReady());
+}
+
+// Test: waiting for the readiness -----------------------------------------------------------------
+
+void TestReadiness::testWait()
+{
+    Readiness readiness;
+    QCOMPARE(readiness.wait(10), Readiness::State::Pending);
+
+    std::thread thread([&readiness]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        readiness.setReady();
+    });
+
+    QCOMPARE(readiness.wait(), Readiness::State::Ready);
+    QCOMPARE(readiness.wait(0), Readiness::State::Ready);
+    thread.join();
+}
+
+// Test: observer of the readiness -----------------------------------------------------------------
+
+void TestReadiness::testObserver()
+{
+    std::vector<Readiness::State> notifications;
+    const auto observer = [&notifications](const Readiness::State state)
+    {
+        notifications.push_back(state);
+    };
+
+    // Observer is notified once when the readiness is settled
+    Readiness readiness1;
+    readiness1.setObserver(observer);
+    QVERIFY(notifications.empty());
+
+    QVERIFY(readiness1.setFailed("error"));
+    QVERIFY(!readiness1.setReady());
+    QCOMPARE(notifications, std::vector<Readiness::State>({ Readiness::State::Failed }));
+
+    // Observer of an already settled readiness is notified immediately
+    notifications.clear();
+
+    Readiness readiness2;
+    QVERIFY(readiness2.setReady());
+    readiness2.setObserver(observer);
+    QCOMPARE(notifications, std::vector<Readiness::State>({ Readiness::State::Ready }));
+
+    // Removed observer is not notified
+    notifications.clear();
+
+    Readiness readiness3;
+    readiness3.setObserver(observer);
+    readiness3.setObserver(Readiness::Observer());
+    QVERIFY(readiness3.setReady());
+    QVERIFY(notifications.empty());
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestReadiness)
+#include "testReadiness.moc"
@@ -0,0 +1,193 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for StartupAnalysis class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/StartupAnalysis.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestStartupAnalysis : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testInvalid();
+    void testCriticalPath();
+    void testReports();
+
+private:
+    //! Creates the test graph: a -> b, a -> c, b -> d, c -> d, e
+    static DependencyGraph createGraph();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestStartupAnalysis::initTestCase()
+{
+}
+
+void TestStartupAnalysis::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestStartupAnalysis::init()
+{
+}
+
+void TestStartupAnalysis::cleanup()
+{
+}
+
+// Test: invalid analysis --------------------------------------------------------------------------
+
+void TestStartupAnalysis::testInvalid()
+{
+    QVERIFY(!StartupAnalysis().isValid());
+
+    // Durations do not match the graph
+    QVERIFY(!StartupAnalysis(createGraph(), { 1, 2, 3 }).isValid());
+
+    // Graph contains a cycle
+    DependencyGraph cyclicGraph({ "a", "b" }, { { 0, 1 }, { 1, 0 } });
+    QVERIFY(!StartupAnalysis(cyclicGraph, { 1, 2 }).isValid());
+}
+
+// Test: critical path -----------------------------------------------------------------------------
+
+void TestStartupAnalysis::testCriticalPath()
+{
+    const StartupAnalysis analysis(createGraph(), { 20, 30, 5, 10, 7 });
+    QVERIFY(analysis.isValid());
+
+    QCOMPARE(analysis.criticalPathDuration(), Q_INT64_C(60));
+    QCOMPARE(analysis.totalDuration(), Q_INT64_C(72));
+    QCOMPARE(analysis.parallelism(), 1.2);
+    QCOMPARE(analysis.criticalPath(), QStringList({ "d", "b", "a" }));
+
+    const auto &timings = analysis.instanceTimings();
+    QCOMPARE(timings.size(), static_cast<size_t>(5));
+
+    // a
+    QCOMPARE(timings[0].name, QString("a"));
+    QCOMPARE(timings[0].earliestStart, Q_INT64_C(40));
+    QCOMPARE(timings[0].earliestFinish, Q_INT64_C(60));
+    QCOMPARE(timings[0].slack, Q_INT64_C(0));
+    QVERIFY(timings[0].isCritical);
+
+    // b
+    QCOMPARE(timings[1].earliestStart, Q_INT64_C(10));
+    QCOMPARE(timings[1].latestFinish, Q_INT64_C(40));
+    QCOMPARE(timings[1].slack, Q_INT64_C(0));
+    QVERIFY(timings[1].isCritical);
+
+    // c
+    QCOMPARE(timings[2].earliestStart, Q_INT64_C(10));
+    QCOMPARE(timings[2].earliestFinish, Q_INT64_C(15));
+    QCOMPARE(timings[2].latestStart, Q_INT64_C(35));
+    QCOMPARE(timings[2].slack, Q_INT64_C(25));
+    QVERIFY(!timings[2].isCritical);
+
+    // d
+    QCOMPARE(timings[3].earliestStart, Q_INT64_C(0));
+    QCOMPARE(timings[3].latestFinish, Q_INT64_C(10));
+    QCOMPARE(timings[3].slack, Q_INT64_C(0));
+    QVERIFY(timings[3].isCritical);
+
+    // e
+    QCOMPARE(timings[4].latestFinish, Q_INT64_C(60));
+    QCOMPARE(timings[4].slack, Q_INT64_C(53));
+    QVERIFY(!timings[4].isCritical);
+}
+
+// Test: JSON and DOT reports ----------------------------------------------------------------------
+
+void TestStartupAnalysis::testReports()
+{
+    const StartupAnalysis analysis(createGraph(), { 20000000, 30000000, 5000000, 10000000, 0 });
+    QVERIFY(analysis.isValid());
+
+    // JSON
+    const QJsonObject json = analysis.toJson();
+    QCOMPARE(json.value("valid").toBool(), true);
+    QCOMPARE(json.value("critical_path_ns").toDouble(), 60000000.0);
+    QCOMPARE(json.value("critical_path").toArray(), QJsonArray({ "d", "b", "a" }));
+    QCOMPARE(json.value("instances").toArray().size(), 5);
+
+    const QJsonObject instanceC = json.value("instances").toArray().at(2).toObject();
+    QCOMPARE(instanceC.value("name").toString(), QString("c"));
+    QCOMPARE(instanceC.value("slack_ns").toDouble(), 25000000.0);
+    QCOMPARE(instanceC.value("critical").toBool(), false);
+    QCOMPARE(instanceC.value("dependencies").toArray(), QJsonArray({ "d" }));
+
+    // DOT
+    const QString dot = analysis.toDot();
+    QVERIFY(dot.startsWith("digraph startup {"));
+    QVERIFY(dot.contains("\"b\" [label=\"b\\nstart: 30.000 ms\\nslack: 0.000 ms\", color=red"));
+    QVERIFY(dot.contains("\"c\" [label=\"c\\nstart: 5.000 ms\\nslack: 25.000 ms\"];"));
+    QVERIFY(dot.contains("\"d\" -> \"b\" [color=red, penwidth=2];"));
+    QVERIFY(dot.contains("\"d\" -> \"c\";"));
+
+    // Files
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(analysis.writeJson(dir.filePath("startup.json")));
+    QVERIFY(analysis.writeDot(dir.filePath("startup.dot")));
+    QVERIFY(QFileInfo(dir.filePath("startup.json")).size() > 0);
+    QVERIFY(QFileInfo(dir.filePath("startup.dot")).size() > 0);
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+DependencyGraph TestStartupAnalysis::createGraph()
+{
+    return DependencyGraph({ "a", "b", "c", "d", "e" },
+                           { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 2, 3 } });
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestStartupAnalysis)
+#include "testStartupAnalysis.moc"
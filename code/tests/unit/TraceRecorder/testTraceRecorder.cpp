@@ -0,0 +1,295 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for TraceRecorder class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LifecycleTimings.hpp>
+#include <CppPluginFramework/TraceRecorder.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+// System includes
+#include <thread>
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+class TestTraceRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testDisabled();
+    void testSpans();
+    void testThreads();
+    void testFlow();
+    void testLifecycleScope();
+    void testWriteJson();
+
+private:
+    //! Gets the recorded events of the specified type
+    static QList<QJsonObject> events(const QString &type);
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestTraceRecorder::initTestCase()
+{
+}
+
+void TestTraceRecorder::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestTraceRecorder::init()
+{
+    TraceRecorder::instance().stop();
+    TraceRecorder::instance().clear();
+}
+
+void TestTraceRecorder::cleanup()
+{
+    TraceRecorder::instance().stop();
+    TraceRecorder::instance().clear();
+}
+
+// Test: disabled recording ------------------------------------------------------------------------
+
+void TestTraceRecorder::testDisabled()
+{
+    QVERIFY(!TraceRecorder::isEnabled());
+
+    {
+        TraceRecorder::Span span("test", "span");
+    }
+
+    TraceRecorder::instance().addCompleteEvent("test", "event", QString(), 0, 10);
+    TraceRecorder::instance().addFlowEvent("flow", 0, 1, 10, 1);
+
+    QCOMPARE(TraceRecorder::instance().eventCount(), 0);
+}
+
+// Test: spans -------------------------------------------------------------------------------------
+
+void TestTraceRecorder::testSpans()
+{
+    TraceRecorder::instance().start();
+    QVERIFY(TraceRecorder::isEnabled());
+
+    {
+        TraceRecorder::Span outer("test", "outer", "instance1");
+
+        // Moved span records only one event
+        TraceRecorder::Span inner("test", "inner");
+        TraceRecorder::Span movedInner(std::move(inner));
+    }
+
+    TraceRecorder::instance().stop();
+
+    // Spans that end after the recording was stopped are dropped
+    {
+        TraceRecorder::Span span("test", "dropped");
+    }
+
+    QCOMPARE(TraceRecorder::instance().eventCount(), 2);
+
+    const auto completeEvents = events("X");
+    QCOMPARE(completeEvents.size(), 2);
+
+    // Inner span ends first
+    const QJsonObject inner = completeEvents.at(0);
+    const QJsonObject outer = completeEvents.at(1);
+
+    QCOMPARE(inner.value("name").toString(), QString("inner"));
+    QCOMPARE(inner.value("cat").toString(), QString("test"));
+    QVERIFY(!inner.contains("args"));
+
+    QCOMPARE(outer.value("name").toString(), QString("outer"));
+    QCOMPARE(outer.value("args").toObject().value("instance").toString(), QString("instance1"));
+
+    // Inner span is nested in the outer span
+    const double outerEnd = outer.value("ts").toDouble() + outer.value("dur").toDouble();
+    const double innerEnd = inner.value("ts").toDouble() + inner.value("dur").toDouble();
+
+    QVERIFY(outer.value("ts").toDouble() <= inner.value("ts").toDouble());
+    QVERIFY(innerEnd <= outerEnd);
+    QCOMPARE(inner.value("tid").toInt(), outer.value("tid").toInt());
+}
+
+// Test: spans from multiple threads ---------------------------------------------------------------
+
+void TestTraceRecorder::testThreads()
+{
+    TraceRecorder::instance().start();
+
+    {
+        TraceRecorder::Span span("test", "main");
+    }
+
+    std::thread thread([]()
+    {
+        TraceRecorder::Span span("test", "worker");
+    });
+    thread.join();
+
+    TraceRecorder::instance().stop();
+
+    const auto completeEvents = events("X");
+    QCOMPARE(completeEvents.size(), 2);
+    QVERIFY(completeEvents.at(0).value("tid").toInt() !=
+            completeEvents.at(1).value("tid").toInt());
+
+    // Each thread gets a name
+    const auto metadataEvents = events("M");
+    int threadNameCount = 0;
+
+    for (const QJsonObject &event : metadataEvents)
+    {
+        if (event.value("name").toString() == QStringLiteral("thread_name"))
+        {
+            QVERIFY(!event.value("args").toObject().value("name").toString().isEmpty());
+            threadNameCount++;
+        }
+    }
+
+    QCOMPARE(threadNameCount, 2);
+}
+
+// Test: flow events -------------------------------------------------------------------------------
+
+void TestTraceRecorder::testFlow()
+{
+    TraceRecorder::instance().start();
+
+    const qint64 timestamp = TraceRecorder::timestamp();
+    const int threadId = TraceRecorder::currentThreadId();
+
+    TraceRecorder::instance().addFlowEvent("dependency", timestamp, threadId, timestamp + 10,
+                                           threadId);
+    TraceRecorder::instance().addFlowEvent("dependency", timestamp, threadId, timestamp + 20,
+                                           threadId);
+    TraceRecorder::instance().stop();
+
+    const auto flowStarts = events("s");
+    const auto flowEnds = events("f");
+
+    QCOMPARE(flowStarts.size(), 2);
+    QCOMPARE(flowEnds.size(), 2);
+
+    for (int i = 0; i < 2; i++)
+    {
+        QCOMPARE(flowStarts.at(i).value("id").toInt(), flowEnds.at(i).value("id").toInt());
+        QCOMPARE(flowEnds.at(i).value("bp").toString(), QString("e"));
+        QCOMPARE(flowStarts.at(i).value("tid").toInt(), threadId);
+    }
+
+    QVERIFY(flowStarts.at(0).value("id").toInt() != flowStarts.at(1).value("id").toInt());
+}
+
+// Test: lifecycle timing scopes -------------------------------------------------------------------
+
+void TestTraceRecorder::testLifecycleScope()
+{
+    TraceRecorder::instance().start();
+
+    {
+        LifecycleTimings::Scope scope(nullptr, LifecycleTimings::Phase::Start, "instance1");
+    }
+
+    {
+        LifecycleTimings::Scope scope(nullptr, LifecycleTimings::Phase::ConfigValidation,
+                                      QString());
+    }
+
+    TraceRecorder::instance().stop();
+
+    const auto completeEvents = events("X");
+    QCOMPARE(completeEvents.size(), 2);
+    QCOMPARE(completeEvents.at(0).value("name").toString(), QString("start instance1"));
+    QCOMPARE(completeEvents.at(0).value("cat").toString(), QString("lifecycle"));
+    QCOMPARE(completeEvents.at(1).value("name").toString(), QString("config_validation"));
+}
+
+// Test: writing of the trace file -----------------------------------------------------------------
+
+void TestTraceRecorder::testWriteJson()
+{
+    TraceRecorder::instance().start();
+
+    {
+        TraceRecorder::Span span("test", "span");
+    }
+
+    TraceRecorder::instance().stop();
+
+    QCOMPARE(TraceRecorder::instance().toJson().value("displayTimeUnit").toString(),
+             QString("ns"));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(TraceRecorder::instance().writeJson(dir.filePath("trace.json")));
+    QVERIFY(QFileInfo(dir.filePath("trace.json")).size() > 0);
+}
+
+// Helper methods ----------------------------------------------------------------------------------
+
+QList<QJsonObject> TestTraceRecorder::events(const QString &type)
+{
+    QList<QJsonObject> result;
+    const QJsonArray traceEvents =
+            TraceRecorder::instance().toJson().value("traceEvents").toArray();
+
+    for (const QJsonValue &value : traceEvents)
+    {
+        const QJsonObject event = value.toObject();
+
+        if (event.value("ph").toString() == type)
+        {
+            result.append(event);
+        }
+    }
+
+    return result;
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestTraceRecorder)
+#include "testTraceRecorder.moc"
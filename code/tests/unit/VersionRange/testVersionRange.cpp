@@ -0,0 +1,330 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains unit tests for VersionRange class
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/VersionRange.hpp>
+
+// Qt includes
+#include <QtCore/QDebug>
+#include <QtTest/QTest>
+
+// System includes
+
+// Forward declarations
+
+// Macros
+
+// Test class declaration --------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+Q_DECLARE_METATYPE(VersionInfo)
+
+class TestVersionRange : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Functions executed by QtTest before and after test suite
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Functions executed by QtTest before and after each test
+    void init();
+    void cleanup();
+
+    // Test functions
+    void testConstructor();
+
+    void testMatches();
+    void testMatches_data();
+
+    void testMinMaxRange();
+    void testMinMaxRange_data();
+
+    void testInvalidExpressions();
+    void testInvalidExpressions_data();
+
+    void testVersionPartOverflow();
+};
+
+// Test Case init/cleanup methods ------------------------------------------------------------------
+
+void TestVersionRange::initTestCase()
+{
+}
+
+void TestVersionRange::cleanupTestCase()
+{
+}
+
+// Test init/cleanup methods -----------------------------------------------------------------------
+
+void TestVersionRange::init()
+{
+}
+
+void TestVersionRange::cleanup()
+{
+}
+
+// Test: constructors ------------------------------------------------------------------------------
+
+void TestVersionRange::testConstructor()
+{
+    // Default constructor
+    {
+        VersionRange range;
+
+        QVERIFY(range.isNull());
+        QVERIFY(!range.isValid());
+        QVERIFY(!range.matches(VersionInfo(1, 0, 0)));
+    }
+
+    // Exact version
+    {
+        VersionRange range(VersionInfo(1, 2, 3, "dev"));
+
+        QVERIFY(!range.isNull());
+        QVERIFY(range.isValid());
+        QCOMPARE(range.intervals().size(), static_cast<size_t>(1));
+        QVERIFY(range.matches(VersionInfo(1, 2, 3, "dev")));
+        QVERIFY(!range.matches(VersionInfo(1, 2, 3)));
+        QVERIFY(!range.matches(VersionInfo(1, 2, 3, "dev2")));
+    }
+
+    // Expression
+    {
+        VersionRange range(" >=1.2 <1.4 || ^2.0 !dev ");
+
+        QVERIFY(range.isValid());
+        QCOMPARE(range.toString(), QString(">=1.2 <1.4 || ^2.0 !dev"));
+        QCOMPARE(range.intervals().size(), static_cast<size_t>(2));
+        QVERIFY(range == VersionRange(">=1.2 <1.4 || ^2.0 !dev"));
+        QVERIFY(range != VersionRange(">=1.2 <1.4"));
+    }
+}
+
+// Test: matching of versions ----------------------------------------------------------------------
+
+void TestVersionRange::testMatches()
+{
+    QFETCH(QString, expression);
+    QFETCH(VersionInfo, version);
+    QFETCH(bool, result);
+
+    qDebug() << "expression:" << expression;
+    qDebug() << "version:" << version.toString();
+
+    const VersionRange range(expression);
+    QVERIFY(range.isValid());
+    QCOMPARE(range.matches(version), result);
+}
+
+void TestVersionRange::testMatches_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<VersionInfo>("version");
+    QTest::addColumn<bool>("result");
+
+    int i = 0;
+
+    // Exact and partial versions
+    QTest::addRow("%d", i++) << "1.2.3"  << VersionInfo(1, 2, 3)        << true;
+    QTest::addRow("%d", i++) << "=1.2.3" << VersionInfo(1, 2, 3)        << true;
+    QTest::addRow("%d", i++) << "1.2.3"  << VersionInfo(1, 2, 4)        << false;
+    QTest::addRow("%d", i++) << "1.2.3"  << VersionInfo(1, 2, 3, "dev") << false;
+    QTest::addRow("%d", i++) << "1.2"    << VersionInfo(1, 2, 99)       << true;
+    QTest::addRow("%d", i++) << "1.2.x"  << VersionInfo(1, 2, 0, "dev") << true;
+    QTest::addRow("%d", i++) << "1.2"    << VersionInfo(1, 3, 0)        << false;
+    QTest::addRow("%d", i++) << "1.x"    << VersionInfo(1, 99, 0)       << true;
+    QTest::addRow("%d", i++) << "1"      << VersionInfo(2, 0, 0)        << false;
+    QTest::addRow("%d", i++) << "*"      << VersionInfo(0, 0, 0)        << true;
+    QTest::addRow("%d", i++) << "*"      << VersionInfo(99, 0, 0)       << true;
+
+    // Comparators
+    QTest::addRow("%d", i++) << ">=1.2"  << VersionInfo(1, 2, 0)        << true;
+    QTest::addRow("%d", i++) << ">=1.2"  << VersionInfo(1, 1, 99)       << false;
+    QTest::addRow("%d", i++) << ">1.2"   << VersionInfo(1, 2, 99)       << false;
+    QTest::addRow("%d", i++) << ">1.2"   << VersionInfo(1, 3, 0)        << true;
+    QTest::addRow("%d", i++) << ">1.2.3" << VersionInfo(1, 2, 3)        << false;
+    QTest::addRow("%d", i++) << ">1.2.3" << VersionInfo(1, 2, 3, "a")   << true;
+    QTest::addRow("%d", i++) << "<1.2"   << VersionInfo(1, 1, 99)       << true;
+    QTest::addRow("%d", i++) << "<1.2"   << VersionInfo(1, 2, 0)        << false;
+    QTest::addRow("%d", i++) << "<=1.2"  << VersionInfo(1, 2, 99)       << true;
+    QTest::addRow("%d", i++) << "<=1.2"  << VersionInfo(1, 3, 0)        << false;
+    QTest::addRow("%d", i++) << "< 1.2"  << VersionInfo(1, 0, 0)        << true;
+
+    // Caret
+    QTest::addRow("%d", i++) << "^1.2.3" << VersionInfo(1, 2, 3)        << true;
+    QTest::addRow("%d", i++) << "^1.2.3" << VersionInfo(1, 99, 0)       << true;
+    QTest::addRow("%d", i++) << "^1.2.3" << VersionInfo(2, 0, 0)        << false;
+    QTest::addRow("%d", i++) << "^1.2.3" << VersionInfo(1, 2, 2)        << false;
+    QTest::addRow("%d", i++) << "^0.2.3" << VersionInfo(0, 2, 9)        << true;
+    QTest::addRow("%d", i++) << "^0.2.3" << VersionInfo(0, 3, 0)        << false;
+    QTest::addRow("%d", i++) << "^0.0.3" << VersionInfo(0, 0, 3)        << true;
+    QTest::addRow("%d", i++) << "^0.0.3" << VersionInfo(0, 0, 4)        << false;
+    QTest::addRow("%d", i++) << "^2.0"   << VersionInfo(2, 5, 1)        << true;
+    QTest::addRow("%d", i++) << "^0.0"   << VersionInfo(0, 0, 9)        << true;
+    QTest::addRow("%d", i++) << "^0.0"   << VersionInfo(0, 1, 0)        << false;
+
+    // Tilde
+    QTest::addRow("%d", i++) << "~1.2.3" << VersionInfo(1, 2, 9)        << true;
+    QTest::addRow("%d", i++) << "~1.2.3" << VersionInfo(1, 3, 0)        << false;
+    QTest::addRow("%d", i++) << "~1"     << VersionInfo(1, 9, 0)        << true;
+    QTest::addRow("%d", i++) << "~1"     << VersionInfo(2, 0, 0)        << false;
+
+    // Hyphen range
+    QTest::addRow("%d", i++) << "1.2.3 - 1.4"   << VersionInfo(1, 4, 9) << true;
+    QTest::addRow("%d", i++) << "1.2.3 - 1.4"   << VersionInfo(1, 5, 0) << false;
+    QTest::addRow("%d", i++) << "1.2.3 - 1.4.0" << VersionInfo(1, 4, 0) << true;
+    QTest::addRow("%d", i++) << "1.2.3 - 1.4.0" << VersionInfo(1, 2, 2) << false;
+
+    // Unions and development versions
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0"      << VersionInfo(1, 3, 5)        << true;
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0"      << VersionInfo(1, 4, 0)        << false;
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0"      << VersionInfo(2, 1, 0)        << true;
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0"      << VersionInfo(2, 1, 0, "rc1") << true;
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0 !dev" << VersionInfo(2, 1, 0, "rc1") << false;
+    QTest::addRow("%d", i++) << ">=1.2 <1.4 || ^2.0 !dev" << VersionInfo(1, 3, 0, "rc1") << true;
+    QTest::addRow("%d", i++) << "!dev"                    << VersionInfo(5, 0, 0)        << true;
+    QTest::addRow("%d", i++) << ">=1.0.0-a <1.0.0-c"      << VersionInfo(1, 0, 0, "b")   << true;
+    QTest::addRow("%d", i++) << ">=1.0.0-a <1.0.0-c"      << VersionInfo(1, 0, 0, "c")   << false;
+
+    // Invalid version
+    QTest::addRow("%d", i++) << "*" << VersionInfo() << false;
+}
+
+// Test: min/max version range ---------------------------------------------------------------------
+
+void TestVersionRange::testMinMaxRange()
+{
+    QFETCH(VersionInfo, version);
+    QFETCH(VersionInfo, minVersion);
+    QFETCH(VersionInfo, maxVersion);
+
+    qDebug() << "version:" << version.toString();
+    qDebug() << "minVersion:" << minVersion.toString();
+    qDebug() << "maxVersion:" << maxVersion.toString();
+
+    // Compiled version range must give the same result as VersionInfo::isVersionInRange()
+    const VersionRange range(minVersion, maxVersion);
+    QCOMPARE(range.matches(version),
+             VersionInfo::isVersionInRange(version, minVersion, maxVersion));
+}
+
+void TestVersionRange::testMinMaxRange_data()
+{
+    QTest::addColumn<VersionInfo>("version");
+    QTest::addColumn<VersionInfo>("minVersion");
+    QTest::addColumn<VersionInfo>("maxVersion");
+
+    int i = 0;
+
+    QTest::addRow("%d", i++) << VersionInfo(1, 0, 0)      << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0);
+    QTest::addRow("%d", i++) << VersionInfo(1, 9, 999)    << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0);
+    QTest::addRow("%d", i++) << VersionInfo(2, 0, 0)      << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0);
+    QTest::addRow("%d", i++) << VersionInfo(0, 9, 999)    << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0);
+    QTest::addRow("%d", i++) << VersionInfo(1, 9, 6, "a") << VersionInfo(1, 9, 6)      << VersionInfo(1, 9, 6, "b");
+    QTest::addRow("%d", i++) << VersionInfo(1, 9, 6, "b") << VersionInfo(1, 9, 6, "a") << VersionInfo(1, 9, 6, "c");
+    QTest::addRow("%d", i++) << VersionInfo(1, 9, 6, "d") << VersionInfo(1, 9, 6, "b") << VersionInfo(1, 9, 6, "c");
+    QTest::addRow("%d", i++) << VersionInfo(1, 9, 6)      << VersionInfo(1, 9, 6, "b") << VersionInfo(1, 9, 6, "c");
+    QTest::addRow("%d", i++) << VersionInfo(1, 0, -1)     << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0);
+    QTest::addRow("%d", i++) << VersionInfo(1, 0, 0)      << VersionInfo(2, 0, 0)      << VersionInfo(1, 0, 0);
+}
+
+// Test: invalid expressions -----------------------------------------------------------------------
+
+void TestVersionRange::testInvalidExpressions()
+{
+    QFETCH(QString, expression);
+
+    qDebug() << "expression:" << expression;
+    QVERIFY(!VersionRange(expression).isValid());
+}
+
+void TestVersionRange::testInvalidExpressions_data()
+{
+    QTest::addColumn<QString>("expression");
+
+    int i = 0;
+
+    QTest::addRow("%d", i++) << "";
+    QTest::addRow("%d", i++) << " ";
+    QTest::addRow("%d", i++) << "||";
+    QTest::addRow("%d", i++) << "1.2 ||";
+    QTest::addRow("%d", i++) << "a.b.c";
+    QTest::addRow("%d", i++) << "1.x.3";
+    QTest::addRow("%d", i++) << "1.2-dev";
+    QTest::addRow("%d", i++) << "=>1.2";
+    QTest::addRow("%d", i++) << ">";
+    QTest::addRow("%d", i++) << ">*";
+    QTest::addRow("%d", i++) << "<*";
+    QTest::addRow("%d", i++) << "^*";
+    QTest::addRow("%d", i++) << "~x";
+    QTest::addRow("%d", i++) << ">=2.0 <1.0";
+    QTest::addRow("%d", i++) << "1.2.3 - *";
+    QTest::addRow("%d", i++) << "!dev 1.2.3-dev";
+    QTest::addRow("%d", i++) << "3000000.0.0";
+}
+
+// Test: version part overflow ---------------------------------------------------------------------
+
+void TestVersionRange::testVersionPartOverflow()
+{
+    const int overflow = VersionRange::MaxVersionPart + 1;
+
+    // Exact version
+    {
+        const VersionRange range(VersionInfo(overflow, 0, 0));
+        QVERIFY(!range.isValid());
+        QVERIFY(!range.matches(VersionInfo(1, 0, 0)));
+        QVERIFY(!range.matches(VersionInfo(overflow, 0, 0)));
+    }
+
+    // Minimum version
+    {
+        const VersionRange range(VersionInfo(overflow, 0, 0), VersionInfo(overflow + 1, 0, 0));
+        QVERIFY(!range.isValid());
+        QVERIFY(!range.matches(VersionInfo(1, 0, 0)));
+    }
+
+    // Maximum version
+    {
+        const VersionRange range(VersionInfo(1, 0, 0), VersionInfo(1, overflow, 0));
+        QVERIFY(!range.isValid());
+        QVERIFY(!range.matches(VersionInfo(1, 0, 0)));
+    }
+
+    // Largest version that can be packed
+    {
+        const VersionInfo maxVersion(VersionRange::MaxVersionPart,
+                                     VersionRange::MaxVersionPart,
+                                     VersionRange::MaxVersionPart);
+        const VersionRange range(maxVersion);
+        QVERIFY(range.isValid());
+        QVERIFY(range.matches(maxVersion));
+        QVERIFY(!range.matches(VersionInfo(1, 0, 0)));
+    }
+}
+
+// Main function -----------------------------------------------------------------------------------
+
+QTEST_MAIN(TestVersionRange)
+#include "testVersionRange.moc"
@@ -0,0 +1,258 @@
+/* This file is part of C++ Plugin Framework.
+ *
+ * C++ Plugin Framework is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU Lesser General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * C++ Plugin Framework is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with C++ Plugin
+ * Framework. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ *
+ * Contains a command-line tool that shows the live stats of the plugin instances of a process
+ */
+
+// C++ Plugin Framework includes
+#include <CppPluginFramework/LiveStats.hpp>
+
+// Qt includes
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+// System includes
+#include <algorithm>
+
+// Forward declarations
+
+// Macros
+
+// -------------------------------------------------------------------------------------------------
+
+using namespace CppPluginFramework;
+
+//! ANSI escape sequence that clears the terminal and moves the cursor to the top left corner
+static const char s_clearScreen[] = "\033[2J\033[H";
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Converts a duration in nanoseconds to milliseconds
+ *
+ * \param   duration    Duration in nanoseconds
+ *
+ * \return  Duration in milliseconds
+ */
+static QString toMilliseconds(const qint64 duration)
+{
+    return QString::number(static_cast<double>(duration) / 1000000.0, 'f', 3);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Formats the uptime of a plugin instance
+ *
+ * \param   startTime   Start time (milliseconds since epoch, 0 if not started)
+ * \param   now         Current time (milliseconds since epoch)
+ *
+ * \return  Uptime as "hh:mm:ss" (or "-" if not started)
+ */
+static QString uptime(const qint64 startTime, const qint64 now)
+{
+    if (startTime <= 0)
+    {
+        return QStringLiteral("-");
+    }
+
+    const qint64 seconds = std::max(now - startTime, Q_INT64_C(0)) / 1000;
+
+    return QString("%1:%2:%3").arg(seconds / 3600, 2, 10, QChar('0'))
+                              .arg((seconds / 60) % 60, 2, 10, QChar('0'))
+                              .arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Renders the live stats
+ *
+ * \param   segmentName     Name of the segment
+ * \param   snapshot        Contents of the segment
+ * \param   stream          Output stream
+ */
+static void render(const QString &segmentName,
+                   const LiveStats::Snapshot &snapshot,
+                   QTextStream &stream)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    stream << "cppplugin-top - PID " << snapshot.processId
+           << " - segment " << segmentName
+           << " - updated "
+           << QDateTime::fromMSecsSinceEpoch(snapshot.updateTime).toString(Qt::ISODateWithMs)
+           << "\n\n";
+
+    // Plugin instances (load duration includes all phases up to the dependency injection)
+    stream << qSetFieldWidth(32) << left << "INSTANCE"
+           << qSetFieldWidth(10) << "STATE"
+           << qSetFieldWidth(10) << "UPTIME"
+           << qSetFieldWidth(14) << right << "LOAD ms"
+           << qSetFieldWidth(14) << "START ms"
+           << qSetFieldWidth(14) << "STOP ms"
+           << qSetFieldWidth(0) << left << "\n";
+
+    for (const auto &instance : snapshot.instances)
+    {
+        qint64 loadDuration = 0;
+
+        for (int i = 0; i < static_cast<int>(LifecycleTimings::Phase::Start); i++)
+        {
+            loadDuration += instance.phaseDurations[static_cast<size_t>(i)];
+        }
+
+        const auto start = static_cast<size_t>(LifecycleTimings::Phase::Start);
+        const auto stop = static_cast<size_t>(LifecycleTimings::Phase::Stop);
+
+        stream << qSetFieldWidth(32) << left << instance.name
+               << qSetFieldWidth(10) << LiveStats::stateToString(instance.state)
+               << qSetFieldWidth(10) << uptime(instance.startTime, now)
+               << qSetFieldWidth(14) << right << toMilliseconds(loadDuration)
+               << qSetFieldWidth(14) << toMilliseconds(instance.phaseDurations[start])
+               << qSetFieldWidth(14) << toMilliseconds(instance.phaseDurations[stop])
+               << qSetFieldWidth(0) << left << "\n";
+    }
+
+    stream << "\n";
+
+    // Metrics
+    stream << qSetFieldWidth(48) << left << "METRIC"
+           << qSetFieldWidth(24) << "INSTANCE"
+           << qSetFieldWidth(16) << right << "VALUE/COUNT"
+           << qSetFieldWidth(16) << "P50"
+           << qSetFieldWidth(16) << "P99"
+           << qSetFieldWidth(0) << left << "\n";
+
+    for (const auto &metric : snapshot.metrics)
+    {
+        const bool histogram = (metric.type == MetricsRegistry::Type::Histogram);
+
+        stream << qSetFieldWidth(48) << left << metric.name
+               << qSetFieldWidth(24) << (metric.instance.isEmpty() ? QStringLiteral("-")
+                                                                  : metric.instance)
+               << qSetFieldWidth(16) << right
+               << (histogram ? QString::number(metric.count) : QString::number(metric.value))
+               << qSetFieldWidth(16)
+               << (histogram ? QString::number(metric.p50) : QStringLiteral("-"))
+               << qSetFieldWidth(16)
+               << (histogram ? QString::number(metric.p99) : QStringLiteral("-"))
+               << qSetFieldWidth(0) << left << "\n";
+    }
+
+    stream.flush();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+/*!
+ * Entry point of the tool
+ *
+ * \param   argc    Number of arguments
+ * \param   argv    Arguments
+ *
+ * \return  Exit code
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("cppplugin-top"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                QStringLiteral("Shows the live stats of the plugin instances of a process"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("target"),
+                                 QStringLiteral("Process ID or name of the live stats segment"));
+
+    const QCommandLineOption intervalOption(
+                QStringList { QStringLiteral("i"), QStringLiteral("interval") },
+                QStringLiteral("Refresh interval in milliseconds (default: 1000)"),
+                QStringLiteral("ms"),
+                QStringLiteral("1000"));
+    parser.addOption(intervalOption);
+
+    const QCommandLineOption onceOption(QStringLiteral("once"),
+                                        QStringLiteral("Show the live stats only once"));
+    parser.addOption(onceOption);
+
+    parser.process(application);
+
+    QTextStream errorStream(stderr);
+
+    if (parser.positionalArguments().size() != 1)
+    {
+        errorStream << "Exactly one target needs to be specified\n";
+        errorStream.flush();
+        parser.showHelp(1);
+    }
+
+    bool ok = false;
+    const int interval = parser.value(intervalOption).toInt(&ok);
+
+    if ((!ok) || (interval <= 0))
+    {
+        errorStream << "Invalid refresh interval: " << parser.value(intervalOption) << "\n";
+        return 1;
+    }
+
+    // Target is either a process ID or a segment name
+    const QString target = parser.positionalArguments().first();
+    const qint64 processId = target.toLongLong(&ok);
+    const QString segmentName = ok ? LiveStats::defaultSegmentName(processId) : target;
+
+    LiveStatsReader reader;
+
+    if (!reader.attach(segmentName))
+    {
+        errorStream << "Failed to attach to the live stats segment: " << segmentName << "\n";
+        return 1;
+    }
+
+    const bool once = parser.isSet(onceOption);
+    QTextStream outputStream(stdout);
+
+    while (true)
+    {
+        LiveStats::Snapshot snapshot;
+
+        if (!reader.read(&snapshot))
+        {
+            errorStream << "Failed to read the live stats segment: " << segmentName << "\n";
+            return 1;
+        }
+
+        if (!once)
+        {
+            outputStream << s_clearScreen;
+        }
+
+        render(segmentName, snapshot, outputStream);
+
+        if (once)
+        {
+            break;
+        }
+
+        QThread::msleep(static_cast<unsigned long>(interval));
+    }
+
+    return 0;
+}